@@ -26,11 +26,13 @@
 /* Includes the header in the wrapper code */
 #include "ICartesianSolver.h"
 #include "ICartesianControl.h"
+#include "ICentroidalDynamics.h"
 %}
 
 /* Parse the header file to generate wrappers */
 %include "ICartesianSolver.h"
 %include "ICartesianControl.h"
+%include "ICentroidalDynamics.h"
 
 %{
 #include <yarp/dev/PolyDriver.h>
@@ -54,3 +56,14 @@ roboticslab::ICartesianControl *viewICartesianControl(yarp::dev::PolyDriver& d)
 %}
 extern roboticslab::ICartesianControl *viewICartesianControl(yarp::dev::PolyDriver& d);
 
+
+%{
+#include <yarp/dev/PolyDriver.h>
+roboticslab::ICentroidalDynamics *viewICentroidalDynamics(yarp::dev::PolyDriver& d)
+{
+    roboticslab::ICentroidalDynamics *result;
+    d.view(result);
+    return result;
+}
+%}
+extern roboticslab::ICentroidalDynamics *viewICentroidalDynamics(yarp::dev::PolyDriver& d);
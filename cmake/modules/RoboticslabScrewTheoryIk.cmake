@@ -0,0 +1,64 @@
+# Generates a specialized Screw Theory IK solver for a given robot and builds it as a
+# plugin, which can be later loaded by KdlSolver via "(ikPos generated) (ikPlugin <path>)".
+#
+#   roboticslab_add_screw_theory_ik_plugin(<target>
+#                                          KINEMATICS <file.ini>
+#                                          [NAME <namespace>])
+#
+# KINEMATICS: kinematics file, same format as expected by KdlSolver.
+# NAME: namespace of the generated solver, defaults to <target> (as a C identifier).
+#
+# The generated header is placed in ${CMAKE_CURRENT_BINARY_DIR}/<target>/<namespace>.hpp
+# and could be also included directly by C++ sources added to <target>.
+#
+# This module is installed along with the package config files, hence it becomes
+# available to downstream projects after find_package(ROBOTICSLAB_KINEMATICS_DYNAMICS).
+# The installed screwTheoryIkGenerator program is looked up in that case.
+
+set(_ROBOTICSLAB_ST_IK_TEMPLATE ${CMAKE_CURRENT_LIST_DIR}/templates/ScrewTheoryIkPlugin.cpp.in)
+
+function(roboticslab_add_screw_theory_ik_plugin target)
+    cmake_parse_arguments(_st "" "KINEMATICS;NAME" "" ${ARGN})
+
+    if(NOT _st_KINEMATICS)
+        message(FATAL_ERROR "roboticslab_add_screw_theory_ik_plugin: missing KINEMATICS argument")
+    endif()
+
+    if(TARGET screwTheoryIkGenerator)
+        set(_generator screwTheoryIkGenerator)
+    else()
+        find_program(ROBOTICSLAB_SCREW_THEORY_IK_GENERATOR screwTheoryIkGenerator)
+
+        if(NOT ROBOTICSLAB_SCREW_THEORY_IK_GENERATOR)
+            message(FATAL_ERROR "roboticslab_add_screw_theory_ik_plugin: screwTheoryIkGenerator not available (enable KdlSolver)")
+        endif()
+
+        set(_generator ${ROBOTICSLAB_SCREW_THEORY_IK_GENERATOR})
+    endif()
+
+    if(NOT _st_NAME)
+        string(MAKE_C_IDENTIFIER ${target} _st_NAME)
+    endif()
+
+    get_filename_component(_kinematics ${_st_KINEMATICS} ABSOLUTE)
+
+    set(_dir ${CMAKE_CURRENT_BINARY_DIR}/${target})
+    set(_header ${_dir}/${_st_NAME}.hpp)
+
+    add_custom_command(OUTPUT ${_header}
+                       COMMAND ${_generator} --kinematics ${_kinematics} --name ${_st_NAME} --output ${_header}
+                       DEPENDS ${_generator} ${_kinematics}
+                       COMMENT "Generating Screw Theory IK solver ${_st_NAME}"
+                       VERBATIM)
+
+    set(ROBOTICSLAB_ST_IK_HEADER ${_st_NAME}.hpp)
+    set(ROBOTICSLAB_ST_IK_NAMESPACE ${_st_NAME})
+    configure_file(${_ROBOTICSLAB_ST_IK_TEMPLATE} ${_dir}/${target}.cpp @ONLY)
+
+    add_library(${target} MODULE ${_dir}/${target}.cpp
+                                 ${_header})
+
+    target_link_libraries(${target} PRIVATE ROBOTICSLAB::ScrewTheoryLib)
+
+    target_include_directories(${target} PRIVATE ${_dir})
+endfunction()
@@ -0,0 +1,147 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+/**
+ * @ingroup kinematics-dynamics-examples
+ * \defgroup asibotSolverBenchmarkExample asibotSolverBenchmarkExample
+ *
+ * <b>Legal</b>
+ *
+ * Copyright: (C) 2026 Universidad Carlos III de Madrid;
+ *
+ * CopyPolicy: Released under the terms of the LGPLv2.1 or later, see license/LGPL.TXT
+ *
+ * <b>Building</b>
+\verbatim
+cd examples/cpp/exampleAsibotSolverBenchmark/
+mkdir build; cd build; cmake -DCMAKE_BUILD_TYPE=Release ..
+make -j$(nproc)
+\endverbatim
+ * <b>Running example</b>
+\verbatim
+./exampleAsibotSolverBenchmark --samples 100000
+\endverbatim
+ * Times each ICartesianSolver call of the AsibotSolver device on random joint
+ * configurations within limits. Only the public device interface is used, so
+ * that the same executable can be run against different builds of the plugin
+ * (e.g. before and after a change) to compare their cost per call.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+
+#include <yarp/os/LogStream.h>
+#include <yarp/os/Property.h>
+#include <yarp/os/Value.h>
+
+#include <yarp/dev/PolyDriver.h>
+
+#include <ICartesianSolver.h>
+
+#define DEFAULT_SAMPLES 100000
+
+namespace rl = roboticslab;
+
+namespace
+{
+    template <typename Fn>
+    double measure(int samples, Fn && fn)
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        for (int n = 0; n < samples; n++)
+        {
+            fn(n);
+        }
+
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::nano>(elapsed).count() / samples;
+    }
+
+    double randomValue(double min, double max)
+    {
+        return min + (max - min) * std::rand() / RAND_MAX;
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    yarp::os::Property options;
+    options.fromCommand(argc, argv);
+
+    int samples = options.check("samples", yarp::os::Value(DEFAULT_SAMPLES), "number of joint configurations").asInt32();
+
+    yarp::os::Property solverOptions;
+    solverOptions.fromString("(device AsibotSolver) (A0 0.3) (A1 0.4) (A2 0.4) (A3 0.3)");
+    solverOptions.fromString("(mins (-180.0 -135.0 -135.0 -135.0 -180.0)) (maxs (180.0 135.0 135.0 135.0 180.0))", false);
+
+    yarp::dev::PolyDriver solverDevice(solverOptions);
+    rl::ICartesianSolver * iCartesianSolver;
+
+    if (!solverDevice.isValid() || !solverDevice.view(iCartesianSolver))
+    {
+        yError() << "Unable to open AsibotSolver device";
+        return 1;
+    }
+
+    std::srand(0);
+
+    // keep away from the joint limits and the straight arm singularity
+    std::vector<std::vector<double>> q(samples, std::vector<double>(5));
+    std::vector<std::vector<double>> x(samples), xdot(samples, std::vector<double>(6));
+
+    for (int n = 0; n < samples; n++)
+    {
+        q[n][0] = randomValue(-170.0, 170.0);
+        q[n][1] = randomValue(-120.0, 120.0);
+        q[n][2] = randomValue(10.0, 120.0);
+        q[n][3] = randomValue(-120.0, 120.0);
+        q[n][4] = randomValue(-170.0, 170.0);
+
+        iCartesianSolver->fwdKin(q[n], x[n]);
+
+        for (auto & v : xdot[n])
+        {
+            v = randomValue(-0.1, 0.1);
+        }
+    }
+
+    std::vector<double> out;
+    int failures = 0;
+
+    double fwdKin = measure(samples, [&](int n) {
+        failures += !iCartesianSolver->fwdKin(q[n], out);
+    });
+
+    double poseDiff = measure(samples, [&](int n) {
+        failures += !iCartesianSolver->poseDiff(x[n], x[(n + 1) % samples], out);
+    });
+
+    double invKin = measure(samples, [&](int n) {
+        failures += !iCartesianSolver->invKin(x[n], q[n], out, rl::ICartesianSolver::BASE_FRAME);
+    });
+
+    double diffInvKinBase = measure(samples, [&](int n) {
+        failures += !iCartesianSolver->diffInvKin(q[n], xdot[n], out, rl::ICartesianSolver::BASE_FRAME);
+    });
+
+    double diffInvKinTcp = measure(samples, [&](int n) {
+        failures += !iCartesianSolver->diffInvKin(q[n], xdot[n], out, rl::ICartesianSolver::TCP_FRAME);
+    });
+
+    yInfo("AsibotSolver (%d samples), ns per call:", samples);
+    yInfo("  fwdKin               %8.1f", fwdKin);
+    yInfo("  poseDiff             %8.1f", poseDiff);
+    yInfo("  invKin               %8.1f", invKin);
+    yInfo("  diffInvKin (base)    %8.1f", diffInvKinBase);
+    yInfo("  diffInvKin (TCP)     %8.1f", diffInvKinTcp);
+
+    if (failures != 0)
+    {
+        yWarning("%d calls failed", failures);
+    }
+
+    solverDevice.close();
+
+    return 0;
+}
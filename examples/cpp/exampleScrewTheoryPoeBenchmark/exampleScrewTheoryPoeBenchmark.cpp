@@ -0,0 +1,172 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+/**
+ * @ingroup kinematics-dynamics-examples
+ * \defgroup screwTheoryPoeBenchmarkExample screwTheoryPoeBenchmarkExample
+ *
+ * <b>Legal</b>
+ *
+ * Copyright: (C) 2026 Universidad Carlos III de Madrid;
+ *
+ * CopyPolicy: Released under the terms of the LGPLv2.1 or later, see license/LGPL.TXT
+ *
+ * <b>Building</b>
+\verbatim
+cd examples/cpp/exampleScrewTheoryPoeBenchmark/
+mkdir build; cd build; cmake -DCMAKE_BUILD_TYPE=Release ..
+make -j$(nproc)
+\endverbatim
+ * <b>Running example</b>
+\verbatim
+./exampleScrewTheoryPoeBenchmark --joints 30 --samples 100000
+\endverbatim
+ * Times forward kinematics of a POE formula with the KDL-based path, the
+ * frame backend (@ref roboticslab::PoeExpressionT) and the dual quaternion
+ * backend (@ref roboticslab::DualQuaternionT), both in single and double
+ * precision. Besides the TEO arm, a serial chain of `--joints` revolute joints
+ * with random axes is used to expose the cost per term in long chains.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+
+#include <yarp/os/LogStream.h>
+#include <yarp/os/Property.h>
+#include <yarp/os/Value.h>
+
+#include <kdl/frames.hpp>
+#include <kdl/jntarray.hpp>
+#include <kdl/utilities/utility.h>
+
+#include <MatrixExponential.hpp>
+#include <ProductOfExponentials.hpp>
+#include <ScrewTheoryDualQuaternion.hpp>
+#include <ScrewTheoryScalar.hpp>
+
+#define DEFAULT_JOINTS 30
+#define DEFAULT_SAMPLES 100000
+
+namespace rl = roboticslab;
+
+namespace
+{
+    rl::PoeExpression makeTeoLeftArmKinematics()
+    {
+        KDL::Frame H_0_T(KDL::Vector(-0.63401, 0, 0));
+
+        rl::PoeExpression poe(H_0_T);
+
+        poe.append(rl::MatrixExponential(rl::MatrixExponential::ROTATION, KDL::Vector(0, 0, 1), KDL::Vector::Zero()));
+        poe.append(rl::MatrixExponential(rl::MatrixExponential::ROTATION, KDL::Vector(0, 1, 0), KDL::Vector::Zero()));
+        poe.append(rl::MatrixExponential(rl::MatrixExponential::ROTATION, KDL::Vector(1, 0, 0), KDL::Vector::Zero()));
+        poe.append(rl::MatrixExponential(rl::MatrixExponential::ROTATION, KDL::Vector(0, 0, 1), KDL::Vector(-0.32901, 0, 0)));
+        poe.append(rl::MatrixExponential(rl::MatrixExponential::ROTATION, KDL::Vector(1, 0, 0), KDL::Vector::Zero()));
+        poe.append(rl::MatrixExponential(rl::MatrixExponential::ROTATION, KDL::Vector(0, 0, 1), KDL::Vector(-0.53101, 0, 0)));
+
+        return poe;
+    }
+
+    double randomValue(double min, double max)
+    {
+        return min + (max - min) * std::rand() / RAND_MAX;
+    }
+
+    rl::PoeExpression makeLongChain(int joints)
+    {
+        rl::PoeExpression poe(KDL::Frame(KDL::Vector(0, 0, 0.1 * joints)));
+
+        for (int i = 0; i < joints; i++)
+        {
+            KDL::Vector axis(randomValue(-1, 1), randomValue(-1, 1), randomValue(-1, 1));
+            KDL::Vector origin(randomValue(-0.1, 0.1), randomValue(-0.1, 0.1), 0.1 * i);
+            poe.append(rl::MatrixExponential(rl::MatrixExponential::ROTATION, axis, origin));
+        }
+
+        return poe;
+    }
+
+    template <typename Fn>
+    double measure(int samples, Fn && fn)
+    {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::nano>(elapsed).count() / samples;
+    }
+
+    void run(const char * name, const rl::PoeExpression & poe, int samples)
+    {
+        std::vector<double> q(samples * poe.size());
+
+        for (auto & v : q)
+        {
+            v = randomValue(-KDL::PI, KDL::PI);
+        }
+
+        KDL::JntArray qKdl(poe.size());
+        KDL::Frame H;
+
+        double kdl = measure(samples, [&] {
+            for (int n = 0; n < samples; n++)
+            {
+                for (int i = 0; i < poe.size(); i++)
+                {
+                    qKdl(i) = q[n * poe.size() + i];
+                }
+
+                poe.evaluate(qKdl, H);
+            }
+        });
+
+        rl::PoeExpressiond poed(poe);
+        rl::PoeExpressionf poef(poe);
+
+        std::vector<rl::FrameT<double>> Hd(samples);
+        std::vector<rl::FrameT<float>> Hf(samples);
+        std::vector<float> qf(q.begin(), q.end());
+
+        double framed = measure(samples, [&] { poed.evaluate(q.data(), samples, Hd.data()); });
+        double framef = measure(samples, [&] { poef.evaluate(qf.data(), samples, Hf.data()); });
+
+        std::vector<rl::DualQuaterniond> DQd(samples);
+        std::vector<rl::DualQuaternionf> DQf(samples);
+
+        double dqd = measure(samples, [&] { poed.evaluate(q.data(), samples, DQd.data()); });
+        double dqf = measure(samples, [&] { poef.evaluate(qf.data(), samples, DQf.data()); });
+
+        // worst deviation of the dual quaternion backend with regard to the frame one
+        double maxErr = 0;
+
+        for (int n = 0; n < samples; n++)
+        {
+            KDL::Vector diff = rl::toKdl(DQf[n]).p - rl::toKdl(Hd[n]).p;
+            maxErr = std::max(maxErr, diff.Norm());
+        }
+
+        yInfo("%s (%d joints), ns per pose:", name, poe.size());
+        yInfo("  KDL                %8.1f", kdl);
+        yInfo("  frame, double      %8.1f (%zu bytes)", framed, sizeof(rl::FrameT<double>));
+        yInfo("  frame, float       %8.1f (%zu bytes)", framef, sizeof(rl::FrameT<float>));
+        yInfo("  dual quat, double  %8.1f (%zu bytes)", dqd, sizeof(rl::DualQuaterniond));
+        yInfo("  dual quat, float   %8.1f (%zu bytes)", dqf, sizeof(rl::DualQuaternionf));
+        yInfo("  max position error (dual quat, float): %g m", maxErr);
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    yarp::os::Property options;
+    options.fromCommand(argc, argv);
+
+    int joints = options.check("joints", yarp::os::Value(DEFAULT_JOINTS), "number of joints of the long chain").asInt32();
+    int samples = options.check("samples", yarp::os::Value(DEFAULT_SAMPLES), "number of joint configurations").asInt32();
+
+    std::srand(0);
+
+    run("TEO arm", makeTeoLeftArmKinematics(), samples);
+    run("Long chain", makeLongChain(joints), samples);
+
+    return 0;
+}
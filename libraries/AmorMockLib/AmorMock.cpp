@@ -0,0 +1,339 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#include "amor.h"
+
+#include <cmath> // std::abs
+#include <cstdlib> // std::getenv, std::strtod
+
+#include <algorithm> // std::min, std::max
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+
+// Environment variables read on amor_connect():
+//  - AMOR_MOCK_LATENCY_MS: mean duration of each API call (milliseconds, default 0)
+//  - AMOR_MOCK_JITTER_MS: half-width of the uniform noise added to the latency, negative
+//    durations are clipped (milliseconds, default 0)
+
+namespace
+{
+
+constexpr real JOINT_LIMIT = 2.9; // [rad]
+constexpr real MAX_JOINT_VELOCITY = 0.5; // [rad/s]
+constexpr real MAX_LINEAR_VELOCITY = 100.0; // [mm/s]
+constexpr real MAX_ANGULAR_VELOCITY = 0.5; // [rad/s]
+constexpr real TOLERANCE = 1e-9;
+
+// initial end-effector pose: position [mm], orientation as roll-pitch-yaw [rad]
+constexpr real HOME_POSE[AMOR_NUM_JOINTS] = {300.0, 0.0, 500.0, 0.0, 0.0, 0.0};
+
+thread_local std::string lastError;
+
+using clock_type = std::chrono::steady_clock;
+
+class MockArm
+{
+public:
+    enum mode { IDLE, JOINT_POSITION, JOINT_VELOCITY, CARTESIAN_POSITION, CARTESIAN_VELOCITY };
+
+    MockArm(double latency, double jitter)
+        : latency(latency),
+          noise(-jitter, jitter),
+          last(clock_type::now())
+    {
+        for (int i = 0; i < AMOR_NUM_JOINTS; i++)
+        {
+            q[i] = 0.0;
+            x[i] = HOME_POSE[i];
+            reference[i] = 0.0;
+        }
+    }
+
+    //! Block the caller for as long as a round-trip to the controller would take.
+    void delay()
+    {
+        double duration = std::max(latency + noise(generator), 0.0);
+        std::this_thread::sleep_for(std::chrono::duration<double>(duration));
+    }
+
+    //! Advance the simulation up to the present time.
+    void update()
+    {
+        auto now = clock_type::now();
+        double dt = std::chrono::duration<double>(now - last).count();
+        last = now;
+
+        bool reached = true;
+
+        for (int i = 0; i < AMOR_NUM_JOINTS; i++)
+        {
+            switch (current)
+            {
+            case JOINT_POSITION:
+                q[i] += clamp(reference[i] - q[i], MAX_JOINT_VELOCITY * dt);
+                reached = reached && std::abs(reference[i] - q[i]) < TOLERANCE;
+                break;
+            case JOINT_VELOCITY:
+                q[i] = std::min(std::max(q[i] + reference[i] * dt, -JOINT_LIMIT), JOINT_LIMIT);
+                reached = reached && reference[i] == 0.0;
+                break;
+            case CARTESIAN_POSITION:
+                x[i] += clamp(reference[i] - x[i], (i < 3 ? MAX_LINEAR_VELOCITY : MAX_ANGULAR_VELOCITY) * dt);
+                reached = reached && std::abs(reference[i] - x[i]) < TOLERANCE;
+                break;
+            case CARTESIAN_VELOCITY:
+                x[i] += reference[i] * dt;
+                reached = reached && reference[i] == 0.0;
+                break;
+            default:
+                break;
+            }
+        }
+
+        if (reached)
+        {
+            current = IDLE;
+        }
+    }
+
+    //! Switch to a new control mode, simulation must be up to date.
+    void command(mode next, const AMOR_VECTOR7 values)
+    {
+        current = next;
+
+        for (int i = 0; i < AMOR_NUM_JOINTS; i++)
+        {
+            reference[i] = values ? values[i] : 0.0;
+        }
+    }
+
+    std::mutex mutex;
+    mode current {IDLE};
+    real q[AMOR_NUM_JOINTS];
+    real x[AMOR_NUM_JOINTS];
+    real reference[AMOR_NUM_JOINTS];
+
+private:
+    static real clamp(real value, real limit)
+    {
+        return std::min(std::max(value, -limit), limit);
+    }
+
+    const double latency;
+    std::uniform_real_distribution<double> noise;
+    std::minstd_rand generator;
+    clock_type::time_point last;
+};
+
+double getEnvironmentMs(const char * name)
+{
+    const char * value = std::getenv(name);
+    return value ? std::max(std::strtod(value, nullptr), 0.0) * 0.001 : 0.0;
+}
+
+AMOR_RESULT fail(const std::string & error)
+{
+    lastError = error;
+    return AMOR_FAILED;
+}
+
+// Runs the given operation after the simulated latency, with the state of the arm brought up to date.
+template <typename Fn>
+AMOR_RESULT access(AMOR_HANDLE handle, Fn && fn)
+{
+    if (handle == AMOR_INVALID_HANDLE)
+    {
+        return fail("invalid handle");
+    }
+
+    auto * arm = static_cast<MockArm *>(handle);
+    std::lock_guard<std::mutex> lock(arm->mutex);
+    arm->delay();
+    arm->update();
+    return fn(*arm);
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+
+AMOR_HANDLE amor_connect(char * libraryName, int can_port)
+{
+    double latency = getEnvironmentMs("AMOR_MOCK_LATENCY_MS");
+    double jitter = getEnvironmentMs("AMOR_MOCK_JITTER_MS");
+    return new MockArm(latency, jitter);
+}
+
+// -----------------------------------------------------------------------------
+
+AMOR_RESULT amor_release(AMOR_HANDLE handle)
+{
+    if (handle == AMOR_INVALID_HANDLE)
+    {
+        return fail("invalid handle");
+    }
+
+    delete static_cast<MockArm *>(handle);
+    return AMOR_SUCCESS;
+}
+
+// -----------------------------------------------------------------------------
+
+const char * amor_error()
+{
+    return lastError.c_str();
+}
+
+// -----------------------------------------------------------------------------
+
+AMOR_RESULT amor_get_joint_info(AMOR_HANDLE handle, unsigned int joint, AMOR_JOINT_INFO * parameters)
+{
+    return access(handle, [joint, parameters](MockArm & arm)
+        {
+            if (joint >= AMOR_NUM_JOINTS)
+            {
+                return fail("joint index out of range: " + std::to_string(joint));
+            }
+
+            parameters->maxVelocity = MAX_JOINT_VELOCITY;
+            parameters->lowerJointLimit = -JOINT_LIMIT;
+            parameters->upperJointLimit = JOINT_LIMIT;
+            return AMOR_SUCCESS;
+        });
+}
+
+// -----------------------------------------------------------------------------
+
+AMOR_RESULT amor_get_actual_positions(AMOR_HANDLE handle, AMOR_VECTOR7 * positions)
+{
+    return access(handle, [positions](MockArm & arm)
+        {
+            std::copy(arm.q, arm.q + AMOR_NUM_JOINTS, *positions);
+            return AMOR_SUCCESS;
+        });
+}
+
+// -----------------------------------------------------------------------------
+
+AMOR_RESULT amor_get_cartesian_position(AMOR_HANDLE handle, AMOR_VECTOR7 & positions)
+{
+    return access(handle, [&positions](MockArm & arm)
+        {
+            std::copy(arm.x, arm.x + AMOR_NUM_JOINTS, positions);
+            return AMOR_SUCCESS;
+        });
+}
+
+// -----------------------------------------------------------------------------
+
+AMOR_RESULT amor_get_movement_status(AMOR_HANDLE handle, amor_movement_status * status)
+{
+    return access(handle, [status](MockArm & arm)
+        {
+            *status = arm.current == MockArm::IDLE ? AMOR_MOVEMENT_STATUS_FINISHED : AMOR_MOVEMENT_STATUS_MOVING;
+            return AMOR_SUCCESS;
+        });
+}
+
+// -----------------------------------------------------------------------------
+
+AMOR_RESULT amor_set_positions(AMOR_HANDLE handle, AMOR_VECTOR7 positions)
+{
+    return access(handle, [positions](MockArm & arm)
+        {
+            for (int i = 0; i < AMOR_NUM_JOINTS; i++)
+            {
+                if (positions[i] < -JOINT_LIMIT || positions[i] > JOINT_LIMIT)
+                {
+                    return fail("joint " + std::to_string(i) + " target out of limits: " + std::to_string(positions[i]));
+                }
+            }
+
+            arm.command(MockArm::JOINT_POSITION, positions);
+            return AMOR_SUCCESS;
+        });
+}
+
+// -----------------------------------------------------------------------------
+
+AMOR_RESULT amor_set_velocities(AMOR_HANDLE handle, AMOR_VECTOR7 velocities)
+{
+    return access(handle, [velocities](MockArm & arm)
+        {
+            for (int i = 0; i < AMOR_NUM_JOINTS; i++)
+            {
+                if (std::abs(velocities[i]) > MAX_JOINT_VELOCITY)
+                {
+                    return fail("joint " + std::to_string(i) + " velocity out of limits: " + std::to_string(velocities[i]));
+                }
+            }
+
+            arm.command(MockArm::JOINT_VELOCITY, velocities);
+            return AMOR_SUCCESS;
+        });
+}
+
+// -----------------------------------------------------------------------------
+
+AMOR_RESULT amor_set_cartesian_positions(AMOR_HANDLE handle, AMOR_VECTOR7 positions)
+{
+    return access(handle, [positions](MockArm & arm)
+        {
+            arm.command(MockArm::CARTESIAN_POSITION, positions);
+            return AMOR_SUCCESS;
+        });
+}
+
+// -----------------------------------------------------------------------------
+
+AMOR_RESULT amor_set_cartesian_velocities(AMOR_HANDLE handle, AMOR_VECTOR7 velocities)
+{
+    return access(handle, [velocities](MockArm & arm)
+        {
+            arm.command(MockArm::CARTESIAN_VELOCITY, velocities);
+            return AMOR_SUCCESS;
+        });
+}
+
+// -----------------------------------------------------------------------------
+
+AMOR_RESULT amor_controlled_stop(AMOR_HANDLE handle)
+{
+    return access(handle, [](MockArm & arm)
+        {
+            arm.command(MockArm::IDLE, nullptr);
+            return AMOR_SUCCESS;
+        });
+}
+
+// -----------------------------------------------------------------------------
+
+AMOR_RESULT amor_emergency_stop(AMOR_HANDLE handle)
+{
+    return amor_controlled_stop(handle);
+}
+
+// -----------------------------------------------------------------------------
+
+AMOR_RESULT amor_open_hand(AMOR_HANDLE handle)
+{
+    return access(handle, [](MockArm & arm) { return AMOR_SUCCESS; });
+}
+
+// -----------------------------------------------------------------------------
+
+AMOR_RESULT amor_close_hand(AMOR_HANDLE handle)
+{
+    return access(handle, [](MockArm & arm) { return AMOR_SUCCESS; });
+}
+
+// -----------------------------------------------------------------------------
+
+AMOR_RESULT amor_stop_hand(AMOR_HANDLE handle)
+{
+    return access(handle, [](MockArm & arm) { return AMOR_SUCCESS; });
+}
+
+// -----------------------------------------------------------------------------
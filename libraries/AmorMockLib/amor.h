@@ -0,0 +1,72 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#ifndef __AMOR_MOCK_H__
+#define __AMOR_MOCK_H__
+
+/**
+ * @ingroup kinematics-dynamics-libraries
+ * \defgroup AmorMockLib
+ *
+ * @brief Offline stand-in for the subset of the AMOR API used by
+ * \ref AmorCartesianControl.
+ *
+ * Mirrors the declarations of the vendor header so that dependent code builds
+ * unchanged. Robot state is simulated in memory and every call is delayed by a
+ * configurable latency, see AmorMock.cpp for the supported environment variables.
+ * The mock carries no kinematic model: joint-space commands act on the simulated
+ * joints and Cartesian-space commands act on the simulated end-effector pose,
+ * neither propagates to the other.
+ */
+
+#define AMOR_NUM_JOINTS 6
+
+#define AMOR_INVALID_HANDLE nullptr
+
+typedef double real;
+
+typedef void * AMOR_HANDLE;
+
+//! Six joint or Cartesian values, the seventh element is reserved for the gripper
+typedef real AMOR_VECTOR7[7];
+
+enum AMOR_RESULT
+{
+    AMOR_SUCCESS = 0,
+    AMOR_FAILED = 1
+};
+
+enum amor_movement_status
+{
+    AMOR_MOVEMENT_STATUS_MOVING = 0,
+    AMOR_MOVEMENT_STATUS_FINISHED = 1
+};
+
+struct AMOR_JOINT_INFO
+{
+    real maxVelocity;     //!< [rad/s]
+    real lowerJointLimit; //!< [rad]
+    real upperJointLimit; //!< [rad]
+};
+
+AMOR_HANDLE amor_connect(char * libraryName, int can_port);
+AMOR_RESULT amor_release(AMOR_HANDLE handle);
+const char * amor_error();
+
+AMOR_RESULT amor_get_joint_info(AMOR_HANDLE handle, unsigned int joint, AMOR_JOINT_INFO * parameters);
+AMOR_RESULT amor_get_actual_positions(AMOR_HANDLE handle, AMOR_VECTOR7 * positions);
+AMOR_RESULT amor_get_cartesian_position(AMOR_HANDLE handle, AMOR_VECTOR7 & positions);
+AMOR_RESULT amor_get_movement_status(AMOR_HANDLE handle, amor_movement_status * status);
+
+AMOR_RESULT amor_set_positions(AMOR_HANDLE handle, AMOR_VECTOR7 positions);
+AMOR_RESULT amor_set_velocities(AMOR_HANDLE handle, AMOR_VECTOR7 velocities);
+AMOR_RESULT amor_set_cartesian_positions(AMOR_HANDLE handle, AMOR_VECTOR7 positions);
+AMOR_RESULT amor_set_cartesian_velocities(AMOR_HANDLE handle, AMOR_VECTOR7 velocities);
+
+AMOR_RESULT amor_controlled_stop(AMOR_HANDLE handle);
+AMOR_RESULT amor_emergency_stop(AMOR_HANDLE handle);
+
+AMOR_RESULT amor_open_hand(AMOR_HANDLE handle);
+AMOR_RESULT amor_close_hand(AMOR_HANDLE handle);
+AMOR_RESULT amor_stop_hand(AMOR_HANDLE handle);
+
+#endif // __AMOR_MOCK_H__
@@ -26,6 +26,13 @@ KDL::Frame vectorToFrame(const std::vector<double> &x)
         return KDL::Frame::Identity();
     }
 
+    return vectorToFrame(x.data());
+}
+
+// -----------------------------------------------------------------------------
+
+KDL::Frame vectorToFrame(const double * x)
+{
     KDL::Frame f;
 
     f.p.x(x[0]);
@@ -44,7 +51,14 @@ KDL::Frame vectorToFrame(const std::vector<double> &x)
 std::vector<double> frameToVector(const KDL::Frame& f)
 {
     std::vector<double> x(6);
+    frameToVector(f, x.data());
+    return x;
+}
+
+// -----------------------------------------------------------------------------
 
+void frameToVector(const KDL::Frame & f, double * x)
+{
     x[0] = f.p.x();
     x[1] = f.p.y();
     x[2] = f.p.z();
@@ -54,8 +68,6 @@ std::vector<double> frameToVector(const KDL::Frame& f)
     x[3] = rotVector.x();
     x[4] = rotVector.y();
     x[5] = rotVector.z();
-
-    return x;
 }
 
 // -----------------------------------------------------------------------------
@@ -68,6 +80,13 @@ KDL::Twist vectorToTwist(const std::vector<double> &xdot)
         return KDL::Twist::Zero();
     }
 
+    return vectorToTwist(xdot.data());
+}
+
+// -----------------------------------------------------------------------------
+
+KDL::Twist vectorToTwist(const double * xdot)
+{
     KDL::Twist t;
 
     t.vel.x(xdot[0]);
@@ -86,7 +105,14 @@ KDL::Twist vectorToTwist(const std::vector<double> &xdot)
 std::vector<double> twistToVector(const KDL::Twist& t)
 {
     std::vector<double> xdot(6);
+    twistToVector(t, xdot.data());
+    return xdot;
+}
+
+// -----------------------------------------------------------------------------
 
+void twistToVector(const KDL::Twist & t, double * xdot)
+{
     xdot[0] = t.vel.x();
     xdot[1] = t.vel.y();
     xdot[2] = t.vel.z();
@@ -94,8 +120,6 @@ std::vector<double> twistToVector(const KDL::Twist& t)
     xdot[3] = t.rot.x();
     xdot[4] = t.rot.y();
     xdot[5] = t.rot.z();
-
-    return xdot;
 }
 
 // -----------------------------------------------------------------------------
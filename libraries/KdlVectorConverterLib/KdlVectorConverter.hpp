@@ -35,6 +35,15 @@ namespace KdlVectorConverter
  */
 KDL::Frame vectorToFrame(const std::vector<double> & x);
 
+/**
+ * @brief Convert from a slice of a contiguous array to KDL::Frame
+ *
+ * @param x Pointer to the first of 6 elements, see @ref vectorToFrame.
+ *
+ * @return Resulting KDL::Frame object.
+ */
+KDL::Frame vectorToFrame(const double * x);
+
 /**
  * @brief Convert from KDL::Frame to std::vector<double>
  *
@@ -46,6 +55,14 @@ KDL::Frame vectorToFrame(const std::vector<double> & x);
  */
 std::vector<double> frameToVector(const KDL::Frame & f);
 
+/**
+ * @brief Convert from KDL::Frame to a slice of a contiguous array
+ *
+ * @param f Input KDL::Frame object.
+ * @param x Pointer to the first of 6 output elements, see @ref frameToVector.
+ */
+void frameToVector(const KDL::Frame & f, double * x);
+
 /**
  * @brief Convert from std::vector<double> to KDL::Twist
  *
@@ -57,6 +74,15 @@ std::vector<double> frameToVector(const KDL::Frame & f);
  */
 KDL::Twist vectorToTwist(const std::vector<double> & xdot);
 
+/**
+ * @brief Convert from a slice of a contiguous array to KDL::Twist
+ *
+ * @param xdot Pointer to the first of 6 elements, see @ref vectorToTwist.
+ *
+ * @return Resulting KDL::Twist object.
+ */
+KDL::Twist vectorToTwist(const double * xdot);
+
 /**
  * @brief Convert from KDL::Twist to std::vector<double>
  *
@@ -68,6 +94,14 @@ KDL::Twist vectorToTwist(const std::vector<double> & xdot);
  */
 std::vector<double> twistToVector(const KDL::Twist & t);
 
+/**
+ * @brief Convert from KDL::Twist to a slice of a contiguous array
+ *
+ * @param t Input KDL::Twist object.
+ * @param xdot Pointer to the first of 6 output elements, see @ref twistToVector.
+ */
+void twistToVector(const KDL::Twist & t, double * xdot);
+
 } // namespace KdlVectorConverter
 } // namespace roboticslab
 
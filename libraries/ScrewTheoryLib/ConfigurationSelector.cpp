@@ -36,6 +36,27 @@ bool ConfigurationSelector::configure(const std::vector<KDL::JntArray> & solutio
 
 // -----------------------------------------------------------------------------
 
+bool ConfigurationSelector::configure(const std::vector<KDL::JntArray> & solutions, const std::vector<bool> & mask)
+{
+    configure(solutions);
+
+    bool anyValid = false;
+
+    for (int i = 0; i < configs.size(); i++)
+    {
+        if (i < mask.size() && !mask[i])
+        {
+            configs[i].invalidate();
+        }
+
+        anyValid = anyValid || configs[i].isValid();
+    }
+
+    return anyValid;
+}
+
+// -----------------------------------------------------------------------------
+
 void ConfigurationSelector::Configuration::validate(const KDL::JntArray & qMin, const KDL::JntArray & qMax)
 {
     valid = true;
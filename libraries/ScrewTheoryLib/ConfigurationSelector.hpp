@@ -43,6 +43,20 @@ public:
      */
     virtual bool configure(const std::vector<KDL::JntArray> & solutions);
 
+    /**
+     * @brief Stores initial values for a specific pose, ruling out some of them.
+     *
+     * Excluded solutions keep their position in the list, so that indices
+     * remain meaningful across calls, but are treated as invalid.
+     *
+     * @param solutions Vector of joint arrays that represent all available
+     * (valid or not) robot joint poses.
+     * @param mask Whether each of the solutions may be selected.
+     *
+     * @return True/false on success/failure.
+     */
+    bool configure(const std::vector<KDL::JntArray> & solutions, const std::vector<bool> & mask);
+
     /**
      * @brief Analyzes available configurations and selects the optimal one.
      *
@@ -0,0 +1,96 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#include "ScrewTheoryIkSubproblems.hpp"
+
+#include "ScrewTheoryIkKernels.hpp"
+#include "ScrewTheoryTools.hpp"
+
+using namespace roboticslab;
+
+// -----------------------------------------------------------------------------
+
+namespace
+{
+    // Inverse of the matrix whose columns are the input vectors, rows are given by their reciprocal basis.
+    KDL::Rotation invertColumns(const KDL::Vector & a, const KDL::Vector & b, const KDL::Vector & c)
+    {
+        double det = KDL::dot(a, b * c);
+
+        KDL::Vector r1 = (b * c) / det;
+        KDL::Vector r2 = (c * a) / det;
+        KDL::Vector r3 = (a * b) / det;
+
+        return KDL::Rotation(r1.x(), r1.y(), r1.z(),
+                             r2.x(), r2.y(), r2.z(),
+                             r3.x(), r3.y(), r3.z());
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+RevolutePrismatic::RevolutePrismatic(int _id1, int _id2, const MatrixExponential & _exp1, const MatrixExponential & _exp2, const KDL::Vector & _p)
+    : id1(_id1),
+      id2(_id2),
+      exp1(_exp1),
+      exp2(_exp2),
+      p(_p),
+      axisPow(vectorPow2(exp1.getAxis())),
+      axesDot(KDL::dot(exp1.getAxis(), exp2.getAxis())),
+      perpendicular(KDL::Equal(axesDot, 0.0))
+{}
+
+// -----------------------------------------------------------------------------
+
+bool RevolutePrismatic::solve(const KDL::Frame & rhs, const KDL::Frame & pointTransform, Solutions & solutions) const
+{
+    double theta[4];
+    bool ret = revolutePrismatic(exp1.getAxis(), exp1.getOrigin(), exp2.getAxis(), axisPow, axesDot, perpendicular, p, rhs, pointTransform, theta);
+    storeSolutions({id1, id2}, theta, solutions);
+    return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+PrismaticRevolute::PrismaticRevolute(int _id1, int _id2, const MatrixExponential & _exp1, const MatrixExponential & _exp2, const KDL::Vector & _p)
+    : id1(_id1),
+      id2(_id2),
+      exp1(_exp1),
+      exp2(_exp2),
+      p(_p),
+      axisPow(vectorPow2(exp2.getAxis())),
+      axesDot(KDL::dot(exp1.getAxis(), exp2.getAxis())),
+      perpendicular(KDL::Equal(axesDot, 0.0))
+{}
+
+// -----------------------------------------------------------------------------
+
+bool PrismaticRevolute::solve(const KDL::Frame & rhs, const KDL::Frame & pointTransform, Solutions & solutions) const
+{
+    double theta[4];
+    bool ret = prismaticRevolute(exp1.getAxis(), exp2.getAxis(), exp2.getOrigin(), axisPow, axesDot, perpendicular, p, rhs, pointTransform, theta);
+    storeSolutions({id1, id2}, theta, solutions);
+    return ret;
+}
+
+// -----------------------------------------------------------------------------
+
+PrismaticTriad::PrismaticTriad(int _id1, int _id2, int _id3, const MatrixExponential & _exp1, const MatrixExponential & _exp2,
+        const MatrixExponential & _exp3, const KDL::Vector & _p)
+    : id1(_id1),
+      id2(_id2),
+      id3(_id3),
+      p(_p),
+      axesInv(invertColumns(_exp1.getAxis(), _exp2.getAxis(), _exp3.getAxis()))
+{}
+
+// -----------------------------------------------------------------------------
+
+bool PrismaticTriad::solve(const KDL::Frame & rhs, const KDL::Frame & pointTransform, Solutions & solutions) const
+{
+    double theta[3];
+    bool ret = prismaticTriad(axesInv, p, rhs, pointTransform, theta);
+    storeSolutions({id1, id2, id3}, theta, solutions);
+    return ret;
+}
+
+// -----------------------------------------------------------------------------
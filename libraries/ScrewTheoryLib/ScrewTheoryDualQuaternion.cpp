@@ -0,0 +1,44 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#include "ScrewTheoryDualQuaternion.hpp"
+
+using namespace roboticslab;
+
+// -----------------------------------------------------------------------------
+
+template <typename T>
+DualQuaternionT<T> DualQuaternionT<T>::fromFrame(const FrameT<T> & H)
+{
+    Quaternion r(H.M);
+    r.normalize();
+    Quaternion t(T(0), H.p.x() / 2, H.p.y() / 2, H.p.z() / 2);
+    return {r, t * r};
+}
+
+// -----------------------------------------------------------------------------
+
+template <typename T>
+FrameT<T> DualQuaternionT<T>::toFrame() const
+{
+    return {real.toRotationMatrix(), translation()};
+}
+
+// -----------------------------------------------------------------------------
+
+template <typename T>
+void DualQuaternionT<T>::normalize()
+{
+    T n = real.norm();
+    real.coeffs() /= n;
+    dual.coeffs() /= n;
+
+    // remove the component of the dual part that breaks orthogonality with the real part
+    dual.coeffs() -= real.coeffs().dot(dual.coeffs()) * real.coeffs();
+}
+
+// -----------------------------------------------------------------------------
+
+template class roboticslab::DualQuaternionT<float>;
+template class roboticslab::DualQuaternionT<double>;
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,123 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#ifndef __SCREW_THEORY_DUAL_QUATERNION_HPP__
+#define __SCREW_THEORY_DUAL_QUATERNION_HPP__
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "ScrewTheoryScalar.hpp"
+
+/**
+ * @file ScrewTheoryDualQuaternion.hpp
+ *
+ * Unit dual quaternion backend for POE formulas, see @ref DualQuaternionT.
+ */
+
+namespace roboticslab
+{
+
+/**
+ * @ingroup ScrewTheoryLib
+ *
+ * @brief Rigid transformation stored as a unit dual quaternion
+ *
+ * Pose is encoded in eight scalars, q = r + eps*d, where the real part r is the
+ * rotation quaternion and the dual part d = 0.5*t*r holds the translation t. The
+ * inverse is just the conjugate of both parts. The unit constraints (|r| = 1 and
+ * r.d = 0) drift on long products, hence @ref normalize should be called every
+ * now and then, see @ref RENORMALIZATION_PERIOD.
+ */
+template <typename T>
+class DualQuaternionT
+{
+public:
+    using Quaternion = Eigen::Quaternion<T>;
+
+    //! Number of consecutive products after which a renormalization is advised
+    static constexpr int RENORMALIZATION_PERIOD = 8;
+
+    //! Default constructor, leaves both parts uninitialized
+    DualQuaternionT() = default;
+
+    /**
+     * @brief Constructor
+     *
+     * @param real Real part, a unit quaternion.
+     * @param dual Dual part.
+     */
+    DualQuaternionT(const Quaternion & real, const Quaternion & dual) : real(real), dual(dual) {}
+
+    //! Identity transformation
+    static DualQuaternionT Identity()
+    { return {Quaternion::Identity(), Quaternion(T(0), T(0), T(0), T(0))}; }
+
+    //! Builds a dual quaternion from a rigid transformation
+    static DualQuaternionT fromFrame(const FrameT<T> & H);
+
+    //! Converts to a rigid transformation
+    FrameT<T> toFrame() const;
+
+    //! Real part (rotation)
+    const Quaternion & getReal() const
+    { return real; }
+
+    //! Dual part
+    const Quaternion & getDual() const
+    { return dual; }
+
+    //! Translation vector
+    VectorT<T> translation() const
+    { return T(2) * (dual * real.conjugate()).vec(); }
+
+    //! Composes two transformations
+    DualQuaternionT operator*(const DualQuaternionT & other) const
+    { return {real * other.real, sum(real * other.dual, dual * other.real)}; }
+
+    //! Transforms a point
+    VectorT<T> operator*(const VectorT<T> & v) const
+    { return real._transformVector(v) + translation(); }
+
+    //! Inverse transformation, assumes a unit dual quaternion
+    DualQuaternionT Inverse() const
+    { return {real.conjugate(), dual.conjugate()}; }
+
+    //! Enforces the unit constraints
+    void normalize();
+
+private:
+    static Quaternion sum(const Quaternion & a, const Quaternion & b)
+    { return Quaternion(a.coeffs() + b.coeffs()); }
+
+    Quaternion real;
+    Quaternion dual;
+};
+
+//! @ingroup ScrewTheoryLib
+using DualQuaternionf = DualQuaternionT<float>;
+
+//! @ingroup ScrewTheoryLib
+using DualQuaterniond = DualQuaternionT<double>;
+
+//! @ingroup ScrewTheoryLib
+//! @brief Converts a KDL frame
+template <typename T>
+inline DualQuaternionT<T> toDualQuaternion(const KDL::Frame & H)
+{
+    return DualQuaternionT<T>::fromFrame(toScalar<T>(H));
+}
+
+//! @ingroup ScrewTheoryLib
+//! @brief Converts a dual quaternion to KDL
+template <typename T>
+inline KDL::Frame toKdl(const DualQuaternionT<T> & dq)
+{
+    return toKdl<T>(dq.toFrame());
+}
+
+extern template class DualQuaternionT<float>;
+extern template class DualQuaternionT<double>;
+
+} // namespace roboticslab
+
+#endif // __SCREW_THEORY_DUAL_QUATERNION_HPP__
@@ -0,0 +1,403 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#include "ScrewTheoryIkProblem.hpp"
+
+#include <cctype>
+
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+#include "ScrewTheoryIkSubproblems.hpp"
+
+using namespace roboticslab;
+
+// -----------------------------------------------------------------------------
+
+namespace
+{
+    std::string literal(const std::string & expression)
+    {
+        return expression;
+    }
+
+    std::string literal(double value)
+    {
+        std::ostringstream oss;
+        oss << std::setprecision(std::numeric_limits<double>::max_digits10) << value;
+        return oss.str();
+    }
+
+    std::string literal(bool value)
+    {
+        return value ? "true" : "false";
+    }
+
+    std::string literal(const KDL::Vector & v)
+    {
+        return "KDL::Vector(" + literal(v.x()) + ", " + literal(v.y()) + ", " + literal(v.z()) + ")";
+    }
+
+    std::string literal(const KDL::Rotation & R)
+    {
+        return "KDL::Rotation(" + literal(R(0, 0)) + ", " + literal(R(0, 1)) + ", " + literal(R(0, 2)) + ", "
+                                + literal(R(1, 0)) + ", " + literal(R(1, 1)) + ", " + literal(R(1, 2)) + ", "
+                                + literal(R(2, 0)) + ", " + literal(R(2, 1)) + ", " + literal(R(2, 2)) + ")";
+    }
+
+    std::string literal(const KDL::Frame & H)
+    {
+        return "KDL::Frame(" + literal(H.M) + ", " + literal(H.p) + ")";
+    }
+
+    template <typename... Ts>
+    std::string call(const std::string & function, const Ts &... args)
+    {
+        std::string out;
+
+        for (const auto & arg : {literal(args)...})
+        {
+            out += (out.empty() ? "" : ", ") + arg;
+        }
+
+        return function + "(" + out + ")";
+    }
+
+    std::string term(const MatrixExponential & exp, const std::string & theta)
+    {
+        if (exp.getMotionType() == MatrixExponential::ROTATION)
+        {
+            // See MatrixExponential::asFrame.
+            KDL::Vector c = exp.getAxis() * exp.getOrigin() * exp.getAxis();
+            return call("rotationExp", exp.getAxis(), c, theta);
+        }
+        else
+        {
+            return call("translationExp", exp.getAxis(), theta);
+        }
+    }
+
+    std::string product(const std::vector<std::string> & terms)
+    {
+        if (terms.empty())
+        {
+            return "KDL::Frame::Identity()";
+        }
+
+        std::string out;
+
+        for (const auto & term : terms)
+        {
+            out += (out.empty() ? "" : " * ") + term;
+        }
+
+        return out;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+std::string PadenKahanOne::generateCode(const std::string & rhs, const std::string & pointTransform, const std::string & theta) const
+{
+    return call("padenKahanOne", exp.getAxis(), exp.getOrigin(), axisPow, p, rhs, pointTransform, theta);
+}
+
+// -----------------------------------------------------------------------------
+
+std::string PadenKahanTwo::generateCode(const std::string & rhs, const std::string & pointTransform, const std::string & theta) const
+{
+    return call("padenKahanTwo", exp1.getAxis(), exp2.getAxis(), r, axesCross, axisPow1, axisPow2, axesDot, p, rhs, pointTransform, theta);
+}
+
+// -----------------------------------------------------------------------------
+
+std::string PadenKahanThree::generateCode(const std::string & rhs, const std::string & pointTransform, const std::string & theta) const
+{
+    return call("padenKahanThree", exp.getAxis(), exp.getOrigin(), axisPow, p, k, rhs, pointTransform, theta);
+}
+
+// -----------------------------------------------------------------------------
+
+std::string PardosGotorOne::generateCode(const std::string & rhs, const std::string & pointTransform, const std::string & theta) const
+{
+    return call("pardosGotorOne", exp.getAxis(), p, rhs, pointTransform, theta);
+}
+
+// -----------------------------------------------------------------------------
+
+std::string PardosGotorTwo::generateCode(const std::string & rhs, const std::string & pointTransform, const std::string & theta) const
+{
+    return call("pardosGotorTwo", exp1.getAxis(), exp2.getAxis(), crossPr2, crossPr2Norm, p, rhs, pointTransform, theta);
+}
+
+// -----------------------------------------------------------------------------
+
+std::string PardosGotorThree::generateCode(const std::string & rhs, const std::string & pointTransform, const std::string & theta) const
+{
+    return call("pardosGotorThree", exp.getAxis(), p, k, rhs, pointTransform, theta);
+}
+
+// -----------------------------------------------------------------------------
+
+std::string PardosGotorFour::generateCode(const std::string & rhs, const std::string & pointTransform, const std::string & theta) const
+{
+    return call("pardosGotorFour", exp1.getAxis(), exp1.getOrigin(), exp2.getAxis(), exp2.getOrigin(), n, axisPow, p, rhs, pointTransform, theta);
+}
+
+// -----------------------------------------------------------------------------
+
+std::string RevolutePrismatic::generateCode(const std::string & rhs, const std::string & pointTransform, const std::string & theta) const
+{
+    return call("revolutePrismatic", exp1.getAxis(), exp1.getOrigin(), exp2.getAxis(), axisPow, axesDot, perpendicular, p, rhs, pointTransform, theta);
+}
+
+// -----------------------------------------------------------------------------
+
+std::string PrismaticRevolute::generateCode(const std::string & rhs, const std::string & pointTransform, const std::string & theta) const
+{
+    return call("prismaticRevolute", exp1.getAxis(), exp2.getAxis(), exp2.getOrigin(), axisPow, axesDot, perpendicular, p, rhs, pointTransform, theta);
+}
+
+// -----------------------------------------------------------------------------
+
+std::string PrismaticTriad::generateCode(const std::string & rhs, const std::string & pointTransform, const std::string & theta) const
+{
+    return call("prismaticTriad", axesInv, p, rhs, pointTransform, theta);
+}
+
+// -----------------------------------------------------------------------------
+
+bool ScrewTheoryIkProblem::generateCode(std::ostream & os, const std::string & name) const
+{
+    const int joints = poe.size();
+
+    auto theta = [](const std::string & row, int id) { return "theta[" + row + "][" + std::to_string(id) + "]"; };
+
+    // Mirrors the bookkeeping of known and computed POE terms performed in 'solve' (and helper methods),
+    // so that the generated code applies exactly the same sequence of transformations.
+
+    auto leftmostTerms = [this, &theta](PoeTerms & poeTerms, const std::string & row)
+    {
+        std::vector<std::string> terms;
+
+        for (int i = 0; i < poeTerms.size(); i++)
+        {
+            if (poeTerms[i] == EXP_KNOWN)
+            {
+                terms.push_back(term(poe.exponentialAtJoint(i), theta(row, i)));
+                poeTerms[i] = EXP_COMPUTED;
+            }
+            else if (poeTerms[i] != EXP_COMPUTED)
+            {
+                break;
+            }
+        }
+
+        return terms;
+    };
+
+    auto rightmostTerms = [this, &theta](PoeTerms & poeTerms, const std::string & row)
+    {
+        // Only the last term is ever inspected, see 'recalculateFrames'.
+        std::vector<std::string> terms;
+        int i = poeTerms.size() - 1;
+
+        if (poeTerms[i] == EXP_KNOWN)
+        {
+            terms.push_back(term(poe.exponentialAtJoint(i), theta(row, i)));
+            poeTerms[i] = EXP_COMPUTED;
+        }
+
+        return terms;
+    };
+
+    auto pointTerms = [this, &theta](const PoeTerms & poeTerms, const std::string & row)
+    {
+        std::vector<std::string> terms;
+
+        bool foundKnown = false;
+        bool foundUnknown = false;
+
+        for (int i = poeTerms.size() - 1; i >= 0; i--)
+        {
+            if (poeTerms[i] == EXP_KNOWN)
+            {
+                terms.insert(terms.begin(), term(poe.exponentialAtJoint(i), theta(row, i)));
+                foundKnown = true;
+            }
+            else if (poeTerms[i] == EXP_UNKNOWN)
+            {
+                foundUnknown = true;
+
+                if (foundKnown)
+                {
+                    break;
+                }
+            }
+            else if (foundKnown || foundUnknown)
+            {
+                break;
+            }
+        }
+
+        return terms;
+    };
+
+    std::string guard = "__SCREW_THEORY_IK_" + name + "_HPP__";
+    std::transform(guard.begin(), guard.end(), guard.begin(), [](unsigned char c) { return std::toupper(c); });
+
+    std::ostringstream body;
+
+    body << "    double theta[SOLUTIONS][JOINTS] = {};\n";
+    body << "    KDL::Frame rhs[SOLUTIONS];\n";
+    body << "    bool reachable = true;\n\n";
+    body << "    rhs[0] = " << (reversed ? "H_S_T.Inverse()" : "H_S_T") << " * " << literal(poe.getTransform().Inverse()) << ";\n";
+
+    PoeTerms poeTerms(joints, EXP_UNKNOWN);
+    int size = 1;
+
+    for (int i = 0; i < steps.size(); i++)
+    {
+        const auto * step = steps[i];
+        const auto ids = step->jointIds();
+        const int local = step->solutions();
+
+        const std::string code = step->generateCode("rhs[j]", "H", "local");
+
+        if (code.empty())
+        {
+            return false;
+        }
+
+        body << "\n    // Step " << i + 1 << ", joint ids:";
+
+        for (int id : ids)
+        {
+            body << " " << id;
+        }
+
+        body << "\n\n";
+
+        if (i != 0)
+        {
+            auto pre = leftmostTerms(poeTerms, "j");
+            auto post = rightmostTerms(poeTerms, "j");
+
+            if (!pre.empty() || !post.empty())
+            {
+                body << "    for (int j = 0; j < " << size << "; j++)\n";
+                body << "    {\n";
+
+                if (!pre.empty())
+                {
+                    body << "        rhs[j] = (" << product(pre) << ").Inverse() * rhs[j];\n";
+                }
+
+                if (!post.empty())
+                {
+                    body << "        rhs[j] = rhs[j] * (" << product(post) << ").Inverse();\n";
+                }
+
+                body << "    }\n\n";
+            }
+        }
+
+        // Joint ids solved in this step are marked as known right after processing the first row.
+        PoeTerms poeTermsNext(poeTerms);
+
+        for (int id : ids)
+        {
+            poeTermsNext[id] = EXP_KNOWN;
+        }
+
+        std::string pointFirst = product(pointTerms(poeTerms, "j"));
+        std::string pointNext = product(pointTerms(poeTermsNext, "j"));
+
+        body << "    for (int j = 0; j < " << size << "; j++)\n";
+        body << "    {\n";
+
+        if (size == 1 || pointFirst == pointNext)
+        {
+            body << "        const KDL::Frame H = " << pointFirst << ";\n";
+        }
+        else
+        {
+            body << "        const KDL::Frame H = j == 0\n";
+            body << "            ? " << pointFirst << "\n";
+            body << "            : " << pointNext << ";\n";
+        }
+
+        body << "\n";
+        body << "        double local[" << local * ids.size() << "];\n";
+        body << "        reachable &= " << code << ";\n";
+
+        if (local > 1)
+        {
+            body << "\n";
+            body << "        for (int k = 1; k < " << local << "; k++)\n";
+            body << "        {\n";
+            body << "            std::copy(theta[j], theta[j] + JOINTS, theta[j + " << size << " * k]);\n";
+            body << "            rhs[j + " << size << " * k] = rhs[j];\n";
+            body << "        }\n";
+        }
+
+        body << "\n";
+
+        for (int k = 0; k < local; k++)
+        {
+            std::string row = k == 0 ? "j" : "j + " + std::to_string(size * k);
+
+            for (int u = 0; u < ids.size(); u++)
+            {
+                body << "        " << theta(row, ids[u]) << " = local[" << k * ids.size() + u << "];\n";
+            }
+        }
+
+        body << "    }\n";
+
+        poeTerms = poeTermsNext;
+        size *= local;
+    }
+
+    body << "\n    for (int s = 0; s < SOLUTIONS; s++)\n";
+    body << "    {\n";
+
+    for (int i = 0; i < joints; i++)
+    {
+        if (reversed)
+        {
+            body << "        q[s][" << i << "] = -" << theta("s", joints - 1 - i) << ";\n";
+        }
+        else
+        {
+            body << "        q[s][" << i << "] = " << theta("s", i) << ";\n";
+        }
+    }
+
+    body << "    }\n\n";
+    body << "    return reachable;\n";
+
+    os << "// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-\n\n";
+    os << "// Generated by roboticslab::ScrewTheoryIkProblem::generateCode, do not edit.\n\n";
+    os << "#ifndef " << guard << "\n";
+    os << "#define " << guard << "\n\n";
+    os << "#include <algorithm>\n\n";
+    os << "#include <kdl/frames.hpp>\n\n";
+    os << "#include \"ScrewTheoryIkKernels.hpp\"\n\n";
+    os << "namespace " << name << "\n";
+    os << "{\n\n";
+    os << "constexpr int JOINTS = " << joints << ";\n";
+    os << "constexpr int SOLUTIONS = " << soln << ";\n\n";
+    os << "inline bool solve(const KDL::Frame & H_S_T, double (&q)[SOLUTIONS][JOINTS])\n";
+    os << "{\n";
+    os << "    using namespace roboticslab;\n\n";
+    os << body.str();
+    os << "}\n\n";
+    os << "} // namespace " << name << "\n\n";
+    os << "#endif // " << guard << "\n";
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
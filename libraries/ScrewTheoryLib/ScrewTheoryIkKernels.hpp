@@ -0,0 +1,514 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#ifndef __SCREW_THEORY_IK_KERNELS_HPP__
+#define __SCREW_THEORY_IK_KERNELS_HPP__
+
+#include <cmath>
+
+#include <algorithm>
+#include <type_traits>
+
+#include <kdl/frames.hpp>
+
+#include "ScrewTheoryScalar.hpp"
+
+/**
+ * @file ScrewTheoryIkKernels.hpp
+ *
+ * Allocation-free implementations of all geometric IK subproblems and POE terms.
+ *
+ * Each subproblem kernel receives its precomputed geometric data, the right-hand side
+ * of the POE formula and the transformation applied to its first characteristic point
+ * (see @ref ScrewTheoryIkSubproblem::solve). Joint values are written to @p theta
+ * one local solution after another, in the order the joint ids were given to the
+ * corresponding subproblem class. All kernels return true if all solutions are reachable.
+ *
+ * Kernels are generic on the geometric types, which are either KDL ones (double precision)
+ * or their scalar-templated counterparts found in ScrewTheoryScalar.hpp. The scalar type
+ * is deduced from @p theta only, other scalar arguments are converted to it.
+ *
+ * Shared by the subproblem classes and by the code generated with
+ * @ref ScrewTheoryIkProblem::generateCode.
+ */
+
+namespace roboticslab
+{
+
+/**
+ * @ingroup ScrewTheoryLib
+ *
+ * @brief Exponential of a rotation screw
+ *
+ * @param axis Unit vector of the rotation axis.
+ * @param c Projection of a point of the axis onto the plane normal to it that
+ * contains the origin, i.e. @f$ \omega \times q \times \omega @f$ .
+ * @param theta Rotation angle.
+ *
+ * @return Resulting transformation.
+ */
+inline KDL::Frame rotationExp(const KDL::Vector & axis, const KDL::Vector & c, double theta)
+{
+    KDL::Rotation R = KDL::Rotation::Rot2(axis, theta);
+    return KDL::Frame(R, c - R * c);
+}
+
+/**
+ * @ingroup ScrewTheoryLib
+ *
+ * @brief Exponential of a translation screw
+ *
+ * @param axis Unit vector of the translation axis.
+ * @param theta Translation magnitude.
+ *
+ * @return Resulting transformation.
+ */
+inline KDL::Frame translationExp(const KDL::Vector & axis, double theta)
+{
+    return KDL::Frame(axis * theta);
+}
+
+/**
+ * @ingroup ScrewTheoryLib
+ *
+ * @brief First Paden-Kahan subproblem, see @ref PadenKahanOne
+ */
+template <typename V, typename R, typename F, typename T>
+inline bool padenKahanOne(const V & axis, const V & origin, const R & axisPow,
+                          const V & p, const F & rhs, const F & pointTransform, T * theta)
+{
+    V f = pointTransform * p;
+    V k = rhs * p;
+
+    V u = f - origin;
+    V v = k - origin;
+
+    V u_w = axisPow * u;
+    V v_w = axisPow * v;
+
+    V u_p = u - u_w;
+    V v_p = v - v_w;
+
+    theta[0] = normalizeAngleT(std::atan2(dot(axis, cross(u_p, v_p)), dot(u_p, v_p)));
+
+    return equalT(u_w, v_w) && equalT(norm(u_p), norm(v_p));
+}
+
+/**
+ * @ingroup ScrewTheoryLib
+ *
+ * @brief Second Paden-Kahan subproblem, see @ref PadenKahanTwo
+ */
+template <typename V, typename R, typename F, typename T>
+inline bool padenKahanTwo(const V & axis1, const V & axis2, const V & r,
+                          const V & axesCross, const R & axisPow1, const R & axisPow2,
+                          typename std::common_type<T>::type axesDot, const V & p, const F & rhs,
+                          const F & pointTransform, T * theta)
+{
+    V f = pointTransform * p;
+    V k = rhs * p;
+
+    V u = f - r;
+    V v = k - r;
+
+    V u_p = u - axisPow2 * u;
+    V v_p = v - axisPow1 * v;
+
+    T axis1dot = dot(axis1, v);
+    T axis2dot = dot(axis2, u);
+    T den = axesDot * axesDot - 1;
+
+    T alpha = (axesDot * axis2dot - axis1dot) / den;
+    T beta = (axesDot * axis1dot - axis2dot) / den;
+
+    V term1 = r + alpha * axis1 + beta * axis2;
+
+    T gamma2 = (squaredNorm(u) - alpha * alpha - beta * beta - 2 * alpha * beta * axesDot) / squaredNorm(axesCross);
+
+    bool gamma2_zero = equalT(gamma2, T(0));
+
+    if (!gamma2_zero && gamma2 > 0)
+    {
+        T gamma = std::sqrt(gamma2);
+        V term2 = gamma * axesCross;
+
+        V d = term1 + term2;
+        V c = term1 - term2;
+
+        V m = c - r;
+        V n = d - r;
+
+        V m1_p = m - axisPow1 * m;
+        V m2_p = m - axisPow2 * m;
+
+        V n1_p = n - axisPow1 * n;
+        V n2_p = n - axisPow2 * n;
+
+        theta[0] = normalizeAngleT(std::atan2(dot(axis1, cross(m1_p, v_p)), dot(m1_p, v_p)));
+        theta[1] = normalizeAngleT(std::atan2(dot(axis2, cross(u_p, m2_p)), dot(u_p, m2_p)));
+
+        theta[2] = normalizeAngleT(std::atan2(dot(axis1, cross(n1_p, v_p)), dot(n1_p, v_p)));
+        theta[3] = normalizeAngleT(std::atan2(dot(axis2, cross(u_p, n2_p)), dot(u_p, n2_p)));
+
+        return equalT(norm(m1_p), norm(v_p));
+    }
+    else
+    {
+        V n = term1 - r;
+        V n1_p = n - axisPow1 * n;
+        V n2_p = n - axisPow2 * n;
+
+        theta[0] = theta[2] = normalizeAngleT(std::atan2(dot(axis1, cross(n1_p, v_p)), dot(n1_p, v_p)));
+        theta[1] = theta[3] = normalizeAngleT(std::atan2(dot(axis2, cross(u_p, n2_p)), dot(u_p, n2_p)));
+
+        return gamma2_zero && equalT(norm(n1_p), norm(v_p));
+    }
+}
+
+/**
+ * @ingroup ScrewTheoryLib
+ *
+ * @brief Third Paden-Kahan subproblem, see @ref PadenKahanThree
+ */
+template <typename V, typename R, typename F, typename T>
+inline bool padenKahanThree(const V & axis, const V & origin, const R & axisPow,
+                            const V & p, const V & k, const F & rhs,
+                            const F & pointTransform, T * theta)
+{
+    V f = pointTransform * p;
+    V rhsAsVector = rhs * p - k;
+    T delta = norm(rhsAsVector);
+
+    V u = f - origin;
+    V v = k - origin;
+
+    V u_p = u - axisPow * u;
+    V v_p = v - axisPow * v;
+
+    T alpha = std::atan2(dot(axis, cross(u_p, v_p)), dot(u_p, v_p));
+    T axial = dot(axis, f - k);
+    T delta_p_2 = delta * delta - axial * axial;
+
+    T u_p_norm = norm(u_p);
+    T v_p_norm = norm(v_p);
+
+    T betaCos = (u_p_norm * u_p_norm + v_p_norm * v_p_norm - delta_p_2) / (2 * u_p_norm * v_p_norm);
+    T betaCosAbs = std::abs(betaCos);
+    bool beta_zero = equalT(betaCosAbs, T(1));
+
+    if (!beta_zero && betaCosAbs < 1)
+    {
+        T betaCosCapped = std::max(T(-1), std::min(T(1), betaCos));
+        T beta = std::acos(betaCosCapped);
+
+        theta[0] = normalizeAngleT(alpha + beta);
+        theta[1] = normalizeAngleT(alpha - beta);
+
+        return true;
+    }
+    else
+    {
+        theta[0] = theta[1] = normalizeAngleT(alpha);
+        return beta_zero;
+    }
+}
+
+/**
+ * @ingroup ScrewTheoryLib
+ *
+ * @brief First Pardos-Gotor subproblem, see @ref PardosGotorOne
+ */
+template <typename V, typename F, typename T>
+inline bool pardosGotorOne(const V & axis, const V & p, const F & rhs,
+                           const F & pointTransform, T * theta)
+{
+    V f = pointTransform * p;
+    V k = rhs * p;
+
+    theta[0] = dot(axis, k - f);
+
+    return true;
+}
+
+/**
+ * @ingroup ScrewTheoryLib
+ *
+ * @brief Second Pardos-Gotor subproblem, see @ref PardosGotorTwo
+ */
+template <typename V, typename F, typename T>
+inline bool pardosGotorTwo(const V & axis1, const V & axis2, const V & crossPr2,
+                           typename std::common_type<T>::type crossPr2Norm, const V & p,
+                           const F & rhs, const F & pointTransform, T * theta)
+{
+    V f = pointTransform * p;
+    V k = rhs * p;
+
+    V crossPr1 = cross(axis2, f - k);
+    T crossPr1Norm = norm(crossPr1);
+
+    V c;
+
+    if (dot(crossPr1, crossPr2) >= crossPr1Norm * crossPr2Norm)
+    {
+        c = k + (crossPr1Norm / crossPr2Norm) * axis1;
+    }
+    else
+    {
+        c = k - (crossPr1Norm / crossPr2Norm) * axis1;
+    }
+
+    theta[0] = dot(axis1, k - c);
+    theta[1] = dot(axis2, c - f);
+
+    return true;
+}
+
+/**
+ * @ingroup ScrewTheoryLib
+ *
+ * @brief Third Pardos-Gotor subproblem, see @ref PardosGotorThree
+ */
+template <typename V, typename F, typename T>
+inline bool pardosGotorThree(const V & axis, const V & p, const V & k,
+                             const F & rhs, const F & pointTransform, T * theta)
+{
+    V f = pointTransform * p;
+    V rhsAsVector = rhs * p - k;
+    T delta = norm(rhsAsVector);
+
+    V diff = k - f;
+
+    T dotPr = dot(axis, diff);
+    T sq2 = dotPr * dotPr - squaredNorm(diff) + delta * delta;
+    bool sq2_zero = equalT(sq2, T(0));
+
+    if (!sq2_zero && sq2 > 0)
+    {
+        T sq = std::sqrt(std::abs(sq2));
+        theta[0] = dotPr + sq;
+        theta[1] = dotPr - sq;
+        return true;
+    }
+    else
+    {
+        V proy = dot(axis, diff) * axis;
+        theta[0] = theta[1] = norm(proy);
+        return sq2_zero;
+    }
+}
+
+/**
+ * @ingroup ScrewTheoryLib
+ *
+ * @brief Fourth Pardos-Gotor subproblem, see @ref PardosGotorFour
+ */
+template <typename V, typename R, typename F, typename T>
+inline bool pardosGotorFour(const V & axis1, const V & origin1, const V & axis2,
+                            const V & origin2, const V & n, const R & axisPow,
+                            const V & p, const F & rhs, const F & pointTransform,
+                            T * theta)
+{
+    V f = pointTransform * p;
+    V k = rhs * p;
+
+    V u = f - origin2;
+    V v = k - origin1;
+
+    V u_p = u - axisPow * u;
+    V v_p = v - axisPow * v;
+
+    V c1 = origin1 + v - v_p;
+    V c2 = origin2 + u - u_p;
+
+    V c_diff = c2 - c1;
+    bool samePlane = equalT(c_diff, n);
+
+    if (!samePlane)
+    {
+        c_diff = n; // proyection of c_diff onto the perpendicular plane
+        c1 = c2 - c_diff; // c1 on the intersecion of axis 1 and the normal plane to both axes
+    }
+
+    T c_norm = norm(c_diff);
+    T u_p_norm = norm(u_p);
+    T v_p_norm = norm(v_p);
+
+    T c_test = u_p_norm + v_p_norm - c_norm;
+    bool c_zero = equalT(c_test, T(0));
+
+    if (!c_zero && c_test > 0)
+    {
+        V omega_a = c_diff / c_norm;
+        V omega_h = cross(axis1, omega_a);
+
+        T a = (c_norm * c_norm - u_p_norm * u_p_norm + v_p_norm * v_p_norm) / (2 * c_norm);
+        T h = std::sqrt(std::abs(squaredNorm(v_p) - a * a));
+
+        V term1 = c1 + a * omega_a;
+        V term2 = h * omega_h;
+
+        V c = term1 + term2;
+        V d = term1 - term2;
+
+        V m1 = c - origin1;
+        V m2 = c - origin2;
+
+        V n1 = d - origin1;
+        V n2 = d - origin2;
+
+        V m1_p = m1 - axisPow * m1;
+        V m2_p = m2 - axisPow * m2;
+
+        V n1_p = n1 - axisPow * n1;
+        V n2_p = n2 - axisPow * n2;
+
+        theta[0] = normalizeAngleT(std::atan2(dot(axis1, cross(m1_p, v_p)), dot(m1_p, v_p)));
+        theta[1] = normalizeAngleT(std::atan2(dot(axis2, cross(u_p, m2_p)), dot(u_p, m2_p)));
+
+        theta[2] = normalizeAngleT(std::atan2(dot(axis1, cross(n1_p, v_p)), dot(n1_p, v_p)));
+        theta[3] = normalizeAngleT(std::atan2(dot(axis2, cross(u_p, n2_p)), dot(u_p, n2_p)));
+
+        return samePlane && equalT(norm(m1_p), v_p_norm);
+    }
+    else
+    {
+        theta[0] = theta[2] = normalizeAngleT(std::atan2(dot(axis1, cross(c_diff, v_p)), dot(c_diff, v_p)));
+        theta[1] = theta[3] = normalizeAngleT(std::atan2(dot(axis2, cross(u_p, c_diff)), dot(-c_diff, u_p)));
+
+        return c_zero;
+    }
+}
+
+/**
+ * @ingroup ScrewTheoryLib
+ *
+ * @brief Revolute-prismatic subproblem, see @ref RevolutePrismatic
+ */
+template <typename V, typename R, typename F, typename T>
+inline bool revolutePrismatic(const V & axis1, const V & origin1, const V & axis2,
+                              const R & axisPow, typename std::common_type<T>::type axesDot, bool perpendicular,
+                              const V & p, const F & rhs, const F & pointTransform,
+                              T * theta)
+{
+    V f = pointTransform * p;
+    V k = rhs * p;
+
+    // Find theta2 such that the translated point lies on the circle described by k around the rotation axis.
+    V u = f - origin1;
+    V v = k - origin1;
+
+    V v_p = v - axisPow * v;
+
+    if (!perpendicular)
+    {
+        // Translation is the only contribution along the rotation axis.
+        T theta2 = dot(axis1, v - u) / axesDot;
+
+        V w = u + theta2 * axis2;
+        V w_p = w - axisPow * w;
+
+        theta[0] = normalizeAngleT(std::atan2(dot(axis1, cross(w_p, v_p)), dot(w_p, v_p)));
+        theta[1] = theta2;
+
+        return equalT(norm(w_p), norm(v_p));
+    }
+
+    // Both axes are perpendicular, intersect the translation line with said circle.
+    V u_p = u - axisPow * u;
+
+    T b = dot(u_p, axis2);
+    T sq2 = b * b - squaredNorm(u_p) + squaredNorm(v_p);
+    bool sq2_zero = equalT(sq2, T(0));
+
+    T sq = (!sq2_zero && sq2 > 0) ? std::sqrt(sq2) : T(0);
+    T theta2s[] = {-b + sq, -b - sq};
+
+    for (int i = 0; i < 2; i++)
+    {
+        V w_p = u_p + theta2s[i] * axis2;
+
+        theta[2 * i] = normalizeAngleT(std::atan2(dot(axis1, cross(w_p, v_p)), dot(w_p, v_p)));
+        theta[2 * i + 1] = theta2s[i];
+    }
+
+    return (sq2_zero || sq2 > 0) && equalT(V(axisPow * u), V(axisPow * v));
+}
+
+/**
+ * @ingroup ScrewTheoryLib
+ *
+ * @brief Prismatic-revolute subproblem, see @ref PrismaticRevolute
+ */
+template <typename V, typename R, typename F, typename T>
+inline bool prismaticRevolute(const V & axis1, const V & axis2, const V & origin2,
+                              const R & axisPow, typename std::common_type<T>::type axesDot, bool perpendicular,
+                              const V & p, const F & rhs, const F & pointTransform,
+                              T * theta)
+{
+    V f = pointTransform * p;
+    V k = rhs * p;
+
+    // Find theta1 such that k, translated backwards, lies on the circle described by f around the rotation axis.
+    V u = f - origin2;
+    V v = k - origin2;
+
+    V u_p = u - axisPow * u;
+
+    if (!perpendicular)
+    {
+        // Translation is the only contribution along the rotation axis.
+        T theta1 = dot(axis2, v - u) / axesDot;
+
+        V w = v - theta1 * axis1;
+        V w_p = w - axisPow * w;
+
+        theta[0] = theta1;
+        theta[1] = normalizeAngleT(std::atan2(dot(axis2, cross(u_p, w_p)), dot(u_p, w_p)));
+
+        return equalT(norm(u_p), norm(w_p));
+    }
+
+    // Both axes are perpendicular, intersect the translation line with said circle.
+    V v_p = v - axisPow * v;
+
+    T b = dot(v_p, axis1);
+    T sq2 = b * b - squaredNorm(v_p) + squaredNorm(u_p);
+    bool sq2_zero = equalT(sq2, T(0));
+
+    T sq = (!sq2_zero && sq2 > 0) ? std::sqrt(sq2) : T(0);
+    T theta1s[] = {b + sq, b - sq};
+
+    for (int i = 0; i < 2; i++)
+    {
+        V w_p = v_p - theta1s[i] * axis1;
+
+        theta[2 * i] = theta1s[i];
+        theta[2 * i + 1] = normalizeAngleT(std::atan2(dot(axis2, cross(u_p, w_p)), dot(u_p, w_p)));
+    }
+
+    return (sq2_zero || sq2 > 0) && equalT(V(axisPow * u), V(axisPow * v));
+}
+
+/**
+ * @ingroup ScrewTheoryLib
+ *
+ * @brief Prismatic triad subproblem, see @ref PrismaticTriad
+ */
+template <typename V, typename R, typename F, typename T>
+inline bool prismaticTriad(const R & axesInv, const V & p, const F & rhs,
+                           const F & pointTransform, T * theta)
+{
+    V f = pointTransform * p;
+    V k = rhs * p;
+
+    V solution = axesInv * (k - f);
+
+    theta[0] = solution.x();
+    theta[1] = solution.y();
+    theta[2] = solution.z();
+
+    return true;
+}
+
+} // namespace roboticslab
+
+#endif // __SCREW_THEORY_IK_KERNELS_HPP__
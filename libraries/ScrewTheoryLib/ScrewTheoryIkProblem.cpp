@@ -41,6 +41,23 @@ namespace
 
 // -----------------------------------------------------------------------------
 
+void ScrewTheoryIkSubproblem::storeSolutions(std::initializer_list<int> ids, const double * theta, Solutions & solutions) const
+{
+    solutions.resize(this->solutions());
+
+    for (auto & jointIdsToSolutions : solutions)
+    {
+        jointIdsToSolutions.resize(ids.size());
+
+        for (int i = 0; i < ids.size(); i++)
+        {
+            jointIdsToSolutions[i] = std::make_pair(*(ids.begin() + i), *theta++);
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+
 ScrewTheoryIkProblem::ScrewTheoryIkProblem(const PoeExpression & _poe, const Steps & _steps, bool _reversed)
     : poe(_poe),
       steps(_steps),
@@ -60,7 +77,7 @@ ScrewTheoryIkProblem::~ScrewTheoryIkProblem()
 
 // -----------------------------------------------------------------------------
 
-bool ScrewTheoryIkProblem::solve(const KDL::Frame & H_S_T, Solutions & solutions)
+bool ScrewTheoryIkProblem::solve(const KDL::Frame & H_S_T, Solutions & solutions) const
 {
     if (!solutions.empty())
     {
@@ -157,7 +174,7 @@ bool ScrewTheoryIkProblem::solve(const KDL::Frame & H_S_T, Solutions & solutions
 
 // -----------------------------------------------------------------------------
 
-void ScrewTheoryIkProblem::recalculateFrames(const Solutions & solutions, Frames & frames, PoeTerms & poeTerms)
+void ScrewTheoryIkProblem::recalculateFrames(const Solutions & solutions, Frames & frames, PoeTerms & poeTerms) const
 {
     std::vector<KDL::Frame> pre, post;
 
@@ -182,7 +199,7 @@ void ScrewTheoryIkProblem::recalculateFrames(const Solutions & solutions, Frames
 
 // -----------------------------------------------------------------------------
 
-bool ScrewTheoryIkProblem::recalculateFrames(const Solutions & solutions, Frames & frames, PoeTerms & poeTerms, bool backwards)
+bool ScrewTheoryIkProblem::recalculateFrames(const Solutions & solutions, Frames & frames, PoeTerms & poeTerms, bool backwards) const
 {
     frames.resize(solutions.size());
 
@@ -224,7 +241,7 @@ bool ScrewTheoryIkProblem::recalculateFrames(const Solutions & solutions, Frames
 
 // -----------------------------------------------------------------------------
 
-KDL::Frame ScrewTheoryIkProblem::transformPoint(const KDL::JntArray & jointValues, const PoeTerms & poeTerms)
+KDL::Frame ScrewTheoryIkProblem::transformPoint(const KDL::JntArray & jointValues, const PoeTerms & poeTerms) const
 {
     KDL::Frame H;
 
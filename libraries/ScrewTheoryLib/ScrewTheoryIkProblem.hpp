@@ -3,6 +3,9 @@
 #ifndef __SCREW_THEORY_IK_PROBLEM_HPP__
 #define __SCREW_THEORY_IK_PROBLEM_HPP__
 
+#include <initializer_list>
+#include <ostream>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -77,6 +80,36 @@ public:
 
     //! Number of local IK solutions
     virtual int solutions() const = 0;
+
+    //! Joint ids solved by this subproblem, in the same order as stored in each local solution
+    virtual std::vector<int> jointIds() const = 0;
+
+    /**
+     * @brief Generates C++ code that solves this subproblem
+     *
+     * The resulting expression calls the matching kernel found in ScrewTheoryIkKernels.hpp
+     * with all geometric data folded into literals.
+     *
+     * @param rhs C++ expression that evaluates to the right-hand side of the POE formula.
+     * @param pointTransform C++ expression that evaluates to the transformation applied
+     * to the first characteristic point.
+     * @param theta Name of the output array of size @ref solutions times the number of
+     * joint ids, filled one local solution after another.
+     *
+     * @return A boolean C++ expression (see @ref solve), empty if not supported.
+     */
+    virtual std::string generateCode(const std::string & rhs, const std::string & pointTransform, const std::string & theta) const
+    { return {}; }
+
+protected:
+    /**
+     * @brief Stores local solutions computed by a kernel
+     *
+     * @param ids Joint ids, in the same order as stored in each local solution.
+     * @param theta Joint values, one local solution after another.
+     * @param solutions Output vector of local solutions, resized to @ref solutions.
+     */
+    void storeSolutions(std::initializer_list<int> ids, const double * theta, Solutions & solutions) const;
 };
 
 /**
@@ -84,7 +117,9 @@ public:
  *
  * @brief Proxy IK problem solver class that iterates over a sequence of subproblems
  *
- * This class is immutable. Instantiation is allowed by means of a static builder method.
+ * This class is immutable, hence a single instance can be shared by several threads
+ * that solve IK concurrently. Instantiation is allowed by means of a static builder
+ * method.
  *
  * @see ScrewTheoryIkProblemBuilder
  */
@@ -112,12 +147,33 @@ public:
      *
      * @return True if all solutions are reachable, false otherwise.
      */
-    bool solve(const KDL::Frame & H_S_T, Solutions & solutions);
+    bool solve(const KDL::Frame & H_S_T, Solutions & solutions) const;
 
     //! Number of global IK solutions
     int solutions() const
     { return soln; }
 
+    /**
+     * @brief Generates a specialized IK solver as C++ source code
+     *
+     * The output is a self-contained header that declares, within namespace \p name,
+     * the constants `JOINTS` and `SOLUTIONS` and the following function:
+     *
+     * @code
+     * inline bool solve(const KDL::Frame & H_S_T, double (&q)[SOLUTIONS][JOINTS]);
+     * @endcode
+     *
+     * It follows the same sequence of steps as @ref solve and yields the same solutions
+     * in the same order, but every subproblem is inlined, all geometric data is turned
+     * into literals and no dynamic memory is allocated.
+     *
+     * @param os Output stream.
+     * @param name Name of the enclosing namespace, must be a valid C++ identifier.
+     *
+     * @return True on success, false if any subproblem does not support code generation.
+     */
+    bool generateCode(std::ostream & os, const std::string & name) const;
+
     /**
      * @brief Creates an IK solver instance given a sequence of known subproblems
      *
@@ -143,10 +199,10 @@ private:
     // disable instantiation, force users to call builder class
     ScrewTheoryIkProblem(const PoeExpression & poe, const Steps & steps, bool reversed);
 
-    void recalculateFrames(const Solutions & solutions, Frames & frames, PoeTerms & poeTerms);
-    bool recalculateFrames(const Solutions & solutions, Frames & frames, PoeTerms & poeTerms, bool backwards);
+    void recalculateFrames(const Solutions & solutions, Frames & frames, PoeTerms & poeTerms) const;
+    bool recalculateFrames(const Solutions & solutions, Frames & frames, PoeTerms & poeTerms, bool backwards) const;
 
-    KDL::Frame transformPoint(const KDL::JntArray & jointValues, const PoeTerms & poeTerms);
+    KDL::Frame transformPoint(const KDL::JntArray & jointValues, const PoeTerms & poeTerms) const;
 
     const PoeExpression poe;
 
@@ -192,6 +248,22 @@ public:
      */
     ScrewTheoryIkProblem * build();
 
+    /**
+     * @brief Finds the nearest POE formula whose geometry is suitable for a closed-form solution
+     *
+     * Nearly parallel or nearly perpendicular joint axes are snapped to their
+     * ideal direction, then revolute axes that nearly intersect (e.g. a spherical
+     * wrist with a slightly offset axis) are shifted so that they actually do.
+     * The transformation between the base and the tool frame is preserved.
+     *
+     * @param poe Product of exponentials (POE) formula.
+     * @param tolerance Maximum deviation to be absorbed, applies to both the sine
+     * of the angle between axes and the distance between them (meters).
+     *
+     * @return An idealized copy of the input POE formula.
+     */
+    static PoeExpression idealize(const PoeExpression & poe, double tolerance);
+
 private:
     static std::vector<KDL::Vector> searchPoints(const PoeExpression & poe);
 
@@ -213,6 +285,7 @@ private:
 
     std::vector<PoeTerm> poeTerms;
 
+    // Number of characteristic points tested simultaneously, no subproblem consumes more than two.
     static const int MAX_SIMPLIFICATION_DEPTH = 2;
 };
 
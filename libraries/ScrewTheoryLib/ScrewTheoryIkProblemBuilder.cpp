@@ -3,6 +3,7 @@
 #include "ScrewTheoryIkProblem.hpp"
 
 #include <algorithm>
+#include <cmath>
 #include <functional>
 #include <iterator>
 #include <set>
@@ -35,7 +36,7 @@ namespace
         return parallelAxes(exp1, exp2) && liesOnAxis(exp1, exp2.getOrigin());
     }
 
-    bool intersectingAxes(const MatrixExponential & exp1, const MatrixExponential & exp2, KDL::Vector & p)
+    void closestPoints(const MatrixExponential & exp1, const MatrixExponential & exp2, KDL::Vector & p1, KDL::Vector & p2)
     {
         // "Intersection of Two Lines in Three-Space" by Ronald Goldman, University of Waterloo (Waterloo, Ontario, Canada)
         // published in: "Graphic Gems", edited by Andrew S. Glassner, 1 ed., ch. 5, "3D Geometry" (p. 304)
@@ -48,14 +49,25 @@ namespace
         double t = KDL::dot(cross, diff * exp2.getAxis()) / den;
         double s = KDL::dot(cross, diff * exp1.getAxis()) / den;
 
-        KDL::Vector L1 = exp1.getOrigin() + exp1.getAxis() * t;
-        KDL::Vector L2 = exp2.getOrigin() + exp2.getAxis() * s;
+        p1 = exp1.getOrigin() + exp1.getAxis() * t;
+        p2 = exp2.getOrigin() + exp2.getAxis() * s;
+    }
+
+    bool intersectingAxes(const MatrixExponential & exp1, const MatrixExponential & exp2, KDL::Vector & p)
+    {
+        KDL::Vector L1, L2;
+        closestPoints(exp1, exp2, L1, L2);
 
         p = L1;
 
         return KDL::Equal(L1, L2);
     }
 
+    inline double distanceToAxis(const MatrixExponential & exp, const KDL::Vector & p)
+    {
+        return ((p - exp.getOrigin()) * exp.getAxis()).Norm();
+    }
+
     inline bool planarMovement(const MatrixExponential & exp1, const MatrixExponential & exp2)
     {
         bool sameMotionType = exp1.getMotionType() == exp2.getMotionType();
@@ -141,6 +153,118 @@ namespace
 
 // -----------------------------------------------------------------------------
 
+PoeExpression ScrewTheoryIkProblemBuilder::idealize(const PoeExpression & poe, double tolerance)
+{
+    std::vector<MatrixExponential> exps;
+    exps.reserve(poe.size());
+
+    for (int i = 0; i < poe.size(); i++)
+    {
+        exps.push_back(poe.exponentialAtJoint(i));
+    }
+
+    // Snap nearly parallel or nearly perpendicular axes to the first previous axis that meets either condition.
+    for (int j = 1; j < exps.size(); j++)
+    {
+        for (int i = 0; i < j; i++)
+        {
+            if (parallelAxes(exps[i], exps[j]) || perpendicularAxes(exps[i], exps[j]))
+            {
+                continue;
+            }
+
+            const KDL::Vector & reference = exps[i].getAxis();
+            KDL::Vector axis = exps[j].getAxis();
+            double cosine = KDL::dot(reference, axis);
+
+            if (std::abs(cosine) < tolerance)
+            {
+                axis = axis - reference * cosine;
+                axis.Normalize();
+            }
+            else if ((reference * axis).Norm() < tolerance)
+            {
+                axis = cosine > 0 ? reference : -reference;
+            }
+            else
+            {
+                continue;
+            }
+
+            exps[j] = MatrixExponential(exps[j].getMotionType(), axis, exps[j].getOrigin());
+            break;
+        }
+    }
+
+    // Shift revolute axes so that they pass through nearby intersection points, or intersect nearby axes.
+    std::vector<KDL::Vector> intersections;
+
+    for (int j = 0; j < exps.size(); j++)
+    {
+        if (exps[j].getMotionType() != MatrixExponential::ROTATION)
+        {
+            continue;
+        }
+
+        bool shifted = false;
+
+        for (const auto & p : intersections)
+        {
+            if (distanceToAxis(exps[j], p) < tolerance)
+            {
+                if (!liesOnAxis(exps[j], p))
+                {
+                    exps[j] = MatrixExponential(exps[j].getMotionType(), exps[j].getAxis(), p);
+                }
+
+                shifted = true;
+                break;
+            }
+        }
+
+        for (int i = 0; i < j; i++)
+        {
+            if (exps[i].getMotionType() != MatrixExponential::ROTATION || parallelAxes(exps[i], exps[j]))
+            {
+                continue;
+            }
+
+            KDL::Vector p1, p2;
+            closestPoints(exps[i], exps[j], p1, p2);
+
+            if ((p1 - p2).Norm() >= tolerance)
+            {
+                continue;
+            }
+
+            if (!KDL::Equal(p1, p2))
+            {
+                if (shifted)
+                {
+                    continue;
+                }
+
+                exps[j] = MatrixExponential(exps[j].getMotionType(), exps[j].getAxis(), exps[j].getOrigin() + (p1 - p2));
+            }
+
+            shifted = true;
+
+            intersections.push_back(p1);
+        }
+    }
+
+    PoeExpression idealPoe(poe.getTransform());
+
+    for (const auto & exp : exps)
+    {
+        idealPoe.append(exp);
+    }
+
+    return idealPoe;
+}
+
+// -----------------------------------------------------------------------------
+
 ScrewTheoryIkProblemBuilder::ScrewTheoryIkProblemBuilder(const PoeExpression & _poe)
     : poe(_poe),
       poeTerms(poe.size())
@@ -387,9 +511,9 @@ ScrewTheoryIkSubproblem * ScrewTheoryIkProblemBuilder::trySolve(int depth)
 {
     int unknownsCount = std::count_if(poeTerms.begin(), poeTerms.end(), unknownNotSimplifiedTerm);
 
-    if (unknownsCount == 0 || unknownsCount > 2) // TODO: hardcoded
+    if (unknownsCount == 0)
     {
-        // Can't solve yet, too many unknowns or oversimplified.
+        // Can't solve yet, oversimplified.
         return nullptr;
     }
 
@@ -483,6 +607,59 @@ ScrewTheoryIkSubproblem * ScrewTheoryIkProblemBuilder::trySolve(int depth)
                 poeTerms[lastExpId].known = poeTerms[nextToLastExpId].known = true;
                 return new PardosGotorFour(nextToLastExpId, lastExpId, nextToLastExp, lastExp, testPoints[0]);
             }
+
+            if (lastExp.getMotionType() == MatrixExponential::TRANSLATION
+                    && nextToLastExp.getMotionType() == MatrixExponential::ROTATION
+                    && !liesOnAxis(nextToLastExp, testPoints[0]))
+            {
+                poeTerms[lastExpId].known = poeTerms[nextToLastExpId].known = true;
+                return new RevolutePrismatic(nextToLastExpId, lastExpId, nextToLastExp, lastExp, testPoints[0]);
+            }
+
+            if (lastExp.getMotionType() == MatrixExponential::ROTATION
+                    && nextToLastExp.getMotionType() == MatrixExponential::TRANSLATION
+                    && !liesOnAxis(lastExp, testPoints[0]))
+            {
+                poeTerms[lastExpId].known = poeTerms[nextToLastExpId].known = true;
+                return new PrismaticRevolute(nextToLastExpId, lastExpId, nextToLastExp, lastExp, testPoints[0]);
+            }
+        }
+    }
+    else if (unknownsCount == 3 && lastUnknown != poeTerms.rend())
+    {
+        // Pick the two previous PoE terms.
+        std::vector<PoeTerm>::reverse_iterator nextToLastUnknown = lastUnknown;
+        std::advance(nextToLastUnknown, 1);
+
+        if (nextToLastUnknown == poeTerms.rend() || !unknownNotSimplifiedTerm(*nextToLastUnknown))
+        {
+            return nullptr;
+        }
+
+        std::vector<PoeTerm>::reverse_iterator firstUnknown = nextToLastUnknown;
+        std::advance(firstUnknown, 1);
+
+        if (firstUnknown == poeTerms.rend() || !unknownNotSimplifiedTerm(*firstUnknown))
+        {
+            return nullptr;
+        }
+
+        int nextToLastExpId = lastExpId - 1;
+        int firstExpId = lastExpId - 2;
+
+        const MatrixExponential & nextToLastExp = poe.exponentialAtJoint(nextToLastExpId);
+        const MatrixExponential & firstExp = poe.exponentialAtJoint(firstExpId);
+
+        if (depth == 0)
+        {
+            if (lastExp.getMotionType() == MatrixExponential::TRANSLATION
+                    && nextToLastExp.getMotionType() == MatrixExponential::TRANSLATION
+                    && firstExp.getMotionType() == MatrixExponential::TRANSLATION
+                    && !KDL::Equal(KDL::dot(firstExp.getAxis(), nextToLastExp.getAxis() * lastExp.getAxis()), 0.0))
+            {
+                poeTerms[lastExpId].known = poeTerms[nextToLastExpId].known = poeTerms[firstExpId].known = true;
+                return new PrismaticTriad(firstExpId, nextToLastExpId, lastExpId, firstExp, nextToLastExp, lastExp, testPoints[0]);
+            }
         }
     }
 
@@ -37,6 +37,11 @@ public:
     int solutions() const override
     { return 1; }
 
+    std::vector<int> jointIds() const override
+    { return {id}; }
+
+    std::string generateCode(const std::string & rhs, const std::string & pointTransform, const std::string & theta) const override;
+
 private:
     const int id;
     const MatrixExponential exp;
@@ -73,6 +78,11 @@ public:
     int solutions() const override
     { return 2; }
 
+    std::vector<int> jointIds() const override
+    { return {id1, id2}; }
+
+    std::string generateCode(const std::string & rhs, const std::string & pointTransform, const std::string & theta) const override;
+
 private:
     const int id1, id2;
     const MatrixExponential exp1, exp2;
@@ -108,6 +118,11 @@ public:
     int solutions() const override
     { return 2; }
 
+    std::vector<int> jointIds() const override
+    { return {id}; }
+
+    std::string generateCode(const std::string & rhs, const std::string & pointTransform, const std::string & theta) const override;
+
 private:
     const int id;
     const MatrixExponential exp;
@@ -141,6 +156,11 @@ public:
     int solutions() const override
     { return 1; }
 
+    std::vector<int> jointIds() const override
+    { return {id}; }
+
+    std::string generateCode(const std::string & rhs, const std::string & pointTransform, const std::string & theta) const override;
+
 private:
     const int id;
     const MatrixExponential exp;
@@ -175,6 +195,11 @@ public:
     int solutions() const override
     { return 1; }
 
+    std::vector<int> jointIds() const override
+    { return {id1, id2}; }
+
+    std::string generateCode(const std::string & rhs, const std::string & pointTransform, const std::string & theta) const override;
+
 private:
     const int id1, id2;
     const MatrixExponential exp1, exp2;
@@ -210,6 +235,11 @@ public:
     int solutions() const override
     { return 2; }
 
+    std::vector<int> jointIds() const override
+    { return {id}; }
+
+    std::string generateCode(const std::string & rhs, const std::string & pointTransform, const std::string & theta) const override;
+
 private:
     const int id;
     const MatrixExponential exp;
@@ -245,6 +275,11 @@ public:
     int solutions() const override
     { return 2; }
 
+    std::vector<int> jointIds() const override
+    { return {id1, id2}; }
+
+    std::string generateCode(const std::string & rhs, const std::string & pointTransform, const std::string & theta) const override;
+
 private:
     const int id1, id2;
     const MatrixExponential exp1, exp2;
@@ -252,6 +287,135 @@ private:
     const KDL::Rotation axisPow;
 };
 
+/**
+ * @ingroup ScrewTheoryLib
+ *
+ * @brief Revolute-prismatic subproblem
+ *
+ * Single or dual solution, revolute plus prismatic joint geometric IK subproblem given by
+ * @f$ e\,^{\hat{\xi_1}\,{\theta_1}} \cdot e\,^{\hat{\xi_2}\,{\theta_2}} \cdot p = k @f$
+ * (translation screw followed by a rotation screw applied to a point). Two solutions
+ * are found if both axes are perpendicular, one otherwise.
+ */
+class RevolutePrismatic : public ScrewTheoryIkSubproblem
+{
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param id1 Zero-based joint id of the first product of exponentials (POE) term (revolute).
+     * @param id2 Zero-based joint id of the second POE term (prismatic).
+     * @param exp1 First POE term.
+     * @param exp2 Second POE term.
+     * @param p Characteristic point.
+     */
+    RevolutePrismatic(int id1, int id2, const MatrixExponential & exp1, const MatrixExponential & exp2, const KDL::Vector & p);
+
+    bool solve(const KDL::Frame & rhs, const KDL::Frame & pointTransform, Solutions & solutions) const override;
+
+    int solutions() const override
+    { return perpendicular ? 2 : 1; }
+
+    std::vector<int> jointIds() const override
+    { return {id1, id2}; }
+
+    std::string generateCode(const std::string & rhs, const std::string & pointTransform, const std::string & theta) const override;
+
+private:
+    const int id1, id2;
+    const MatrixExponential exp1, exp2;
+    const KDL::Vector p;
+    const KDL::Rotation axisPow;
+    const double axesDot;
+    const bool perpendicular;
+};
+
+/**
+ * @ingroup ScrewTheoryLib
+ *
+ * @brief Prismatic-revolute subproblem
+ *
+ * Single or dual solution, prismatic plus revolute joint geometric IK subproblem given by
+ * @f$ e\,^{\hat{\xi_1}\,{\theta_1}} \cdot e\,^{\hat{\xi_2}\,{\theta_2}} \cdot p = k @f$
+ * (rotation screw followed by a translation screw applied to a point). Two solutions
+ * are found if both axes are perpendicular, one otherwise.
+ */
+class PrismaticRevolute : public ScrewTheoryIkSubproblem
+{
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param id1 Zero-based joint id of the first product of exponentials (POE) term (prismatic).
+     * @param id2 Zero-based joint id of the second POE term (revolute).
+     * @param exp1 First POE term.
+     * @param exp2 Second POE term.
+     * @param p Characteristic point.
+     */
+    PrismaticRevolute(int id1, int id2, const MatrixExponential & exp1, const MatrixExponential & exp2, const KDL::Vector & p);
+
+    bool solve(const KDL::Frame & rhs, const KDL::Frame & pointTransform, Solutions & solutions) const override;
+
+    int solutions() const override
+    { return perpendicular ? 2 : 1; }
+
+    std::vector<int> jointIds() const override
+    { return {id1, id2}; }
+
+    std::string generateCode(const std::string & rhs, const std::string & pointTransform, const std::string & theta) const override;
+
+private:
+    const int id1, id2;
+    const MatrixExponential exp1, exp2;
+    const KDL::Vector p;
+    const KDL::Rotation axisPow;
+    const double axesDot;
+    const bool perpendicular;
+};
+
+/**
+ * @ingroup ScrewTheoryLib
+ *
+ * @brief Prismatic triad subproblem
+ *
+ * Single solution, triple prismatic joint geometric IK subproblem given by
+ * @f$ e\,^{\hat{\xi_1}\,{\theta_1}} \cdot e\,^{\hat{\xi_2}\,{\theta_2}} \cdot e\,^{\hat{\xi_3}\,{\theta_3}} \cdot p = k @f$
+ * (three consecutive, linearly independent translation screws applied to a point,
+ * e.g. a cartesian gantry).
+ */
+class PrismaticTriad : public ScrewTheoryIkSubproblem
+{
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param id1 Zero-based joint id of the first product of exponentials (POE) term.
+     * @param id2 Zero-based joint id of the second POE term.
+     * @param id3 Zero-based joint id of the third POE term.
+     * @param exp1 First POE term.
+     * @param exp2 Second POE term.
+     * @param exp3 Third POE term.
+     * @param p Characteristic point.
+     */
+    PrismaticTriad(int id1, int id2, int id3, const MatrixExponential & exp1, const MatrixExponential & exp2,
+                   const MatrixExponential & exp3, const KDL::Vector & p);
+
+    bool solve(const KDL::Frame & rhs, const KDL::Frame & pointTransform, Solutions & solutions) const override;
+
+    int solutions() const override
+    { return 1; }
+
+    std::vector<int> jointIds() const override
+    { return {id1, id2, id3}; }
+
+    std::string generateCode(const std::string & rhs, const std::string & pointTransform, const std::string & theta) const override;
+
+private:
+    const int id1, id2, id3;
+    const KDL::Vector p;
+    const KDL::Rotation axesInv;
+};
+
 } // namespace roboticslab
 
 #endif // __SCREW_THEORY_IK_SUBPROBLEMS_HPP__
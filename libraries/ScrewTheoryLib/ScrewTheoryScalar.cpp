@@ -0,0 +1,167 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#include "ScrewTheoryScalar.hpp"
+
+#include <cmath>
+
+#include "ScrewTheoryDualQuaternion.hpp"
+
+using namespace roboticslab;
+
+// -----------------------------------------------------------------------------
+
+template <typename T>
+MatrixExponentialT<T>::MatrixExponentialT(motion _motionType, const VectorT<T> & _axis, const VectorT<T> & _origin)
+    : motionType(_motionType),
+      axis(_axis.normalized()),
+      origin(_origin),
+      c(axis.cross(origin).cross(axis)),
+      m(origin.cross(axis))
+{}
+
+// -----------------------------------------------------------------------------
+
+template <typename T>
+MatrixExponentialT<T>::MatrixExponentialT(const MatrixExponential & exp)
+    : MatrixExponentialT(exp.getMotionType(), toScalar<T>(exp.getAxis()), toScalar<T>(exp.getOrigin()))
+{}
+
+// -----------------------------------------------------------------------------
+
+template <typename T>
+FrameT<T> MatrixExponentialT<T>::asFrame(T theta) const
+{
+    FrameT<T> H = FrameT<T>::Identity();
+
+    switch (motionType)
+    {
+    case MatrixExponential::ROTATION:
+        H.M = Eigen::AngleAxis<T>(theta, axis).toRotationMatrix();
+        H.p = c - H.M * c;
+        break;
+    case MatrixExponential::TRANSLATION:
+        H.p = axis * theta;
+        break;
+    }
+
+    return H;
+}
+
+// -----------------------------------------------------------------------------
+
+template <typename T>
+DualQuaternionT<T> MatrixExponentialT<T>::asDualQuaternion(T theta) const
+{
+    using Quaternion = typename DualQuaternionT<T>::Quaternion;
+
+    switch (motionType)
+    {
+    case MatrixExponential::ROTATION:
+    {
+        // cos(theta/2) + sin(theta/2) * (axis + eps * moment)
+        T s = std::sin(theta / 2);
+        T co = std::cos(theta / 2);
+        return {Quaternion(co, s * axis.x(), s * axis.y(), s * axis.z()),
+                Quaternion(T(0), s * m.x(), s * m.y(), s * m.z())};
+    }
+    case MatrixExponential::TRANSLATION:
+    {
+        T h = theta / 2;
+        return {Quaternion::Identity(), Quaternion(T(0), h * axis.x(), h * axis.y(), h * axis.z())};
+    }
+    }
+
+    return DualQuaternionT<T>::Identity();
+}
+
+// -----------------------------------------------------------------------------
+
+template <typename T>
+PoeExpressionT<T>::PoeExpressionT(const FrameT<T> & _H_S_T)
+    : H_S_T(_H_S_T)
+{
+    DualQuaternionT<T> dq = DualQuaternionT<T>::fromFrame(H_S_T);
+    H_S_T_real = dq.getReal();
+    H_S_T_dual = dq.getDual();
+}
+
+// -----------------------------------------------------------------------------
+
+template <typename T>
+PoeExpressionT<T>::PoeExpressionT(const PoeExpression & poe)
+    : PoeExpressionT(toScalar<T>(poe.getTransform()))
+{
+    exps.reserve(poe.size());
+
+    for (int i = 0; i < poe.size(); i++)
+    {
+        exps.emplace_back(poe.exponentialAtJoint(i));
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+template <typename T>
+void PoeExpressionT<T>::evaluate(const T * q, FrameT<T> & H) const
+{
+    H = FrameT<T>::Identity();
+
+    for (int i = 0; i < exps.size(); i++)
+    {
+        H = H * exps[i].asFrame(q[i]);
+    }
+
+    H = H * H_S_T;
+}
+
+// -----------------------------------------------------------------------------
+
+template <typename T>
+void PoeExpressionT<T>::evaluate(const T * q, int count, FrameT<T> * H) const
+{
+    for (int n = 0; n < count; n++)
+    {
+        evaluate(q + n * exps.size(), H[n]);
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+template <typename T>
+void PoeExpressionT<T>::evaluate(const T * q, DualQuaternionT<T> & H) const
+{
+    H = DualQuaternionT<T>::Identity();
+
+    for (int i = 0; i < exps.size(); i++)
+    {
+        H = H * exps[i].asDualQuaternion(q[i]);
+
+        if ((i + 1) % DualQuaternionT<T>::RENORMALIZATION_PERIOD == 0)
+        {
+            H.normalize();
+        }
+    }
+
+    H = H * DualQuaternionT<T>(H_S_T_real, H_S_T_dual);
+    H.normalize();
+}
+
+// -----------------------------------------------------------------------------
+
+template <typename T>
+void PoeExpressionT<T>::evaluate(const T * q, int count, DualQuaternionT<T> * H) const
+{
+    for (int n = 0; n < count; n++)
+    {
+        evaluate(q + n * exps.size(), H[n]);
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+template class roboticslab::MatrixExponentialT<float>;
+template class roboticslab::MatrixExponentialT<double>;
+template class roboticslab::PoeExpressionT<float>;
+template class roboticslab::PoeExpressionT<double>;
+
+// -----------------------------------------------------------------------------
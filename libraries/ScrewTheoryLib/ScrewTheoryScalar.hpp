@@ -0,0 +1,414 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#ifndef __SCREW_THEORY_SCALAR_HPP__
+#define __SCREW_THEORY_SCALAR_HPP__
+
+#include <cmath>
+
+#include <vector>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include <kdl/frames.hpp>
+
+#include "ProductOfExponentials.hpp"
+
+/**
+ * @file ScrewTheoryScalar.hpp
+ *
+ * Scalar-templated core of ScrewTheoryLib, instantiated for `float` and `double`.
+ *
+ * Geometric types are backed by fixed-size Eigen matrices. Single precision is meant
+ * for batch workloads (e.g. workspace sampling) where throughput matters more than
+ * accuracy. The KDL-based classes remain the reference implementation, conversions
+ * are provided by @ref toScalar and @ref toKdl.
+ */
+
+namespace roboticslab
+{
+
+template <typename T>
+class DualQuaternionT;
+
+//! @ingroup ScrewTheoryLib
+//! @brief Column vector of size 3
+template <typename T>
+using VectorT = Eigen::Matrix<T, 3, 1>;
+
+//! @ingroup ScrewTheoryLib
+//! @brief 3x3 matrix, not necessarily a rotation one
+template <typename T>
+using RotationT = Eigen::Matrix<T, 3, 3>;
+
+/**
+ * @ingroup ScrewTheoryLib
+ *
+ * @brief Rigid transformation, mirrors the layout and naming of KDL::Frame
+ *
+ * Lighter than Eigen::Transform since it does not store the bottom row of the
+ * homogeneous matrix.
+ */
+template <typename T>
+struct FrameT
+{
+    RotationT<T> M; ///< Rotation matrix.
+    VectorT<T> p;   ///< Position vector.
+
+    //! Identity transformation
+    static FrameT Identity()
+    { return {RotationT<T>::Identity(), VectorT<T>::Zero()}; }
+
+    //! Transforms a point
+    VectorT<T> operator*(const VectorT<T> & v) const
+    { return M * v + p; }
+
+    //! Composes two transformations
+    FrameT operator*(const FrameT & other) const
+    { return {M * other.M, M * other.p + p}; }
+
+    //! Inverse transformation
+    FrameT Inverse() const
+    { return {M.transpose(), -(M.transpose() * p)}; }
+};
+
+/**
+ * @ingroup ScrewTheoryLib
+ *
+ * @brief Tolerance used in comparisons between scalars of type @p T
+ *
+ * Matches KDL::epsilon in double precision, single precision is accurate down to
+ * micrometers at most on typical robot sizes.
+ */
+template <typename T>
+constexpr T scalarEpsilon();
+
+template <>
+constexpr double scalarEpsilon<double>()
+{ return 1e-6; }
+
+template <>
+constexpr float scalarEpsilon<float>()
+{ return 1e-4f; }
+
+/**
+ * @ingroup ScrewTheoryLib
+ *
+ * @brief Compares two scalars, see KDL::Equal
+ */
+template <typename T>
+inline bool equalT(T a, T b, T eps = scalarEpsilon<T>())
+{
+    return a + eps > b && a - eps < b;
+}
+
+/**
+ * @ingroup ScrewTheoryLib
+ *
+ * @brief Compares two vectors element-wise, see KDL::Equal
+ */
+template <typename A, typename B>
+inline bool equalT(const Eigen::MatrixBase<A> & a, const Eigen::MatrixBase<B> & b,
+                   typename A::Scalar eps = scalarEpsilon<typename A::Scalar>())
+{
+    return equalT(a.x(), b.x(), eps) && equalT(a.y(), b.y(), eps) && equalT(a.z(), b.z(), eps);
+}
+
+//! @ingroup ScrewTheoryLib
+inline bool equalT(const KDL::Vector & a, const KDL::Vector & b, double eps = KDL::epsilon)
+{
+    return KDL::Equal(a, b, eps);
+}
+
+//! @ingroup ScrewTheoryLib
+//! @brief Dot product, KDL vectors rely on KDL::dot
+template <typename A, typename B>
+inline typename A::Scalar dot(const Eigen::MatrixBase<A> & a, const Eigen::MatrixBase<B> & b)
+{
+    return a.dot(b);
+}
+
+//! @ingroup ScrewTheoryLib
+//! @brief Cross product
+template <typename A, typename B>
+inline VectorT<typename A::Scalar> cross(const Eigen::MatrixBase<A> & a, const Eigen::MatrixBase<B> & b)
+{
+    return a.cross(b);
+}
+
+//! @ingroup ScrewTheoryLib
+inline KDL::Vector cross(const KDL::Vector & a, const KDL::Vector & b)
+{
+    return a * b;
+}
+
+//! @ingroup ScrewTheoryLib
+//! @brief Euclidean norm
+template <typename A>
+inline typename A::Scalar norm(const Eigen::MatrixBase<A> & a)
+{
+    return a.norm();
+}
+
+//! @ingroup ScrewTheoryLib
+inline double norm(const KDL::Vector & a)
+{
+    return a.Norm();
+}
+
+//! @ingroup ScrewTheoryLib
+//! @brief Squared euclidean norm
+template <typename A>
+inline typename A::Scalar squaredNorm(const Eigen::MatrixBase<A> & a)
+{
+    return a.squaredNorm();
+}
+
+//! @ingroup ScrewTheoryLib
+inline double squaredNorm(const KDL::Vector & a)
+{
+    return KDL::dot(a, a);
+}
+
+/**
+ * @ingroup ScrewTheoryLib
+ *
+ * @brief Clip an angle value between certain bounds, see @ref normalizeAngle
+ */
+template <typename T>
+inline T normalizeAngleT(T angle)
+{
+    const T pi = T(KDL::PI);
+
+    if (equalT(std::abs(angle), pi))
+    {
+        return pi;
+    }
+    else if (angle > pi)
+    {
+        return angle - 2 * pi;
+    }
+    else if (angle < -pi)
+    {
+        return angle + 2 * pi;
+    }
+    else
+    {
+        return angle;
+    }
+}
+
+//! @ingroup ScrewTheoryLib
+//! @brief Converts a KDL vector
+template <typename T>
+inline VectorT<T> toScalar(const KDL::Vector & v)
+{
+    return VectorT<T>(T(v.x()), T(v.y()), T(v.z()));
+}
+
+//! @ingroup ScrewTheoryLib
+//! @brief Converts a KDL rotation
+template <typename T>
+inline RotationT<T> toScalar(const KDL::Rotation & R)
+{
+    RotationT<T> out;
+    out << T(R(0, 0)), T(R(0, 1)), T(R(0, 2)),
+           T(R(1, 0)), T(R(1, 1)), T(R(1, 2)),
+           T(R(2, 0)), T(R(2, 1)), T(R(2, 2));
+    return out;
+}
+
+//! @ingroup ScrewTheoryLib
+//! @brief Converts a KDL frame
+template <typename T>
+inline FrameT<T> toScalar(const KDL::Frame & H)
+{
+    return {toScalar<T>(H.M), toScalar<T>(H.p)};
+}
+
+//! @ingroup ScrewTheoryLib
+//! @brief Converts a vector to KDL
+template <typename T>
+inline KDL::Vector toKdl(const VectorT<T> & v)
+{
+    return KDL::Vector(v.x(), v.y(), v.z());
+}
+
+//! @ingroup ScrewTheoryLib
+//! @brief Converts a frame to KDL
+template <typename T>
+inline KDL::Frame toKdl(const FrameT<T> & H)
+{
+    const RotationT<T> & R = H.M;
+    return KDL::Frame(KDL::Rotation(R(0, 0), R(0, 1), R(0, 2), R(1, 0), R(1, 1), R(1, 2), R(2, 0), R(2, 1), R(2, 2)),
+                      toKdl<T>(H.p));
+}
+
+/**
+ * @ingroup ScrewTheoryLib
+ *
+ * @brief Scalar-templated counterpart of @ref MatrixExponential
+ */
+template <typename T>
+class MatrixExponentialT
+{
+public:
+    //! Screw motion types, see MatrixExponential::motion
+    using motion = MatrixExponential::motion;
+
+    /**
+     * @brief Constructor
+     *
+     * @param motionType Screw motion type.
+     * @param axis Screw axis.
+     * @param origin A point along the screw axis (ignored in prismatic joints).
+     */
+    MatrixExponentialT(motion motionType, const VectorT<T> & axis, const VectorT<T> & origin = VectorT<T>::Zero());
+
+    /**
+     * @brief Converting constructor
+     *
+     * @param exp A term of a KDL-based POE formula.
+     */
+    explicit MatrixExponentialT(const MatrixExponential & exp);
+
+    //! Evaluates this term for the given magnitude of the screw, see MatrixExponential::asFrame
+    FrameT<T> asFrame(T theta) const;
+
+    /**
+     * @brief Evaluates this term as a unit dual quaternion
+     *
+     * Requires ScrewTheoryDualQuaternion.hpp.
+     *
+     * @param theta Magnitude of the screw.
+     */
+    DualQuaternionT<T> asDualQuaternion(T theta) const;
+
+    //! Retrieves the motion type of this screw
+    motion getMotionType() const
+    { return motionType; }
+
+    //! Screw axis
+    const VectorT<T> & getAxis() const
+    { return axis; }
+
+    //! A point along the screw axis
+    const VectorT<T> & getOrigin() const
+    { return origin; }
+
+private:
+    motion motionType;
+    VectorT<T> axis;
+    VectorT<T> origin;
+    VectorT<T> c; // projection of origin onto the plane normal to the axis that contains the base frame
+    VectorT<T> m; // moment of the screw axis
+};
+
+/**
+ * @ingroup ScrewTheoryLib
+ *
+ * @brief Scalar-templated counterpart of @ref PoeExpression
+ */
+template <typename T>
+class PoeExpressionT
+{
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param H_S_T Transformation between the base and the tool frame.
+     */
+    explicit PoeExpressionT(const FrameT<T> & H_S_T = FrameT<T>::Identity());
+
+    /**
+     * @brief Converting constructor
+     *
+     * @param poe A KDL-based POE formula.
+     */
+    explicit PoeExpressionT(const PoeExpression & poe);
+
+    //! Appends a new term to this POE formula (already referred to its base frame)
+    void append(const MatrixExponentialT<T> & exp)
+    { exps.push_back(exp); }
+
+    //! Retrieves the transformation between base and tool frames
+    const FrameT<T> & getTransform() const
+    { return H_S_T; }
+
+    //! Size of this POE
+    int size() const
+    { return exps.size(); }
+
+    //! Retrieves a term of the POE formula
+    const MatrixExponentialT<T> & exponentialAtJoint(int i) const
+    { return exps.at(i); }
+
+    /**
+     * @brief Performs forward kinematics
+     *
+     * @param q Joint values, @ref size elements.
+     * @param H Output transformation.
+     */
+    void evaluate(const T * q, FrameT<T> & H) const;
+
+    /**
+     * @brief Performs forward kinematics on a batch of joint configurations
+     *
+     * @param q Joint values, @p count times @ref size elements stored one
+     * configuration after another.
+     * @param count Number of joint configurations.
+     * @param H Output transformations, @p count elements.
+     */
+    void evaluate(const T * q, int count, FrameT<T> * H) const;
+
+    /**
+     * @brief Performs forward kinematics using the dual quaternion backend
+     *
+     * Products are renormalized every DualQuaternionT::RENORMALIZATION_PERIOD
+     * terms and once more at the end. Requires ScrewTheoryDualQuaternion.hpp.
+     *
+     * @param q Joint values, @ref size elements.
+     * @param H Output transformation.
+     */
+    void evaluate(const T * q, DualQuaternionT<T> & H) const;
+
+    /**
+     * @brief Performs forward kinematics on a batch of joint configurations
+     * using the dual quaternion backend
+     *
+     * @param q Joint values, @p count times @ref size elements stored one
+     * configuration after another.
+     * @param count Number of joint configurations.
+     * @param H Output transformations, @p count elements.
+     */
+    void evaluate(const T * q, int count, DualQuaternionT<T> * H) const;
+
+private:
+    std::vector<MatrixExponentialT<T>> exps;
+    FrameT<T> H_S_T;
+
+    // H_S_T in dual quaternion form, split into its real and dual parts
+    Eigen::Quaternion<T> H_S_T_real;
+    Eigen::Quaternion<T> H_S_T_dual;
+};
+
+//! @ingroup ScrewTheoryLib
+using MatrixExponentialf = MatrixExponentialT<float>;
+
+//! @ingroup ScrewTheoryLib
+using MatrixExponentiald = MatrixExponentialT<double>;
+
+//! @ingroup ScrewTheoryLib
+using PoeExpressionf = PoeExpressionT<float>;
+
+//! @ingroup ScrewTheoryLib
+using PoeExpressiond = PoeExpressionT<double>;
+
+extern template class MatrixExponentialT<float>;
+extern template class MatrixExponentialT<double>;
+extern template class PoeExpressionT<float>;
+extern template class PoeExpressionT<double>;
+
+} // namespace roboticslab
+
+#endif // __SCREW_THEORY_SCALAR_HPP__
@@ -4,8 +4,9 @@
 
 #include <cmath>
 
-#include <yarp/os/Log.h>
+#include <yarp/os/LogStream.h>
 
+#include "KinematicRepresentation.hpp"
 #include "LogComponent.hpp"
 
 using namespace roboticslab;
@@ -27,3 +28,84 @@ bool AmorCartesianControl::checkJointVelocities(const std::vector<double> & qdot
 }
 
 // -----------------------------------------------------------------------------
+
+bool AmorCartesianControl::getCurrentJoints(std::vector<double> & q) const
+{
+    State latest = getState();
+
+    if (!latest.valid)
+    {
+        yCError(AMOR) << "Robot state not available";
+        return false;
+    }
+
+    q.resize(AMOR_NUM_JOINTS);
+
+    for (int i = 0; i < AMOR_NUM_JOINTS; i++)
+    {
+        q[i] = KinRepresentation::radToDeg(latest.joints[i]);
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+AmorCartesianControl::State AmorCartesianControl::getState() const
+{
+    std::lock_guard<std::mutex> lock(stateMutex);
+    return state;
+}
+
+// -----------------------------------------------------------------------------
+
+void AmorCartesianControl::setStreamCommand(const StreamCommand & command)
+{
+    std::lock_guard<std::mutex> lock(commandMutex);
+    streamCommand = command;
+}
+
+// -----------------------------------------------------------------------------
+
+AmorCartesianControl::CallResult AmorCartesianControl::callLocked(const std::function<AMOR_RESULT(AMOR_HANDLE)> & call) const
+{
+    std::lock_guard<std::mutex> lock(*handleMutex);
+    CallResult out {call(handle), {}};
+
+    if (out.code != AMOR_SUCCESS)
+    {
+        // the last error is global to the library, read it before any other user of the handle gets in
+        out.error = amor_error();
+    }
+
+    return out;
+}
+
+// -----------------------------------------------------------------------------
+
+AmorCartesianControl::CallResult AmorCartesianControl::execute(const std::function<AMOR_RESULT(AMOR_HANDLE)> & call)
+{
+    // the handle and its mutex are gone after close()
+    if (handle == AMOR_INVALID_HANDLE)
+    {
+        return {AMOR_FAILED, "invalid AMOR handle"};
+    }
+
+    std::packaged_task<CallResult()> task([this, &call] { return callLocked(call); });
+
+    auto result = task.get_future();
+
+    if (std::unique_lock<std::mutex> lock(commandMutex); yarp::os::PeriodicThread::isRunning())
+    {
+        requests.push_back(std::move(task));
+    }
+    else
+    {
+        lock.unlock();
+        task();
+    }
+
+    return result.get();
+}
+
+// -----------------------------------------------------------------------------
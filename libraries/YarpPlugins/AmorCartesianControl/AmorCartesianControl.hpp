@@ -3,11 +3,17 @@
 #ifndef __AMOR_CARTESIAN_CONTROL_HPP__
 #define __AMOR_CARTESIAN_CONTROL_HPP__
 
+#include <deque>
+#include <functional>
+#include <future>
 #include <mutex>
+#include <string>
 #include <vector>
 
 #include <amor.h>
 
+#include <yarp/os/PeriodicThread.h>
+
 #include <yarp/dev/DeviceDriver.h>
 #include <yarp/dev/PolyDriver.h>
 
@@ -27,12 +33,20 @@ namespace roboticslab
  * @ingroup AmorCartesianControl
  * @brief The AmorCartesianControl class implements ICartesianControl.
  *
- * Uses the roll-pitch-yaw (RPY) angle representation.
+ * Uses the roll-pitch-yaw (RPY) angle representation. All calls to the AMOR API
+ * are issued by a dedicated I/O thread, which refreshes a cache of the latest
+ * robot state at a fixed rate. RPC commands are queued and their caller blocks
+ * until the I/O thread reports the outcome, whereas streaming commands are
+ * stored in a single slot: a newer one replaces any older one not sent yet.
  */
 class AmorCartesianControl : public yarp::dev::DeviceDriver,
+                             public yarp::os::PeriodicThread,
                              public ICartesianControl
 {
 public:
+    AmorCartesianControl() : yarp::os::PeriodicThread(1.0, yarp::os::PeriodicThreadClock::Absolute)
+    {}
+
     // -- ICartesianControl declarations. Implementation in ICartesianControlImpl.cpp --
     bool stat(std::vector<double> & x, int * state = nullptr, double * timestamp = nullptr) override;
     bool inv(const std::vector<double> & xd, std::vector<double> & q) override;
@@ -40,6 +54,7 @@ public:
     bool relj(const std::vector<double> & xd) override;
     bool movl(const std::vector<double> & xd) override;
     bool movv(const std::vector<double> & xdotd) override;
+    bool movw(const std::vector<double> & xd) override;
     bool gcmp() override;
     bool forc(const std::vector<double> & td) override;
     bool stopControl() override;
@@ -53,18 +68,63 @@ public:
     bool getParameter(int vocab, double * value) override;
     bool setParameters(const std::map<int, double> & params) override;
     bool getParameters(std::map<int, double> & params) override;
+    bool getLatencyStats(std::map<int, std::vector<double>> & stats) override;
+    bool resetLatencyStats() override;
+
+    // -------- PeriodicThread declarations. Implementation in PeriodicThreadImpl.cpp --------
+    void run() override;
 
     // -------- DeviceDriver declarations. Implementation in DeviceDriverImpl.cpp --------
     bool open(yarp::os::Searchable & config) override;
     bool close() override;
 
 private:
+    //! Latest robot state as retrieved by the I/O thread.
+    struct State
+    {
+        AMOR_VECTOR7 cartesian;
+        AMOR_VECTOR7 joints;
+        amor_movement_status status;
+        double timestamp {0.0};
+        unsigned int count {0}; // number of refreshes so far
+        bool valid {false};
+    };
+
+    //! Streaming command, a newer one replaces it if not sent yet.
+    struct StreamCommand
+    {
+        enum kind { NONE, POSITIONS, VELOCITIES, STOP };
+        kind type {NONE};
+        AMOR_VECTOR7 values;
+    };
+
+    //! Outcome of a call to the AMOR API, the error message is read right after a failure.
+    struct CallResult
+    {
+        AMOR_RESULT code;
+        std::string error;
+    };
+
     bool checkJointVelocities(const std::vector<double> & qdot);
+    bool getCurrentJoints(std::vector<double> & q) const;
+    State getState() const;
+    void refreshState();
+    void setStreamCommand(const StreamCommand & command);
+    void processRequests();
+    CallResult callLocked(const std::function<AMOR_RESULT(AMOR_HANDLE)> & call) const;
+    CallResult execute(const std::function<AMOR_RESULT(AMOR_HANDLE)> & call);
 
     AMOR_HANDLE handle {AMOR_INVALID_HANDLE};
     bool ownsHandle {true};
     mutable std::mutex * handleMutex {nullptr};
 
+    State state;
+    mutable std::mutex stateMutex;
+
+    StreamCommand streamCommand;
+    std::deque<std::packaged_task<CallResult()>> requests;
+    std::mutex commandMutex;
+
     yarp::dev::PolyDriver cartesianDevice;
     ICartesianSolver * iCartesianSolver;
 
@@ -20,6 +20,7 @@ constexpr auto DEFAULT_CAN_LIBRARY = "libeddriver.so";
 constexpr auto DEFAULT_CAN_PORT = 0;
 constexpr auto DEFAULT_GAIN = 0.05;
 constexpr auto DEFAULT_WAIT_PERIOD_MS = 30;
+constexpr auto DEFAULT_IO_PERIOD_MS = 20;
 constexpr auto DEFAULT_REFERENCE_FRAME = "base";
 
 // ------------------- DeviceDriver Related ------------------------------------
@@ -36,6 +37,15 @@ bool AmorCartesianControl::open(yarp::os::Searchable& config)
     waitPeriodMs = config.check("waitPeriodMs", yarp::os::Value(DEFAULT_WAIT_PERIOD_MS),
             "wait command period (milliseconds)").asInt32();
 
+    int ioPeriodMs = config.check("ioPeriodMs", yarp::os::Value(DEFAULT_IO_PERIOD_MS),
+            "I/O thread period, also state refresh period (milliseconds)").asInt32();
+
+    if (ioPeriodMs <= 0)
+    {
+        yCError(AMOR) << "Illegal I/O thread period:" << ioPeriodMs;
+        return false;
+    }
+
     auto referenceFrameStr = config.check("referenceFrame", yarp::os::Value(DEFAULT_REFERENCE_FRAME),
             "reference frame (base|tcp)").asString();
 
@@ -132,14 +142,29 @@ bool AmorCartesianControl::open(yarp::os::Searchable& config)
         return false;
     }
 
+    refreshState();
+
+    if (!getState().valid)
+    {
+        yCError(AMOR) << "Unable to retrieve initial robot state";
+        return false;
+    }
+
     currentState = VOCAB_CC_NOT_CONTROLLING;
-    return true;
+
+    yarp::os::PeriodicThread::setPeriod(ioPeriodMs * 0.001);
+    return yarp::os::PeriodicThread::start();
 }
 
 // -----------------------------------------------------------------------------
 
 bool AmorCartesianControl::close()
 {
+    yarp::os::PeriodicThread::stop();
+
+    // unblock callers whose requests did not reach the I/O thread
+    processRequests();
+
     if (handle != AMOR_INVALID_HANDLE)
     {
         std::unique_lock<std::mutex> lock(*handleMutex);
@@ -15,23 +15,23 @@ using namespace roboticslab;
 
 bool AmorCartesianControl::stat(std::vector<double> & x, int * state, double * timestamp)
 {
-    AMOR_VECTOR7 positions;
+    State latest = getState();
 
-    if (std::lock_guard<std::mutex> lock(*handleMutex); amor_get_cartesian_position(handle, positions) != AMOR_SUCCESS)
+    if (!latest.valid)
     {
-        yCError(AMOR) << "amor_get_cartesian_position() failed:" << amor_error();
+        yCError(AMOR) << "Robot state not available";
         return false;
     }
 
     x.resize(6);
 
-    x[0] = positions[0] * 0.001; // [m]
-    x[1] = positions[1] * 0.001;
-    x[2] = positions[2] * 0.001;
+    x[0] = latest.cartesian[0] * 0.001; // [m]
+    x[1] = latest.cartesian[1] * 0.001;
+    x[2] = latest.cartesian[2] * 0.001;
 
-    x[3] = positions[3]; // [rad]
-    x[4] = positions[4];
-    x[5] = positions[5];
+    x[3] = latest.cartesian[3]; // [rad]
+    x[4] = latest.cartesian[4];
+    x[5] = latest.cartesian[5];
 
     KinRepresentation::encodePose(x, x, KinRepresentation::coordinate_system::CARTESIAN, KinRepresentation::orientation_system::RPY);
 
@@ -42,7 +42,7 @@ bool AmorCartesianControl::stat(std::vector<double> & x, int * state, double * t
 
     if (timestamp)
     {
-        *timestamp = yarp::os::Time::now();
+        *timestamp = latest.timestamp;
     }
 
     return true;
@@ -52,21 +52,13 @@ bool AmorCartesianControl::stat(std::vector<double> & x, int * state, double * t
 
 bool AmorCartesianControl::inv(const std::vector<double> &xd, std::vector<double> &q)
 {
-    AMOR_VECTOR7 positions;
+    std::vector<double> currentQ;
 
-    if (std::lock_guard<std::mutex> lock(*handleMutex); amor_get_actual_positions(handle, &positions) != AMOR_SUCCESS)
+    if (!getCurrentJoints(currentQ))
     {
-        yCError(AMOR) << "amor_get_actual_positions() failed:" << amor_error();
         return false;
     }
 
-    std::vector<double> currentQ(AMOR_NUM_JOINTS);
-
-    for (int i = 0; i < AMOR_NUM_JOINTS; i++)
-    {
-        currentQ[i] = KinRepresentation::radToDeg(positions[i]);
-    }
-
     if (!iCartesianSolver->invKin(xd, currentQ, q, referenceFrame))
     {
         yCError(AMOR) << "invKin() failed";
@@ -95,9 +87,12 @@ bool AmorCartesianControl::movj(const std::vector<double> &xd)
         positions[i] = KinRepresentation::degToRad(qd[i]);
     }
 
-    if (std::lock_guard<std::mutex> lock(*handleMutex); amor_set_positions(handle, positions) != AMOR_SUCCESS)
+    // discard pending streaming commands, if any
+    setStreamCommand(StreamCommand());
+
+    if (auto result = execute([&positions](AMOR_HANDLE h) { return amor_set_positions(h, positions); }); result.code != AMOR_SUCCESS)
     {
-        yCError(AMOR) << "amor_set_positions() failed:" << amor_error();
+        yCError(AMOR) << "amor_set_positions() failed:" << result.error;
         return false;
     }
 
@@ -139,21 +134,13 @@ bool AmorCartesianControl::movl(const std::vector<double> &xd)
 
     if (referenceFrame == ICartesianSolver::TCP_FRAME)
     {
-        AMOR_VECTOR7 positions;
+        std::vector<double> currentQ;
 
-        if (std::lock_guard<std::mutex> lock(*handleMutex); amor_get_actual_positions(handle, &positions) != AMOR_SUCCESS)
+        if (!getCurrentJoints(currentQ))
         {
-            yCError(AMOR) << "amor_get_actual_positions() failed:" << amor_error();
             return false;
         }
 
-        std::vector<double> currentQ(AMOR_NUM_JOINTS);
-
-        for (int i = 0; i < AMOR_NUM_JOINTS; i++)
-        {
-            currentQ[i] = KinRepresentation::radToDeg(positions[i]);
-        }
-
         std::vector<double> x_base_tcp;
 
         if (!iCartesianSolver->fwdKin(currentQ, x_base_tcp))
@@ -187,9 +174,12 @@ bool AmorCartesianControl::movl(const std::vector<double> &xd)
     positions[4] = xd_rpy[4];
     positions[5] = xd_rpy[5];
 
-    if (std::lock_guard<std::mutex> lock(*handleMutex); amor_set_cartesian_positions(handle, positions) != AMOR_SUCCESS)
+    // discard pending streaming commands, if any
+    setStreamCommand(StreamCommand());
+
+    if (auto result = execute([&positions](AMOR_HANDLE h) { return amor_set_cartesian_positions(h, positions); }); result.code != AMOR_SUCCESS)
     {
-        yCError(AMOR) << "amor_set_cartesian_positions() failed:" << amor_error();
+        yCError(AMOR) << "amor_set_cartesian_positions() failed:" << result.error;
         return false;
     }
 
@@ -231,9 +221,12 @@ bool AmorCartesianControl::movv(const std::vector<double> &xdotd)
     velocities[4] = -xdotd_rpy[5];
     velocities[5] = xdotd_rpy[3];
 
-    if (std::lock_guard<std::mutex> lock(*handleMutex); amor_set_cartesian_velocities(handle, velocities) != AMOR_SUCCESS)
+    // discard pending streaming commands, if any
+    setStreamCommand(StreamCommand());
+
+    if (auto result = execute([&velocities](AMOR_HANDLE h) { return amor_set_cartesian_velocities(h, velocities); }); result.code != AMOR_SUCCESS)
     {
-        yCError(AMOR) << "amor_set_cartesian_velocities() failed:" << amor_error();
+        yCError(AMOR) << "amor_set_cartesian_velocities() failed:" << result.error;
         return false;
     }
 
@@ -244,6 +237,14 @@ bool AmorCartesianControl::movv(const std::vector<double> &xdotd)
 
 // -----------------------------------------------------------------------------
 
+bool AmorCartesianControl::movw(const std::vector<double> &xd)
+{
+    yCWarning(AMOR) << "movw() not implemented";
+    return false;
+}
+
+// -----------------------------------------------------------------------------
+
 bool AmorCartesianControl::gcmp()
 {
     yCWarning(AMOR) << "gcmp() not implemented";
@@ -264,9 +265,12 @@ bool AmorCartesianControl::stopControl()
 {
     currentState = VOCAB_CC_NOT_CONTROLLING;
 
-    if (std::lock_guard<std::mutex> lock(*handleMutex); amor_controlled_stop(handle) != AMOR_SUCCESS)
+    // discard pending streaming commands, if any
+    setStreamCommand(StreamCommand());
+
+    if (auto result = execute(amor_controlled_stop); result.code != AMOR_SUCCESS)
     {
-        yCError(AMOR) << "amor_controlled_stop() failed:" << amor_error();
+        yCError(AMOR) << "amor_controlled_stop() failed:" << result.error;
         return false;
     }
 
@@ -282,12 +286,13 @@ bool AmorCartesianControl::wait(double timeout)
         return true;
     }
 
-    AMOR_RESULT res = AMOR_SUCCESS;
-    amor_movement_status status;
+    // only trust movement status retrieved after this point
+    const unsigned int count = getState().count;
+    bool ok = true;
 
     double start = yarp::os::Time::now();
 
-    do
+    while (true)
     {
         if (timeout != 0.0 && yarp::os::Time::now() - start > timeout)
         {
@@ -296,24 +301,26 @@ bool AmorCartesianControl::wait(double timeout)
             break;
         }
 
+        yarp::os::Time::delay(waitPeriodMs / 1000.0);
+
+        State latest = getState();
+
+        if (!latest.valid)
         {
-            std::lock_guard<std::mutex> lock(*handleMutex);
-            res = amor_get_movement_status(handle, &status);
+            yCError(AMOR) << "Robot state not available";
+            ok = false;
+            break;
         }
 
-        if (res == AMOR_FAILED)
+        if (latest.count > count && latest.status == AMOR_MOVEMENT_STATUS_FINISHED)
         {
-            yCError(AMOR) << "amor_get_movement_status() failed:" << amor_error();
             break;
         }
-
-        yarp::os::Time::delay(waitPeriodMs / 1000.0);
     }
-    while (status != AMOR_MOVEMENT_STATUS_FINISHED);
 
     currentState = VOCAB_CC_NOT_CONTROLLING;
 
-    return res == AMOR_SUCCESS;
+    return ok;
 }
 
 // -----------------------------------------------------------------------------
@@ -346,9 +353,9 @@ bool AmorCartesianControl::act(int command)
         return false;
     }
 
-    if (std::lock_guard<std::mutex> lock(*handleMutex); amor_command(handle) != AMOR_SUCCESS)
+    if (auto result = execute(amor_command); result.code != AMOR_SUCCESS)
     {
-        yCError(AMOR) << "amor_command() failed:" << amor_error();
+        yCError(AMOR) << "amor_command() failed:" << result.error;
         return false;
     }
 
@@ -359,67 +366,49 @@ bool AmorCartesianControl::act(int command)
 
 void AmorCartesianControl::twist(const std::vector<double> &xdot)
 {
-    AMOR_VECTOR7 positions;
+    std::vector<double> currentQ, qdot;
 
-    if (std::lock_guard<std::mutex> lock(*handleMutex); amor_get_actual_positions(handle, &positions) != AMOR_SUCCESS)
+    if (!getCurrentJoints(currentQ))
     {
-        yCError(AMOR) << "amor_get_actual_positions() failed:" << amor_error();
         return;
     }
 
-    std::vector<double> currentQ(AMOR_NUM_JOINTS), qdot;
-
-    for (int i = 0; i < AMOR_NUM_JOINTS; i++)
-    {
-        currentQ[i] = KinRepresentation::radToDeg(positions[i]);
-    }
-
     if (!iCartesianSolver->diffInvKin(currentQ, xdot, qdot, referenceFrame))
     {
         yCError(AMOR) << "diffInvKin() failed";
         return;
     }
 
+    StreamCommand command;
+
     if (!checkJointVelocities(qdot))
     {
-        std::lock_guard<std::mutex> lock(*handleMutex);
-        amor_controlled_stop(handle);
+        command.type = StreamCommand::STOP;
+        setStreamCommand(command);
         return;
     }
 
-    AMOR_VECTOR7 velocities;
+    command.type = StreamCommand::VELOCITIES;
 
     for (int i = 0; i < qdot.size(); i++)
     {
-        velocities[i] = KinRepresentation::degToRad(qdot[i]);
+        command.values[i] = KinRepresentation::degToRad(qdot[i]);
     }
 
-    if (std::lock_guard<std::mutex> lock(*handleMutex); amor_set_velocities(handle, velocities) != AMOR_SUCCESS)
-    {
-        yCError(AMOR) << "amor_set_velocities() failed:" << amor_error();
-        return;
-    }
+    setStreamCommand(command);
 }
 
 // -----------------------------------------------------------------------------
 
 void AmorCartesianControl::pose(const std::vector<double> &x, double interval)
 {
-    AMOR_VECTOR7 positions;
+    std::vector<double> currentQ;
 
-    if (std::lock_guard<std::mutex> lock(*handleMutex); amor_get_actual_positions(handle, &positions) != AMOR_SUCCESS)
+    if (!getCurrentJoints(currentQ))
     {
-        yCError(AMOR) << "amor_get_actual_positions() failed:" << amor_error();
         return;
     }
 
-    std::vector<double> currentQ(AMOR_NUM_JOINTS);
-
-    for (int i = 0; i < AMOR_NUM_JOINTS; i++)
-    {
-        currentQ[i] = KinRepresentation::radToDeg(positions[i]);
-    }
-
     std::vector<double> x_base_tcp;
 
     if (!iCartesianSolver->fwdKin(currentQ, x_base_tcp))
@@ -467,33 +456,48 @@ void AmorCartesianControl::pose(const std::vector<double> &x, double interval)
         return;
     }
 
+    StreamCommand command;
+
     if (!checkJointVelocities(qdot))
     {
-        std::lock_guard<std::mutex> lock(*handleMutex);
-        amor_controlled_stop(handle);
+        command.type = StreamCommand::STOP;
+        setStreamCommand(command);
         return;
     }
 
-    AMOR_VECTOR7 velocities;
+    command.type = StreamCommand::VELOCITIES;
 
     for (int i = 0; i < qdot.size(); i++)
     {
-        velocities[i] = KinRepresentation::degToRad(qdot[i]);
+        command.values[i] = KinRepresentation::degToRad(qdot[i]);
     }
 
-    if (std::lock_guard<std::mutex> lock(*handleMutex); amor_set_velocities(handle, velocities) != AMOR_SUCCESS)
-    {
-        yCError(AMOR) << "amor_set_velocities() failed:" << amor_error();
-        return;
-    }
+    setStreamCommand(command);
 }
 
 // -----------------------------------------------------------------------------
 
 void AmorCartesianControl::movi(const std::vector<double> &x)
 {
-    yCWarning(AMOR) << "movi() not supported, falling back to movj()";
-    movj(x);
+    std::vector<double> qd;
+
+    if (!inv(x, qd))
+    {
+        yCError(AMOR) << "inv() failed";
+        return;
+    }
+
+    StreamCommand command;
+    command.type = StreamCommand::POSITIONS;
+
+    for (int i = 0; i < qd.size(); i++)
+    {
+        command.values[i] = KinRepresentation::degToRad(qd[i]);
+    }
+
+    setStreamCommand(command);
+
+    currentState = VOCAB_CC_MOVJ_CONTROLLING;
 }
 
 // -----------------------------------------------------------------------------
@@ -594,3 +598,19 @@ bool AmorCartesianControl::getParameters(std::map<int, double> & params)
 }
 
 // -----------------------------------------------------------------------------
+
+bool AmorCartesianControl::getLatencyStats(std::map<int, std::vector<double>> & stats)
+{
+    yCError(AMOR) << "getLatencyStats() not implemented";
+    return false;
+}
+
+// -----------------------------------------------------------------------------
+
+bool AmorCartesianControl::resetLatencyStats()
+{
+    yCError(AMOR) << "resetLatencyStats() not implemented";
+    return false;
+}
+
+// -----------------------------------------------------------------------------
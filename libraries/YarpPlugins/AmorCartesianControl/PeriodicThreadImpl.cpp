@@ -0,0 +1,135 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#include "AmorCartesianControl.hpp"
+
+#include <yarp/os/LogStream.h>
+#include <yarp/os/Time.h>
+
+#include "LogComponent.hpp"
+
+using namespace roboticslab;
+
+// ------------------- PeriodicThread Related ------------------------------------
+
+void AmorCartesianControl::run()
+{
+    processRequests();
+
+    StreamCommand command;
+
+    {
+        std::lock_guard<std::mutex> lock(commandMutex);
+        command = streamCommand;
+        streamCommand.type = StreamCommand::NONE;
+    }
+
+    switch (command.type)
+    {
+    case StreamCommand::POSITIONS:
+        if (auto result = callLocked([&command](AMOR_HANDLE h) { return amor_set_positions(h, command.values); });
+            result.code != AMOR_SUCCESS)
+        {
+            yCError(AMOR) << "amor_set_positions() failed:" << result.error;
+        }
+        break;
+    case StreamCommand::VELOCITIES:
+        if (auto result = callLocked([&command](AMOR_HANDLE h) { return amor_set_velocities(h, command.values); });
+            result.code != AMOR_SUCCESS)
+        {
+            yCError(AMOR) << "amor_set_velocities() failed:" << result.error;
+        }
+        break;
+    case StreamCommand::STOP:
+        if (auto result = callLocked(amor_controlled_stop); result.code != AMOR_SUCCESS)
+        {
+            yCError(AMOR) << "amor_controlled_stop() failed:" << result.error;
+        }
+        break;
+    default:
+        break;
+    }
+
+    refreshState();
+}
+
+// -----------------------------------------------------------------------------
+
+void AmorCartesianControl::processRequests()
+{
+    std::deque<std::packaged_task<CallResult()>> pending;
+
+    {
+        std::lock_guard<std::mutex> lock(commandMutex);
+        pending.swap(requests);
+    }
+
+    for (auto & task : pending)
+    {
+        task();
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void AmorCartesianControl::refreshState()
+{
+    State latest;
+    const char * failed = nullptr;
+    std::string error;
+
+    {
+        std::lock_guard<std::mutex> lock(*handleMutex);
+
+        // query status first, positions read afterwards reflect a finished movement
+        if (amor_get_movement_status(handle, &latest.status) != AMOR_SUCCESS)
+        {
+            failed = "amor_get_movement_status()";
+        }
+        else if (amor_get_cartesian_position(handle, latest.cartesian) != AMOR_SUCCESS)
+        {
+            failed = "amor_get_cartesian_position()";
+        }
+        else if (amor_get_actual_positions(handle, &latest.joints) != AMOR_SUCCESS)
+        {
+            failed = "amor_get_actual_positions()";
+        }
+
+        if (failed)
+        {
+            error = amor_error(); // global to the library, read it before the handle is released
+        }
+    }
+
+    bool wasValid;
+    unsigned int count;
+
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        wasValid = state.valid;
+        count = state.count;
+
+        if (failed)
+        {
+            state.valid = false;
+        }
+        else
+        {
+            latest.timestamp = yarp::os::Time::now();
+            latest.count = state.count + 1;
+            latest.valid = true;
+            state = latest;
+        }
+    }
+
+    // report only once per failure streak (or on the very first refresh), this runs on every cycle
+    if (failed && (wasValid || count == 0))
+    {
+        yCError(AMOR) << failed << "failed:" << error;
+    }
+    else if (!failed && !wasValid && latest.count > 1)
+    {
+        yCInfo(AMOR) << "Robot state available again";
+    }
+}
+
+// -----------------------------------------------------------------------------
@@ -16,35 +16,26 @@ namespace
     // epsilon for floating-point operations (represents degrees)
     constexpr double eps = 0.001;
 
-    inline bool checkJointInLimits(double q, double qMin, double qMax)
+    Eigen::Array4d normalizeAngles(const Eigen::Array4d & q)
     {
-        return q >= (qMin - eps) && q <= (qMax + eps);
+        // FIXME: assumes that joint limits may not surpass +-180º, but this
+        // is not necessarily true for circular joints (q1 and q2)
+        Eigen::Array4d wrapped = (q > 180.0).select(q - 360.0, (q <= -180.0).select(q + 360.0, q));
+        return (wrapped.abs() < eps).select(0.0, wrapped);
     }
+}
 
-    double normalizeAngle(double q)
+AsibotConfiguration::AsibotConfiguration(JointsIn qMin, JointsIn qMax)
+{
+    for (int i = 0; i < NUM_JOINTS; i++)
     {
-        // FIXME: assumes that joint limits may not surpass +-180º, but this
-        // is not necessarily true for circular joints (q1 and q2)
-        if (q > 180)
-        {
-            return q - 360;
-        }
-        else if (q <= -180)
-        {
-            return q + 360;
-        }
-        else if (std::abs(q) < eps)
-        {
-            return 0.0;
-        }
-        else
-        {
-            return q;
-        }
+        qLower[i] = qMin[i] - eps;
+        qUpper[i] = qMax[i] + eps;
     }
 }
 
-bool AsibotConfiguration::configure(double q1, double q2u, double q2d, double q3, double q4u, double q4d, double q5)
+bool AsibotConfiguration::findOptimalConfiguration(double q1, double q2u, double q2d, double q3, double q4u, double q4d, double q5,
+        JointsIn qGuess, JointsOut q) const
 {
     if (std::abs((q2u + q3 + q4u) - (q2d - q3 + q4d)) > eps)
     {
@@ -53,89 +44,59 @@ bool AsibotConfiguration::configure(double q1, double q2u, double q2d, double q3
         return false;
     }
 
-    forwardElbowUp.storeAngles(q1, q2u, q3, q4u, q5, Pose::FORWARD, Pose::UP);
-
-    if (!forwardElbowUp.checkJointsInLimits(_qMin, _qMax))
-    {
-        forwardElbowUp.valid = false;
-    }
-
-    yCInfo(ASIBOT) << forwardElbowUp.toString();
+    Candidates candidates;
 
-    forwardElbowDown.storeAngles(q1, q2d, -q3, q4d, q5, Pose::FORWARD, Pose::DOWN);
+    //                FORWARD_UP  FORWARD_DOWN  REVERSED_UP  REVERSED_DOWN
+    candidates[0] <<  q1,         q1,           q1 + 180,    q1 + 180;
+    candidates[1] <<  q2u,        q2d,          -q2u,        -q2d;
+    candidates[2] <<  q3,         -q3,          -q3,         q3;
+    candidates[3] <<  q4u,        q4d,          -q4u,        -q4d;
+    candidates[4] <<  q5,         q5,           q5 + 180,    q5 + 180;
 
-    if (!forwardElbowDown.checkJointsInLimits(_qMin, _qMax))
+    for (int i = 0; i < NUM_JOINTS; i++)
     {
-        forwardElbowDown.valid = false;
+        candidates[i] = normalizeAngles(candidates[i]);
     }
 
-    yCInfo(ASIBOT) << forwardElbowDown.toString();
+    int lane = selectConfiguration(candidates, qGuess);
 
-    reversedElbowUp.storeAngles(q1 + 180, -q2u, -q3, -q4u, q5 + 180, Pose::REVERSED, Pose::UP);
-
-    if (!reversedElbowUp.checkJointsInLimits(_qMin, _qMax))
+    if (lane == -1)
     {
-        reversedElbowUp.valid = false;
-    }
+        yCWarning(ASIBOT) << "No valid configuration found";
 
-    yCInfo(ASIBOT) << reversedElbowUp.toString();
-
-    reversedElbowDown.storeAngles(q1 + 180, -q2d, q3, -q4d, q5 + 180, Pose::REVERSED, Pose::DOWN);
+        for (int i = FORWARD_UP; i <= REVERSED_DOWN; i++)
+        {
+            yCDebug(ASIBOT) << toString(candidates, i);
+        }
 
-    if (!reversedElbowDown.checkJointsInLimits(_qMin, _qMax))
-    {
-        reversedElbowDown.valid = false;
+        return false;
     }
 
-    yCInfo(ASIBOT) << reversedElbowDown.toString();
-
-    return forwardElbowUp.valid || forwardElbowDown.valid || reversedElbowUp.valid || reversedElbowDown.valid;
-}
-
-void AsibotConfiguration::Pose::storeAngles(double q1, double q2, double q3, double q4, double q5, orientation orient, elbow elb)
-{
-    _q1 = normalizeAngle(q1);
-    _q2 = normalizeAngle(q2);
-    _q3 = normalizeAngle(q3);
-    _q4 = normalizeAngle(q4);
-    _q5 = normalizeAngle(q5);
-
-    _orient = orient;
-    _elb = elb;
-}
+    yCInfo(ASIBOT) << "Using config:" << toString(candidates, lane);
 
-bool AsibotConfiguration::Pose::checkJointsInLimits(JointsIn qMin, JointsIn qMax) const
-{
-    double joints[5] = {_q1, _q2, _q3, _q4, _q5};
-    bool ok = true;
+    q.resize(NUM_JOINTS);
 
-    for (int i = 0; i < 5; i++)
+    for (int i = 0; i < NUM_JOINTS; i++)
     {
-        double joint = joints[i];
-
-        if (!checkJointInLimits(joint, qMin[i], qMax[i]))
-        {
-            yCWarning(ASIBOT, "Joint out of limits: q[%d] = %f not in [%f,%f]", i, joint, qMin[i], qMax[i]);
-            ok = false;
-        }
+        q[i] = candidates[i][lane];
     }
 
-    return ok;
-}
-
-void AsibotConfiguration::Pose::retrieveAngles(JointsOut q) const
-{
-    q = {_q1, _q2, _q3, _q4, _q5};
+    return true;
 }
 
-std::string AsibotConfiguration::Pose::toString() const
+std::string AsibotConfiguration::toString(const Candidates & candidates, int lane)
 {
     std::stringstream ss;
 
-    ss << (_orient == FORWARD ? "FORWARD" : "REVERSED");
+    ss << (lane == FORWARD_UP || lane == FORWARD_DOWN ? "FORWARD" : "REVERSED");
     ss << " ";
-    ss << (_elb == UP ? "UP" : "DOWN");
-    ss << ": " << _q1 << " " << _q2 << " " << _q3 << " " << _q4 << " " << _q5;
+    ss << (lane == FORWARD_UP || lane == REVERSED_UP ? "UP" : "DOWN");
+    ss << ":";
+
+    for (int i = 0; i < NUM_JOINTS; i++)
+    {
+        ss << " " << candidates[i][lane];
+    }
 
     return ss.str();
 }
@@ -6,6 +6,8 @@
 #include <vector>
 #include <string>
 
+#include <Eigen/Core>
+
 namespace roboticslab
 {
 
@@ -15,6 +17,10 @@ namespace roboticslab
  *
  * Designed with ASIBOT's specific case in mind, which entails up to
  * four different configurations depending on initial angles provided.
+ * All of them are evaluated at once: candidate joint values are stored
+ * as a structure of arrays, one four-lane packet per joint, and each lane
+ * holds a distinct configuration. Instances are immutable once built,
+ * hence a single one may serve concurrent queries.
  */
 class AsibotConfiguration
 {
@@ -30,15 +36,13 @@ public:
      * @param qMin vector of minimum joint limits [deg]
      * @param qMax vector of maximum joint limits [deg]
      */
-    AsibotConfiguration(JointsIn qMin, JointsIn qMax)
-        : _qMin(qMin), _qMax(qMax)
-    {}
+    AsibotConfiguration(JointsIn qMin, JointsIn qMax);
 
     //! @brief Destructor
     virtual ~AsibotConfiguration() = default;
 
     /**
-     * @brief Stores initial values for a specific pose.
+     * @brief Builds all configurations for a specific pose and selects the optimal one.
      *
      * Distinguishes between elbow up and down poses. Make sure that:
      *
@@ -51,71 +55,44 @@ public:
      * @param q4u IK solution for joint 4 (elbow up) [deg]
      * @param q4d IK solution for joint 4 (elbow down) [deg]
      * @param q5 IK solution for joint 5 [deg]
-     *
-     * @return true/false on success/failure
-     */
-    virtual bool configure(double q1, double q2u, double q2d, double q3, double q4u, double q4d, double q5);
-
-    /**
-     * @brief Analyzes available configurations and selects the optimal one.
      * @param qGuess vector of joint angles for current robot position [deg]
+     * @param q vector of joint angles of the optimal configuration [deg]
+     *
      * @return true/false on success/failure
      */
-    virtual bool findOptimalConfiguration(JointsIn qGuess) = 0;
-
-    /**
-     * @brief Queries computed angles for the optimal configuration.
-     * @param q vector of joint angles [deg]
-     */
-    virtual void retrieveAngles(JointsOut q) const
-    {
-        optimalPose.retrieveAngles(q);
-    }
+    bool findOptimalConfiguration(double q1, double q2u, double q2d, double q3, double q4u, double q4d, double q5,
+                                  JointsIn qGuess, JointsOut q) const;
 
 protected:
-    /**
-     * @brief Helper class to store a specific robot configuration.
-     */
-    struct Pose
-    {
-        //! @brief Orientation of axis 1 ('forward' or 180º offset).
-        enum orientation { FORWARD, REVERSED };
-
-        //! @brief Orientation of axes 2-3 (elbow up/down).
-        enum elbow { UP, DOWN };
+    //! @brief Number of joints.
+    static constexpr int NUM_JOINTS = 5;
 
-        //! @brief Constructor
-        Pose()
-            : _q1(0.0), _q2(0.0), _q3(0.0), _q4(0.0), _q5(0.0), valid(true), _orient(FORWARD), _elb(UP)
-        {}
+    //! @brief Lane index of each configuration, orientation of axis 1 ('forward' or 180º offset) and elbow.
+    enum configuration { FORWARD_UP, FORWARD_DOWN, REVERSED_UP, REVERSED_DOWN };
 
-        //! @brief Initializes angle values (in degrees).
-        void storeAngles(double q1, double q2, double q3, double q4, double q5, orientation orient, elbow elb);
+    //! @brief One value per configuration, indexed by @ref configuration.
+    using Lanes = Eigen::Array4d;
 
-        //! @brief Checks whether current configuration is reachable.
-        bool checkJointsInLimits(JointsIn qMin, JointsIn qMax) const;
+    //! @brief Candidate joint angles, one set of lanes per joint.
+    using Candidates = Lanes[NUM_JOINTS];
 
-        //! @brief Returns stored angles.
-        void retrieveAngles(JointsOut q) const;
-
-        //! @brief Serializes stored data.
-        std::string toString() const;
-
-        double _q1, _q2, _q3, _q4, _q5;
-        bool valid;
-
-        orientation _orient;
-        elbow _elb;
-    };
-
-    JointsIn _qMin, _qMax;
+    /**
+     * @brief Analyzes available configurations and selects the optimal one.
+     *
+     * Implementations should discard configurations that do not lie within
+     * the joint limits (see @ref qLower and @ref qUpper) in the same pass.
+     *
+     * @param candidates joint angles of all configurations [deg]
+     * @param qGuess vector of joint angles for current robot position [deg]
+     * @return lane index of the optimal configuration, -1 if none is valid
+     */
+    virtual int selectConfiguration(const Candidates & candidates, JointsIn qGuess) const = 0;
 
-    Pose optimalPose;
+    //! @brief Serializes the joint angles of a configuration.
+    static std::string toString(const Candidates & candidates, int lane);
 
-    Pose forwardElbowUp;
-    Pose forwardElbowDown;
-    Pose reversedElbowUp;
-    Pose reversedElbowDown;
+    //! @brief Joint limits widened by the angle tolerance [deg].
+    double qLower[NUM_JOINTS], qUpper[NUM_JOINTS];
 };
 
 /**
@@ -140,65 +117,8 @@ public:
         : AsibotConfiguration(qMin, qMax)
     {}
 
-    bool findOptimalConfiguration(JointsIn qGuess) override;
-
-private:
-    //! @brief Obtains vector of differences between current and desired joint angles [deg].
-    std::vector<double> getDiffs(JointsIn qGuess, const Pose & pose);
-};
-
-/**
- * @ingroup AsibotSolver
- * @brief Base factory class for AsibotConfiguration.
- *
- * Acts as the base class in the <a href="https://stackoverflow.com/a/1741424">
- * abstract factory pattern</a>, encapsulates individual factories.
- */
-class AsibotConfigurationFactory
-{
-public:
-    /**
-     * @brief Creates an instance of the concrete class.
-     * @return A pointer to the base class of the inheritance tree.
-     */
-    virtual AsibotConfiguration * create() const = 0;
-    virtual ~AsibotConfigurationFactory() = default;
-
 protected:
-    /**
-     * @brief Constructor
-     * @param qMin vector of minimum joint limits [deg]
-     * @param qMax vector of maximum joint limits [deg]
-     */
-    AsibotConfigurationFactory(AsibotConfiguration::JointsIn qMin, AsibotConfiguration::JointsIn qMax)
-        : _qMin(qMin), _qMax(qMax)
-    {}
-
-    AsibotConfiguration::JointsIn _qMin, _qMax;
-};
-
-/**
- * @ingroup AsibotSolver
- * @brief Implementation factory class for AsibotConfigurationLeastOverallAngularDisplacement.
- *
- * Implements AsibotConfigurationFactory::create.
- */
-class AsibotConfigurationLeastOverallAngularDisplacementFactory : public AsibotConfigurationFactory
-{
-public:
-    /**
-     * @brief Constructor
-     * @param qMin vector of minimum joint limits [deg]
-     * @param qMax vector of maximum joint limits [deg]
-     */
-    AsibotConfigurationLeastOverallAngularDisplacementFactory(AsibotConfiguration::JointsIn qMin, AsibotConfiguration::JointsIn qMax)
-        : AsibotConfigurationFactory(qMin, qMax)
-    {}
-
-    AsibotConfiguration * create() const override
-    {
-        return new AsibotConfigurationLeastOverallAngularDisplacement(_qMin, _qMax);
-    }
+    int selectConfiguration(const Candidates & candidates, JointsIn qGuess) const override;
 };
 
 } // namespace roboticslab
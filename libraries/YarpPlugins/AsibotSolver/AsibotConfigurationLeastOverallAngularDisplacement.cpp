@@ -2,93 +2,54 @@
 
 #include "AsibotConfiguration.hpp"
 
-#include <cmath>
-#include <map>
-#include <numeric>
-#include <utility>
-
-#include <yarp/os/LogStream.h>
-
-#include "LogComponent.hpp"
+#include <limits>
 
 using namespace roboticslab;
 
-bool AsibotConfigurationLeastOverallAngularDisplacement::findOptimalConfiguration(JointsIn qGuess)
+int AsibotConfigurationLeastOverallAngularDisplacement::selectConfiguration(const Candidates & candidates, JointsIn qGuess) const
 {
-    using MapPair = std::pair<double, const Pose *>;
-    using MapType = std::map<MapPair::first_type, MapPair::second_type>;
-    MapType angularDisplacementPerConfiguration;
+    constexpr double inf = std::numeric_limits<double>::infinity();
 
-    if (forwardElbowUp.valid)
-    {
-        std::vector<double> diffs = getDiffs(qGuess, forwardElbowUp);
-        double sum = std::accumulate(diffs.begin(), diffs.end(), 0.0);
-        angularDisplacementPerConfiguration.insert(MapPair(sum, &forwardElbowUp));
-    }
+    Lanes sums = Lanes::Zero();
+    Lanes diffs2;
 
-    if (forwardElbowDown.valid)
+    // single pass over all joints: accumulate displacements and discard lanes out of limits
+    for (int i = 0; i < NUM_JOINTS; i++)
     {
-        std::vector<double> diffs = getDiffs(qGuess, forwardElbowDown);
-        double sum = std::accumulate(diffs.begin(), diffs.end(), 0.0);
-        angularDisplacementPerConfiguration.insert(MapPair(sum, &forwardElbowDown));
-    }
+        const Lanes & q = candidates[i];
+        Lanes diffs = (q - qGuess[i]).abs();
 
-    if (reversedElbowUp.valid)
-    {
-        std::vector<double> diffs = getDiffs(qGuess, reversedElbowUp);
-        double sum = std::accumulate(diffs.begin(), diffs.end(), 0.0);
-        angularDisplacementPerConfiguration.insert(MapPair(sum, &reversedElbowUp));
-    }
+        if (i == 1)
+        {
+            diffs2 = diffs;
+        }
 
-    if (reversedElbowDown.valid)
-    {
-        std::vector<double> diffs = getDiffs(qGuess, reversedElbowDown);
-        double sum = std::accumulate(diffs.begin(), diffs.end(), 0.0);
-        angularDisplacementPerConfiguration.insert(MapPair(sum, &reversedElbowDown));
+        sums = (q >= qLower[i] && q <= qUpper[i]).select(sums + diffs, inf);
     }
 
-    if (angularDisplacementPerConfiguration.empty())
+    // lowest angle sum, first lane wins on ties
+    int optimal;
+    double optimalSum = sums.minCoeff(&optimal);
+
+    if (optimalSum == inf)
     {
-        yCWarning(ASIBOT) << "No valid configuration found";
-        return false;
+        return -1;
     }
 
-    // std::map keys are sorted, pick std::pair with lowest key (angle sum)
-    MapType::iterator it = angularDisplacementPerConfiguration.begin();
-    optimalPose = *it->second;
+    // compare with second best option if available, i.e. next greater sum
+    int alternative;
+    double alternativeSum = (sums > optimalSum).select(sums, inf).minCoeff(&alternative);
 
-    // compare with second best option if available
-    if (angularDisplacementPerConfiguration.size() > 1)
+    // both candidates share same orientation of joint 1
+    if (alternativeSum != inf && (alternative <= FORWARD_DOWN) == (optimal <= FORWARD_DOWN))
     {
-        Pose alternativePose = *(++it)->second;
-
-        // both candidates share same orientation of joint 1
-        if (alternativePose._orient == optimalPose._orient)
+        // alternative pose minimizes angular travel distance for joint 2;
+        // if equal, prefer elbow up configuration
+        if (diffs2[alternative] < diffs2[optimal] || (diffs2[alternative] == diffs2[optimal] && (alternative == FORWARD_UP || alternative == REVERSED_UP)))
         {
-            std::vector<double> diffsA = getDiffs(qGuess, optimalPose);
-            std::vector<double> diffsB = getDiffs(qGuess, alternativePose);
-
-            // alternative pose minimizes angular travel distance for joint 2;
-            // if equal, prefer elbow up configuration
-            if (diffsB[1] < diffsA[1] || (diffsB[1] == diffsA[1] && alternativePose._elb == Pose::UP))
-            {
-                optimalPose = alternativePose;
-            }
+            return alternative;
         }
     }
 
-    yCInfo(ASIBOT) << "Using config:" << optimalPose.toString();
-
-    return true;
-}
-
-std::vector<double> AsibotConfigurationLeastOverallAngularDisplacement::getDiffs(JointsIn qGuess, const Pose & pose)
-{
-    return {
-        std::abs(qGuess[0] - pose._q1),
-        std::abs(qGuess[1] - pose._q2),
-        std::abs(qGuess[2] - pose._q3),
-        std::abs(qGuess[3] - pose._q4),
-        std::abs(qGuess[4] - pose._q5)
-    };
+    return optimal;
 }
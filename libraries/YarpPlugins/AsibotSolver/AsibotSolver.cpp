@@ -6,13 +6,6 @@ using namespace roboticslab;
 
 // -----------------------------------------------------------------------------
 
-AsibotConfiguration * AsibotSolver::getConfiguration() const
-{
-    return confFactory->create();
-}
-
-// -----------------------------------------------------------------------------
-
 AsibotSolver::AsibotTcpFrame AsibotSolver::getTcpFrame() const
 {
     std::lock_guard<std::mutex> lock(mtx);
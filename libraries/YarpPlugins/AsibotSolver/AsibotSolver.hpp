@@ -8,7 +8,8 @@
 
 #include <yarp/os/Searchable.h>
 #include <yarp/dev/DeviceDriver.h>
-#include <yarp/sig/Matrix.h>
+
+#include <kdl/frames.hpp>
 
 #include "AsibotConfiguration.hpp"
 #include "ICartesianSolver.h"
@@ -76,11 +77,9 @@ private:
     struct AsibotTcpFrame
     {
         bool hasFrame;
-        yarp::sig::Matrix frameTcp;
+        KDL::Frame frameTcp;
     };
 
-    AsibotConfiguration * getConfiguration() const;
-
     AsibotTcpFrame getTcpFrame() const;
     void setTcpFrame(const AsibotTcpFrame & tcpFrameStruct);
 
@@ -88,7 +87,7 @@ private:
 
     std::vector<double> qMin, qMax;
 
-    AsibotConfigurationFactory * confFactory {nullptr};
+    AsibotConfiguration * conf {nullptr};
 
     AsibotTcpFrame tcpFrameStruct;
 
@@ -14,8 +14,6 @@
 #include <yarp/os/ResourceFinder.h>
 #include <yarp/os/Value.h>
 
-#include <yarp/math/Math.h>
-
 #include "LogComponent.hpp"
 
 using namespace roboticslab;
@@ -86,7 +84,7 @@ bool AsibotSolver::open(yarp::os::Searchable& config)
 
     if (strategy == DEFAULT_STRATEGY)
     {
-        confFactory = new AsibotConfigurationLeastOverallAngularDisplacementFactory(qMin, qMax);
+        conf = new AsibotConfigurationLeastOverallAngularDisplacement(qMin, qMax);
     }
     else
     {
@@ -95,7 +93,7 @@ bool AsibotSolver::open(yarp::os::Searchable& config)
     }
 
     tcpFrameStruct.hasFrame = false;
-    tcpFrameStruct.frameTcp = yarp::math::eye(4);
+    tcpFrameStruct.frameTcp = KDL::Frame::Identity();
 
     return true;
 }
@@ -103,10 +101,10 @@ bool AsibotSolver::open(yarp::os::Searchable& config)
 // -----------------------------------------------------------------------------
 
 bool AsibotSolver::close() {
-    if (confFactory)
+    if (conf)
     {
-        delete confFactory;
-        confFactory = nullptr;
+        delete conf;
+        conf = nullptr;
     }
 
     return true;
@@ -3,12 +3,13 @@
 #include "AsibotSolver.hpp"
 
 #include <cmath>
-#include <memory>
 
 #include <yarp/os/LogStream.h>
-#include <yarp/math/Math.h>
-#include <yarp/math/SVD.h>
 
+#include <Eigen/Core>
+#include <Eigen/SVD>
+
+#include "KdlVectorConverter.hpp"
 #include "KinematicRepresentation.hpp"
 #include "LogComponent.hpp"
 
@@ -19,65 +20,9 @@ using namespace roboticslab::KinRepresentation;
 
 namespace
 {
-    yarp::sig::Matrix vectorToMatrix(const std::vector<double> &v, bool fillTransl)
-    {
-        yarp::sig::Vector axisAngleScaled(3);
-
-        for (int i = 0; i < 3; i++)
-        {
-            axisAngleScaled[i] = v[i + 3];
-        }
-
-        double rotAngle = yarp::math::norm(axisAngleScaled);
-
-        yarp::sig::Vector axisAngle = axisAngleScaled;
-
-        if (rotAngle > 1e-9)
-        {
-            axisAngle /= rotAngle;
-        }
-        else
-        {
-            axisAngle[0] = axisAngle[1] = axisAngle[2] = 0.0;
-        }
-
-        axisAngle.push_back(rotAngle);
-
-        yarp::sig::Matrix H = yarp::math::axis2dcm(axisAngle);
-
-        if (fillTransl)
-        {
-            for (int i = 0; i < 3; i++)
-            {
-                H(i, 3) = v[i];
-            }
-        }
-
-        return H;
-    }
-
-    void matrixToVector(const yarp::sig::Matrix &H, std::vector<double> &v, bool fillTransl)
-    {
-        yarp::sig::Vector axisAngle = yarp::math::dcm2axis(H);
-        yarp::sig::Vector axisAngleScaled = axisAngle.subVector(0, 2) * axisAngle[3];
-
-        v.resize(6);
-
-        for (int i = 0; i < 3; i++)
-        {
-            v[i + 3] = axisAngleScaled[i];
-        }
-
-        if (fillTransl)
-        {
-            for (int i = 0; i < 3; i++)
-            {
-                v[i] = H(i, 3);
-            }
-        }
-    }
+    using Jacobian = Eigen::Matrix<double, 6, 5>;
 
-    void computeBaseFrameDiffInvKin(double A1, double A2, double A3, const std::vector<double> & q, yarp::sig::Matrix & Ja)
+    void computeBaseFrameDiffInvKin(double A1, double A2, double A3, const double * q, Jacobian & Ja)
     {
         double s1 = std::sin(q[0]);
         double c1 = std::cos(q[0]);
@@ -127,7 +72,7 @@ namespace
         Ja(5, 4) = c234;
     }
 
-    void computeTcpFrameDiffInvKin(double A1, double A2, double A3, const std::vector<double> & q, yarp::sig::Matrix & Ja)
+    void computeTcpFrameDiffInvKin(double A1, double A2, double A3, const double * q, Jacobian & Ja)
     {
         double s2 = std::sin(q[1]);
         double c2 = std::cos(q[1]);
@@ -181,6 +126,25 @@ namespace
         Ja(5, 3) = 0;
         Ja(5, 4) = 1;
     }
+
+    // Singular values below the tolerance are discarded, same as yarp::math::pinv.
+    Eigen::Matrix<double, 5, 6> pinv(const Jacobian & Ja, double tol)
+    {
+        Eigen::JacobiSVD<Jacobian> svd(Ja, Eigen::ComputeFullU | Eigen::ComputeFullV);
+        const auto & sv = svd.singularValues();
+
+        Eigen::Matrix<double, 5, 6> Sinv = Eigen::Matrix<double, 5, 6>::Zero();
+
+        for (int i = 0; i < sv.size(); i++)
+        {
+            if (sv(i) > tol)
+            {
+                Sinv(i, i) = 1.0 / sv(i);
+            }
+        }
+
+        return svd.matrixV() * Sinv * svd.matrixU().transpose();
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -201,11 +165,11 @@ int AsibotSolver::getNumTcps()
 
 bool AsibotSolver::appendLink(const std::vector<double> &x)
 {
-    yarp::sig::Matrix newFrame = vectorToMatrix(x, true);
+    KDL::Frame newFrame = KdlVectorConverter::vectorToFrame(x.data());
 
     AsibotTcpFrame tcpFrameStruct = getTcpFrame();
     tcpFrameStruct.hasFrame = true;
-    tcpFrameStruct.frameTcp *= newFrame;
+    tcpFrameStruct.frameTcp = tcpFrameStruct.frameTcp * newFrame;
     setTcpFrame(tcpFrameStruct);
 
     return true;
@@ -217,7 +181,7 @@ bool AsibotSolver::restoreOriginalChain()
 {
     AsibotTcpFrame tcpFrameStruct = getTcpFrame();
     tcpFrameStruct.hasFrame = false;
-    tcpFrameStruct.frameTcp = yarp::math::eye(4);
+    tcpFrameStruct.frameTcp = KDL::Frame::Identity();
     setTcpFrame(tcpFrameStruct);
     return true;
 }
@@ -226,11 +190,12 @@ bool AsibotSolver::restoreOriginalChain()
 
 bool AsibotSolver::changeOrigin(const std::vector<double> &x_old_obj, const std::vector<double> &x_new_old, std::vector<double> &x_new_obj)
 {
-    yarp::sig::Matrix H_old_obj = vectorToMatrix(x_old_obj, true);
-    yarp::sig::Matrix H_new_old = vectorToMatrix(x_new_old, true);
-    yarp::sig::Matrix H_new_obj = H_new_old * H_old_obj;
+    KDL::Frame H_old_obj = KdlVectorConverter::vectorToFrame(x_old_obj.data());
+    KDL::Frame H_new_old = KdlVectorConverter::vectorToFrame(x_new_old.data());
+    KDL::Frame H_new_obj = H_new_old * H_old_obj;
 
-    matrixToVector(H_new_obj, x_new_obj, true);
+    x_new_obj.resize(6);
+    KdlVectorConverter::frameToVector(H_new_obj, x_new_obj.data());
 
     return true;
 }
@@ -239,11 +204,11 @@ bool AsibotSolver::changeOrigin(const std::vector<double> &x_old_obj, const std:
 
 bool AsibotSolver::fwdKin(const std::vector<double> &q, std::vector<double> &x)
 {
-    std::vector<double> qInRad(q);
+    double qInRad[5];
 
-    for (auto & val : qInRad)
+    for (int i = 0; i < 5; i++)
     {
-        val = degToRad(val);
+        qInRad[i] = degToRad(q[i]);
     }
 
     double s1 = std::sin(qInRad[0]);
@@ -276,8 +241,8 @@ bool AsibotSolver::fwdKin(const std::vector<double> &q, std::vector<double> &x)
 
     if (tcpFrameStruct.hasFrame)
     {
-        yarp::sig::Matrix H_base_tcp = vectorToMatrix(x, true) * tcpFrameStruct.frameTcp;
-        matrixToVector(H_base_tcp, x, true);
+        KDL::Frame H_base_tcp = KdlVectorConverter::vectorToFrame(x.data()) * tcpFrameStruct.frameTcp;
+        KdlVectorConverter::frameToVector(H_base_tcp, x.data());
     }
 
     return true;
@@ -293,14 +258,13 @@ bool AsibotSolver::poseDiff(const std::vector<double> &xLhs, const std::vector<d
     xOut[1] = xLhs[1] - xRhs[1];
     xOut[2] = xLhs[2] - xRhs[2];
 
-    yarp::sig::Matrix rotLhs = vectorToMatrix(xLhs, true).submatrix(0, 2, 0, 2);
-    yarp::sig::Matrix rotRhs = vectorToMatrix(xRhs, true).submatrix(0, 2, 0, 2);
+    KDL::Rotation rotLhs = KdlVectorConverter::vectorToFrame(xLhs.data()).M;
+    KDL::Rotation rotRhs = KdlVectorConverter::vectorToFrame(xRhs.data()).M;
 
-    yarp::sig::Matrix rotRhsToLhs = rotRhs.transposed() * rotLhs;
+    KDL::Rotation rotRhsToLhs = rotRhs.Inverse() * rotLhs;
 
-    yarp::sig::Vector axisAngle = yarp::math::dcm2axis(rotRhsToLhs);
-    yarp::sig::Vector axis = axisAngle.subVector(0, 2) * axisAngle[3];
-    yarp::sig::Vector rotd = rotRhs * axis;
+    KDL::Vector axis = rotRhsToLhs.GetRot(); // scaled by the rotation angle
+    KDL::Vector rotd = rotRhs * axis;
 
     xOut[3] = rotd[0];
     xOut[4] = rotd[1];
@@ -335,8 +299,8 @@ bool AsibotSolver::invKin(const std::vector<double> &xd, const std::vector<doubl
 
     if (tcpFrameStruct.hasFrame)
     {
-        yarp::sig::Matrix H_0_N = vectorToMatrix(xd_base_obj, true) * yarp::math::luinv(tcpFrameStruct.frameTcp);
-        matrixToVector(H_0_N, xd_base_obj, true);
+        KDL::Frame H_0_N = KdlVectorConverter::vectorToFrame(xd_base_obj.data()) * tcpFrameStruct.frameTcp.Inverse();
+        KdlVectorConverter::frameToVector(H_0_N, xd_base_obj.data());
     }
 
     std::vector<double> xd_eYZ;
@@ -391,28 +355,19 @@ bool AsibotSolver::invKin(const std::vector<double> &xd, const std::vector<doubl
     double t3uRad = oyPdRad - t1uRad - t2Rad;
     double t3dRad = oyPdRad - t1dRad + t2Rad;
 
-    std::unique_ptr<AsibotConfiguration> conf(getConfiguration());
-
-    if (!conf->configure(radToDeg(ozdRad),
+    if (!conf->findOptimalConfiguration(radToDeg(ozdRad),
             radToDeg(t1uRad),
             radToDeg(t1dRad),
             radToDeg(t2Rad),
             radToDeg(t3uRad),
             radToDeg(t3dRad),
-            radToDeg(xd_eYZ[4])))
+            radToDeg(xd_eYZ[4]),
+            qGuess, q))
     {
         yCError(ASIBOT) << "Unable to find a valid configuration within joint limits";
         return false;
     }
 
-    if (!conf->findOptimalConfiguration(qGuess))
-    {
-        yCError(ASIBOT) << "findOptimalConfiguration() failed";
-        return false;
-    }
-
-    conf->retrieveAngles(q);
-
     return true;
 }
 
@@ -421,14 +376,14 @@ bool AsibotSolver::invKin(const std::vector<double> &xd, const std::vector<doubl
 bool AsibotSolver::diffInvKin(const std::vector<double> &q, const std::vector<double> &xdot, std::vector<double> &qdot,
         const reference_frame frame)
 {
-    std::vector<double> qInRad(q);
+    double qInRad[5];
 
-    for (auto & val : qInRad)
+    for (int i = 0; i < 5; i++)
     {
-        val = degToRad(val);
+        qInRad[i] = degToRad(q[i]);
     }
 
-    yarp::sig::Matrix Ja(6, 5);
+    Jacobian Ja;
 
     if (frame == BASE_FRAME)
     {
@@ -451,27 +406,36 @@ bool AsibotSolver::diffInvKin(const std::vector<double> &q, const std::vector<do
         std::vector<double> x;
         fwdKin(q, x);
 
-        yarp::sig::Matrix R_0_N = vectorToMatrix(x, true).submatrix(0, 2, 0, 2);
-        yarp::sig::Vector transl = tcpFrameStruct.frameTcp.subcol(0, 3, 3);
-        yarp::sig::Matrix skewSM = yarp::math::crossProductMatrix(transl);
-        yarp::sig::Matrix similTransform = (-1) * R_0_N * skewSM * R_0_N.transposed();
+        KDL::Rotation R_0_N = KdlVectorConverter::vectorToFrame(x.data()).M;
+        const KDL::Vector & transl = tcpFrameStruct.frameTcp.p;
+
+        Eigen::Matrix3d R;
+        Eigen::Matrix3d skewSM;
+
+        R << R_0_N(0, 0), R_0_N(0, 1), R_0_N(0, 2),
+             R_0_N(1, 0), R_0_N(1, 1), R_0_N(1, 2),
+             R_0_N(2, 0), R_0_N(2, 1), R_0_N(2, 2);
+
+        skewSM <<          0, -transl.z(),  transl.y(),
+                  transl.z(),           0, -transl.x(),
+                 -transl.y(),  transl.x(),           0;
 
-        yarp::sig::Matrix S = yarp::math::eye(6);
-        S.setSubmatrix(similTransform, 0, 3);
+        Eigen::Matrix<double, 6, 6> S = Eigen::Matrix<double, 6, 6>::Identity();
+        S.block<3, 3>(0, 3) = -R * skewSM * R.transpose();
 
         Ja = S * Ja;
     }
 
-    yarp::sig::Matrix Ja_inv = yarp::math::pinv(Ja, 1e-2);
+    Eigen::Matrix<double, 5, 6> Ja_inv = pinv(Ja, 1e-2);
 
-    yarp::sig::Vector xdotv(6);
+    Eigen::Matrix<double, 6, 1> xdotv = Eigen::Matrix<double, 6, 1>::Zero();
 
-    for (unsigned int i = 0; i < xdot.size(); i++)
+    for (unsigned int i = 0; i < xdot.size() && i < 6; i++)
     {
         xdotv[i] = xdot[i];
     }
 
-    yarp::sig::Vector qdotv = Ja_inv * xdotv;
+    Eigen::Matrix<double, 5, 1> qdotv = Ja_inv * xdotv;
 
     qdot.resize(5);
 
@@ -3,6 +3,9 @@
 #ifndef __TRAJ_GEN_HPP__
 #define __TRAJ_GEN_HPP__
 
+#include <cmath>
+#include <algorithm>
+
 #include <yarp/os/Log.h>
 
 /**
@@ -35,6 +38,94 @@ public:
     virtual bool maxAccBelow(const double thresAcc) const = 0;
     virtual double getT() const = 0;
     virtual void dump(double samples) const = 0;
+
+    /**
+     * Evaluate the trajectory on an evenly spaced time grid, i.e. at instants t0 + k * dt
+     * for k = 0...n-1, and store the results in contiguous arrays of n elements each.
+     * Null output pointers are skipped.
+     */
+    virtual void sample(const double t0, const double dt, const int n, double * x, double * xdot, double * xdotdot) const
+    {
+        for (int k = 0; k < n; k++)
+        {
+            const double ti = t0 + k * dt;
+            if (x) x[k] = get(ti);
+            if (xdot) xdot[k] = getdot(ti);
+            if (xdotdot) xdotdot[k] = getdotdot(ti);
+        }
+    }
+
+protected:
+    /**
+     * Find the real roots of c2 * s^2 + c1 * s + c0 (lower order if leading coefficients vanish).
+     * @return number of roots stored in the output array.
+     */
+    static int quadraticRoots(const double c2, const double c1, const double c0, double * roots)
+    {
+        const double scale = std::max(std::abs(c2), std::max(std::abs(c1), std::abs(c0)));
+
+        if (std::abs(c2) <= 1e-12 * scale)
+        {
+            if (std::abs(c1) <= 1e-12 * scale)
+            {
+                return 0;
+            }
+
+            roots[0] = -c0 / c1;
+            return 1;
+        }
+
+        const double disc = c1 * c1 - 4 * c2 * c0;
+
+        if (disc < 0)
+        {
+            return 0;
+        }
+
+        const double sq = std::sqrt(disc);
+        roots[0] = (-c1 - sq) / (2 * c2);
+        roots[1] = (-c1 + sq) / (2 * c2);
+        return 2;
+    }
+
+    /**
+     * Find the real roots of c3 * s^3 + c2 * s^2 + c1 * s + c0 (lower order if leading coefficients vanish).
+     * @return number of roots stored in the output array.
+     */
+    static int cubicRoots(const double c3, const double c2, const double c1, const double c0, double * roots)
+    {
+        const double scale = std::max(std::max(std::abs(c3), std::abs(c2)), std::max(std::abs(c1), std::abs(c0)));
+
+        if (std::abs(c3) <= 1e-12 * scale)
+        {
+            return quadraticRoots(c2, c1, c0, roots);
+        }
+
+        // depressed cubic: s = y - a / 3, y^3 + p * y + q = 0
+        const double a = c2 / c3, b = c1 / c3, c = c0 / c3;
+        const double p = b - a * a / 3;
+        const double q = 2 * a * a * a / 27 - a * b / 3 + c;
+        const double disc = q * q / 4 + p * p * p / 27;
+        const double shift = -a / 3;
+
+        if (disc > 0 || p == 0)
+        {
+            const double sq = std::sqrt(std::max(disc, 0.0));
+            roots[0] = std::cbrt(-q / 2 + sq) + std::cbrt(-q / 2 - sq) + shift;
+            return 1;
+        }
+
+        // three real roots, trigonometric method
+        const double r = 2 * std::sqrt(-p / 3);
+        const double phi = std::acos(std::min(1.0, std::max(-1.0, 3 * q / (p * r)))) / 3;
+
+        for (int k = 0; k < 3; k++)
+        {
+            roots[k] = r * std::cos(phi - 2 * k * std::acos(-1.0) / 3) + shift;
+        }
+
+        return 3;
+    }
 };
 
 /**
@@ -77,7 +168,7 @@ public:
 
     bool maxVelBelow(const double thresVel) const
     {
-        return m < thresVel;
+        return std::abs(m) < thresVel;
     }
 
     bool maxAccBelow(const double thresAcc) const
@@ -98,6 +189,16 @@ public:
         }
     }
 
+    void sample(const double t0, const double dt, const int n, double * x, double * xdot, double * xdotdot) const
+    {
+        for (int k = 0; k < n; k++)
+        {
+            if (x) x[k] = b + m * (t0 + k * dt);
+            if (xdot) xdot[k] = m;
+            if (xdotdot) xdotdot[k] = 0;
+        }
+    }
+
 private:
     double T, m, b;
 };
@@ -175,19 +276,33 @@ public:
     }
 
     /**
-     * Check if the maximum of the first derivative is below a certain threshold.
+     * Check if the maximum magnitude of the first derivative is below a certain threshold.
+     * Evaluated at both ends and at the vertex of the parabola, if it lies in between.
      */
     bool maxVelBelow(const double thresVel) const
     {
-        return getdot(T / 2) < thresVel;
+        double maxVel = std::max(std::abs(getdot(0)), std::abs(getdot(T)));
+
+        if (a3 != 0)
+        {
+            const double tv = -a2 / (3 * a3);
+
+            if (tv > 0 && tv < T)
+            {
+                maxVel = std::max(maxVel, std::abs(getdot(tv)));
+            }
+        }
+
+        return maxVel < thresVel;
     }
 
     /**
-     * Check if the maximum of the second derivative is below a certain threshold.
+     * Check if the maximum magnitude of the second derivative is below a certain threshold.
+     * The second derivative is linear, hence attains its extrema at both ends.
      */
     bool maxAccBelow(const double thresAcc) const
     {
-        return getdotdot(T / 2) < thresAcc;
+        return std::max(std::abs(getdotdot(0)), std::abs(getdotdot(T))) < thresAcc;
     }
 
     /**
@@ -210,9 +325,457 @@ public:
         }
     }
 
+    void sample(const double t0, const double dt, const int n, double * x, double * xdot, double * xdotdot) const
+    {
+        for (int k = 0; k < n; k++)
+        {
+            const double ti = std::min(t0 + k * dt, T);  // Security hack
+            if (x) x[k] = ((a3 * ti + a2) * ti + a1) * ti + a0;
+            if (xdot) xdot[k] = (3 * a3 * ti + 2 * a2) * ti + a1;
+            if (xdotdot) xdotdot[k] = 6 * a3 * ti + 2 * a2;
+        }
+    }
+
 private:
     double a3, a2, a1, a0, T;
 };
 
+/**
+ * @ingroup TrajGen
+ *
+ * @brief Generates a 1DOF order-five trajectory.
+ *
+ * Continuous acceleration at both ends, which avoids the initial and final jerk spikes
+ * of OrderThreeTraj.
+ */
+class OrderFiveTraj : public Traj
+{
+public:
+    OrderFiveTraj() : a5(0.0), a4(0.0), a3(0.0), a2(0.0), a1(0.0), a0(0.0), T(0.0) {}
+
+    /**
+     * Configure the trajectory. Forces null initial and final velocities and accelerations.
+     */
+    bool configure(const double xi, const double xf, const double _T)
+    {
+        return configure(xi, xf, 0.0, 0.0, 0.0, 0.0, _T);
+    }
+
+    /**
+     * Configure the trajectory setting an initial and final velocity too (warning: possible overshoot).
+     * Forces null initial and final accelerations.
+     */
+    bool configure(const double xi, const double xf, const double xdoti, const double xdotf, const double _T)
+    {
+        return configure(xi, xf, xdoti, xdotf, 0.0, 0.0, _T);
+    }
+
+    /**
+     * Configure the trajectory setting initial and final velocities and accelerations (warning: possible overshoot).
+     */
+    bool configure(const double xi, const double xf, const double xdoti, const double xdotf,
+                   const double xdotdoti, const double xdotdotf, const double _T)
+    {
+        T = _T;
+        const double h = xf - xi;
+        const double T2 = T * T;
+        a0 = xi;
+        a1 = xdoti;
+        a2 = xdotdoti / 2;
+        a3 = (20 * h - (8 * xdotf + 12 * xdoti) * T - (3 * xdotdoti - xdotdotf) * T2) / (2 * T2 * T);
+        a4 = (-30 * h + (14 * xdotf + 16 * xdoti) * T + (3 * xdotdoti - 2 * xdotdotf) * T2) / (2 * T2 * T2);
+        a5 = (12 * h - 6 * (xdotf + xdoti) * T - (xdotdoti - xdotdotf) * T2) / (2 * T2 * T2 * T);
+        return true;
+    }
+
+    /**
+     * @return the value of the function at instant ti.
+     */
+    double get(const double ti) const
+    {
+        const double t = std::min(ti, T);  // Security hack
+        return ((((a5 * t + a4) * t + a3) * t + a2) * t + a1) * t + a0;
+    }
+
+    /**
+     * @return the value of the first derivative of the function at instant ti.
+     */
+    double getdot(const double ti) const
+    {
+        const double t = std::min(ti, T);  // Security hack
+        return (((5 * a5 * t + 4 * a4) * t + 3 * a3) * t + 2 * a2) * t + a1;
+    }
+
+    /**
+     * @return the value of the second derivative of the function at instant ti.
+     */
+    double getdotdot(const double ti) const
+    {
+        const double t = std::min(ti, T);  // Security hack
+        return ((20 * a5 * t + 12 * a4) * t + 6 * a3) * t + 2 * a2;
+    }
+
+    /**
+     * Check if the maximum magnitude of the first derivative is below a certain threshold.
+     * Evaluated at both ends and at the roots of the second derivative in between.
+     */
+    bool maxVelBelow(const double thresVel) const
+    {
+        // second derivative in normalized time s = t / T
+        double roots[3];
+        const int n = cubicRoots(20 * a5 * T * T * T, 12 * a4 * T * T, 6 * a3 * T, 2 * a2, roots);
+        double maxVel = std::max(std::abs(getdot(0)), std::abs(getdot(T)));
+
+        for (int i = 0; i < n; i++)
+        {
+            if (roots[i] > 0 && roots[i] < 1)
+            {
+                maxVel = std::max(maxVel, std::abs(getdot(roots[i] * T)));
+            }
+        }
+
+        return maxVel < thresVel;
+    }
+
+    /**
+     * Check if the maximum magnitude of the second derivative is below a certain threshold.
+     * Evaluated at both ends and at the roots of the third derivative in between.
+     */
+    bool maxAccBelow(const double thresAcc) const
+    {
+        // third derivative in normalized time s = t / T
+        double roots[2];
+        const int n = quadraticRoots(60 * a5 * T * T, 24 * a4 * T, 6 * a3, roots);
+        double maxAcc = std::max(std::abs(getdotdot(0)), std::abs(getdotdot(T)));
+
+        for (int i = 0; i < n; i++)
+        {
+            if (roots[i] > 0 && roots[i] < 1)
+            {
+                maxAcc = std::max(maxAcc, std::abs(getdotdot(roots[i] * T)));
+            }
+        }
+
+        return maxAcc < thresAcc;
+    }
+
+    /**
+     * @return duration assigned to the trajectory instance.
+     */
+    double getT() const
+    {
+        return T;
+    }
+
+    /**
+     * Printf of ti, f(ti), fdot(ti), fdotdot(ti) for whole duration interval.
+     * @param samples number of lines to print.
+     */
+    void dump(double samples) const
+    {
+        for (double i = 0; i < T; i += (T / samples))
+        {
+            yInfo("%05.2f %+02.6f %+02.6f %+02.6f", i, get(i), getdot(i), getdotdot(i));
+        }
+    }
+
+    void sample(const double t0, const double dt, const int n, double * x, double * xdot, double * xdotdot) const
+    {
+        for (int k = 0; k < n; k++)
+        {
+            const double t = std::min(t0 + k * dt, T);  // Security hack
+            if (x) x[k] = ((((a5 * t + a4) * t + a3) * t + a2) * t + a1) * t + a0;
+            if (xdot) xdot[k] = (((5 * a5 * t + 4 * a4) * t + 3 * a3) * t + 2 * a2) * t + a1;
+            if (xdotdot) xdotdot[k] = ((20 * a5 * t + 12 * a4) * t + 6 * a3) * t + 2 * a2;
+        }
+    }
+
+private:
+    double a5, a4, a3, a2, a1, a0, T;
+};
+
+/**
+ * @ingroup TrajGen
+ *
+ * @brief Generates a 1DOF jerk-limited (seven-segment, S-curve) trajectory.
+ *
+ * Starts and ends at rest. Jerk is piecewise constant and bounded, acceleration and
+ * velocity are bounded too; the cruise velocity is lowered so that the motion lasts
+ * exactly as long as requested.
+ */
+class JerkLimitedTraj : public Traj
+{
+public:
+    /**
+     * @param _maxVel velocity limit (positive).
+     * @param _maxAcc acceleration limit (positive).
+     * @param _maxJerk jerk limit (positive).
+     */
+    JerkLimitedTraj(const double _maxVel, const double _maxAcc, const double _maxJerk)
+        : maxVel(_maxVel), maxAcc(_maxAcc), maxJerk(_maxJerk),
+          x0(0.0), D(0.0), dir(1.0), vPeak(0.0), aPeak(0.0), Tj(0.0), Ta(0.0), Tv(0.0), T(0.0)
+    {}
+
+    /**
+     * Configure the shortest trajectory that complies with the limits.
+     */
+    bool configure(const double xi, const double xf)
+    {
+        if (!setDistance(xi, xf))
+        {
+            return false;
+        }
+
+        setProfile(getReachableVel());
+        return true;
+    }
+
+    /**
+     * Configure the trajectory. Fails if the given duration is too short to comply with the limits.
+     */
+    bool configure(const double xi, const double xf, const double _T)
+    {
+        if (!setDistance(xi, xf) || _T <= 0)
+        {
+            return false;
+        }
+
+        if (D == 0)
+        {
+            setProfile(0.0);
+            Tv = T = _T;
+            return true;
+        }
+
+        double lo = 0.0, hi = getReachableVel();
+
+        if (getDuration(hi) > _T * (1 + 1e-9))
+        {
+            return false;
+        }
+
+        // duration strictly decreases with the cruise velocity
+        for (int i = 0; i < 100; i++)
+        {
+            const double mid = (lo + hi) / 2;
+
+            if (getDuration(mid) > _T)
+            {
+                lo = mid;
+            }
+            else
+            {
+                hi = mid;
+            }
+        }
+
+        setProfile(hi);
+        return true;
+    }
+
+    /**
+     * Initial and final velocities other than zero are not supported.
+     */
+    bool configure(const double xi, const double xf, const double xdoti, const double xdotf, const double _T)
+    {
+        return xdoti == 0 && xdotf == 0 && configure(xi, xf, _T);
+    }
+
+    /**
+     * @return the value of the function at instant ti.
+     */
+    double get(const double ti) const
+    {
+        double x, xdot, xdotdot;
+        evaluate(ti, x, xdot, xdotdot);
+        return x;
+    }
+
+    /**
+     * @return the value of the first derivative of the function at instant ti.
+     */
+    double getdot(const double ti) const
+    {
+        double x, xdot, xdotdot;
+        evaluate(ti, x, xdot, xdotdot);
+        return xdot;
+    }
+
+    /**
+     * @return the value of the second derivative of the function at instant ti.
+     */
+    double getdotdot(const double ti) const
+    {
+        double x, xdot, xdotdot;
+        evaluate(ti, x, xdot, xdotdot);
+        return xdotdot;
+    }
+
+    /**
+     * Check if the maximum magnitude of the first derivative (cruise velocity) is below a certain threshold.
+     */
+    bool maxVelBelow(const double thresVel) const
+    {
+        return vPeak < thresVel;
+    }
+
+    /**
+     * Check if the maximum magnitude of the second derivative is below a certain threshold.
+     */
+    bool maxAccBelow(const double thresAcc) const
+    {
+        return aPeak < thresAcc;
+    }
+
+    /**
+     * @return duration assigned to the trajectory instance.
+     */
+    double getT() const
+    {
+        return T;
+    }
+
+    /**
+     * Printf of ti, f(ti), fdot(ti), fdotdot(ti) for whole duration interval.
+     * @param samples number of lines to print.
+     */
+    void dump(double samples) const
+    {
+        for (double i = 0; i < T; i += (T / samples))
+        {
+            yInfo("%05.2f %+02.6f %+02.6f %+02.6f", i, get(i), getdot(i), getdotdot(i));
+        }
+    }
+
+    void sample(const double t0, const double dt, const int n, double * x, double * xdot, double * xdotdot) const
+    {
+        double p, v, a;
+
+        for (int k = 0; k < n; k++)
+        {
+            evaluate(t0 + k * dt, p, v, a);
+            if (x) x[k] = p;
+            if (xdot) xdot[k] = v;
+            if (xdotdot) xdotdot[k] = a;
+        }
+    }
+
+private:
+    bool setDistance(const double xi, const double xf)
+    {
+        if (maxVel <= 0 || maxAcc <= 0 || maxJerk <= 0)
+        {
+            return false;
+        }
+
+        x0 = xi;
+        D = std::abs(xf - xi);
+        dir = xf < xi ? -1.0 : 1.0;
+        return true;
+    }
+
+    /**
+     * Highest cruise velocity within limits such that the acceleration and deceleration phases fit the distance.
+     */
+    double getReachableVel() const
+    {
+        // acceleration limit is reached
+        double v = maxAcc / 2 * (std::sqrt(maxAcc * maxAcc / (maxJerk * maxJerk) + 4 * D / maxAcc) - maxAcc / maxJerk);
+
+        if (v * maxJerk < maxAcc * maxAcc)
+        {
+            // acceleration limit is not reached
+            v = std::cbrt(D * D * maxJerk / 4);
+        }
+
+        return std::min(v, maxVel);
+    }
+
+    /**
+     * Duration of an acceleration phase from rest to velocity v.
+     */
+    double getAccelerationTime(const double v) const
+    {
+        return v * maxJerk >= maxAcc * maxAcc ? v / maxAcc + maxAcc / maxJerk : 2 * std::sqrt(v / maxJerk);
+    }
+
+    /**
+     * Total duration given a cruise velocity v.
+     */
+    double getDuration(const double v) const
+    {
+        return getAccelerationTime(v) + D / v;
+    }
+
+    void setProfile(const double v)
+    {
+        vPeak = v;
+        aPeak = std::min(maxAcc, std::sqrt(v * maxJerk));
+        Tj = aPeak / maxJerk;
+        Ta = v != 0 ? getAccelerationTime(v) : 0.0;
+        Tv = v != 0 ? std::max(D / v - Ta, 0.0) : 0.0;
+        T = 2 * Ta + Tv;
+    }
+
+    /**
+     * Acceleration phase from rest, tau in [0, Ta].
+     */
+    void accelerate(const double tau, double & p, double & v, double & a) const
+    {
+        if (tau < Tj)
+        {
+            a = maxJerk * tau;
+            v = a * tau / 2;
+            p = v * tau / 3;
+        }
+        else if (tau < Ta - Tj)
+        {
+            const double dt = tau - Tj;
+            const double v1 = aPeak * Tj / 2;
+            a = aPeak;
+            v = v1 + aPeak * dt;
+            p = v1 * Tj / 3 + v1 * dt + aPeak * dt * dt / 2;
+        }
+        else
+        {
+            const double s = Ta - tau;
+            a = maxJerk * s;
+            v = vPeak - a * s / 2;
+            p = vPeak * Ta / 2 - vPeak * s + a * s * s / 6;
+        }
+    }
+
+    void evaluate(const double ti, double & p, double & v, double & a) const
+    {
+        const double t = std::min(std::max(ti, 0.0), T);  // Security hack
+
+        if (t < Ta)
+        {
+            accelerate(t, p, v, a);
+        }
+        else if (t < Ta + Tv)
+        {
+            p = vPeak * Ta / 2 + vPeak * (t - Ta);
+            v = vPeak;
+            a = 0;
+        }
+        else
+        {
+            // deceleration phase mirrors the acceleration phase
+            accelerate(T - t, p, v, a);
+            p = D - p;
+            a = -a;
+        }
+
+        p = x0 + dir * p;
+        v *= dir;
+        a *= dir;
+    }
+
+    double maxVel, maxAcc, maxJerk;
+    double x0, D, dir;
+    double vPeak, aPeak, Tj, Ta, Tv, T;
+};
+
 #endif  // __TRAJ_GEN_HPP__
 
@@ -8,8 +8,11 @@
 
 #include <yarp/os/Bottle.h>
 #include <yarp/os/LogStream.h>
+#include <yarp/os/Time.h>
 #include <yarp/os/Vocab.h>
 
+#include "JointPathSolver.hpp"
+#include "KdlVectorConverter.hpp"
 #include "LogComponent.hpp"
 
 using namespace roboticslab;
@@ -28,6 +31,7 @@ namespace
 }
 
 constexpr double epsilon = 1e-5;
+constexpr int timeOptimalGridPoints = 101;
 
 // -----------------------------------------------------------------------------
 
@@ -124,7 +128,9 @@ bool BasicCartesianControl::checkJointVelocities(const std::vector<double> &qdot
 
 bool BasicCartesianControl::checkControlModes(int mode)
 {
-    std::vector<int> modes(numRobotJoints);
+    // called on every CMC iteration, but also from streaming commands
+    thread_local std::vector<int> modes;
+    modes.resize(numRobotJoints);
 
     if (!iControlMode->getControlModes(modes.data()))
     {
@@ -180,9 +186,12 @@ bool BasicCartesianControl::presetStreamingCommand(int command)
     switch (command)
     {
     case VOCAB_CC_TWIST:
+        return setControlModes(VOCAB_CM_VELOCITY);
     case VOCAB_CC_POSE:
+        streamTarget.configure(6 * iCartesianSolver->getNumTcps());
         return setControlModes(VOCAB_CM_VELOCITY);
     case VOCAB_CC_MOVI:
+        streamTarget.configure(numRobotJoints);
         return setControlModes(VOCAB_CM_POSITION_DIRECT);
     default:
         yCError(BCC) << "Unrecognized or unsupported streaming command vocab:" << command;
@@ -193,6 +202,132 @@ bool BasicCartesianControl::presetStreamingCommand(int command)
 
 // -----------------------------------------------------------------------------
 
+bool BasicCartesianControl::queueWaypoint(const std::vector<double> & xd)
+{
+    std::vector<double> xd_obj;
+
+    if (referenceFrame == ICartesianSolver::TCP_FRAME)
+    {
+        //-- Relative to the previous waypoint, not to the current position
+        std::vector<double> x_last;
+        waypoints.getLastWaypoint(x_last);
+
+        if (!iCartesianSolver->changeOrigin(xd, x_last, xd_obj))
+        {
+            yCError(BCC) << "changeOrigin() failed";
+            return false;
+        }
+    }
+    else
+    {
+        xd_obj = xd;
+    }
+
+    return waypoints.append(xd_obj, yarp::os::Time::now() - movementStartTime, duration, blendRadius);
+}
+
+// -----------------------------------------------------------------------------
+
+bool BasicCartesianControl::queueJointTarget(const std::vector<double> & xd)
+{
+    //-- Solve from the previous target, not from the current position
+    std::vector<double> qLast, qd;
+    jointTrajectory.getLastTarget(qLast);
+
+    if (!iCartesianSolver->invKin(xd, qLast, qd, referenceFrame))
+    {
+        yCError(BCC) << "invKin() failed";
+        return false;
+    }
+
+    if (!checkJointLimits(qd))
+    {
+        yCError(BCC) << "Target out of joint limits";
+        return false;
+    }
+
+    return jointTrajectory.append(qd, yarp::os::Time::now() - movementStartTime);
+}
+
+// -----------------------------------------------------------------------------
+
+bool BasicCartesianControl::movjDirectly(const std::vector<double> & xd)
+{
+    if (getCurrentState() == VOCAB_CC_MOVJ_CONTROLLING)
+    {
+        //-- Append to the ongoing motion, the CMC thread picks it up once the previous target is reached
+        if (queueJointTarget(xd))
+        {
+            return true;
+        }
+
+        if (!jointTrajectory.isClosed())
+        {
+            yCError(BCC) << "Unable to queue joint target";
+            return false;
+        }
+
+        //-- Too late, the last target has just been reached: start anew once the CMC thread stops control
+        while (getCurrentState() == VOCAB_CC_MOVJ_CONTROLLING)
+        {
+            yarp::os::Time::delay(waitPeriodMs / 1000.0);
+        }
+    }
+
+    if (getCurrentState() != VOCAB_CC_NOT_CONTROLLING)
+    {
+        yCError(BCC) << "Unable to start MOVJ while controlling";
+        return false;
+    }
+
+    if (qRefAccelerations.empty())
+    {
+        yCError(BCC) << "Joint acceleration limits not available";
+        return false;
+    }
+
+    std::vector<double> currentQ(numRobotJoints);
+
+    if (!iEncoders->getEncoders(currentQ.data()))
+    {
+        yCError(BCC) << "getEncoders() failed";
+        return false;
+    }
+
+    //-- Jerk bounded by the time it takes to build up the acceleration limit
+    std::vector<double> qdddotMax(qRefAccelerations);
+
+    for (auto & value : qdddotMax)
+    {
+        value /= movjJerkTime;
+    }
+
+    jointTrajectory.reset(currentQ, qRefSpeeds, qRefAccelerations, qdddotMax);
+    movementStartTime = yarp::os::Time::now();
+
+    if (!queueJointTarget(xd))
+    {
+        yCError(BCC) << "Unable to queue joint target";
+        return false;
+    }
+
+    //-- Enter position direct mode, the CMC thread streams the trajectory
+    if (!setControlModes(VOCAB_CM_POSITION_DIRECT))
+    {
+        yCError(BCC) << "Unable to set position direct mode";
+        return false;
+    }
+
+    cmcSuccess = true;
+    yCInfo(BCC) << "Performing MOVJ (streamed)";
+
+    setCurrentState(VOCAB_CC_MOVJ_CONTROLLING);
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
 void BasicCartesianControl::computeIsocronousSpeeds(const std::vector<double> & q, const std::vector<double> & qd,
         std::vector<double> & qdot)
 {
@@ -238,3 +373,170 @@ void BasicCartesianControl::computeIsocronousSpeeds(const std::vector<double> &
 }
 
 // -----------------------------------------------------------------------------
+
+bool BasicCartesianControl::computeTimeOptimalProfile(const std::vector<std::unique_ptr<KDL::Path>> & paths,
+        const std::vector<double> & q, TimeOptimalProfile & profile)
+{
+    if (qRefAccelerations.empty() || qdotMax.empty())
+    {
+        yCError(BCC) << "Joint velocity and acceleration limits not available";
+        return false;
+    }
+
+    //-- Sample the joint path along a common normalized parameter (one path per TCP)
+    std::vector<std::vector<double>> dq(timeOptimalGridPoints);
+    std::vector<std::vector<double>> ddq(timeOptimalGridPoints);
+
+    std::vector<double> x(6 * paths.size());
+    std::vector<double> xdot(6 * paths.size());
+    std::vector<double> qPrev(q), qNext;
+
+    for (int k = 0; k < timeOptimalGridPoints; k++)
+    {
+        const double s = static_cast<double>(k) / (timeOptimalGridPoints - 1);
+
+        for (unsigned int i = 0; i < paths.size(); i++)
+        {
+            const double length = paths[i]->PathLength();
+            KdlVectorConverter::frameToVector(paths[i]->Pos(s * length), x.data() + 6 * i);
+            KdlVectorConverter::twistToVector(paths[i]->Vel(s * length, length), xdot.data() + 6 * i); // d(pose)/ds
+        }
+
+        if (k == 0)
+        {
+            qNext = q;
+        }
+        else if (!iCartesianSolver->invKin(x, qPrev, qNext))
+        {
+            yCError(BCC) << "invKin() failed at path sample" << k;
+            return false;
+        }
+
+        //-- Map the path tangent through the Jacobian
+        if (!iCartesianSolver->diffInvKin(qNext, xdot, dq[k]))
+        {
+            yCError(BCC) << "diffInvKin() failed at path sample" << k;
+            return false;
+        }
+
+        qPrev = qNext;
+    }
+
+    //-- Path curvature in joint space by finite differences
+    const double step = 1.0 / (timeOptimalGridPoints - 1);
+
+    for (int k = 0; k < timeOptimalGridPoints; k++)
+    {
+        const int prev = std::max(k - 1, 0);
+        const int next = std::min(k + 1, timeOptimalGridPoints - 1);
+
+        ddq[k].resize(dq[k].size());
+
+        for (unsigned int joint = 0; joint < dq[k].size(); joint++)
+        {
+            ddq[k][joint] = (dq[next][joint] - dq[prev][joint]) / ((next - prev) * step);
+        }
+    }
+
+    //-- Leave some room for the feedback term of the CMC
+    auto scaled = [this](std::vector<double> limits)
+    {
+        for (auto & value : limits)
+        {
+            value *= timeOptimalScaling;
+        }
+
+        return limits;
+    };
+
+    if (!profile.configure(dq, ddq, scaled(qdotMin), scaled(qdotMax), scaled(qRefAccelerations)))
+    {
+        yCError(BCC) << "Unable to find a feasible timing within joint limits";
+        return false;
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+bool BasicCartesianControl::computeJointPath(const std::vector<double> & q)
+{
+    const int numSamples = trajectory.getNumSamples();
+    const double step = trajectory.getStep();
+
+    if (!jointPath.configure(numSamples, numRobotJoints, step))
+    {
+        yCError(BCC) << "Unable to allocate joint trajectory";
+        return false;
+    }
+
+    //-- Solve in parallel, same result as a sequential pass
+    int failed = solveJointPath(trajectory, ikSolvers, q, jointPath);
+
+    if (failed != -1)
+    {
+        yCError(BCC) << "invKin() failed at trajectory sample" << failed;
+        return false;
+    }
+
+    //-- Validate the whole motion before it starts
+    std::vector<double> qk(numRobotJoints), qdot(numRobotJoints, 0.0);
+
+    for (int k = 0; k < numSamples; k++)
+    {
+        qk.assign(jointPath.row(k), jointPath.row(k) + numRobotJoints);
+
+        if (k + 1 < numSamples)
+        {
+            for (int joint = 0; joint < numRobotJoints; joint++)
+            {
+                qdot[joint] = (jointPath.row(k + 1)[joint] - qk[joint]) / step;
+            }
+        }
+
+        if (!checkJointLimits(qk, qdot) || !checkJointVelocities(qdot))
+        {
+            yCError(BCC) << "Joint trajectory not feasible at" << k * step << "[s]";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+bool BasicCartesianControl::getCmcStat(int vocab, double * value) const
+{
+    std::lock_guard<std::mutex> lock(statsMutex);
+    const double ticks = cmcStats.ticks != 0 ? cmcStats.ticks : 1;
+
+    switch (vocab)
+    {
+    case VOCAB_CC_STATS_TICKS:
+        *value = cmcStats.ticks;
+        break;
+    case VOCAB_CC_STATS_RUN_MEAN:
+        *value = cmcStats.runTimeSum / ticks * 1000.0;
+        break;
+    case VOCAB_CC_STATS_RUN_MAX:
+        *value = cmcStats.runTimeMax * 1000.0;
+        break;
+    case VOCAB_CC_STATS_JITTER_MEAN:
+        *value = cmcStats.jitterSum / ticks * 1000.0;
+        break;
+    case VOCAB_CC_STATS_JITTER_MAX:
+        *value = cmcStats.jitterMax * 1000.0;
+        break;
+    case VOCAB_CC_STATS_OVERRUNS:
+        *value = cmcStats.overruns;
+        break;
+    default:
+        return false;
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
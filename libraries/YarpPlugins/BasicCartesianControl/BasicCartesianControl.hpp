@@ -3,6 +3,9 @@
 #ifndef __BASIC_CARTESIAN_CONTROL_HPP__
 #define __BASIC_CARTESIAN_CONTROL_HPP__
 
+#include <array>
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <vector>
 
@@ -13,10 +16,18 @@
 #include <yarp/dev/ControlBoardInterfaces.h>
 #include <yarp/dev/IPreciselyTimed.h>
 
-#include <kdl/trajectory.hpp>
+#include <kdl/path.hpp>
 
 #include "ICartesianSolver.h"
 #include "ICartesianControl.h"
+#include "JointSpline.hpp"
+#include "JointTrajectory.hpp"
+#include "LatencyHistogram.hpp"
+#include "SampledTrajectory.hpp"
+#include "StreamInterpolator.hpp"
+#include "TimeOptimalProfile.hpp"
+#include "TwistTrajectory.hpp"
+#include "WaypointTrajectory.hpp"
 
 namespace roboticslab
 {
@@ -51,7 +62,7 @@ We connect, can ask for help, etc. Here's an example interaction:
 \verbatim
 [on terminal 3] yarp rpc /CartesianControl/rpc_transform:s
 [>>] help
-Response: [stat] [inv] [movj] [movl] [movv] [gcmp] [forc] [stop]
+Response: [stat] [inv] [movj] [movl] [movv] [movw] [gcmp] [forc] [stop]
 [>>] stat
 Response: [ccnc] 1.0 0.0 0.0 0.0 0.0 1.0 0.0
 \endverbatim
@@ -87,6 +98,16 @@ On the real robot, you can even activate Gravity Compensation (warning: dangerou
 [>>] gcmp
 \endverbatim
 
+@section BasicCartesianControl_RealTime Real-time settings
+
+The control loop (CMC) thread can be set up for deterministic timing on PREEMPT_RT kernels (Linux only):
+\verbatim
+[on terminal 2] yarpdev --device BasicCartesianControl ... --cmcPeriodMs 1 --cmcScheduler fifo --cmcPriority 80 --cmcCpus "(3)" --cmcLockMemory
+\endverbatim
+Use `--cmcScheduler deadline` (optionally with `--cmcRuntimeUs`) for SCHED_DEADLINE; CPU pinning is not allowed in that case.
+Missing privileges (CAP_SYS_NICE, memlock limits) only produce warnings and the thread keeps its default settings,
+pass `--cmcRequireRealTime` to make the device fail to open instead.
+
 @section BasicCartesianControl_Running4 Very Important
 
 When you launch the BasicCartesianControl device as in [terminal 2], it's actually wrapped: CartesianControlServer is the device that is
@@ -115,6 +136,7 @@ public:
     bool relj(const std::vector<double> & xd) override;
     bool movl(const std::vector<double> & xd) override;
     bool movv(const std::vector<double> & xdotd) override;
+    bool movw(const std::vector<double> & xd) override;
     bool gcmp() override;
     bool forc(const std::vector<double> & td) override;
     bool stopControl() override;
@@ -128,8 +150,11 @@ public:
     bool getParameter(int vocab, double * value) override;
     bool setParameters(const std::map<int, double> & params) override;
     bool getParameters(std::map<int, double> & params) override;
+    bool getLatencyStats(std::map<int, std::vector<double>> & stats) override;
+    bool resetLatencyStats() override;
 
     // -------- PeriodicThread declarations. Implementation in PeriodicThreadImpl.cpp --------
+    bool threadInit() override;
     void run() override;
 
     // -------- DeviceDriver declarations. Implementation in IDeviceImpl.cpp --------
@@ -147,17 +172,39 @@ protected:
     bool checkControlModes(int mode);
     bool setControlModes(int mode);
     bool presetStreamingCommand(int command);
+    bool queueWaypoint(const std::vector<double> & xd);
+    bool queueJointTarget(const std::vector<double> & xd);
+    bool movjDirectly(const std::vector<double> & xd);
     void computeIsocronousSpeeds(const std::vector<double> & q, const std::vector<double> & qd, std::vector<double> & qdot);
+    bool computeTimeOptimalProfile(const std::vector<std::unique_ptr<KDL::Path>> & paths, const std::vector<double> & q,
+                                   TimeOptimalProfile & profile);
+    bool computeJointPath(const std::vector<double> & q);
 
+    void handleCurrentState();
     void handleMovj(const std::vector<double> & q);
+    void handleMovjDirect(const std::vector<double> & q);
     void handleMovl(const std::vector<double> & q);
+    void handleMovlDirect(const std::vector<double> & q);
     void handleMovv(const std::vector<double> & q);
+    void handleMovw(const std::vector<double> & q);
     void handleGcmp(const std::vector<double> & q);
     void handleForc(const std::vector<double> & q);
+    void handleStreaming();
+    void handlePoseStream(const std::vector<double> & q);
+    void handleMoviStream(const std::vector<double> & q);
+
+    bool applyCmcScheduler();
+
+    void updateCmcStats(double start, double end);
+    bool getCmcStat(int vocab, double * value) const;
 
     yarp::dev::PolyDriver solverDevice;
     ICartesianSolver * iCartesianSolver {nullptr};
 
+    /** MOVL IK workers, each one owns a solver instance (the first one is iCartesianSolver) */
+    std::vector<std::unique_ptr<yarp::dev::PolyDriver>> ikSolverDevices;
+    std::vector<ICartesianSolver *> ikSolvers;
+
     yarp::dev::PolyDriver robotDevice;
     yarp::dev::IControlMode * iControlMode {nullptr};
     yarp::dev::IEncoders * iEncoders {nullptr};
@@ -171,32 +218,92 @@ protected:
 
     double gain;
     double duration; // [s]
+    double blendRadius; // [m]
+    double timeOptimalScaling; // fraction of joint limits, 0 means fixed duration
+    bool movjDirect;
+    double movjJerkTime; // [s]
+    bool movlDirect;
+    bool streamInterpolation;
+    double streamExtrapolation; // [s]
+    double streamTimeout; // [s]
 
     int cmcPeriodMs;
     int waitPeriodMs;
     int numRobotJoints, numSolverJoints;
     int currentState;
-    int streamingCommand;
+    std::atomic<int> streamingCommand; // preset by the client, read by the CMC thread
 
     mutable std::mutex stateMutex;
 
     /** MOVJ store previous reference speeds */
     std::vector<double> vmoStored;
 
+    /** MOVJ queue of jerk-limited joint segments, streamed if movjDirect is set */
+    JointTrajectory jointTrajectory;
+
     /** MOVL keep track of movement start time to know at what time of trajectory movement we are */
     double movementStartTime;
 
-    /** MOVL store Cartesian trajectory */
-    std::vector<std::unique_ptr<KDL::Trajectory>> trajectories;
+    /** MOVL Cartesian trajectory, sampled at the CMC period */
+    SampledTrajectory trajectory;
+
+    /** MOVV constant twist motion, evaluated in closed form */
+    TwistTrajectory twistTrajectory;
+
+    /** MOVL joint positions solved ahead of time on the same grid, streamed if movlDirect is set */
+    JointSpline jointPath;
+
+    /** MOVW queue of blended line segments, appended to while in motion */
+    WaypointTrajectory waypoints;
+
+    /** POSE/MOVI latest streamed target, rendered by the CMC thread if streamInterpolation is set */
+    StreamInterpolator streamTarget;
 
     /** FORC desired Cartesian force */
     std::vector<double> td;
 
     bool cmcSuccess;
 
+    /** CMC buffers, sized on open() and reused on every iteration */
+    std::vector<double> qCmc, commandQ, streamOffset;
+    std::vector<double> desiredX, desiredXdot;
+    std::vector<double> currentX, commandXdot, commandQdot;
+    std::vector<double> commandTorques, zeroQdot;
+    std::vector<std::vector<double>> fexts;
+
+    /** CMC timing statistics, updated at the end of each iteration */
+    struct CmcStats
+    {
+        unsigned int ticks {0};
+        unsigned int overruns {0};
+        double runTimeSum {0.0}, runTimeMax {0.0}; // [s]
+        double jitterSum {0.0}, jitterMax {0.0}; // [s]
+    };
+
+    CmcStats cmcStats;
+    double cmcScheduleOrigin, cmcSchedulePeriod; // [s]
+    mutable std::mutex statsMutex;
+
+    /** Latency histograms per control phase, shared by the CMC thread and streaming commands */
+    enum latency_phase { ENCODERS, FWD_KIN, POSE_DIFF, INV_KIN, CHECKS, SEND, TICK, NUM_PHASES };
+    std::array<LatencyHistogram, NUM_PHASES> latencies;
+
+    /** CMC thread real-time settings, applied on thread startup */
+    enum class cmc_scheduler { OTHER, FIFO, DEADLINE };
+
+    cmc_scheduler cmcScheduler;
+    int cmcPriority;
+    int cmcRuntimeUs;
+    std::vector<int> cmcCpus;
+    bool cmcLockMemory;
+    bool cmcRequireRealTime;
+    double cmcSchedulerPeriod; // period of the current SCHED_DEADLINE reservation [s]
+    double cmcSchedulerAttempt; // period of the last reservation request [s]
+
     std::vector<double> qMin, qMax;
     std::vector<double> qdotMin, qdotMax;
     std::vector<double> qRefSpeeds;
+    std::vector<double> qRefAccelerations;
 };
 
 } // namespace roboticslab
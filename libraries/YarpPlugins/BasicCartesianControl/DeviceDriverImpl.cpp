@@ -2,6 +2,10 @@
 
 #include "BasicCartesianControl.hpp"
 
+#include <algorithm> // std::any_of, std::max, std::min
+#include <limits>
+#include <thread>
+
 #include <yarp/conf/version.h>
 
 #include <yarp/os/LogStream.h>
@@ -14,9 +18,18 @@ constexpr auto DEFAULT_SOLVER = "KdlSolver";
 constexpr auto DEFAULT_ROBOT = "remote_controlboard";
 constexpr auto DEFAULT_GAIN = 0.05;
 constexpr auto DEFAULT_DURATION = 10.0;
+constexpr auto DEFAULT_BLEND_RADIUS = 0.0;
+constexpr auto DEFAULT_TIME_OPTIMAL_SCALING = 0.0;
+constexpr auto DEFAULT_MOVJ_JERK_TIME = 0.1;
+constexpr auto DEFAULT_IK_THREADS = 1;
+constexpr auto DEFAULT_STREAM_EXTRAPOLATION = 0.1;
+constexpr auto DEFAULT_STREAM_TIMEOUT = 0.5;
 constexpr auto DEFAULT_CMC_PERIOD_MS = 50;
 constexpr auto DEFAULT_WAIT_PERIOD_MS = 30;
 constexpr auto DEFAULT_REFERENCE_FRAME = "base";
+constexpr auto DEFAULT_CMC_SCHEDULER = "other";
+constexpr auto DEFAULT_CMC_PRIORITY = 80;
+constexpr auto DEFAULT_CMC_RUNTIME_US = 0;
 
 // ------------------- DeviceDriver Related ------------------------------------
 
@@ -32,12 +45,158 @@ bool BasicCartesianControl::open(yarp::os::Searchable& config)
     duration = config.check("trajectoryDuration", yarp::os::Value(DEFAULT_DURATION),
             "trajectory duration (seconds)").asFloat64();
 
+    blendRadius = config.check("blendRadius", yarp::os::Value(DEFAULT_BLEND_RADIUS),
+            "blend radius of queued waypoints (meters)").asFloat64();
+
+    if (blendRadius < 0.0)
+    {
+        yCError(BCC) << "Blend radius cannot be negative:" << blendRadius;
+        return false;
+    }
+
+    timeOptimalScaling = config.check("timeOptimalScaling", yarp::os::Value(DEFAULT_TIME_OPTIMAL_SCALING),
+            "time-optimal MOVL at this fraction of joint limits (0: fixed trajectory duration)").asFloat64();
+
+    if (timeOptimalScaling < 0.0 || timeOptimalScaling > 1.0)
+    {
+        yCError(BCC) << "Time-optimal scaling must lie in [0, 1]:" << timeOptimalScaling;
+        return false;
+    }
+
+    movjDirect = config.check("movjDirect", yarp::os::Value(false),
+            "stream jerk-limited MOVJ trajectories in position direct mode").asBool();
+
+    movjJerkTime = config.check("movjJerkTime", yarp::os::Value(DEFAULT_MOVJ_JERK_TIME),
+            "time to build up the acceleration limit in streamed MOVJ, bounds jerk (seconds)").asFloat64();
+
+    if (movjJerkTime <= 0.0)
+    {
+        yCError(BCC) << "MOVJ jerk time must be positive:" << movjJerkTime;
+        return false;
+    }
+
+    movlDirect = config.check("movlDirect", yarp::os::Value(false),
+            "solve MOVL joint trajectories ahead of time and stream them in position direct mode").asBool();
+
+    int ikThreads = config.check("ikThreads", yarp::os::Value(DEFAULT_IK_THREADS),
+            "number of threads that solve streamed MOVL trajectories, one solver instance each (0: hardware concurrency)").asInt32();
+
+    if (ikThreads < 0)
+    {
+        yCError(BCC) << "Illegal number of IK threads:" << ikThreads;
+        return false;
+    }
+
+    streamInterpolation = config.check("streamInterpolation", yarp::os::Value(false),
+            "render pose and movi streams at the CMC rate instead of acting once per message").asBool();
+
+    streamExtrapolation = config.check("streamExtrapolation", yarp::os::Value(DEFAULT_STREAM_EXTRAPOLATION),
+            "maximum time to extrapolate past the last streamed target (seconds)").asFloat64();
+
+    if (streamExtrapolation < 0.0)
+    {
+        yCError(BCC) << "Stream extrapolation time cannot be negative:" << streamExtrapolation;
+        return false;
+    }
+
+    streamTarget.setMaxExtrapolation(streamExtrapolation);
+
+    streamTimeout = config.check("streamTimeout", yarp::os::Value(DEFAULT_STREAM_TIMEOUT),
+            "longest interval between streamed targets before the stream is regarded as paused (seconds)").asFloat64();
+
+    if (streamTimeout < 0.0)
+    {
+        yCError(BCC) << "Stream timeout cannot be negative:" << streamTimeout;
+        return false;
+    }
+
+    streamTarget.setMaxInterval(streamTimeout);
+
     cmcPeriodMs = config.check("cmcPeriodMs", yarp::os::Value(DEFAULT_CMC_PERIOD_MS),
             "CMC rate (milliseconds)").asInt32();
 
     waitPeriodMs = config.check("waitPeriodMs", yarp::os::Value(DEFAULT_WAIT_PERIOD_MS),
             "wait command period (milliseconds)").asInt32();
 
+    std::string cmcSchedulerStr = config.check("cmcScheduler", yarp::os::Value(DEFAULT_CMC_SCHEDULER),
+            "CMC thread scheduling policy (other|fifo|deadline)").asString();
+
+    if (cmcSchedulerStr == "other")
+    {
+        cmcScheduler = cmc_scheduler::OTHER;
+    }
+    else if (cmcSchedulerStr == "fifo")
+    {
+        cmcScheduler = cmc_scheduler::FIFO;
+    }
+    else if (cmcSchedulerStr == "deadline")
+    {
+        cmcScheduler = cmc_scheduler::DEADLINE;
+    }
+    else
+    {
+        yCError(BCC) << "Unsupported CMC scheduling policy:" << cmcSchedulerStr;
+        return false;
+    }
+
+    cmcPriority = config.check("cmcPriority", yarp::os::Value(DEFAULT_CMC_PRIORITY),
+            "CMC thread priority for the fifo policy (1-99)").asInt32();
+
+    if (cmcScheduler == cmc_scheduler::FIFO && (cmcPriority < 1 || cmcPriority > 99))
+    {
+        yCError(BCC) << "CMC thread priority out of range:" << cmcPriority;
+        return false;
+    }
+
+    cmcRuntimeUs = config.check("cmcRuntimeUs", yarp::os::Value(DEFAULT_CMC_RUNTIME_US),
+            "CMC runtime budget per period for the deadline policy, half the period if zero (microseconds)").asInt32();
+
+    if (cmcRuntimeUs < 0 || (cmcScheduler == cmc_scheduler::DEADLINE && cmcRuntimeUs > cmcPeriodMs * 1000))
+    {
+        yCError(BCC) << "CMC runtime budget must lie between zero and the CMC period:" << cmcRuntimeUs;
+        return false;
+    }
+
+    cmcCpus.clear();
+
+    if (config.check("cmcCpus", "CPUs the CMC thread is pinned to"))
+    {
+        const auto & cpusValue = config.find("cmcCpus");
+
+        if (cpusValue.isList())
+        {
+            const auto * cpus = cpusValue.asList();
+
+            for (int i = 0; i < cpus->size(); i++)
+            {
+                cmcCpus.push_back(cpus->get(i).asInt32());
+            }
+        }
+        else
+        {
+            cmcCpus.push_back(cpusValue.asInt32());
+        }
+
+        if (std::any_of(cmcCpus.begin(), cmcCpus.end(), [](int cpu) { return cpu < 0; }))
+        {
+            yCError(BCC) << "Illegal CPU index in:" << cpusValue.toString();
+            return false;
+        }
+
+        if (cmcScheduler == cmc_scheduler::DEADLINE)
+        {
+            // the kernel rejects SCHED_DEADLINE on threads whose affinity is narrower than their root domain
+            yCError(BCC) << "CPU pinning is not compatible with the deadline policy, use cpusets instead";
+            return false;
+        }
+    }
+
+    cmcLockMemory = config.check("cmcLockMemory", yarp::os::Value(false),
+            "lock all process memory and prefault the CMC thread stack").asBool();
+
+    cmcRequireRealTime = config.check("cmcRequireRealTime", yarp::os::Value(false),
+            "fail instead of falling back to default scheduling if real-time settings cannot be applied").asBool();
+
     std::string referenceFrameStr = config.check("referenceFrame", yarp::os::Value(DEFAULT_REFERENCE_FRAME),
             "reference frame (base|tcp)").asString();
 
@@ -121,6 +280,14 @@ bool BasicCartesianControl::open(yarp::os::Searchable& config)
         return false;
     }
 
+    qRefAccelerations.resize(numRobotJoints);
+
+    if (!iPositionControl->getRefAccelerations(qRefAccelerations.data()))
+    {
+        yCWarning(BCC) << "Could not retrieve reference accelerations, time-optimal MOVL not available";
+        qRefAccelerations.clear();
+    }
+
     yarp::os::Property solverOptions;
     solverOptions.fromString(config.toString());
     solverOptions.put("device", solverStr);
@@ -183,6 +350,37 @@ bool BasicCartesianControl::open(yarp::os::Searchable& config)
     else
     {
         yCInfo(BCC) << "Using joint limits provided via user configuration";
+
+        const auto * bMin = config.find("mins").asList();
+        const auto * bMax = config.find("maxs").asList();
+        const auto * bMaxVel = config.find("maxvels").asList();
+
+        if (!bMin || !bMax || !bMaxVel)
+        {
+            yCError(BCC) << "Joint limits must be lists";
+            return false;
+        }
+
+        //-- Joints left out of the lists are not limited, null lower speed limits mean symmetric ones
+        qMin.assign(numRobotJoints, -std::numeric_limits<double>::infinity());
+        qMax.assign(numRobotJoints, std::numeric_limits<double>::infinity());
+        qdotMin.assign(numRobotJoints, 0.0);
+        qdotMax.assign(numRobotJoints, std::numeric_limits<double>::infinity());
+
+        for (int joint = 0; joint < std::min<int>(numRobotJoints, bMin->size()); joint++)
+        {
+            qMin[joint] = bMin->get(joint).asFloat64();
+        }
+
+        for (int joint = 0; joint < std::min<int>(numRobotJoints, bMax->size()); joint++)
+        {
+            qMax[joint] = bMax->get(joint).asFloat64();
+        }
+
+        for (int joint = 0; joint < std::min<int>(numRobotJoints, bMaxVel->size()); joint++)
+        {
+            qdotMax[joint] = bMaxVel->get(joint).asFloat64();
+        }
     }
 
     solverOptions.setMonitor(config.getMonitor(), solverStr.c_str());
@@ -199,6 +397,31 @@ bool BasicCartesianControl::open(yarp::os::Searchable& config)
         return false;
     }
 
+    //-- Solvers are not reentrant, give each additional IK worker its own instance
+    int ikWorkers = ikThreads > 0 ? ikThreads : std::max<int>(std::thread::hardware_concurrency(), 1);
+
+    ikSolverDevices.clear();
+    ikSolvers.assign(1, iCartesianSolver);
+
+    for (int i = 1; i < ikWorkers; i++)
+    {
+        ikSolverDevices.emplace_back(new yarp::dev::PolyDriver);
+        ICartesianSolver * iSolver;
+
+        if (!ikSolverDevices.back()->open(solverOptions) || !ikSolverDevices.back()->view(iSolver))
+        {
+            yCError(BCC) << "Unable to create IK worker solver:" << solverStr;
+            return false;
+        }
+
+        ikSolvers.push_back(iSolver);
+    }
+
+    if (ikWorkers > 1)
+    {
+        yCInfo(BCC) << "Number of IK workers:" << ikWorkers;
+    }
+
     numSolverJoints = iCartesianSolver->getNumJoints();
     yCInfo(BCC) << "Number of solver joints:" << numSolverJoints;
 
@@ -207,7 +430,22 @@ bool BasicCartesianControl::open(yarp::os::Searchable& config)
         yCWarning(BCC, "numRobotJoints(%d) != numSolverJoints(%d)", numRobotJoints, numSolverJoints);
     }
 
-    yCInfo(BCC) << "Number of solver TCPs:" << iCartesianSolver->getNumTcps();
+    int numTcps = iCartesianSolver->getNumTcps();
+    yCInfo(BCC) << "Number of solver TCPs:" << numTcps;
+
+    qCmc.resize(numRobotJoints);
+    commandQ.resize(numRobotJoints);
+    streamOffset.resize(std::max(6 * numTcps, numRobotJoints));
+    desiredX.resize(6 * numTcps);
+    desiredXdot.resize(6 * numTcps);
+    currentX.resize(6 * numTcps);
+    commandXdot.resize(6 * numTcps);
+    commandQdot.resize(numSolverJoints);
+    commandTorques.resize(numRobotJoints);
+    zeroQdot.assign(numRobotJoints, 0.0);
+
+    //-- "numRobotJoints-1" null wrenches, the last one is overwritten with the FORC target
+    fexts.assign(numRobotJoints, std::vector<double>(6, 0.0));
 
     yarp::os::PeriodicThread::setPeriod(cmcPeriodMs * 0.001);
 
@@ -215,6 +453,9 @@ bool BasicCartesianControl::open(yarp::os::Searchable& config)
     streamingCommand = VOCAB_CC_NOT_SET;
     movementStartTime = 0.0;
     cmcSuccess = true;
+    cmcStats = CmcStats();
+    cmcScheduleOrigin = cmcSchedulePeriod = 0.0;
+    cmcSchedulerPeriod = cmcSchedulerAttempt = 0.0;
 
     return yarp::os::PeriodicThread::start();
 }
@@ -227,6 +468,14 @@ bool BasicCartesianControl::close()
     yarp::os::PeriodicThread::stop();
     robotDevice.close();
     solverDevice.close();
+
+    for (auto & device : ikSolverDevices)
+    {
+        device->close();
+    }
+
+    ikSolverDevices.clear();
+    ikSolvers.clear();
     return true;
 }
 
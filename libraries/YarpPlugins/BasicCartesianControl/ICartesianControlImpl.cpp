@@ -14,7 +14,6 @@
 #include <kdl/path_line.hpp>
 #include <kdl/rotational_interpolation_sa.hpp>
 #include <kdl/trajectory_segment.hpp>
-#include <kdl/velocityprofile_rect.hpp>
 #include <kdl/velocityprofile_trap.hpp>
 
 #include "KdlVectorConverter.hpp"
@@ -88,6 +87,11 @@ bool BasicCartesianControl::inv(const std::vector<double> &xd, std::vector<doubl
 
 bool BasicCartesianControl::movj(const std::vector<double> &xd)
 {
+    if (movjDirect)
+    {
+        return movjDirectly(xd);
+    }
+
     std::vector<double> currentQ(numRobotJoints), qd;
 
     if (!iEncoders->getEncoders(currentQ.data()))
@@ -203,9 +207,9 @@ bool BasicCartesianControl::movl(const std::vector<double> &xd)
         xd_obj = xd;
     }
 
-    trajectories.clear();
+    std::vector<std::unique_ptr<KDL::Path>> paths;
 
-    //-- Create line trajectories (one per endpoint if robot is a kin-tree)
+    //-- Create line paths (one per endpoint if robot is a kin-tree)
     for (unsigned int i = 0; i < xd.size() / 6; i++)
     {
         std::vector<double> xd_base_tcp_sub(x_base_tcp.cbegin() + i * 6, x_base_tcp.cbegin() + (i + 1) * 6);
@@ -215,14 +219,64 @@ bool BasicCartesianControl::movl(const std::vector<double> &xd)
         auto H_base_end = KdlVectorConverter::vectorToFrame(xd_obj_sub);
 
         auto * interpolator = new KDL::RotationalInterpolation_SingleAxis();
-        auto * path = new KDL::Path_Line(H_base_start, H_base_end, interpolator, 1.0);
-        auto * profile = new KDL::VelocityProfile_Trap(10.0, 10.0);
+        paths.emplace_back(new KDL::Path_Line(H_base_start, H_base_end, interpolator, 1.0));
+    }
+
+    //-- Either the fastest timing allowed by joint limits, or a fixed duration
+    TimeOptimalProfile timeOptimalProfile;
+
+    if (timeOptimalScaling > 0.0)
+    {
+        if (!computeTimeOptimalProfile(paths, currentQ, timeOptimalProfile))
+        {
+            return false;
+        }
+
+        yCInfo(BCC) << "Time-optimal MOVL duration:" << timeOptimalProfile.Duration() << "[s]";
+    }
 
-        trajectories.emplace_back(new KDL::Trajectory_Segment(path, profile, duration));
+    std::vector<std::unique_ptr<KDL::Trajectory>> trajectories;
+
+    for (auto & path : paths)
+    {
+        if (timeOptimalScaling > 0.0)
+        {
+            auto * profile = timeOptimalProfile.Clone();
+            profile->SetProfile(0.0, path->PathLength());
+            trajectories.emplace_back(new KDL::Trajectory_Segment(path.release(), profile));
+        }
+        else
+        {
+            auto * profile = new KDL::VelocityProfile_Trap(10.0, 10.0);
+            trajectories.emplace_back(new KDL::Trajectory_Segment(path.release(), profile, duration));
+        }
     }
 
+    //-- Tabulate at the CMC period, each iteration will just interpolate between samples
+    if (!trajectory.configure(trajectories, cmcPeriodMs * 0.001))
+    {
+        yCError(BCC) << "Unable to sample trajectory";
+        return false;
+    }
+
+    if (movlDirect)
+    {
+        //-- Solve IK for the whole path, reject the movement before it starts if not feasible
+        if (!computeJointPath(currentQ))
+        {
+            trajectory.clear();
+            jointPath.clear();
+            return false;
+        }
+
+        if (!setControlModes(VOCAB_CM_POSITION_DIRECT))
+        {
+            yCError(BCC) << "Unable to set position direct mode";
+            return false;
+        }
+    }
     //-- Set velocity mode and set state which makes periodic thread implement control.
-    if (!setControlModes(VOCAB_CM_VELOCITY))
+    else if (!setControlModes(VOCAB_CM_VELOCITY))
     {
         yCError(BCC) << "Unable to set velocity mode";
         return false;
@@ -231,7 +285,7 @@ bool BasicCartesianControl::movl(const std::vector<double> &xd)
     //-- Set state, enable CMC thread and wait for movement to be done
     movementStartTime = yarp::os::Time::now();
     cmcSuccess = true;
-    yCInfo(BCC) << "Performing MOVL";
+    yCInfo(BCC) << (movlDirect ? "Performing MOVL (streamed)" : "Performing MOVL");
 
     setCurrentState(VOCAB_CC_MOVL_CONTROLLING);
 
@@ -258,22 +312,12 @@ bool BasicCartesianControl::movv(const std::vector<double> &xdotd)
         return false;
     }
 
-    trajectories.clear();
-
-    for (unsigned int i = 0; i < xdotd.size() / 6; i++)
+    //-- Constant twist from the current pose, evaluated in closed form: a null twist holds the pose,
+    //-- otherwise each TCP stops after 10 units of path length
+    if (!twistTrajectory.configure(x_base_tcp, xdotd, 10.0))
     {
-        std::vector<double> xd_base_tcp_sub(x_base_tcp.cbegin() + i * 6, x_base_tcp.cbegin() + (i + 1) * 6);
-        std::vector<double> xdotd_sub(xdotd.cbegin() + i * 6, xdotd.cbegin() + (i + 1) * 6);
-
-        auto H_base_start = KdlVectorConverter::vectorToFrame(xd_base_tcp_sub);
-        auto twist_in_base = KdlVectorConverter::vectorToTwist(xdotd_sub);
-
-        auto * interpolator = new KDL::RotationalInterpolation_SingleAxis();
-        auto * path = new KDL::Path_Line(H_base_start, twist_in_base, interpolator, 1.0);
-        auto * profile = new KDL::VelocityProfile_Rectangular(10.0);
-        profile->SetProfileDuration(0, 10.0, 10.0 / path->PathLength());
-
-        trajectories.emplace_back(new KDL::Trajectory_Segment(path, profile));
+        yCError(BCC) << "Invalid twist, expected" << x_base_tcp.size() << "values, got" << xdotd.size();
+        return false;
     }
 
     //-- Set velocity mode and set state which makes periodic thread implement control.
@@ -295,6 +339,77 @@ bool BasicCartesianControl::movv(const std::vector<double> &xdotd)
 
 // -----------------------------------------------------------------------------
 
+bool BasicCartesianControl::movw(const std::vector<double> &xd)
+{
+    if (getCurrentState() == VOCAB_CC_MOVW_CONTROLLING)
+    {
+        //-- Append to the ongoing motion, the CMC thread picks it up on the next iteration
+        if (queueWaypoint(xd))
+        {
+            return true;
+        }
+
+        if (!waypoints.isClosed())
+        {
+            yCError(BCC) << "Unable to queue waypoint";
+            return false;
+        }
+
+        //-- Too late, the last waypoint has just been reached: start anew once the CMC thread stops control
+        while (getCurrentState() == VOCAB_CC_MOVW_CONTROLLING)
+        {
+            yarp::os::Time::delay(waitPeriodMs / 1000.0);
+        }
+    }
+
+    if (getCurrentState() != VOCAB_CC_NOT_CONTROLLING)
+    {
+        yCError(BCC) << "Unable to start MOVW while controlling";
+        return false;
+    }
+
+    std::vector<double> currentQ(numRobotJoints);
+
+    if (!iEncoders->getEncoders(currentQ.data()))
+    {
+        yCError(BCC) << "getEncoders() failed";
+        return false;
+    }
+
+    std::vector<double> x_base_tcp;
+
+    if (!iCartesianSolver->fwdKin(currentQ, x_base_tcp))
+    {
+        yCError(BCC) << "fwdKin() failed";
+        return false;
+    }
+
+    waypoints.reset(x_base_tcp);
+    movementStartTime = yarp::os::Time::now();
+
+    if (!queueWaypoint(xd))
+    {
+        yCError(BCC) << "Unable to queue waypoint";
+        return false;
+    }
+
+    //-- Set velocity mode and set state which makes periodic thread implement control.
+    if (!setControlModes(VOCAB_CM_VELOCITY))
+    {
+        yCError(BCC) << "Unable to set velocity mode";
+        return false;
+    }
+
+    cmcSuccess = true;
+    yCInfo(BCC) << "Performing MOVW";
+
+    setCurrentState(VOCAB_CC_MOVW_CONTROLLING);
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
 bool BasicCartesianControl::gcmp()
 {
     //-- Set torque mode and set state which makes periodic thread implement control.
@@ -351,7 +466,9 @@ bool BasicCartesianControl::stopControl()
         yCWarning(BCC) << "stop() failed";
     }
 
-    trajectories.clear();
+    trajectory.clear();
+    jointPath.clear();
+    streamTarget.reset();
 
     return true;
 }
@@ -362,7 +479,7 @@ bool BasicCartesianControl::wait(double timeout)
 {
     int state = getCurrentState();
 
-    if (state != VOCAB_CC_MOVJ_CONTROLLING && state != VOCAB_CC_MOVL_CONTROLLING)
+    if (state != VOCAB_CC_MOVJ_CONTROLLING && state != VOCAB_CC_MOVL_CONTROLLING && state != VOCAB_CC_MOVW_CONTROLLING)
     {
         return true;
     }
@@ -389,16 +506,20 @@ bool BasicCartesianControl::wait(double timeout)
 
 bool BasicCartesianControl::tool(const std::vector<double> &x)
 {
-    if (!iCartesianSolver->restoreOriginalChain())
+    //-- Keep all IK worker solvers in sync, the first one is iCartesianSolver
+    for (auto * solver : ikSolvers)
     {
-        yCError(BCC) << "restoreOriginalChain() failed";
-        return false;
-    }
+        if (!solver->restoreOriginalChain())
+        {
+            yCError(BCC) << "restoreOriginalChain() failed";
+            return false;
+        }
 
-    if (!iCartesianSolver->appendLink(x))
-    {
-        yCError(BCC) << "appendLink() failed";
-        return false;
+        if (!solver->appendLink(x))
+        {
+            yCError(BCC) << "appendLink() failed";
+            return false;
+        }
     }
 
     return true;
@@ -415,7 +536,7 @@ bool BasicCartesianControl::act(int command)
 void BasicCartesianControl::twist(const std::vector<double> &xdot)
 {
     if (getCurrentState() != VOCAB_CC_NOT_CONTROLLING || streamingCommand != VOCAB_CC_TWIST
-            || !checkControlModes(VOCAB_CM_VELOCITY))
+            || !latencies[CHECKS].measure([this] { return checkControlModes(VOCAB_CM_VELOCITY); }))
     {
         yCError(BCC) << "Streaming command not preset";
         return;
@@ -423,19 +544,19 @@ void BasicCartesianControl::twist(const std::vector<double> &xdot)
 
     std::vector<double> currentQ(numRobotJoints), qdot;
 
-    if (!iEncoders->getEncoders(currentQ.data()))
+    if (!latencies[ENCODERS].measure([this, &currentQ] { return iEncoders->getEncoders(currentQ.data()); }))
     {
         yCError(BCC) << "getEncoders() failed";
         return;
     }
 
-    if (!iCartesianSolver->diffInvKin(currentQ, xdot, qdot, referenceFrame))
+    if (!latencies[INV_KIN].measure([&] { return iCartesianSolver->diffInvKin(currentQ, xdot, qdot, referenceFrame); }))
     {
         yCError(BCC) << "diffInvKin() failed";
         return;
     }
 
-    if (!checkJointLimits(currentQ, qdot) || !checkJointVelocities(qdot))
+    if (!latencies[CHECKS].measure([&] { return checkJointLimits(currentQ, qdot) && checkJointVelocities(qdot); }))
     {
         yCError(BCC) << "Joint position or velocity limits exceeded, stopping";
         std::fill(qdot.begin(), qdot.end(), 0.0);
@@ -443,7 +564,7 @@ void BasicCartesianControl::twist(const std::vector<double> &xdot)
         return;
     }
 
-    if (!iVelocityControl->velocityMove(qdot.data()))
+    if (!latencies[SEND].measure([this, &qdot] { return iVelocityControl->velocityMove(qdot.data()); }))
     {
         yCError(BCC) << "velocityMove() failed";
         return;
@@ -455,7 +576,7 @@ void BasicCartesianControl::twist(const std::vector<double> &xdot)
 void BasicCartesianControl::pose(const std::vector<double> &x, double interval)
 {
     if (getCurrentState() != VOCAB_CC_NOT_CONTROLLING || streamingCommand != VOCAB_CC_POSE
-            || !checkControlModes(VOCAB_CM_VELOCITY))
+            || !latencies[CHECKS].measure([this] { return checkControlModes(VOCAB_CM_VELOCITY); }))
     {
         yCError(BCC) << "Streaming command not preset";
         return;
@@ -463,7 +584,7 @@ void BasicCartesianControl::pose(const std::vector<double> &x, double interval)
 
     std::vector<double> currentQ(numRobotJoints);
 
-    if (!iEncoders->getEncoders(currentQ.data()))
+    if (!latencies[ENCODERS].measure([this, &currentQ] { return iEncoders->getEncoders(currentQ.data()); }))
     {
         yCError(BCC) << "getEncoders() failed";
         return;
@@ -471,7 +592,7 @@ void BasicCartesianControl::pose(const std::vector<double> &x, double interval)
 
     std::vector<double> x_base_tcp;
 
-    if (!iCartesianSolver->fwdKin(currentQ, x_base_tcp))
+    if (!latencies[FWD_KIN].measure([&] { return iCartesianSolver->fwdKin(currentQ, x_base_tcp); }))
     {
         yCError(BCC) << "fwdKin() failed";
         return;
@@ -492,9 +613,24 @@ void BasicCartesianControl::pose(const std::vector<double> &x, double interval)
         xd_obj = x;
     }
 
+    if (streamInterpolation)
+    {
+        //-- Just store the target, the CMC thread takes it from here
+        std::vector<double> x_last, delta;
+
+        if (streamTarget.getLastTarget(x_last) && !iCartesianSolver->poseDiff(xd_obj, x_last, delta))
+        {
+            yCError(BCC) << "poseDiff() failed";
+            return;
+        }
+
+        streamTarget.push(xd_obj, delta, yarp::os::Time::now());
+        return;
+    }
+
     std::vector<double> xd;
 
-    if (!iCartesianSolver->poseDiff(xd_obj, x_base_tcp, xd))
+    if (!latencies[POSE_DIFF].measure([&] { return iCartesianSolver->poseDiff(xd_obj, x_base_tcp, xd); }))
     {
         yCError(BCC) << "fwdKinError() failed";
         return;
@@ -506,13 +642,13 @@ void BasicCartesianControl::pose(const std::vector<double> &x, double interval)
 
     std::vector<double> qdot;
 
-    if (!iCartesianSolver->diffInvKin(currentQ, xdot, qdot, referenceFrame))
+    if (!latencies[INV_KIN].measure([&] { return iCartesianSolver->diffInvKin(currentQ, xdot, qdot, referenceFrame); }))
     {
         yCError(BCC) << "diffInvKin() failed";
         return;
     }
 
-    if (!checkJointLimits(currentQ, qdot) || !checkJointVelocities(qdot))
+    if (!latencies[CHECKS].measure([&] { return checkJointLimits(currentQ, qdot) && checkJointVelocities(qdot); }))
     {
         yCError(BCC) << "Joint position or velocity limits exceeded, stopping";
         std::fill(qdot.begin(), qdot.end(), 0.0);
@@ -520,7 +656,7 @@ void BasicCartesianControl::pose(const std::vector<double> &x, double interval)
         return;
     }
 
-    if (!iVelocityControl->velocityMove(qdot.data()))
+    if (!latencies[SEND].measure([this, &qdot] { return iVelocityControl->velocityMove(qdot.data()); }))
     {
         yCError(BCC) << "velocityMove() failed";
         return;
@@ -532,7 +668,7 @@ void BasicCartesianControl::pose(const std::vector<double> &x, double interval)
 void BasicCartesianControl::movi(const std::vector<double> &x)
 {
     if (getCurrentState() != VOCAB_CC_NOT_CONTROLLING || streamingCommand != VOCAB_CC_MOVI
-            || !checkControlModes(VOCAB_CM_POSITION_DIRECT))
+            || !latencies[CHECKS].measure([this] { return checkControlModes(VOCAB_CM_POSITION_DIRECT); }))
     {
         yCError(BCC) << "Streaming command not preset";
         return;
@@ -540,13 +676,13 @@ void BasicCartesianControl::movi(const std::vector<double> &x)
 
     std::vector<double> currentQ(numRobotJoints), q;
 
-    if (!iEncoders->getEncoders(currentQ.data()))
+    if (!latencies[ENCODERS].measure([this, &currentQ] { return iEncoders->getEncoders(currentQ.data()); }))
     {
         yCError(BCC) << "getEncoders() failed";
         return;
     }
 
-    if (!iCartesianSolver->invKin(x, currentQ, q, referenceFrame))
+    if (!latencies[INV_KIN].measure([&] { return iCartesianSolver->invKin(x, currentQ, q, referenceFrame); }))
     {
         yCError(BCC) << "invKin() failed";
         return;
@@ -559,13 +695,30 @@ void BasicCartesianControl::movi(const std::vector<double> &x)
         qdiff[i] = q[i] - currentQ[i];
     }
 
-    if (!checkJointLimits(currentQ, qdiff))
+    if (!latencies[CHECKS].measure([&] { return checkJointLimits(currentQ, qdiff); }))
     {
         yCError(BCC) << "Joint position limits exceeded, not moving";
         return;
     }
 
-    if (!iPositionDirect->setPositions(q.data()))
+    if (streamInterpolation)
+    {
+        //-- Just store the target, the CMC thread takes it from here
+        std::vector<double> qLast;
+
+        if (streamTarget.getLastTarget(qLast))
+        {
+            for (int i = 0; i < numRobotJoints; i++)
+            {
+                qdiff[i] = q[i] - qLast[i];
+            }
+        }
+
+        streamTarget.push(q, qdiff, yarp::os::Time::now());
+        return;
+    }
+
+    if (!latencies[SEND].measure([this, &q] { return iPositionDirect->setPositions(q.data()); }))
     {
         yCError(BCC) << "setPositions() failed";
     }
@@ -599,7 +752,72 @@ bool BasicCartesianControl::setParameter(int vocab, double value)
         }
         duration = value;
         break;
+    case VOCAB_CC_CONFIG_BLEND_RADIUS:
+        if (value < 0.0)
+        {
+            yCError(BCC) << "Blend radius cannot be negative";
+            return false;
+        }
+        blendRadius = value;
+        break;
+    case VOCAB_CC_CONFIG_TIME_OPTIMAL:
+        if (value < 0.0 || value > 1.0)
+        {
+            yCError(BCC) << "Time-optimal scaling must lie in [0, 1]";
+            return false;
+        }
+        timeOptimalScaling = value;
+        break;
+    case VOCAB_CC_CONFIG_MOVJ_DIRECT:
+        if (value != 0.0 && value != 1.0)
+        {
+            yCError(BCC) << "MOVJ direct mode must be either 0 or 1";
+            return false;
+        }
+        movjDirect = value != 0.0;
+        break;
+    case VOCAB_CC_CONFIG_MOVL_DIRECT:
+        if (value != 0.0 && value != 1.0)
+        {
+            yCError(BCC) << "MOVL direct mode must be either 0 or 1";
+            return false;
+        }
+        movlDirect = value != 0.0;
+        break;
+    case VOCAB_CC_CONFIG_STREAM_INTERPOLATION:
+        if (value != 0.0 && value != 1.0)
+        {
+            yCError(BCC) << "Stream interpolation must be either 0 or 1";
+            return false;
+        }
+        streamInterpolation = value != 0.0;
+        streamTarget.reset();
+        break;
+    case VOCAB_CC_CONFIG_STREAM_EXTRAPOLATION:
+        if (value < 0.0)
+        {
+            yCError(BCC) << "Stream extrapolation time cannot be negative";
+            return false;
+        }
+        streamExtrapolation = value;
+        streamTarget.setMaxExtrapolation(value);
+        break;
+    case VOCAB_CC_CONFIG_STREAM_TIMEOUT:
+        if (value < 0.0)
+        {
+            yCError(BCC) << "Stream timeout cannot be negative";
+            return false;
+        }
+        streamTimeout = value;
+        streamTarget.setMaxInterval(value);
+        break;
     case VOCAB_CC_CONFIG_CMC_PERIOD:
+        if (cmcScheduler == cmc_scheduler::DEADLINE && cmcRuntimeUs > value * 1000.0)
+        {
+            yCError(BCC) << "CMC period cannot be shorter than the runtime budget of" << cmcRuntimeUs << "us";
+            return false;
+        }
+
         if (!yarp::os::PeriodicThread::setPeriod(value * 0.001))
         {
             yCError(BCC) << "Cannot set new CMC period";
@@ -631,6 +849,14 @@ bool BasicCartesianControl::setParameter(int vocab, double value)
         }
         streamingCommand = value;
         break;
+    case VOCAB_CC_STATS_TICKS:
+    case VOCAB_CC_STATS_RUN_MEAN:
+    case VOCAB_CC_STATS_RUN_MAX:
+    case VOCAB_CC_STATS_JITTER_MEAN:
+    case VOCAB_CC_STATS_JITTER_MAX:
+    case VOCAB_CC_STATS_OVERRUNS:
+        yCError(BCC) << "Controller statistics are read-only:" << yarp::os::Vocab32::decode(vocab);
+        return false;
     default:
         yCError(BCC) << "Unrecognized or unsupported config parameter key:" << yarp::os::Vocab32::decode(vocab);
         return false;
@@ -651,6 +877,27 @@ bool BasicCartesianControl::getParameter(int vocab, double * value)
     case VOCAB_CC_CONFIG_TRAJ_DURATION:
         *value = duration;
         break;
+    case VOCAB_CC_CONFIG_BLEND_RADIUS:
+        *value = blendRadius;
+        break;
+    case VOCAB_CC_CONFIG_TIME_OPTIMAL:
+        *value = timeOptimalScaling;
+        break;
+    case VOCAB_CC_CONFIG_MOVJ_DIRECT:
+        *value = movjDirect;
+        break;
+    case VOCAB_CC_CONFIG_MOVL_DIRECT:
+        *value = movlDirect;
+        break;
+    case VOCAB_CC_CONFIG_STREAM_INTERPOLATION:
+        *value = streamInterpolation;
+        break;
+    case VOCAB_CC_CONFIG_STREAM_EXTRAPOLATION:
+        *value = streamExtrapolation;
+        break;
+    case VOCAB_CC_CONFIG_STREAM_TIMEOUT:
+        *value = streamTimeout;
+        break;
     case VOCAB_CC_CONFIG_CMC_PERIOD:
         *value = cmcPeriodMs;
         break;
@@ -663,6 +910,13 @@ bool BasicCartesianControl::getParameter(int vocab, double * value)
     case VOCAB_CC_CONFIG_STREAMING_CMD:
         *value = streamingCommand;
         break;
+    case VOCAB_CC_STATS_TICKS:
+    case VOCAB_CC_STATS_RUN_MEAN:
+    case VOCAB_CC_STATS_RUN_MAX:
+    case VOCAB_CC_STATS_JITTER_MEAN:
+    case VOCAB_CC_STATS_JITTER_MAX:
+    case VOCAB_CC_STATS_OVERRUNS:
+        return getCmcStat(vocab, value);
     default:
         yCError(BCC) << "Unrecognized or unsupported config parameter key:" << yarp::os::Vocab32::decode(vocab);
         return false;
@@ -697,6 +951,13 @@ bool BasicCartesianControl::getParameters(std::map<int, double> & params)
 {
     params.emplace(VOCAB_CC_CONFIG_GAIN, gain);
     params.emplace(VOCAB_CC_CONFIG_TRAJ_DURATION, duration);
+    params.emplace(VOCAB_CC_CONFIG_BLEND_RADIUS, blendRadius);
+    params.emplace(VOCAB_CC_CONFIG_TIME_OPTIMAL, timeOptimalScaling);
+    params.emplace(VOCAB_CC_CONFIG_MOVJ_DIRECT, movjDirect);
+    params.emplace(VOCAB_CC_CONFIG_MOVL_DIRECT, movlDirect);
+    params.emplace(VOCAB_CC_CONFIG_STREAM_INTERPOLATION, streamInterpolation);
+    params.emplace(VOCAB_CC_CONFIG_STREAM_EXTRAPOLATION, streamExtrapolation);
+    params.emplace(VOCAB_CC_CONFIG_STREAM_TIMEOUT, streamTimeout);
     params.emplace(VOCAB_CC_CONFIG_CMC_PERIOD, cmcPeriodMs);
     params.emplace(VOCAB_CC_CONFIG_WAIT_PERIOD, waitPeriodMs);
     params.emplace(VOCAB_CC_CONFIG_FRAME, referenceFrame);
@@ -705,3 +966,38 @@ bool BasicCartesianControl::getParameters(std::map<int, double> & params)
 }
 
 // -----------------------------------------------------------------------------
+
+bool BasicCartesianControl::getLatencyStats(std::map<int, std::vector<double>> & stats)
+{
+    // indexed by latency_phase
+    static const int vocabs[NUM_PHASES] = {
+        VOCAB_CC_LATENCY_ENCODERS,
+        VOCAB_CC_LATENCY_FWD_KIN,
+        VOCAB_CC_LATENCY_POSE_DIFF,
+        VOCAB_CC_LATENCY_INV_KIN,
+        VOCAB_CC_LATENCY_CHECKS,
+        VOCAB_CC_LATENCY_SEND,
+        VOCAB_CC_LATENCY_TICK
+    };
+
+    for (int i = 0; i < NUM_PHASES; i++)
+    {
+        latencies[i].summarize(stats[vocabs[i]]);
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+bool BasicCartesianControl::resetLatencyStats()
+{
+    for (auto & histogram : latencies)
+    {
+        histogram.reset();
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,143 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#include "JointPathSolver.hpp"
+
+#include <cmath> // std::abs
+
+#include <algorithm> // std::copy, std::max, std::min
+#include <thread>
+
+using namespace roboticslab;
+
+// -----------------------------------------------------------------------------
+
+namespace
+{
+    // largest joint mismatch at a chunk boundary still regarded as the same solution [deg],
+    // iterative solvers may land slightly apart from different guesses, a branch switch is way larger
+    constexpr double CONTINUITY_TOLERANCE = 1e-3;
+}
+
+// -----------------------------------------------------------------------------
+
+int roboticslab::solveJointPath(const SampledTrajectory & trajectory, const std::vector<ICartesianSolver *> & solvers,
+                                const std::vector<double> & q, JointSpline & jointPath)
+{
+    const int numSamples = trajectory.getNumSamples();
+    const int numJoints = q.size();
+    const int width = 6 * trajectory.getNumTcps();
+
+    //-- Joints not handled by the solver keep their current position, the first sample is the current pose
+    for (int k = 0; k < numSamples; k++)
+    {
+        std::copy(q.cbegin(), q.cend(), jointPath.row(k));
+    }
+
+    //-- Solve samples in [first, last) one after another, seeding each one with the previous solution
+    auto solveSamples = [&trajectory, &jointPath, width](ICartesianSolver * solver, int first, int last, std::vector<double> qPrev)
+    {
+        std::vector<double> x, qNext;
+
+        for (int k = first; k < last; k++)
+        {
+            x.assign(trajectory.getPose(k), trajectory.getPose(k) + width);
+
+            if (!solver->invKin(x, qPrev, qNext))
+            {
+                return k;
+            }
+
+            std::copy(qNext.cbegin(), qNext.cend(), jointPath.row(k));
+            qPrev = qNext;
+        }
+
+        return -1;
+    };
+
+    const int workers = std::max(1, std::min<int>(solvers.size(), numSamples - 1));
+
+    //-- Split the path into contiguous chunks
+    std::vector<int> starts(workers + 1);
+
+    for (int i = 0; i <= workers; i++)
+    {
+        starts[i] = 1 + i * (numSamples - 1) / workers;
+    }
+
+    //-- Rough guess for the first sample of each chunk, solved from the previous guess;
+    //-- if this fails, the chunk is left to the sequential pass below
+    std::vector<std::vector<double>> seeds(workers, q);
+    std::vector<int> failures(workers, -1);
+
+    for (int i = 1; i < workers; i++)
+    {
+        failures[i] = solveSamples(solvers[0], starts[i], starts[i] + 1, seeds[i - 1]);
+
+        if (failures[i] == -1)
+        {
+            seeds[i].assign(jointPath.row(starts[i]), jointPath.row(starts[i]) + numJoints);
+        }
+        else
+        {
+            seeds[i] = seeds[i - 1];
+        }
+    }
+
+    //-- Fill each chunk on its own thread
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+
+    for (int i = 1; i < workers; i++)
+    {
+        if (failures[i] == -1)
+        {
+            pool.emplace_back([&, i] { failures[i] = solveSamples(solvers[i], starts[i] + 1, starts[i + 1], seeds[i]); });
+        }
+    }
+
+    failures[0] = solveSamples(solvers[0], starts[0], starts[1], q);
+
+    for (auto & worker : pool)
+    {
+        worker.join();
+    }
+
+    //-- Stitch chunks in order, each one must continue where the previous one ended
+    std::vector<double> x, qPrev, qNext;
+
+    for (int i = 1; i < workers; i++)
+    {
+        if (failures[i - 1] != -1)
+        {
+            return failures[i - 1];
+        }
+
+        qPrev.assign(jointPath.row(starts[i] - 1), jointPath.row(starts[i] - 1) + numJoints);
+
+        bool continuous = failures[i] == -1;
+
+        if (continuous)
+        {
+            x.assign(trajectory.getPose(starts[i]), trajectory.getPose(starts[i]) + width);
+
+            if (!solvers[0]->invKin(x, qPrev, qNext))
+            {
+                return starts[i];
+            }
+
+            for (unsigned int joint = 0; joint < qNext.size() && continuous; joint++)
+            {
+                continuous = std::abs(qNext[joint] - jointPath.row(starts[i])[joint]) <= CONTINUITY_TOLERANCE;
+            }
+        }
+
+        if (!continuous)
+        {
+            failures[i] = solveSamples(solvers[0], starts[i], starts[i + 1], qPrev);
+        }
+    }
+
+    return failures[workers - 1];
+}
+
+// -----------------------------------------------------------------------------
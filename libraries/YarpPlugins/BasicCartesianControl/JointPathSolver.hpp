@@ -0,0 +1,43 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#ifndef __JOINT_PATH_SOLVER_HPP__
+#define __JOINT_PATH_SOLVER_HPP__
+
+#include <vector>
+
+#include "ICartesianSolver.h"
+#include "JointSpline.hpp"
+#include "SampledTrajectory.hpp"
+
+namespace roboticslab
+{
+
+/**
+ * @ingroup BasicCartesianControl
+ * @brief Joint positions at every sample of a tabulated Cartesian trajectory.
+ *
+ * Each sample is solved with the solution of the previous one as the initial
+ * guess, so that the joint path stays on the same IK branch as a sequential
+ * pass would. The samples are split into contiguous chunks, one per solver,
+ * which are filled in parallel from a rough guess of their first sample. The
+ * chunks are then stitched in order: the first sample of each chunk is solved
+ * again from the last sample of the previous one, and the whole chunk is solved
+ * sequentially if both solutions disagree (e.g. a different branch was picked).
+ * The result is the same as with a single solver.
+ *
+ * @param trajectory Cartesian trajectory, the first sample is the current pose.
+ * @param solvers Independent solver instances, one per thread, the first one
+ * runs on the calling thread.
+ * @param q Current joint positions [deg], also used for joints not handled by
+ * the solvers.
+ * @param jointPath Output table, configured by the caller with as many rows as
+ * @p trajectory has samples and as many columns as @p q has values.
+ *
+ * @return index of the first sample that could not be solved, -1 on success
+ */
+int solveJointPath(const SampledTrajectory & trajectory, const std::vector<ICartesianSolver *> & solvers,
+                   const std::vector<double> & q, JointSpline & jointPath);
+
+} // namespace roboticslab
+
+#endif // __JOINT_PATH_SOLVER_HPP__
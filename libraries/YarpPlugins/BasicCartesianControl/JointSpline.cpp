@@ -0,0 +1,78 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#include "JointSpline.hpp"
+
+#include <algorithm> // std::copy, std::max, std::min
+
+using namespace roboticslab;
+
+// -----------------------------------------------------------------------------
+
+bool JointSpline::configure(int _numSamples, int _numJoints, double _step)
+{
+    clear();
+
+    if (_numSamples < 1 || _numJoints < 1 || _step <= 0.0)
+    {
+        return false;
+    }
+
+    numSamples = _numSamples;
+    numJoints = _numJoints;
+    step = _step;
+
+    positions.resize(numSamples * numJoints);
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+void JointSpline::clear()
+{
+    numJoints = numSamples = 0;
+    step = 0.0;
+    positions.clear();
+}
+
+// -----------------------------------------------------------------------------
+
+void JointSpline::evaluate(double t, double * q) const
+{
+    if (numSamples == 0)
+    {
+        return;
+    }
+
+    if (t >= getDuration() || numSamples == 1)
+    {
+        std::copy(positions.end() - numJoints, positions.end(), q);
+        return;
+    }
+
+    const double position = std::max(t, 0.0) / step;
+    const int k = std::min(static_cast<int>(position), numSamples - 2);
+    const double s = position - k;
+
+    //-- Hermite basis functions
+    const double h00 = (1.0 + 2.0 * s) * (1.0 - s) * (1.0 - s);
+    const double h10 = s * (1.0 - s) * (1.0 - s);
+    const double h01 = s * s * (3.0 - 2.0 * s);
+    const double h11 = s * s * (s - 1.0);
+
+    const double * p0 = row(k);
+    const double * p1 = row(k + 1);
+
+    // rest at both ends of the table
+    const double * prev = k != 0 ? row(k - 1) : nullptr;
+    const double * next = k + 2 < numSamples ? row(k + 2) : nullptr;
+
+    for (int joint = 0; joint < numJoints; joint++)
+    {
+        const double m0 = prev ? 0.5 * (p1[joint] - prev[joint]) : 0.0;
+        const double m1 = next ? 0.5 * (next[joint] - p0[joint]) : 0.0;
+
+        q[joint] = h00 * p0[joint] + h10 * m0 + h01 * p1[joint] + h11 * m1;
+    }
+}
+
+// -----------------------------------------------------------------------------
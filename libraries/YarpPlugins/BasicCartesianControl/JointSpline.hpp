@@ -0,0 +1,68 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#ifndef __JOINT_SPLINE_HPP__
+#define __JOINT_SPLINE_HPP__
+
+#include <vector>
+
+namespace roboticslab
+{
+
+/**
+ * @ingroup BasicCartesianControl
+ * @brief Joint positions tabulated on a fixed time grid, interpolated by a cubic spline.
+ *
+ * Rows of joint positions are filled in by the caller via @ref row. Between
+ * samples, a cubic Hermite (Catmull-Rom) spline is evaluated with tangents
+ * taken from the neighbouring samples. The motion is assumed to start and end
+ * at rest, hence tangents are null at both ends of the table.
+ */
+class JointSpline
+{
+public:
+    /**
+     * @brief Allocate a table of @p numSamples rows, @p step seconds apart.
+     *
+     * @return false if the dimensions are not positive
+     */
+    bool configure(int numSamples, int numJoints, double step);
+
+    //! Drop the current table, keeping the storage for the next movement.
+    void clear();
+
+    //! Number of rows in the table.
+    int getNumSamples() const
+    { return numSamples; }
+
+    //! Time elapsed between the first and the last sample [s].
+    double getDuration() const
+    { return numSamples > 1 ? (numSamples - 1) * step : 0.0; }
+
+    //! Joint positions at the k-th sample [deg].
+    double * row(int k)
+    { return positions.data() + k * numJoints; }
+
+    //! Joint positions at the k-th sample [deg].
+    const double * row(int k) const
+    { return positions.data() + k * numJoints; }
+
+    /**
+     * @brief Interpolate joint positions at time @p t.
+     *
+     * Past the end of the table the last row is held.
+     *
+     * @param t Time since the start of the movement [s].
+     * @param q Output joint positions [deg].
+     */
+    void evaluate(double t, double * q) const;
+
+private:
+    int numJoints {0};
+    int numSamples {0};
+    double step {0.0}; // [s]
+    std::vector<double> positions;
+};
+
+} // namespace roboticslab
+
+#endif // __JOINT_SPLINE_HPP__
@@ -0,0 +1,255 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#include "JointTrajectory.hpp"
+
+#include <cmath> // std::abs, std::cbrt, std::sqrt
+
+#include <algorithm> // std::copy, std::max, std::min
+#include <limits>
+
+using namespace roboticslab;
+
+// -----------------------------------------------------------------------------
+
+namespace
+{
+    constexpr double EPSILON = 1e-9; // [deg]
+}
+
+// -----------------------------------------------------------------------------
+
+bool JointTrajectory::Profile::configure(double maxVel, double maxAcc, double maxJerk)
+{
+    if (!(maxVel > 0.0) || !(maxAcc > 0.0) || !(maxJerk > 0.0))
+    {
+        return false;
+    }
+
+    jerk = maxJerk;
+
+    //-- Assume the velocity limit is reached
+    if (maxVel * maxJerk < maxAcc * maxAcc)
+    {
+        jerkTime = std::sqrt(maxVel / maxJerk);
+        rampTime = 2.0 * jerkTime;
+    }
+    else
+    {
+        jerkTime = maxAcc / maxJerk;
+        rampTime = jerkTime + maxVel / maxAcc;
+    }
+
+    peakAcc = jerk * jerkTime;
+    peakVel = (rampTime - jerkTime) * peakAcc;
+    cruiseTime = 1.0 / peakVel - rampTime;
+
+    //-- Otherwise, the segment is too short for a cruise phase
+    if (cruiseTime < 0.0)
+    {
+        cruiseTime = 0.0;
+
+        if (maxJerk * maxJerk >= 2.0 * maxAcc * maxAcc * maxAcc)
+        {
+            jerkTime = maxAcc / maxJerk;
+            rampTime = 0.5 * jerkTime + std::sqrt(0.25 * jerkTime * jerkTime + 1.0 / maxAcc);
+        }
+        else
+        {
+            jerkTime = std::cbrt(0.5 / maxJerk);
+            rampTime = 2.0 * jerkTime;
+        }
+
+        peakAcc = jerk * jerkTime;
+        peakVel = (rampTime - jerkTime) * peakAcc;
+    }
+
+    duration = 2.0 * rampTime + cruiseTime;
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+double JointTrajectory::Profile::rampPosition(double t) const
+{
+    if (t < jerkTime)
+    {
+        return jerk * t * t * t / 6.0;
+    }
+
+    if (t < rampTime - jerkTime)
+    {
+        return peakAcc * (3.0 * t * t - 3.0 * jerkTime * t + jerkTime * jerkTime) / 6.0;
+    }
+
+    const double remaining = rampTime - t;
+    return peakVel * (0.5 * rampTime - remaining) + jerk * remaining * remaining * remaining / 6.0;
+}
+
+// -----------------------------------------------------------------------------
+
+double JointTrajectory::Profile::position(double t) const
+{
+    if (t >= duration)
+    {
+        return 1.0;
+    }
+
+    if (t <= 0.0)
+    {
+        return 0.0;
+    }
+
+    if (t < rampTime)
+    {
+        return rampPosition(t);
+    }
+
+    if (t <= rampTime + cruiseTime)
+    {
+        return peakVel * (t - 0.5 * rampTime);
+    }
+
+    return 1.0 - rampPosition(duration - t);
+}
+
+// -----------------------------------------------------------------------------
+
+void JointTrajectory::reset(const std::vector<double> & q, const std::vector<double> & qdotMax,
+                            const std::vector<double> & qddotMax, const std::vector<double> & qdddotMax)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    origin = tail = q;
+
+    // missing limits render the corresponding joints immovable
+    maxVel = qdotMax;
+    maxAcc = qddotMax;
+    maxJerk = qdddotMax;
+
+    maxVel.resize(q.size(), 0.0);
+    maxAcc.resize(q.size(), 0.0);
+    maxJerk.resize(q.size(), 0.0);
+
+    segments.resize(CAPACITY);
+
+    for (auto & segment : segments)
+    {
+        segment.deltas.resize(q.size());
+    }
+
+    head = count = 0;
+    closed = false;
+}
+
+// -----------------------------------------------------------------------------
+
+bool JointTrajectory::append(const std::vector<double> & qd, double now)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (closed || count == CAPACITY || qd.size() > tail.size())
+    {
+        return false;
+    }
+
+    auto & segment = segments[(head + count) % CAPACITY];
+
+    //-- Normalized limits: the common time law must not overdrive any joint
+    double vel = std::numeric_limits<double>::infinity();
+    double acc = std::numeric_limits<double>::infinity();
+    double jerk = std::numeric_limits<double>::infinity();
+    bool moving = false;
+
+    for (unsigned int joint = 0; joint < tail.size(); joint++)
+    {
+        const double delta = joint < qd.size() ? qd[joint] - tail[joint] : 0.0;
+        segment.deltas[joint] = delta;
+
+        if (std::abs(delta) > EPSILON)
+        {
+            vel = std::min(vel, maxVel[joint] / std::abs(delta));
+            acc = std::min(acc, maxAcc[joint] / std::abs(delta));
+            jerk = std::min(jerk, maxJerk[joint] / std::abs(delta));
+            moving = true;
+        }
+    }
+
+    if (!moving)
+    {
+        segment.profile = Profile();
+    }
+    else if (!segment.profile.configure(vel, acc, jerk))
+    {
+        return false;
+    }
+
+    segment.start = now;
+
+    if (count != 0)
+    {
+        const auto & previous = at(count - 1);
+        segment.start = std::max(segment.start, previous.start + previous.profile.duration);
+    }
+
+    for (unsigned int joint = 0; joint < tail.size(); joint++)
+    {
+        tail[joint] += segment.deltas[joint];
+    }
+
+    count++;
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+bool JointTrajectory::evaluate(double t, double * q)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    //-- Completed segments are folded into the origin
+    while (count != 0 && t >= at(0).start + at(0).profile.duration)
+    {
+        for (unsigned int joint = 0; joint < origin.size(); joint++)
+        {
+            origin[joint] += at(0).deltas[joint];
+        }
+
+        head = (head + 1) % CAPACITY;
+        count--;
+    }
+
+    if (count == 0)
+    {
+        std::copy(origin.cbegin(), origin.cend(), q);
+        closed = true;
+        return false;
+    }
+
+    const auto & segment = at(0);
+    const double s = segment.profile.position(t - segment.start);
+
+    for (unsigned int joint = 0; joint < origin.size(); joint++)
+    {
+        q[joint] = origin[joint] + segment.deltas[joint] * s;
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+bool JointTrajectory::isClosed() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return closed;
+}
+
+// -----------------------------------------------------------------------------
+
+void JointTrajectory::getLastTarget(std::vector<double> & q) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    q = tail;
+}
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,108 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#ifndef __JOINT_TRAJECTORY_HPP__
+#define __JOINT_TRAJECTORY_HPP__
+
+#include <mutex>
+#include <vector>
+
+namespace roboticslab
+{
+
+/**
+ * @ingroup BasicCartesianControl
+ * @brief Queue of synchronized, jerk-limited joint space movements.
+ *
+ * Each queued target adds a rest-to-rest segment along a straight line in joint
+ * space. All joints share a single seven-phase (S-curve) time law, scaled so
+ * that no joint exceeds its velocity, acceleration and jerk limits, hence they
+ * start and stop at once. Segments are executed one after another.
+ *
+ * Targets can be appended while the motion is being evaluated from another
+ * thread. Storage is reserved on @ref reset, neither call allocates afterwards.
+ */
+class JointTrajectory
+{
+public:
+    //! Maximum number of segments being executed or waiting for execution.
+    static constexpr int CAPACITY = 32;
+
+    /**
+     * @brief Start anew from the given joint positions, dropping pending segments.
+     *
+     * @param q Current joint positions [deg].
+     * @param qdotMax Joint velocity limits [deg/s].
+     * @param qddotMax Joint acceleration limits [deg/s^2].
+     * @param qdddotMax Joint jerk limits [deg/s^3].
+     */
+    void reset(const std::vector<double> & q, const std::vector<double> & qdotMax,
+               const std::vector<double> & qddotMax, const std::vector<double> & qdddotMax);
+
+    /**
+     * @brief Queue a segment from the last target towards @p qd.
+     *
+     * @param qd Target joint positions [deg], joints beyond its size keep their
+     * current target.
+     * @param now Current time [s], the segment never starts in the past.
+     *
+     * @return false if the queue is full, @p qd is too long, a limit of a moving
+     * joint is not positive or the trajectory has already finished
+     */
+    bool append(const std::vector<double> & qd, double now);
+
+    /**
+     * @brief Desired joint positions at time @p t.
+     *
+     * @return false once the last segment has ended, the trajectory is then
+     * closed and no more segments will be accepted until the next @ref reset
+     */
+    bool evaluate(double t, double * q);
+
+    //! Whether the trajectory has finished, see @ref evaluate.
+    bool isClosed() const;
+
+    //! Joint positions at the last queued target.
+    void getLastTarget(std::vector<double> & q) const;
+
+    //! Seven-phase time law over a unit distance, symmetric acceleration and deceleration.
+    struct Profile
+    {
+        //! Fastest profile within the given (normalized) limits, false if any of them is not positive.
+        bool configure(double maxVel, double maxAcc, double maxJerk);
+
+        //! Normalized position at time @p t, clamped to [0, 1].
+        double position(double t) const;
+
+        //! Normalized position during the acceleration phase.
+        double rampPosition(double t) const;
+
+        double jerk {0.0}, peakAcc {0.0}, peakVel {0.0};
+        double jerkTime {0.0}, rampTime {0.0}, cruiseTime {0.0}, duration {0.0}; // [s]
+    };
+
+private:
+    struct Segment
+    {
+        double start; // [s]
+        Profile profile;
+        std::vector<double> deltas;
+    };
+
+    const Segment & at(int i) const
+    { return segments[(head + i) % CAPACITY]; }
+
+    std::vector<Segment> segments; // ring buffer
+    int head {0};
+    int count {0};
+    bool closed {true};
+
+    std::vector<double> origin; // where completed segments left the joints
+    std::vector<double> tail; // where queued segments will leave the joints
+    std::vector<double> maxVel, maxAcc, maxJerk;
+
+    mutable std::mutex mutex;
+};
+
+} // namespace roboticslab
+
+#endif // __JOINT_TRAJECTORY_HPP__
@@ -0,0 +1,172 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#ifndef __LATENCY_HISTOGRAM_HPP__
+#define __LATENCY_HISTOGRAM_HPP__
+
+#include <cstdint>
+
+#include <algorithm> // std::min
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <vector>
+
+namespace roboticslab
+{
+
+/**
+ * @ingroup BasicCartesianControl
+ * @brief Lock-free latency histogram with HDR-style log-linear buckets.
+ *
+ * Durations are recorded in nanoseconds. Each power-of-two range is split into
+ * 32 linear sub-buckets, so that any reported value is within ~3% of the actual
+ * one across the whole range (up to ~2 minutes, longer durations saturate).
+ * Recording only performs relaxed atomic operations and may take place from
+ * several threads at once, i.e. the CMC thread and streaming commands.
+ */
+class LatencyHistogram
+{
+public:
+    //! Number of values returned by @ref summarize.
+    static constexpr int SUMMARY_SIZE = 7;
+
+    LatencyHistogram()
+    { reset(); }
+
+    //! Run the callable and record how long it took, return its result.
+    template <typename Fn>
+    auto measure(Fn && fn) -> decltype(fn())
+    {
+        const auto start = std::chrono::steady_clock::now();
+        auto ret = fn();
+        record(std::chrono::steady_clock::now() - start);
+        return ret;
+    }
+
+    //! Record a single duration.
+    template <typename Rep, typename Period>
+    void record(std::chrono::duration<Rep, Period> elapsed)
+    {
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+        const std::uint64_t value = ns > 0 ? ns : 0;
+
+        counts[indexOf(value)].fetch_add(1, std::memory_order_relaxed);
+
+        auto prev = minimum.load(std::memory_order_relaxed);
+        while (value < prev && !minimum.compare_exchange_weak(prev, value, std::memory_order_relaxed)) {}
+
+        prev = maximum.load(std::memory_order_relaxed);
+        while (value > prev && !maximum.compare_exchange_weak(prev, value, std::memory_order_relaxed)) {}
+    }
+
+    //! Discard all recorded values, concurrent records may or may not survive.
+    void reset()
+    {
+        for (auto & count : counts)
+        {
+            count.store(0, std::memory_order_relaxed);
+        }
+
+        minimum.store(std::numeric_limits<std::uint64_t>::max(), std::memory_order_relaxed);
+        maximum.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Compute a snapshot of the recorded distribution.
+     *
+     * @param out Sample count, minimum, 50th, 90th, 99th and 99.9th percentiles,
+     * maximum. All but the first value are expressed in milliseconds.
+     */
+    void summarize(std::vector<double> & out) const
+    {
+        static constexpr double QUANTILES[] = {0.5, 0.9, 0.99, 0.999};
+
+        std::array<std::uint64_t, NUM_BUCKETS> snapshot;
+        std::uint64_t total = 0;
+
+        for (int i = 0; i < NUM_BUCKETS; i++)
+        {
+            snapshot[i] = counts[i].load(std::memory_order_relaxed);
+            total += snapshot[i];
+        }
+
+        out.assign(SUMMARY_SIZE, 0.0);
+
+        if (total == 0)
+        {
+            return;
+        }
+
+        const std::uint64_t max = maximum.load(std::memory_order_relaxed);
+
+        out[0] = total;
+        out[1] = toMs(minimum.load(std::memory_order_relaxed));
+        out[SUMMARY_SIZE - 1] = toMs(max);
+
+        std::uint64_t accumulated = 0;
+        int bucket = 0;
+
+        for (int q = 0; q < 4; q++)
+        {
+            // smallest recorded value such that a fraction q of all samples is at or below it
+            const auto rank = std::max<std::uint64_t>(static_cast<std::uint64_t>(QUANTILES[q] * total + 0.5), 1);
+
+            while (accumulated + snapshot[bucket] < rank && bucket < NUM_BUCKETS - 1)
+            {
+                accumulated += snapshot[bucket++];
+            }
+
+            out[2 + q] = toMs(std::min(highestEquivalentValue(bucket), max));
+        }
+    }
+
+private:
+    static constexpr int SUB_BUCKET_BITS = 5;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr int MAX_EXPONENT = 36; // 2^37 ns ~ 137 s
+    static constexpr int NUM_BUCKETS = (MAX_EXPONENT - SUB_BUCKET_BITS + 2) << SUB_BUCKET_BITS;
+
+    static int indexOf(std::uint64_t value)
+    {
+        if (value < SUB_BUCKETS)
+        {
+            return value;
+        }
+
+        int exponent = SUB_BUCKET_BITS;
+
+        while ((value >> (exponent + 1)) != 0)
+        {
+            exponent++;
+        }
+
+        const int shift = exponent - SUB_BUCKET_BITS;
+        const int index = ((shift + 1) << SUB_BUCKET_BITS) + static_cast<int>((value >> shift) - SUB_BUCKETS);
+        return std::min(index, NUM_BUCKETS - 1);
+    }
+
+    static std::uint64_t highestEquivalentValue(int index)
+    {
+        if (index < 2 * SUB_BUCKETS)
+        {
+            return index;
+        }
+
+        const int shift = (index >> SUB_BUCKET_BITS) - 1;
+        const std::uint64_t subBucket = index & (SUB_BUCKETS - 1);
+        return ((SUB_BUCKETS + subBucket + 1) << shift) - 1;
+    }
+
+    static double toMs(std::uint64_t ns)
+    {
+        return ns * 1e-6;
+    }
+
+    std::array<std::atomic<std::uint64_t>, NUM_BUCKETS> counts;
+    std::atomic<std::uint64_t> minimum, maximum;
+};
+
+} // namespace roboticslab
+
+#endif // __LATENCY_HISTOGRAM_HPP__
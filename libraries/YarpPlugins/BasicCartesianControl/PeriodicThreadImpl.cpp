@@ -2,34 +2,280 @@
 
 #include "BasicCartesianControl.hpp"
 
+#if defined(__linux__)
+# include <malloc.h> // mallopt
+# include <pthread.h>
+# include <sched.h>
+# include <sys/mman.h> // mlockall
+# include <sys/syscall.h>
+# include <unistd.h> // syscall, sysconf
+#endif
+
+#include <cerrno>
+#include <cmath> // std::fmod
+#include <cstdint>
+#include <cstring> // std::strerror
+
+#include <algorithm> // std::min, std::max
+#include <chrono>
+
 #include <yarp/os/LogStream.h>
 #include <yarp/os/Time.h>
 
-#include "KdlVectorConverter.hpp"
 #include "LogComponent.hpp"
 
 using namespace roboticslab;
 
+// -----------------------------------------------------------------------------
+
+namespace
+{
+    // stack pages touched by the CMC thread on startup so that they are resident before the first iteration
+    constexpr std::size_t PREFAULT_STACK_SIZE = 128 * 1024;
+
+#if defined(__linux__)
+# ifndef SCHED_DEADLINE
+    constexpr int SCHED_DEADLINE = 6;
+# endif
+
+    // see sched_setattr(2), not wrapped by glibc until 2.41
+    struct deadline_attributes
+    {
+        std::uint32_t size;
+        std::uint32_t sched_policy;
+        std::uint64_t sched_flags;
+        std::int32_t sched_nice;
+        std::uint32_t sched_priority;
+        std::uint64_t sched_runtime; // [ns]
+        std::uint64_t sched_deadline; // [ns]
+        std::uint64_t sched_period; // [ns]
+    };
+#endif
+
+    bool lockMemory()
+    {
+#if defined(__linux__)
+        if (::mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+        {
+            yCWarning(BCC) << "mlockall() failed:" << std::strerror(errno);
+            return false;
+        }
+
+# if defined(__GLIBC__)
+        // keep freed memory in the (already locked) heap instead of giving it back to the system
+        ::mallopt(M_TRIM_THRESHOLD, -1);
+        ::mallopt(M_MMAP_MAX, 0);
+# endif
+
+        volatile unsigned char stack[PREFAULT_STACK_SIZE];
+        const long pageSize = ::sysconf(_SC_PAGESIZE);
+
+        for (std::size_t i = 0; i < PREFAULT_STACK_SIZE; i += pageSize)
+        {
+            stack[i] = 0;
+        }
+
+        return true;
+#else
+        yCWarning(BCC) << "Memory locking is not supported on this platform";
+        return false;
+#endif
+    }
+
+    bool pinCurrentThread(const std::vector<int> & cpus)
+    {
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+
+        for (auto cpu : cpus)
+        {
+            if (cpu >= CPU_SETSIZE)
+            {
+                yCWarning(BCC) << "CPU index out of range:" << cpu;
+                return false;
+            }
+
+            CPU_SET(cpu, &set);
+        }
+
+        int ret = ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set);
+
+        if (ret != 0)
+        {
+            yCWarning(BCC) << "pthread_setaffinity_np() failed:" << std::strerror(ret);
+            return false;
+        }
+
+        return true;
+#else
+        yCWarning(BCC) << "CPU pinning is not supported on this platform";
+        return false;
+#endif
+    }
+
+    bool setFifoScheduler(int priority)
+    {
+#if defined(__linux__)
+        sched_param param {};
+        param.sched_priority = priority;
+
+        int ret = ::pthread_setschedparam(::pthread_self(), SCHED_FIFO, &param);
+
+        if (ret != 0)
+        {
+            yCWarning(BCC) << "pthread_setschedparam() failed:" << std::strerror(ret);
+            return false;
+        }
+
+        return true;
+#else
+        yCWarning(BCC) << "SCHED_FIFO is not supported on this platform";
+        return false;
+#endif
+    }
+
+    bool setDeadlineScheduler(double runtime, double period)
+    {
+#if defined(__linux__) && defined(SYS_sched_setattr)
+        deadline_attributes attr {};
+        attr.size = sizeof(attr);
+        attr.sched_policy = SCHED_DEADLINE;
+        attr.sched_runtime = runtime * 1e9;
+        attr.sched_deadline = attr.sched_period = period * 1e9;
+
+        if (::syscall(SYS_sched_setattr, 0, &attr, 0) != 0)
+        {
+            yCWarning(BCC) << "sched_setattr() failed:" << std::strerror(errno);
+            return false;
+        }
+
+        return true;
+#else
+        yCWarning(BCC) << "SCHED_DEADLINE is not supported on this platform";
+        return false;
+#endif
+    }
+}
+
 // ------------------- PeriodicThread Related ------------------------------------
 
+bool BasicCartesianControl::threadInit()
+{
+    bool ok = true;
+
+    if (cmcLockMemory)
+    {
+        ok = lockMemory() && ok;
+    }
+
+    if (!cmcCpus.empty())
+    {
+        ok = pinCurrentThread(cmcCpus) && ok;
+    }
+
+    if (cmcScheduler != cmc_scheduler::OTHER && !applyCmcScheduler())
+    {
+        // still running with the default policy
+        cmcScheduler = cmc_scheduler::OTHER;
+        ok = false;
+    }
+
+    if (!ok)
+    {
+        if (cmcRequireRealTime)
+        {
+            yCError(BCC) << "Unable to apply real-time settings to the CMC thread";
+            return false;
+        }
+
+        // fail safe: keep running under whatever settings could be applied
+        yCWarning(BCC) << "Real-time settings not fully applied (missing privileges?), CMC timing is not guaranteed";
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+bool BasicCartesianControl::applyCmcScheduler()
+{
+    const double period = yarp::os::PeriodicThread::getPeriod();
+    cmcSchedulerAttempt = period;
+
+    switch (cmcScheduler)
+    {
+    case cmc_scheduler::FIFO:
+        if (!setFifoScheduler(cmcPriority))
+        {
+            return false;
+        }
+
+        yCInfo(BCC) << "CMC thread running with SCHED_FIFO, priority" << cmcPriority;
+        return true;
+    case cmc_scheduler::DEADLINE:
+    {
+        const double runtime = cmcRuntimeUs > 0 ? cmcRuntimeUs * 1e-6 : period * 0.5;
+
+        if (!setDeadlineScheduler(runtime, period))
+        {
+            return false;
+        }
+
+        yCInfo(BCC, "CMC thread running with SCHED_DEADLINE, runtime %.0f us every %.0f us", runtime * 1e6, period * 1e6);
+        cmcSchedulerPeriod = period;
+        return true;
+    }
+    default:
+        return true;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
 void BasicCartesianControl::run()
+{
+    const double period = yarp::os::PeriodicThread::getPeriod();
+
+    if (cmcScheduler == cmc_scheduler::DEADLINE && period != cmcSchedulerPeriod && period != cmcSchedulerAttempt)
+    {
+        // the CMC period has changed, renew the bandwidth reservation from within the thread;
+        // on failure, do not insist until the period changes again
+        if (!applyCmcScheduler())
+        {
+            yCWarning(BCC, "Unable to renew SCHED_DEADLINE reservation for a period of %.0f us, keeping the one for %.0f us",
+                period * 1e6, cmcSchedulerPeriod * 1e6);
+        }
+    }
+
+    const double start = yarp::os::Time::now();
+    handleCurrentState();
+    updateCmcStats(start, yarp::os::Time::now());
+}
+
+// -----------------------------------------------------------------------------
+
+void BasicCartesianControl::handleCurrentState()
 {
     const int currentState = getCurrentState();
 
     if (currentState == VOCAB_CC_NOT_CONTROLLING)
     {
+        if (streamInterpolation)
+        {
+            handleStreaming();
+        }
+
         return;
     }
 
-    std::vector<double> q(numRobotJoints);
-
-    if (!iEncoders->getEncoders(q.data()))
+    if (!latencies[ENCODERS].measure([this] { return iEncoders->getEncoders(qCmc.data()); }))
     {
         yCError(BCC) << "getEncoders() failed, unable to check joint limits";
         return;
     }
 
-    if (!checkJointLimits(q))
+    if (!latencies[CHECKS].measure([this] { return checkJointLimits(qCmc); }))
     {
         yCError(BCC) << "checkJointLimits() failed, stopping control";
         cmcSuccess = false;
@@ -40,19 +286,36 @@ void BasicCartesianControl::run()
     switch (currentState)
     {
     case VOCAB_CC_MOVJ_CONTROLLING:
-        handleMovj(q);
+        if (movjDirect)
+        {
+            handleMovjDirect(qCmc);
+        }
+        else
+        {
+            handleMovj(qCmc);
+        }
         break;
     case VOCAB_CC_MOVL_CONTROLLING:
-        handleMovl(q);
+        if (movlDirect)
+        {
+            handleMovlDirect(qCmc);
+        }
+        else
+        {
+            handleMovl(qCmc);
+        }
         break;
     case VOCAB_CC_MOVV_CONTROLLING:
-        handleMovv(q);
+        handleMovv(qCmc);
+        break;
+    case VOCAB_CC_MOVW_CONTROLLING:
+        handleMovw(qCmc);
         break;
     case VOCAB_CC_GCMP_CONTROLLING:
-        handleGcmp(q);
+        handleGcmp(qCmc);
         break;
     case VOCAB_CC_FORC_CONTROLLING:
-        handleForc(q);
+        handleForc(qCmc);
         break;
     default:
         break;
@@ -61,9 +324,159 @@ void BasicCartesianControl::run()
 
 // -----------------------------------------------------------------------------
 
+void BasicCartesianControl::updateCmcStats(double start, double end)
+{
+    const double period = yarp::os::PeriodicThread::getPeriod();
+    const double runTime = end - start;
+
+    // iterations are due at fixed multiples of the period (absolute clock), restart
+    // the reference on the first iteration and whenever the period changes
+    if (period != cmcSchedulePeriod)
+    {
+        cmcScheduleOrigin = start;
+        cmcSchedulePeriod = period;
+    }
+
+    // distance to the nearest slot
+    double offset = std::fmod(start - cmcScheduleOrigin, period);
+    double jitter = std::min(offset, period - offset);
+
+    std::lock_guard<std::mutex> lock(statsMutex);
+
+    latencies[TICK].record(std::chrono::duration<double>(runTime));
+
+    cmcStats.ticks++;
+    cmcStats.runTimeSum += runTime;
+    cmcStats.runTimeMax = std::max(cmcStats.runTimeMax, runTime);
+    cmcStats.jitterSum += jitter;
+    cmcStats.jitterMax = std::max(cmcStats.jitterMax, jitter);
+
+    if (runTime > period)
+    {
+        cmcStats.overruns++;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void BasicCartesianControl::handleStreaming()
+{
+    const int command = streamingCommand;
+
+    if (command != VOCAB_CC_POSE && command != VOCAB_CC_MOVI)
+    {
+        return;
+    }
+
+    double * x = command == VOCAB_CC_POSE ? desiredX.data() : commandQ.data();
+    double * xdot = command == VOCAB_CC_POSE ? desiredXdot.data() : nullptr;
+
+    //-- Idle until the first target arrives
+    if (!streamTarget.evaluate(yarp::os::Time::now(), x, streamOffset.data(), xdot))
+    {
+        return;
+    }
+
+    if (!latencies[ENCODERS].measure([this] { return iEncoders->getEncoders(qCmc.data()); }))
+    {
+        yCWarning(BCC) << "getEncoders() failed, not updating control this iteration";
+        return;
+    }
+
+    if (command == VOCAB_CC_POSE)
+    {
+        handlePoseStream(qCmc);
+    }
+    else
+    {
+        handleMoviStream(qCmc);
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void BasicCartesianControl::handlePoseStream(const std::vector<double> &q)
+{
+    if (!latencies[CHECKS].measure([this] { return checkControlModes(VOCAB_CM_VELOCITY); }))
+    {
+        yCError(BCC) << "Not in velocity control mode, dropping streamed target";
+        streamTarget.reset();
+        return;
+    }
+
+    if (!latencies[FWD_KIN].measure([this, &q] { return iCartesianSolver->fwdKin(q, currentX); }))
+    {
+        yCWarning(BCC) << "fwdKin() failed, not updating control this iteration";
+        return;
+    }
+
+    //-- Same control law as MOVL, the desired pose is extrapolated from the latest target.
+    latencies[POSE_DIFF].measure([this] { return iCartesianSolver->poseDiff(desiredX, currentX, commandXdot); });
+
+    for (unsigned int i = 0; i < commandXdot.size(); i++)
+    {
+        commandXdot[i] += streamOffset[i];
+        commandXdot[i] *= gain * (1000.0 / cmcPeriodMs);
+        commandXdot[i] += desiredXdot[i];
+    }
+
+    if (!latencies[INV_KIN].measure([this, &q] { return iCartesianSolver->diffInvKin(q, commandXdot, commandQdot); }))
+    {
+        yCWarning(BCC) << "diffInvKin() failed, not updating control this iteration";
+        return;
+    }
+
+    if (!latencies[CHECKS].measure([this, &q] { return checkJointLimits(q, commandQdot) && checkJointVelocities(commandQdot); }))
+    {
+        yCError(BCC) << "Joint position or velocity limits exceeded, stopping until the next target";
+        iVelocityControl->velocityMove(zeroQdot.data());
+        streamTarget.reset();
+        return;
+    }
+
+    if (!latencies[SEND].measure([this] { return iVelocityControl->velocityMove(commandQdot.data()); }))
+    {
+        yCWarning(BCC) << "velocityMove() failed, not updating control this iteration";
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void BasicCartesianControl::handleMoviStream(const std::vector<double> &q)
+{
+    if (!latencies[CHECKS].measure([this] { return checkControlModes(VOCAB_CM_POSITION_DIRECT); }))
+    {
+        yCError(BCC) << "Not in position direct control mode, dropping streamed target";
+        streamTarget.reset();
+        return;
+    }
+
+    //-- Joint targets are extrapolated in joint space, the offset buffer then holds the command increment;
+    //-- extrapolation may overshoot a target close to a limit, never command beyond it
+    for (int joint = 0; joint < numRobotJoints; joint++)
+    {
+        commandQ[joint] = std::min(std::max(commandQ[joint] + streamOffset[joint], qMin[joint]), qMax[joint]);
+        streamOffset[joint] = commandQ[joint] - q[joint];
+    }
+
+    if (!latencies[CHECKS].measure([this, &q] { return checkJointLimits(q, streamOffset); }))
+    {
+        yCError(BCC) << "Joint position limits exceeded, not moving until the next target";
+        streamTarget.reset();
+        return;
+    }
+
+    if (!latencies[SEND].measure([this] { return iPositionDirect->setPositions(commandQ.data()); }))
+    {
+        yCWarning(BCC) << "setPositions() failed, not updating control this iteration";
+    }
+}
+
+// -----------------------------------------------------------------------------
+
 void BasicCartesianControl::handleMovj(const std::vector<double> &q)
 {
-    if (!checkControlModes(VOCAB_CM_POSITION))
+    if (!latencies[CHECKS].measure([this] { return checkControlModes(VOCAB_CM_POSITION); }))
     {
         yCError(BCC) << "Not in position control mode";
         cmcSuccess = false;
@@ -94,11 +507,11 @@ void BasicCartesianControl::handleMovj(const std::vector<double> &q)
 
 // -----------------------------------------------------------------------------
 
-void BasicCartesianControl::handleMovl(const std::vector<double> &q)
+void BasicCartesianControl::handleMovjDirect(const std::vector<double> &q)
 {
-    if (!checkControlModes(VOCAB_CM_VELOCITY))
+    if (!latencies[CHECKS].measure([this] { return checkControlModes(VOCAB_CM_POSITION_DIRECT); }))
     {
-        yCError(BCC) << "Not in velocity control mode";
+        yCError(BCC) << "Not in position direct control mode";
         cmcSuccess = false;
         stopControl();
         return;
@@ -106,38 +519,54 @@ void BasicCartesianControl::handleMovl(const std::vector<double> &q)
 
     double movementTime = yarp::os::Time::now() - movementStartTime;
 
-    std::vector<double> desiredX, desiredXdot;
+    //-- Stream the trajectory, the final setpoint is sent as well
+    bool moving = jointTrajectory.evaluate(movementTime, commandQ.data());
 
-    for (const auto & trajectory : trajectories)
+    if (!latencies[SEND].measure([this] { return iPositionDirect->setPositions(commandQ.data()); }))
     {
-        if (movementTime > trajectory->Duration())
-        {
-            stopControl();
-            return;
-        }
+        yCWarning(BCC) << "setPositions() failed, not updating control this iteration";
+    }
 
-        //-- Obtain desired Cartesian position and velocity.
-        KDL::Frame H = trajectory->Pos(movementTime);
-        KDL::Twist tw = trajectory->Vel(movementTime);
+    if (!moving)
+    {
+        stopControl();
+    }
+}
 
-        std::vector<double> desiredX_sub = KdlVectorConverter::frameToVector(H);
-        std::vector<double> desiredXdot_sub = KdlVectorConverter::twistToVector(tw);
+// -----------------------------------------------------------------------------
 
-        desiredX.insert(desiredX.end(), desiredX_sub.cbegin(), desiredX_sub.cend());
-        desiredXdot.insert(desiredXdot.end(), desiredXdot_sub.cbegin(), desiredXdot_sub.cend());
+void BasicCartesianControl::handleMovl(const std::vector<double> &q)
+{
+    if (!latencies[CHECKS].measure([this] { return checkControlModes(VOCAB_CM_VELOCITY); }))
+    {
+        yCError(BCC) << "Not in velocity control mode";
+        cmcSuccess = false;
+        stopControl();
+        return;
+    }
+
+    double movementTime = yarp::os::Time::now() - movementStartTime;
+
+    if (movementTime > trajectory.getDuration())
+    {
+        stopControl();
+        return;
     }
 
-    std::vector<double> currentX;
+    desiredX.resize(6 * trajectory.getNumTcps());
+    desiredXdot.resize(6 * trajectory.getNumTcps());
 
-    if (!iCartesianSolver->fwdKin(q, currentX))
+    //-- Obtain desired Cartesian position and velocity.
+    trajectory.evaluate(movementTime, desiredX.data(), desiredXdot.data());
+
+    if (!latencies[FWD_KIN].measure([this, &q] { return iCartesianSolver->fwdKin(q, currentX); }))
     {
         yCWarning(BCC) << "fwdKin() failed, not updating control this iteration";
         return;
     }
 
     //-- Apply control law to compute robot Cartesian velocity commands.
-    std::vector<double> commandXdot;
-    iCartesianSolver->poseDiff(desiredX, currentX, commandXdot);
+    latencies[POSE_DIFF].measure([this] { return iCartesianSolver->poseDiff(desiredX, currentX, commandXdot); });
 
     for (unsigned int i = 0; i < commandXdot.size(); i++)
     {
@@ -146,9 +575,7 @@ void BasicCartesianControl::handleMovl(const std::vector<double> &q)
     }
 
     //-- Compute joint velocity commands and send to robot.
-    std::vector<double> commandQdot;
-
-    if (!iCartesianSolver->diffInvKin(q, commandXdot, commandQdot))
+    if (!latencies[INV_KIN].measure([this, &q] { return iCartesianSolver->diffInvKin(q, commandXdot, commandQdot); }))
     {
         yCWarning(BCC) << "diffInvKin() failed, not updating control this iteration";
         return;
@@ -156,7 +583,7 @@ void BasicCartesianControl::handleMovl(const std::vector<double> &q)
 
     yCDebug(BCC) << "[MOVL]" << movementTime << "||" << commandXdot << "->" << commandQdot << "[deg/s]";
 
-    if (!checkJointVelocities(commandQdot))
+    if (!latencies[CHECKS].measure([this] { return checkJointVelocities(commandQdot); }))
     {
         yCError(BCC) << "diffInvKin() too dangerous, stopping";
         cmcSuccess = false;
@@ -164,7 +591,7 @@ void BasicCartesianControl::handleMovl(const std::vector<double> &q)
         return;
     }
 
-    if (!iVelocityControl->velocityMove(commandQdot.data()))
+    if (!latencies[SEND].measure([this] { return iVelocityControl->velocityMove(commandQdot.data()); }))
     {
         yCWarning(BCC) << "velocityMove() failed, not updating control this iteration";
     }
@@ -172,9 +599,37 @@ void BasicCartesianControl::handleMovl(const std::vector<double> &q)
 
 // -----------------------------------------------------------------------------
 
+void BasicCartesianControl::handleMovlDirect(const std::vector<double> &q)
+{
+    if (!latencies[CHECKS].measure([this] { return checkControlModes(VOCAB_CM_POSITION_DIRECT); }))
+    {
+        yCError(BCC) << "Not in position direct control mode";
+        cmcSuccess = false;
+        stopControl();
+        return;
+    }
+
+    double movementTime = yarp::os::Time::now() - movementStartTime;
+
+    //-- Joint positions were solved and checked beforehand, just interpolate
+    jointPath.evaluate(movementTime, commandQ.data());
+
+    if (!latencies[SEND].measure([this] { return iPositionDirect->setPositions(commandQ.data()); }))
+    {
+        yCWarning(BCC) << "setPositions() failed, not updating control this iteration";
+    }
+
+    if (movementTime > jointPath.getDuration())
+    {
+        stopControl();
+    }
+}
+
+// -----------------------------------------------------------------------------
+
 void BasicCartesianControl::handleMovv(const std::vector<double> &q)
 {
-    if (!checkControlModes(VOCAB_CM_VELOCITY))
+    if (!latencies[CHECKS].measure([this] { return checkControlModes(VOCAB_CM_VELOCITY); }))
     {
         yCError(BCC) << "Not in velocity control mode";
         cmcSuccess = false;
@@ -184,33 +639,82 @@ void BasicCartesianControl::handleMovv(const std::vector<double> &q)
 
     double movementTime = yarp::os::Time::now() - movementStartTime;
 
-    std::vector<double> currentX;
-
-    if (!iCartesianSolver->fwdKin(q, currentX))
+    if (!latencies[FWD_KIN].measure([this, &q] { return iCartesianSolver->fwdKin(q, currentX); }))
     {
         yCWarning(BCC) << "fwdKin() failed, not updating control this iteration";
         return;
     }
 
+    desiredX.resize(6 * twistTrajectory.getNumTcps());
+    desiredXdot.resize(6 * twistTrajectory.getNumTcps());
+
     //-- Obtain desired Cartesian position and velocity.
-    std::vector<double> desiredX, desiredXdot;
+    twistTrajectory.evaluate(movementTime, desiredX.data(), desiredXdot.data());
 
-    for (const auto & trajectory : trajectories)
+    //-- Apply control law to compute robot Cartesian velocity commands.
+    latencies[POSE_DIFF].measure([this] { return iCartesianSolver->poseDiff(desiredX, currentX, commandXdot); });
+
+    for (unsigned int i = 0; i < commandXdot.size(); i++)
     {
-        //-- Obtain desired Cartesian position and velocity.
-        KDL::Frame H = trajectory->Pos(movementTime);
-        KDL::Twist tw = trajectory->Vel(movementTime);
+        commandXdot[i] *= gain * (1000.0 / cmcPeriodMs);
+        commandXdot[i] += desiredXdot[i];
+    }
 
-        std::vector<double> desiredX_sub = KdlVectorConverter::frameToVector(H);
-        std::vector<double> desiredXdot_sub = KdlVectorConverter::twistToVector(tw);
+    //-- Compute joint velocity commands and send to robot.
+    if (!latencies[INV_KIN].measure([this, &q] { return iCartesianSolver->diffInvKin(q, commandXdot, commandQdot, referenceFrame); }))
+    {
+        yCWarning(BCC) << "diffInvKin() failed, not updating control this iteration";
+        return;
+    }
+
+    yCDebug(BCC) << "[MOVV]" << movementTime << "||" << commandXdot << "->" << commandQdot << "[deg/s]";
 
-        desiredX.insert(desiredX.end(), desiredX_sub.cbegin(), desiredX_sub.cend());
-        desiredXdot.insert(desiredXdot.end(), desiredXdot_sub.cbegin(), desiredXdot_sub.cend());
+    if (!latencies[CHECKS].measure([this] { return checkJointVelocities(commandQdot); }))
+    {
+        yCError(BCC) << "diffInvKin() too dangerous, stopping";
+        cmcSuccess = false;
+        stopControl();
+        return;
+    }
+
+    if (!latencies[SEND].measure([this] { return iVelocityControl->velocityMove(commandQdot.data()); }))
+    {
+        yCWarning(BCC) << "velocityMove() failed, not updating control this iteration";
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void BasicCartesianControl::handleMovw(const std::vector<double> &q)
+{
+    if (!latencies[CHECKS].measure([this] { return checkControlModes(VOCAB_CM_VELOCITY); }))
+    {
+        yCError(BCC) << "Not in velocity control mode";
+        cmcSuccess = false;
+        stopControl();
+        return;
+    }
+
+    double movementTime = yarp::os::Time::now() - movementStartTime;
+
+    desiredX.resize(currentX.size());
+    desiredXdot.resize(currentX.size());
+
+    //-- Obtain desired Cartesian position and velocity, stop once the last waypoint is reached.
+    if (!waypoints.evaluate(movementTime, desiredX.data(), desiredXdot.data()))
+    {
+        stopControl();
+        return;
+    }
+
+    if (!latencies[FWD_KIN].measure([this, &q] { return iCartesianSolver->fwdKin(q, currentX); }))
+    {
+        yCWarning(BCC) << "fwdKin() failed, not updating control this iteration";
+        return;
     }
 
     //-- Apply control law to compute robot Cartesian velocity commands.
-    std::vector<double> commandXdot;
-    iCartesianSolver->poseDiff(desiredX, currentX, commandXdot);
+    latencies[POSE_DIFF].measure([this] { return iCartesianSolver->poseDiff(desiredX, currentX, commandXdot); });
 
     for (unsigned int i = 0; i < commandXdot.size(); i++)
     {
@@ -219,17 +723,15 @@ void BasicCartesianControl::handleMovv(const std::vector<double> &q)
     }
 
     //-- Compute joint velocity commands and send to robot.
-    std::vector<double> commandQdot;
-
-    if (!iCartesianSolver->diffInvKin(q, commandXdot, commandQdot, referenceFrame))
+    if (!latencies[INV_KIN].measure([this, &q] { return iCartesianSolver->diffInvKin(q, commandXdot, commandQdot); }))
     {
         yCWarning(BCC) << "diffInvKin() failed, not updating control this iteration";
         return;
     }
 
-    yCDebug(BCC) << "[MOVV]" << movementTime << "||" << commandXdot << "->" << commandQdot << "[deg/s]";
+    yCDebug(BCC) << "[MOVW]" << movementTime << "||" << commandXdot << "->" << commandQdot << "[deg/s]";
 
-    if (!checkJointVelocities(commandQdot))
+    if (!latencies[CHECKS].measure([this] { return checkJointVelocities(commandQdot); }))
     {
         yCError(BCC) << "diffInvKin() too dangerous, stopping";
         cmcSuccess = false;
@@ -237,7 +739,7 @@ void BasicCartesianControl::handleMovv(const std::vector<double> &q)
         return;
     }
 
-    if (!iVelocityControl->velocityMove(commandQdot.data()))
+    if (!latencies[SEND].measure([this] { return iVelocityControl->velocityMove(commandQdot.data()); }))
     {
         yCWarning(BCC) << "velocityMove() failed, not updating control this iteration";
     }
@@ -247,22 +749,20 @@ void BasicCartesianControl::handleMovv(const std::vector<double> &q)
 
 void BasicCartesianControl::handleGcmp(const std::vector<double> &q)
 {
-    if (!checkControlModes(VOCAB_CM_TORQUE))
+    if (!latencies[CHECKS].measure([this] { return checkControlModes(VOCAB_CM_TORQUE); }))
     {
         yCError(BCC) << "Not in torque control mode";
         stopControl();
         return;
     }
 
-    std::vector<double> t(numRobotJoints);
-
-    if (!iCartesianSolver->invDyn(q, t))
+    if (!latencies[INV_KIN].measure([this, &q] { return iCartesianSolver->invDyn(q, commandTorques); }))
     {
         yCWarning(BCC) << "invDyn() failed, not updating control this iteration";
         return;
     }
 
-    if (!iTorqueControl->setRefTorques(t.data()))
+    if (!latencies[SEND].measure([this] { return iTorqueControl->setRefTorques(commandTorques.data()); }))
     {
         yCWarning(BCC) << "setRefTorques() failed, not updating control this iteration";
     }
@@ -272,32 +772,23 @@ void BasicCartesianControl::handleGcmp(const std::vector<double> &q)
 
 void BasicCartesianControl::handleForc(const std::vector<double> &q)
 {
-    if (!checkControlModes(VOCAB_CM_TORQUE))
+    if (!latencies[CHECKS].measure([this] { return checkControlModes(VOCAB_CM_TORQUE); }))
     {
         yCError(BCC) << "Not in torque control mode";
         stopControl();
         return;
     }
 
-    std::vector<double> qdot(numRobotJoints, 0), qdotdot(numRobotJoints, 0);
-    std::vector< std::vector<double> > fexts;
-
-    for (int i = 0; i < numRobotJoints - 1; i++)  //-- "numRobotJoints-1" is important
-    {
-        fexts.emplace_back(6, 0);
-    }
-
-    fexts.push_back(td);
-
-    std::vector<double> t(numRobotJoints);
+    //-- Only the last segment is subject to an external wrench
+    fexts.back() = td;
 
-    if (!iCartesianSolver->invDyn(q, qdot, qdotdot, fexts, t))
+    if (!latencies[INV_KIN].measure([this, &q] { return iCartesianSolver->invDyn(q, zeroQdot, zeroQdot, fexts, commandTorques); }))
     {
         yCWarning(BCC) << "invDyn() failed, not updating control this iteration";
         return;
     }
 
-    if (!iTorqueControl->setRefTorques(t.data()))
+    if (!latencies[SEND].measure([this] { return iTorqueControl->setRefTorques(commandTorques.data()); }))
     {
         yCWarning(BCC) << "setRefTorques() failed, not updating control this iteration";
     }
@@ -0,0 +1,135 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#include "SampledTrajectory.hpp"
+
+#include <cmath> // std::ceil, std::isfinite, std::sqrt
+
+#include <algorithm> // std::copy, std::fill, std::max, std::min
+
+#include <kdl/utilities/utility.h> // KDL::PI
+
+#include "KdlVectorConverter.hpp"
+
+using namespace roboticslab;
+
+// -----------------------------------------------------------------------------
+
+namespace
+{
+    // ~1 minute at 1 ms (~6 MiB per TCP), longer trajectories are sampled more sparsely
+    constexpr int MAX_SAMPLES = 65536;
+
+    // pick the equivalent rotation vector (axis flipped, angle 2*pi - angle) that
+    // lies closest to the previous sample, required around angles of pi
+    void unwrapRotation(const double * prev, double * r)
+    {
+        const double dot = prev[0] * r[0] + prev[1] * r[1] + prev[2] * r[2];
+        const double norm = std::sqrt(r[0] * r[0] + r[1] * r[1] + r[2] * r[2]);
+        const double prevNorm = std::sqrt(prev[0] * prev[0] + prev[1] * prev[1] + prev[2] * prev[2]);
+
+        // opposite vectors near the identity mean a legit crossing through zero
+        if (dot < 0.0 && norm + prevNorm > KDL::PI)
+        {
+            const double factor = (norm - 2.0 * KDL::PI) / norm;
+
+            for (int i = 0; i < 3; i++)
+            {
+                r[i] *= factor;
+            }
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+bool SampledTrajectory::configure(const std::vector<std::unique_ptr<KDL::Trajectory>> & trajectories, double _step)
+{
+    clear();
+
+    if (trajectories.empty() || _step <= 0.0)
+    {
+        return false;
+    }
+
+    double _duration = 0.0;
+
+    for (const auto & trajectory : trajectories)
+    {
+        _duration = std::max(_duration, trajectory->Duration());
+    }
+
+    if (!std::isfinite(_duration))
+    {
+        return false;
+    }
+
+    width = 6 * trajectories.size();
+    numSamples = std::min<double>(std::ceil(_duration / _step), MAX_SAMPLES - 1) + 1;
+    step = numSamples > 1 ? _duration / (numSamples - 1) : _step; // last sample at the very end
+    duration = _duration;
+
+    poses.resize(numSamples * width);
+    twists.resize(numSamples * width);
+
+    for (int k = 0; k < numSamples; k++)
+    {
+        const double t = k * step;
+        double * pose = poses.data() + k * width;
+        double * twist = twists.data() + k * width;
+
+        for (int i = 0; i < width / 6; i++)
+        {
+            KdlVectorConverter::frameToVector(trajectories[i]->Pos(t), pose + 6 * i);
+            KdlVectorConverter::twistToVector(trajectories[i]->Vel(t), twist + 6 * i);
+
+            if (k != 0)
+            {
+                unwrapRotation(pose - width + 6 * i + 3, pose + 6 * i + 3);
+            }
+        }
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+void SampledTrajectory::clear()
+{
+    width = numSamples = 0;
+    step = duration = 0.0;
+    poses.clear();
+    twists.clear();
+}
+
+// -----------------------------------------------------------------------------
+
+void SampledTrajectory::evaluate(double t, double * x, double * xdot) const
+{
+    if (numSamples == 0)
+    {
+        return;
+    }
+
+    if (t >= duration || numSamples == 1)
+    {
+        std::copy(poses.end() - width, poses.end(), x);
+        std::fill(xdot, xdot + width, 0.0);
+        return;
+    }
+
+    const double position = std::max(t, 0.0) / step;
+    const int k = std::min(static_cast<int>(position), numSamples - 2);
+    const double alpha = position - k;
+
+    const double * pose = poses.data() + k * width;
+    const double * twist = twists.data() + k * width;
+
+    for (int j = 0; j < width; j++)
+    {
+        x[j] = pose[j] + alpha * (pose[j + width] - pose[j]);
+        xdot[j] = twist[j] + alpha * (twist[j + width] - twist[j]);
+    }
+}
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,80 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#ifndef __SAMPLED_TRAJECTORY_HPP__
+#define __SAMPLED_TRAJECTORY_HPP__
+
+#include <memory>
+#include <vector>
+
+#include <kdl/trajectory.hpp>
+
+namespace roboticslab
+{
+
+/**
+ * @ingroup BasicCartesianControl
+ * @brief Cartesian trajectories of all TCPs tabulated on a fixed time grid.
+ *
+ * Poses and twists are stored as contiguous rows of 6 * (number of TCPs)
+ * values per sample, in the representation returned by KdlVectorConverter.
+ * Rotation vectors are unwrapped so that consecutive samples never flip their
+ * axis, hence linear interpolation between rows is well-behaved.
+ */
+class SampledTrajectory
+{
+public:
+    /**
+     * @brief Evaluate the given trajectories (one per TCP) every @p step seconds.
+     *
+     * The grid is widened for long movements so that the table never exceeds
+     * a fixed number of samples.
+     *
+     * @return false if the trajectories are empty or unbounded
+     */
+    bool configure(const std::vector<std::unique_ptr<KDL::Trajectory>> & trajectories, double step);
+
+    //! Drop the current table, keeping the storage for the next movement.
+    void clear();
+
+    //! Number of TCPs covered by the table.
+    int getNumTcps() const
+    { return width / 6; }
+
+    //! Duration of the longest trajectory [s].
+    double getDuration() const
+    { return duration; }
+
+    //! Number of rows in the table.
+    int getNumSamples() const
+    { return numSamples; }
+
+    //! Time elapsed between consecutive samples [s].
+    double getStep() const
+    { return step; }
+
+    //! Poses of all TCPs at the k-th sample, 6 * @ref getNumTcps values.
+    const double * getPose(int k) const
+    { return poses.data() + k * width; }
+
+    /**
+     * @brief Interpolate pose and twist of all TCPs at time @p t.
+     *
+     * Past the end of the table the final pose is held with null twist.
+     *
+     * @param t Time since the start of the movement [s].
+     * @param x Output poses, 6 * @ref getNumTcps values.
+     * @param xdot Output twists, 6 * @ref getNumTcps values.
+     */
+    void evaluate(double t, double * x, double * xdot) const;
+
+private:
+    int width {0};
+    int numSamples {0};
+    double step {0.0}; // [s]
+    double duration {0.0}; // [s]
+    std::vector<double> poses, twists;
+};
+
+} // namespace roboticslab
+
+#endif // __SAMPLED_TRAJECTORY_HPP__
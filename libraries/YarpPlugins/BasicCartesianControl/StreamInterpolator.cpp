@@ -0,0 +1,131 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#include "StreamInterpolator.hpp"
+
+#include <algorithm> // std::copy, std::fill, std::max, std::min
+
+using namespace roboticslab;
+
+// -----------------------------------------------------------------------------
+
+void StreamInterpolator::configure(int width)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    target.assign(width, 0.0);
+    rate.assign(width, 0.0);
+    valid = false;
+}
+
+// -----------------------------------------------------------------------------
+
+void StreamInterpolator::reset()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    valid = false;
+}
+
+// -----------------------------------------------------------------------------
+
+void StreamInterpolator::setMaxExtrapolation(double value)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    maxExtrapolation = value;
+}
+
+// -----------------------------------------------------------------------------
+
+void StreamInterpolator::setMaxInterval(double value)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    maxInterval = value;
+}
+
+// -----------------------------------------------------------------------------
+
+void StreamInterpolator::push(const std::vector<double> & x, const std::vector<double> & delta, double now)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    const int width = std::min<int>(x.size(), target.size());
+    const double interval = now - stamp;
+
+    //-- A stream resumed after a pause (or just started) is not assumed to be moving
+    if (valid && interval > 0.0 && interval <= maxInterval && static_cast<int>(delta.size()) >= width)
+    {
+        for (int i = 0; i < width; i++)
+        {
+            rate[i] = delta[i] / interval;
+        }
+    }
+    else
+    {
+        std::fill(rate.begin(), rate.end(), 0.0);
+    }
+
+    std::copy(x.cbegin(), x.cbegin() + width, target.begin());
+    stamp = now;
+    valid = true;
+}
+
+// -----------------------------------------------------------------------------
+
+bool StreamInterpolator::getLastTarget(std::vector<double> & x) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (!valid)
+    {
+        return false;
+    }
+
+    x = target;
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+bool StreamInterpolator::evaluate(double now, double * x, double * dx, double * xdot) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (!valid)
+    {
+        return false;
+    }
+
+    const double elapsed = std::max(now - stamp, 0.0);
+
+    //-- Extrapolate, then wind back to the latest target, then hold it
+    double horizon, direction;
+
+    if (elapsed < maxExtrapolation)
+    {
+        horizon = elapsed;
+        direction = 1.0;
+    }
+    else if (elapsed < 2.0 * maxExtrapolation)
+    {
+        horizon = 2.0 * maxExtrapolation - elapsed;
+        direction = -1.0;
+    }
+    else
+    {
+        horizon = 0.0;
+        direction = 0.0;
+    }
+
+    for (unsigned int i = 0; i < target.size(); i++)
+    {
+        x[i] = target[i];
+        dx[i] = rate[i] * horizon;
+
+        if (xdot)
+        {
+            xdot[i] = rate[i] * direction;
+        }
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
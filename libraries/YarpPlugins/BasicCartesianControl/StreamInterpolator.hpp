@@ -0,0 +1,80 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#ifndef __STREAM_INTERPOLATOR_HPP__
+#define __STREAM_INTERPOLATOR_HPP__
+
+#include <mutex>
+#include <vector>
+
+namespace roboticslab
+{
+
+/**
+ * @ingroup BasicCartesianControl
+ * @brief Latest target of a streaming command, extrapolated between messages.
+ *
+ * Targets arrive at the client's pace, the rate of change between the last two
+ * of them is used to predict where the stream is heading until the next one
+ * comes in. Prediction never runs further than a given time past the last
+ * target (e.g. the client stopped sending or lags behind), after that it winds
+ * back at the same rate and the last target is held. Targets that arrive after
+ * a longer pause than allowed are assumed to start at rest. Differences between
+ * targets are supplied by the caller, so that orientations can be handled in the
+ * representation of choice.
+ *
+ * Targets are pushed from the streaming thread and read from the CMC thread.
+ * Storage is reserved on @ref configure, neither call allocates afterwards.
+ */
+class StreamInterpolator
+{
+public:
+    //! Reserve storage for targets of @p width values, dropping the current one.
+    void configure(int width);
+
+    //! Drop the current target, @ref evaluate fails until the next @ref push.
+    void reset();
+
+    //! Set the maximum time to extrapolate past the last target [s].
+    void setMaxExtrapolation(double value);
+
+    //! Set the longest interval between targets of a stream that is still moving [s].
+    void setMaxInterval(double value);
+
+    /**
+     * @brief Store a new target.
+     *
+     * @param x Target values.
+     * @param delta Change since the previous target, as given by @ref getLastTarget,
+     * ignored if there is none.
+     * @param now Current time [s].
+     */
+    void push(const std::vector<double> & x, const std::vector<double> & delta, double now);
+
+    //! Latest target, false if none has been pushed since the last reset.
+    bool getLastTarget(std::vector<double> & x) const;
+
+    /**
+     * @brief Predicted state of the stream at time @p now.
+     *
+     * @param x Output latest target.
+     * @param dx Output change predicted since the latest target arrived.
+     * @param xdot Output predicted rate of change, reversed while winding back
+     * and null once the latest target is held, may be nullptr.
+     *
+     * @return false if no target has been pushed since the last reset
+     */
+    bool evaluate(double now, double * x, double * dx, double * xdot) const;
+
+private:
+    std::vector<double> target, rate;
+    double stamp {0.0}; // [s]
+    double maxExtrapolation {0.0}; // [s]
+    double maxInterval {0.0}; // [s]
+    bool valid {false};
+
+    mutable std::mutex mutex;
+};
+
+} // namespace roboticslab
+
+#endif // __STREAM_INTERPOLATOR_HPP__
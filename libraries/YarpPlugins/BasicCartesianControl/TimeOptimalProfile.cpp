@@ -0,0 +1,324 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#include "TimeOptimalProfile.hpp"
+
+#include <cmath> // std::abs, std::isfinite, std::sqrt
+
+#include <algorithm> // std::max, std::min, std::swap, std::upper_bound
+#include <limits>
+
+using namespace roboticslab;
+
+// -----------------------------------------------------------------------------
+
+namespace
+{
+    constexpr double EPSILON = 1e-9;
+
+    // normalized squared path speed, caps grid points where no joint moves
+    constexpr double MAX_SQUARED_SPEED = 1e12;
+
+    constexpr int BISECTION_ITERATIONS = 60;
+
+    // narrow [uMin, uMax] so that lower <= coefficient * u <= upper
+    bool clampAcceleration(double coefficient, double lower, double upper, double & uMin, double & uMax)
+    {
+        if (std::abs(coefficient) > EPSILON)
+        {
+            double u1 = lower / coefficient;
+            double u2 = upper / coefficient;
+
+            if (coefficient < 0.0)
+            {
+                std::swap(u1, u2);
+            }
+
+            uMin = std::max(uMin, u1);
+            uMax = std::min(uMax, u2);
+            return true;
+        }
+
+        return lower <= 0.0 && upper >= 0.0;
+    }
+
+    // admissible path accelerations u at squared path speed x on the i-th interval, so that
+    // -amax <= q' * u + q'' * sd^2 <= amax holds at both ends (far end: sd^2 = x + 2 * step * u)
+    bool accelerationBounds(const std::vector<std::vector<double>> & dq, const std::vector<std::vector<double>> & ddq,
+                            const std::vector<double> & qddotMax, int i, double step, double x, double & uMin, double & uMax)
+    {
+        uMin = -std::numeric_limits<double>::infinity();
+        uMax = std::numeric_limits<double>::infinity();
+
+        for (unsigned int joint = 0; joint < dq[i].size(); joint++)
+        {
+            const double near = ddq[i][joint] * x;
+            const double far = ddq[i + 1][joint] * x;
+            const double farCoefficient = dq[i + 1][joint] + 2.0 * step * ddq[i + 1][joint];
+
+            if (!clampAcceleration(dq[i][joint], -qddotMax[joint] - near, qddotMax[joint] - near, uMin, uMax)
+                || !clampAcceleration(farCoefficient, -qddotMax[joint] - far, qddotMax[joint] - far, uMin, uMax))
+            {
+                return false;
+            }
+        }
+
+        return uMin <= uMax;
+    }
+
+    // largest squared path speed such that qdotMin <= q' * sqrt(x) <= qdotMax
+    double maxSquaredSpeed(const std::vector<double> & dq, const std::vector<double> & qdotMin, const std::vector<double> & qdotMax)
+    {
+        double speed = std::sqrt(MAX_SQUARED_SPEED);
+
+        for (unsigned int joint = 0; joint < dq.size(); joint++)
+        {
+            // a null lower limit means symmetric limits, see BasicCartesianControl::checkJointVelocities
+            const double lower = qdotMin[joint] == 0.0 ? -qdotMax[joint] : qdotMin[joint];
+
+            if (dq[joint] > EPSILON)
+            {
+                speed = std::min(speed, qdotMax[joint] / dq[joint]);
+            }
+            else if (dq[joint] < -EPSILON)
+            {
+                speed = std::min(speed, lower / dq[joint]);
+            }
+        }
+
+        return speed * speed;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+bool TimeOptimalProfile::configure(const std::vector<std::vector<double>> & dq, const std::vector<std::vector<double>> & ddq,
+                                   const std::vector<double> & qdotMin, const std::vector<double> & qdotMax,
+                                   const std::vector<double> & qddotMax)
+{
+    times.clear();
+    speeds.clear();
+    accelerations.clear();
+
+    const int numPoints = dq.size();
+
+    if (numPoints < 2 || ddq.size() != dq.size())
+    {
+        return false;
+    }
+
+    const unsigned int numJoints = dq[0].size();
+
+    if (qdotMin.size() < numJoints || qdotMax.size() < numJoints || qddotMax.size() < numJoints)
+    {
+        return false;
+    }
+
+    for (unsigned int joint = 0; joint < numJoints; joint++)
+    {
+        if (qdotMax[joint] <= 0.0 || qdotMin[joint] > 0.0 || qddotMax[joint] <= 0.0)
+        {
+            return false;
+        }
+    }
+
+    for (int i = 0; i < numPoints; i++)
+    {
+        if (dq[i].size() != numJoints || ddq[i].size() != numJoints)
+        {
+            return false;
+        }
+    }
+
+    step = 1.0 / (numPoints - 1);
+
+    //-- Backward pass: largest squared speed at each point from which the end can be reached at rest
+    std::vector<double> controllable(numPoints);
+    controllable.back() = 0.0;
+
+    for (int i = numPoints - 2; i >= 0; i--)
+    {
+        auto isControllable = [&](double x)
+        {
+            double uMin, uMax;
+
+            return accelerationBounds(dq, ddq, qddotMax, i, step, x, uMin, uMax)
+                && x + 2.0 * step * uMin <= controllable[i + 1]
+                && x + 2.0 * step * uMax >= 0.0;
+        };
+
+        double upper = maxSquaredSpeed(dq[i], qdotMin, qdotMax);
+
+        if (isControllable(upper))
+        {
+            controllable[i] = upper;
+            continue;
+        }
+
+        double lower = 0.0;
+
+        if (!isControllable(lower))
+        {
+            return false;
+        }
+
+        for (int iteration = 0; iteration < BISECTION_ITERATIONS; iteration++)
+        {
+            const double middle = 0.5 * (lower + upper);
+
+            if (isControllable(middle))
+            {
+                lower = middle;
+            }
+            else
+            {
+                upper = middle;
+            }
+        }
+
+        controllable[i] = lower;
+    }
+
+    //-- Forward pass: accelerate as much as possible while staying controllable
+    times.resize(numPoints);
+    speeds.resize(numPoints);
+    accelerations.resize(numPoints - 1);
+
+    times[0] = speeds[0] = 0.0;
+    double x = 0.0;
+
+    for (int i = 0; i < numPoints - 1; i++)
+    {
+        double uMin, uMax;
+
+        if (!accelerationBounds(dq, ddq, qddotMax, i, step, x, uMin, uMax))
+        {
+            times.clear();
+            return false;
+        }
+
+        const double next = std::max(std::min(controllable[i + 1], x + 2.0 * step * uMax), 0.0);
+
+        accelerations[i] = (next - x) / (2.0 * step);
+        speeds[i + 1] = std::sqrt(next);
+
+        if (speeds[i] + speeds[i + 1] <= 0.0)
+        {
+            times.clear();
+            return false;
+        }
+
+        times[i + 1] = times[i] + 2.0 * step / (speeds[i] + speeds[i + 1]);
+        x = next;
+    }
+
+    if (!std::isfinite(times.back()))
+    {
+        times.clear();
+        return false;
+    }
+
+    SetProfile(0.0, 1.0);
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+void TimeOptimalProfile::SetProfile(double pos1, double pos2)
+{
+    offset = pos1;
+    length = pos2 - pos1;
+    timeScale = 1.0;
+}
+
+// -----------------------------------------------------------------------------
+
+void TimeOptimalProfile::SetProfileDuration(double pos1, double pos2, double duration)
+{
+    SetProfile(pos1, pos2);
+
+    if (!times.empty() && duration > times.back())
+    {
+        timeScale = duration / times.back();
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+double TimeOptimalProfile::Duration() const
+{
+    return times.empty() ? 0.0 : times.back() * timeScale;
+}
+
+// -----------------------------------------------------------------------------
+
+int TimeOptimalProfile::locate(double t) const
+{
+    const int i = std::upper_bound(times.cbegin(), times.cend(), t) - times.cbegin() - 1;
+    return std::min(std::max(i, 0), static_cast<int>(times.size()) - 2);
+}
+
+// -----------------------------------------------------------------------------
+
+double TimeOptimalProfile::Pos(double time) const
+{
+    const double t = time / timeScale;
+
+    if (times.empty() || t <= 0.0)
+    {
+        return offset;
+    }
+
+    if (t >= times.back())
+    {
+        return offset + length;
+    }
+
+    const int i = locate(t);
+    const double tau = t - times[i];
+    return offset + length * (i * step + speeds[i] * tau + 0.5 * accelerations[i] * tau * tau);
+}
+
+// -----------------------------------------------------------------------------
+
+double TimeOptimalProfile::Vel(double time) const
+{
+    const double t = time / timeScale;
+
+    if (times.empty() || t <= 0.0 || t >= times.back())
+    {
+        return 0.0;
+    }
+
+    const int i = locate(t);
+    return length * (speeds[i] + accelerations[i] * (t - times[i])) / timeScale;
+}
+
+// -----------------------------------------------------------------------------
+
+double TimeOptimalProfile::Acc(double time) const
+{
+    const double t = time / timeScale;
+
+    if (times.empty() || t < 0.0 || t > times.back())
+    {
+        return 0.0;
+    }
+
+    return length * accelerations[locate(t)] / (timeScale * timeScale);
+}
+
+// -----------------------------------------------------------------------------
+
+void TimeOptimalProfile::Write(std::ostream & os) const
+{
+    os << "TIMEOPTIMAL[" << times.size() << "," << Duration() << "]";
+}
+
+// -----------------------------------------------------------------------------
+
+KDL::VelocityProfile * TimeOptimalProfile::Clone() const
+{
+    return new TimeOptimalProfile(*this);
+}
+
+// -----------------------------------------------------------------------------
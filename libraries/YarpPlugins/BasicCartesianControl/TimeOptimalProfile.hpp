@@ -0,0 +1,77 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#ifndef __TIME_OPTIMAL_PROFILE_HPP__
+#define __TIME_OPTIMAL_PROFILE_HPP__
+
+#include <ostream>
+#include <vector>
+
+#include <kdl/velocityprofile.hpp>
+
+namespace roboticslab
+{
+
+/**
+ * @ingroup BasicCartesianControl
+ * @brief Fastest timing of a path subject to joint velocity and acceleration limits.
+ *
+ * Follows the reachability analysis of TOPP-RA on a uniform grid over a
+ * normalized path parameter: given the joint path derivatives q'(s) and q''(s)
+ * at each grid point, a backward pass computes the largest squared path speed
+ * from which the end of the path can still be reached at rest, then a forward
+ * pass greedily accelerates within those bounds. Path acceleration is constant
+ * between grid points, acceleration limits are enforced at both ends of each
+ * interval.
+ *
+ * The normalized parameter spans [0, 1] and is mapped onto the actual path
+ * length via @ref SetProfile, so that a single solution can be cloned for every
+ * TCP of a kinematic tree.
+ */
+class TimeOptimalProfile : public KDL::VelocityProfile
+{
+public:
+    /**
+     * @brief Solve the parameterization problem.
+     *
+     * @param dq Joint path tangent q'(s) at each grid point [deg].
+     * @param ddq Joint path curvature q''(s) at each grid point [deg].
+     * @param qdotMin Lower joint velocity limits [deg/s].
+     * @param qdotMax Upper joint velocity limits [deg/s].
+     * @param qddotMax Symmetric joint acceleration limits [deg/s^2].
+     *
+     * @return false if the inputs are inconsistent or the path cannot be traversed
+     */
+    bool configure(const std::vector<std::vector<double>> & dq, const std::vector<std::vector<double>> & ddq,
+                   const std::vector<double> & qdotMin, const std::vector<double> & qdotMax,
+                   const std::vector<double> & qddotMax);
+
+    //! Map the normalized path onto [pos1, pos2] at optimal timing.
+    void SetProfile(double pos1, double pos2) override;
+
+    //! Same as @ref SetProfile, slowed down uniformly if a longer duration is requested.
+    void SetProfileDuration(double pos1, double pos2, double duration) override;
+
+    double Duration() const override;
+    double Pos(double time) const override;
+    double Vel(double time) const override;
+    double Acc(double time) const override;
+    void Write(std::ostream & os) const override;
+    KDL::VelocityProfile * Clone() const override;
+
+private:
+    // index of the grid interval that contains the given (unscaled) time
+    int locate(double t) const;
+
+    std::vector<double> times; // [s], at each grid point
+    std::vector<double> speeds; // normalized path speed at each grid point
+    std::vector<double> accelerations; // normalized path acceleration on each interval
+    double step {0.0}; // normalized grid spacing
+
+    double offset {0.0};
+    double length {1.0};
+    double timeScale {1.0};
+};
+
+} // namespace roboticslab
+
+#endif // __TIME_OPTIMAL_PROFILE_HPP__
@@ -0,0 +1,62 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#include "TwistTrajectory.hpp"
+
+#include <algorithm> // std::max, std::min
+#include <limits>
+
+#include "KdlVectorConverter.hpp"
+
+using namespace roboticslab;
+
+// -----------------------------------------------------------------------------
+
+bool TwistTrajectory::configure(const std::vector<double> & x, const std::vector<double> & xdot, double maxPathLength)
+{
+    clear();
+
+    if (x.empty() || x.size() % 6 != 0 || x.size() != xdot.size() || maxPathLength <= 0.0)
+    {
+        return false;
+    }
+
+    for (unsigned int i = 0; i < x.size(); i += 6)
+    {
+        KDL::Frame start = KdlVectorConverter::vectorToFrame(x.data() + i);
+        KDL::Twist twist = KdlVectorConverter::vectorToTwist(xdot.data() + i);
+
+        // path length covered per second, same metric as KDL::Path_Line with unit equivalent radius
+        double speed = std::max(twist.vel.Norm(), twist.rot.Norm());
+
+        starts.push_back(start);
+        twists.push_back(twist);
+        durations.push_back(speed > 0.0 ? maxPathLength / speed : std::numeric_limits<double>::infinity());
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+void TwistTrajectory::clear()
+{
+    starts.clear();
+    twists.clear();
+    durations.clear();
+}
+
+// -----------------------------------------------------------------------------
+
+void TwistTrajectory::evaluate(double t, double * x, double * xdot) const
+{
+    for (unsigned int i = 0; i < starts.size(); i++)
+    {
+        const double elapsed = std::min(std::max(t, 0.0), durations[i]);
+
+        // rotation about a fixed axis of the base frame, linear motion of the origin
+        KdlVectorConverter::frameToVector(KDL::addDelta(starts[i], twists[i], elapsed), x + 6 * i);
+        KdlVectorConverter::twistToVector(t < durations[i] ? twists[i] : KDL::Twist::Zero(), xdot + 6 * i);
+    }
+}
+
+// -----------------------------------------------------------------------------
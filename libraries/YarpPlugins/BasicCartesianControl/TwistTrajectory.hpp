@@ -0,0 +1,63 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#ifndef __TWIST_TRAJECTORY_HPP__
+#define __TWIST_TRAJECTORY_HPP__
+
+#include <vector>
+
+#include <kdl/frames.hpp>
+
+namespace roboticslab
+{
+
+/**
+ * @ingroup BasicCartesianControl
+ * @brief Constant twist motion of all TCPs, evaluated in closed form.
+ *
+ * Each TCP starts at its own pose and moves with its own twist, expressed in
+ * the base frame, until it has covered a given path length (measured as in
+ * KDL::Path_Line, i.e. the largest of the distance and the rotated angle).
+ * Afterwards, the final pose is held with null twist. A TCP with null twist
+ * holds its start pose right away. Poses and twists use the representation of
+ * KdlVectorConverter. Nothing is allocated after @ref configure, and there is
+ * no time limit on the evaluation.
+ */
+class TwistTrajectory
+{
+public:
+    /**
+     * @brief Set start poses and twists.
+     *
+     * @param x Start poses, 6 values per TCP.
+     * @param xdot Twists, 6 values per TCP.
+     * @param maxPathLength Path length after which each TCP stops.
+     *
+     * @return false if the sizes do not match or there are no TCPs at all
+     */
+    bool configure(const std::vector<double> & x, const std::vector<double> & xdot, double maxPathLength);
+
+    //! Drop the current motion, keeping the storage for the next one.
+    void clear();
+
+    //! Number of TCPs.
+    int getNumTcps() const
+    { return starts.size(); }
+
+    /**
+     * @brief Pose and twist of all TCPs at time @p t.
+     *
+     * @param t Time since the start of the movement [s].
+     * @param x Output poses, 6 * @ref getNumTcps values.
+     * @param xdot Output twists, 6 * @ref getNumTcps values.
+     */
+    void evaluate(double t, double * x, double * xdot) const;
+
+private:
+    std::vector<KDL::Frame> starts;
+    std::vector<KDL::Twist> twists;
+    std::vector<double> durations; // [s], infinite for null twists
+};
+
+} // namespace roboticslab
+
+#endif // __TWIST_TRAJECTORY_HPP__
@@ -0,0 +1,215 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#include "WaypointTrajectory.hpp"
+
+#include <cmath> // std::sqrt
+
+#include <algorithm> // std::max, std::min
+
+#include "KdlVectorConverter.hpp"
+
+using namespace roboticslab;
+
+// -----------------------------------------------------------------------------
+
+namespace
+{
+    // trapezoidal time law, acceleration and deceleration take this fraction of the segment duration each
+    constexpr double ACCEL_FRACTION = 0.25;
+    constexpr double PEAK_VELOCITY = 1.0 / (1.0 - ACCEL_FRACTION); // normalized
+
+    // progress along the segment and its derivative, both normalized to segment length and duration
+    void timeLaw(double u, double & s, double & sdot)
+    {
+        if (u <= 0.0)
+        {
+            s = sdot = 0.0;
+        }
+        else if (u >= 1.0)
+        {
+            s = 1.0;
+            sdot = 0.0;
+        }
+        else if (u < ACCEL_FRACTION)
+        {
+            sdot = PEAK_VELOCITY * u / ACCEL_FRACTION;
+            s = 0.5 * sdot * u;
+        }
+        else if (u <= 1.0 - ACCEL_FRACTION)
+        {
+            sdot = PEAK_VELOCITY;
+            s = PEAK_VELOCITY * (u - 0.5 * ACCEL_FRACTION);
+        }
+        else
+        {
+            sdot = PEAK_VELOCITY * (1.0 - u) / ACCEL_FRACTION;
+            s = 1.0 - 0.5 * sdot * (1.0 - u);
+        }
+    }
+
+    // normalized time at which the remaining fraction of the segment equals q (up to one half)
+    double timeToGo(double q)
+    {
+        // fraction of the segment traversed while decelerating
+        constexpr double DECEL_SPAN = 0.5 * PEAK_VELOCITY * ACCEL_FRACTION;
+
+        if (q <= DECEL_SPAN)
+        {
+            return 1.0 - std::sqrt(2.0 * ACCEL_FRACTION * q / PEAK_VELOCITY);
+        }
+        else
+        {
+            return (1.0 - q) / PEAK_VELOCITY + 0.5 * ACCEL_FRACTION;
+        }
+    }
+
+    // rotation about the axis of the given rotation vector, scaled by s
+    inline KDL::Rotation partialRotation(const KDL::Vector & rotvec, double s)
+    {
+        return KDL::Rotation::Rot(rotvec, rotvec.Norm() * s);
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void WaypointTrajectory::reset(const std::vector<double> & x)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    const int numTcps = x.size() / 6;
+
+    origin.resize(numTcps);
+    tail.resize(numTcps);
+
+    for (int i = 0; i < numTcps; i++)
+    {
+        origin[i] = tail[i] = KdlVectorConverter::vectorToFrame(x.data() + 6 * i);
+    }
+
+    segments.resize(CAPACITY);
+
+    for (auto & segment : segments)
+    {
+        segment.deltas.resize(numTcps);
+    }
+
+    head = count = 0;
+    closed = false;
+}
+
+// -----------------------------------------------------------------------------
+
+bool WaypointTrajectory::append(const std::vector<double> & xd, double now, double duration, double radius)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (closed || count == CAPACITY || xd.size() != 6 * tail.size() || duration <= 0.0)
+    {
+        return false;
+    }
+
+    auto & segment = segments[(head + count) % CAPACITY];
+    segment.length = 0.0;
+
+    for (unsigned int i = 0; i < tail.size(); i++)
+    {
+        const auto target = KdlVectorConverter::vectorToFrame(xd.data() + 6 * i);
+        segment.deltas[i].vel = target.p - tail[i].p;
+        segment.deltas[i].rot = (target.M * tail[i].M.Inverse()).GetRot();
+        segment.length = std::max(segment.length, segment.deltas[i].vel.Norm());
+        tail[i] = target;
+    }
+
+    segment.start = now;
+    segment.duration = duration;
+
+    if (count != 0)
+    {
+        //-- Start as soon as the previous segment enters the blend zone around its target
+        const auto & previous = at(count - 1);
+        const double blend = std::min(radius, 0.5 * std::min(previous.length, segment.length));
+        const double progress = blend > 0.0 ? timeToGo(blend / previous.length) : 1.0;
+        segment.start = std::max(segment.start, previous.start + progress * previous.duration);
+    }
+
+    count++;
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+bool WaypointTrajectory::evaluate(double t, double * x, double * xdot)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    //-- Completed segments are folded into the origin
+    while (count != 0 && t >= at(0).start + at(0).duration)
+    {
+        const auto & segment = at(0);
+
+        for (unsigned int i = 0; i < origin.size(); i++)
+        {
+            origin[i].p += segment.deltas[i].vel;
+            origin[i].M = partialRotation(segment.deltas[i].rot, 1.0) * origin[i].M;
+        }
+
+        head = (head + 1) % CAPACITY;
+        count--;
+    }
+
+    //-- Superpose active segments, start times are non-decreasing
+    for (unsigned int i = 0; i < origin.size(); i++)
+    {
+        auto H = origin[i];
+        auto tw = KDL::Twist::Zero();
+
+        for (int j = 0; j < count && t > at(j).start; j++)
+        {
+            const auto & segment = at(j);
+            double s, sdot;
+
+            timeLaw((t - segment.start) / segment.duration, s, sdot);
+            sdot /= segment.duration;
+
+            H.p += segment.deltas[i].vel * s;
+            H.M = partialRotation(segment.deltas[i].rot, s) * H.M;
+            tw.vel += segment.deltas[i].vel * sdot;
+            tw.rot += segment.deltas[i].rot * sdot;
+        }
+
+        KdlVectorConverter::frameToVector(H, x + 6 * i);
+        KdlVectorConverter::twistToVector(tw, xdot + 6 * i);
+    }
+
+    if (count == 0)
+    {
+        closed = true;
+        return false;
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+bool WaypointTrajectory::isClosed() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return closed;
+}
+
+// -----------------------------------------------------------------------------
+
+void WaypointTrajectory::getLastWaypoint(std::vector<double> & x) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    x.resize(6 * tail.size());
+
+    for (unsigned int i = 0; i < tail.size(); i++)
+    {
+        KdlVectorConverter::frameToVector(tail[i], x.data() + 6 * i);
+    }
+}
+
+// -----------------------------------------------------------------------------
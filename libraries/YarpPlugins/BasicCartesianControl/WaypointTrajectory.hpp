@@ -0,0 +1,94 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#ifndef __WAYPOINT_TRAJECTORY_HPP__
+#define __WAYPOINT_TRAJECTORY_HPP__
+
+#include <mutex>
+#include <vector>
+
+#include <kdl/frames.hpp>
+
+namespace roboticslab
+{
+
+/**
+ * @ingroup BasicCartesianControl
+ * @brief Queue of linear Cartesian segments with blended corners.
+ *
+ * Each queued waypoint adds a straight segment (rotation about a fixed axis)
+ * with a trapezoidal time law. A segment may start before the previous one
+ * ends, at the instant the latter gets within the blend radius of its target;
+ * displacements of overlapping segments are superposed, which rounds off the
+ * corner without stopping. Every waypoint is eventually reached, the path only
+ * deviates from it while blending.
+ *
+ * Segments can be appended while the motion is being evaluated from another
+ * thread. Storage is reserved on @ref reset, neither call allocates afterwards.
+ */
+class WaypointTrajectory
+{
+public:
+    //! Maximum number of segments being executed or waiting for execution.
+    static constexpr int CAPACITY = 32;
+
+    /**
+     * @brief Start anew from the given pose of all TCPs, dropping pending segments.
+     *
+     * @param x Current poses, 6 values per TCP.
+     */
+    void reset(const std::vector<double> & x);
+
+    /**
+     * @brief Queue a linear segment from the last waypoint towards @p xd.
+     *
+     * @param xd Target poses, 6 values per TCP.
+     * @param now Current time [s], the segment never starts in the past.
+     * @param duration Duration of the segment [s].
+     * @param radius Blend radius at the corner with the previous segment [m],
+     * limited to half of the length of either segment.
+     *
+     * @return false if the queue is full, the size of @p xd is wrong or the
+     * trajectory has already finished
+     */
+    bool append(const std::vector<double> & xd, double now, double duration, double radius);
+
+    /**
+     * @brief Desired pose and twist at time @p t.
+     *
+     * @return false once the last segment has ended, the trajectory is then
+     * closed and no more segments will be accepted until the next @ref reset
+     */
+    bool evaluate(double t, double * x, double * xdot);
+
+    //! Whether the trajectory has finished, see @ref evaluate.
+    bool isClosed() const;
+
+    //! Pose of all TCPs at the last queued waypoint.
+    void getLastWaypoint(std::vector<double> & x) const;
+
+private:
+    struct Segment
+    {
+        double start; // [s]
+        double duration; // [s]
+        double length; // [m], largest translation among all TCPs
+        std::vector<KDL::Twist> deltas; // per TCP, rotation vector expressed in base frame
+    };
+
+    const Segment & at(int i) const
+    { return segments[(head + i) % CAPACITY]; }
+
+    std::vector<Segment> segments; // ring buffer
+    int head {0};
+    int count {0};
+    bool closed {true};
+
+    std::vector<KDL::Frame> origin; // where completed segments left the TCPs
+    std::vector<KDL::Frame> tail; // where queued segments will leave the TCPs
+
+    mutable std::mutex mutex;
+};
+
+} // namespace roboticslab
+
+#endif // __WAYPOINT_TRAJECTORY_HPP__
@@ -60,6 +60,7 @@ public:
     bool relj(const std::vector<double> &xd) override;
     bool movl(const std::vector<double> &xd) override;
     bool movv(const std::vector<double> &xdotd) override;
+    bool movw(const std::vector<double> &xd) override;
     bool gcmp() override;
     bool forc(const std::vector<double> &td) override;
     bool stopControl() override;
@@ -73,6 +74,8 @@ public:
     bool getParameter(int vocab, double * value) override;
     bool setParameters(const std::map<int, double> & params) override;
     bool getParameters(std::map<int, double> & params) override;
+    bool getLatencyStats(std::map<int, std::vector<double>> & stats) override;
+    bool resetLatencyStats() override;
 
     // -------- DeviceDriver declarations. Implementation in IDeviceImpl.cpp --------
     bool open(yarp::os::Searchable& config) override;
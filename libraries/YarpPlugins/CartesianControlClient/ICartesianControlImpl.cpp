@@ -216,6 +216,13 @@ bool roboticslab::CartesianControlClient::movv(const std::vector<double> &xdotd)
 
 // -----------------------------------------------------------------------------
 
+bool roboticslab::CartesianControlClient::movw(const std::vector<double> &xd)
+{
+    return handleRpcConsumerCmd(VOCAB_CC_MOVW, xd);
+}
+
+// -----------------------------------------------------------------------------
+
 bool roboticslab::CartesianControlClient::gcmp()
 {
     return handleRpcRunnableCmd(VOCAB_CC_GCMP);
@@ -376,3 +383,48 @@ bool roboticslab::CartesianControlClient::getParameters(std::map<int, double> &
 }
 
 // -----------------------------------------------------------------------------
+
+bool roboticslab::CartesianControlClient::getLatencyStats(std::map<int, std::vector<double>> & stats)
+{
+    yarp::os::Bottle cmd, response;
+
+    cmd.addVocab32(VOCAB_CC_GET);
+    cmd.addVocab32(VOCAB_CC_LATENCY_STATS);
+
+    rpcClient.write(cmd, response);
+
+    if (!checkSuccess(response))
+    {
+        return false;
+    }
+
+    for (int i = 0; i < response.size(); i++)
+    {
+        yarp::os::Bottle * b = response.get(i).asList();
+        std::vector<double> & summary = stats[b->get(0).asVocab32()];
+        summary.resize(b->size() - 1);
+
+        for (int j = 1; j < b->size(); j++)
+        {
+            summary[j - 1] = b->get(j).asFloat64();
+        }
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+bool roboticslab::CartesianControlClient::resetLatencyStats()
+{
+    yarp::os::Bottle cmd, response;
+
+    cmd.addVocab32(VOCAB_CC_SET);
+    cmd.addVocab32(VOCAB_CC_LATENCY_STATS);
+
+    rpcClient.write(cmd, response);
+
+    return checkSuccess(response);
+}
+
+// -----------------------------------------------------------------------------
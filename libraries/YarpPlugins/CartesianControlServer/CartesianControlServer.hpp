@@ -117,6 +117,9 @@ private:
     bool handleParameterSetterGroup(const yarp::os::Bottle & in, yarp::os::Bottle & out);
     bool handleParameterGetterGroup(const yarp::os::Bottle & in, yarp::os::Bottle & out);
 
+    bool handleLatencyStatsGetter(const yarp::os::Bottle & in, yarp::os::Bottle & out);
+    bool handleLatencyStatsReset(const yarp::os::Bottle & in, yarp::os::Bottle & out);
+
     roboticslab::ICartesianControl * iCartesianControl;
 };
 
@@ -21,6 +21,11 @@ namespace
         return in.size() > 1 && in.get(1).asVocab32() == VOCAB_CC_CONFIG_PARAMS;
     }
 
+    inline bool isLatencyParam(const yarp::os::Bottle& in)
+    {
+        return in.size() > 1 && in.get(1).asVocab32() == VOCAB_CC_LATENCY_STATS;
+    }
+
     inline void addValue(yarp::os::Bottle& b, int vocab, double value)
     {
         if (vocab == VOCAB_CC_CONFIG_FRAME || vocab == VOCAB_CC_CONFIG_STREAMING_CMD)
@@ -64,6 +69,8 @@ bool RpcResponder::respond(const yarp::os::Bottle& in, yarp::os::Bottle& out)
         return handleConsumerCmdMsg(in, out, &ICartesianControl::movl);
     case VOCAB_CC_MOVV:
         return handleConsumerCmdMsg(in, out, &ICartesianControl::movv);
+    case VOCAB_CC_MOVW:
+        return handleConsumerCmdMsg(in, out, &ICartesianControl::movw);
     case VOCAB_CC_GCMP:
         return handleRunnableCmdMsg(in, out, &ICartesianControl::gcmp);
     case VOCAB_CC_FORC:
@@ -77,8 +84,16 @@ bool RpcResponder::respond(const yarp::os::Bottle& in, yarp::os::Bottle& out)
     case VOCAB_CC_ACT:
         return handleActMsg(in, out);
     case VOCAB_CC_SET:
+        if (isLatencyParam(in))
+        {
+            return handleLatencyStatsReset(in, out);
+        }
         return isGroupParam(in) ? handleParameterSetterGroup(in, out) : handleParameterSetter(in, out);
     case VOCAB_CC_GET:
+        if (isLatencyParam(in))
+        {
+            return handleLatencyStatsGetter(in, out);
+        }
         return isGroupParam(in) ? handleParameterGetterGroup(in, out) : handleParameterGetter(in, out);
     default:
         return DeviceResponder::respond(in, out);
@@ -117,6 +132,10 @@ void RpcResponder::makeUsage()
     addUsage(ss.str().c_str(), "velocity move using supplied vector (cartesian space)");
     ss.str("");
 
+    ss << "[" << Vocab::decode(VOCAB_CC_MOVW) << "] coord1 coord2 ...";
+    addUsage(ss.str().c_str(), "queue waypoint of a blended linear move (absolute coordinates in cartesian space)");
+    ss.str("");
+
     ss << "[" << Vocab::decode(VOCAB_CC_GCMP) << "]";
     addUsage(ss.str().c_str(), "enable gravity compensation");
     ss.str("");
@@ -157,6 +176,14 @@ void RpcResponder::makeUsage()
     addUsage(ss.str().c_str(), "get all configuration parameters");
     ss.str("");
 
+    ss << "[" << Vocab::decode(VOCAB_CC_GET) << "] [" << Vocab::decode(VOCAB_CC_LATENCY_STATS) << "]";
+    addUsage(ss.str().c_str(), "get latency statistics: (phase count min p50 p90 p99 p99.9 max) ... [ms]");
+    ss.str("");
+
+    ss << "[" << Vocab::decode(VOCAB_CC_SET) << "] [" << Vocab::decode(VOCAB_CC_LATENCY_STATS) << "]";
+    addUsage(ss.str().c_str(), "reset latency statistics");
+    ss.str("");
+
     ss << "... [" << Vocab::decode(VOCAB_CC_CONFIG_GAIN) << "] value";
     addUsage(ss.str().c_str(), "(config param) controller gain");
     ss.str("");
@@ -169,6 +196,55 @@ void RpcResponder::makeUsage()
     addUsage(ss.str().c_str(), "(config param) CMC period [ms]");
     ss.str("");
 
+    std::stringstream ss_blend;
+    ss_blend << "(config param) blend radius of [" << Vocab::decode(VOCAB_CC_MOVW) << "] waypoints [m]";
+
+    ss << "... [" << Vocab::decode(VOCAB_CC_CONFIG_BLEND_RADIUS) << "] value";
+    addUsage(ss.str().c_str(), ss_blend.str().c_str());
+    ss.str("");
+
+    std::stringstream ss_optimal;
+    ss_optimal << "(config param) time-optimal [" << Vocab::decode(VOCAB_CC_MOVL) << "] at this fraction of joint limits, 0 means fixed duration";
+
+    ss << "... [" << Vocab::decode(VOCAB_CC_CONFIG_TIME_OPTIMAL) << "] value";
+    addUsage(ss.str().c_str(), ss_optimal.str().c_str());
+    ss.str("");
+
+    std::stringstream ss_movj;
+    ss_movj << "(config param) stream jerk-limited [" << Vocab::decode(VOCAB_CC_MOVJ) << "] in position direct mode (1) or rely on the controller profile (0)";
+
+    ss << "... [" << Vocab::decode(VOCAB_CC_CONFIG_MOVJ_DIRECT) << "] value";
+    addUsage(ss.str().c_str(), ss_movj.str().c_str());
+    ss.str("");
+
+    std::stringstream ss_movl;
+    ss_movl << "(config param) solve [" << Vocab::decode(VOCAB_CC_MOVL) << "] joint trajectories ahead of time and stream them in position direct mode (1) or track them in velocity mode (0)";
+
+    ss << "... [" << Vocab::decode(VOCAB_CC_CONFIG_MOVL_DIRECT) << "] value";
+    addUsage(ss.str().c_str(), ss_movl.str().c_str());
+    ss.str("");
+
+    std::stringstream ss_interp;
+    ss_interp << "(config param) render [" << Vocab::decode(VOCAB_CC_POSE) << "] and [" << Vocab::decode(VOCAB_CC_MOVI) << "] streams at the CMC rate (1) or act once per message (0)";
+
+    ss << "... [" << Vocab::decode(VOCAB_CC_CONFIG_STREAM_INTERPOLATION) << "] value";
+    addUsage(ss.str().c_str(), ss_interp.str().c_str());
+    ss.str("");
+
+    std::stringstream ss_extrap;
+    ss_extrap << "(config param) maximum time to extrapolate past the last streamed target [s]";
+
+    ss << "... [" << Vocab::decode(VOCAB_CC_CONFIG_STREAM_EXTRAPOLATION) << "] value";
+    addUsage(ss.str().c_str(), ss_extrap.str().c_str());
+    ss.str("");
+
+    std::stringstream ss_timeout;
+    ss_timeout << "(config param) longest interval between streamed targets before the stream is regarded as paused [s]";
+
+    ss << "... [" << Vocab::decode(VOCAB_CC_CONFIG_STREAM_TIMEOUT) << "] value";
+    addUsage(ss.str().c_str(), ss_timeout.str().c_str());
+    ss.str("");
+
     std::stringstream ss_wait;
     ss_wait << "(config param) check period of [" << Vocab::decode(VOCAB_CC_WAIT) << "] command [ms]";
 
@@ -488,6 +564,64 @@ bool RpcResponder::handleParameterGetterGroup(const yarp::os::Bottle& in, yarp::
 
 // -----------------------------------------------------------------------------
 
+bool RpcResponder::handleLatencyStatsGetter(const yarp::os::Bottle& in, yarp::os::Bottle& out)
+{
+    if (in.size() == 2)
+    {
+        std::map<int, std::vector<double>> stats;
+
+        if (!iCartesianControl->getLatencyStats(stats))
+        {
+            out.addVocab32(VOCAB_CC_FAILED);
+            return false;
+        }
+
+        for (const auto & it : stats)
+        {
+            yarp::os::Bottle & b = out.addList();
+            b.addVocab32(it.first);
+
+            for (auto value : it.second)
+            {
+                b.addFloat64(value);
+            }
+        }
+
+        return true;
+    }
+    else
+    {
+        yCError(CCS) << "Size error:" << in.size();
+        out.addVocab32(VOCAB_CC_FAILED);
+        return false;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+bool RpcResponder::handleLatencyStatsReset(const yarp::os::Bottle& in, yarp::os::Bottle& out)
+{
+    if (in.size() == 2)
+    {
+        if (!iCartesianControl->resetLatencyStats())
+        {
+            out.addVocab32(VOCAB_CC_FAILED);
+            return false;
+        }
+
+        out.addVocab32(VOCAB_CC_OK);
+        return true;
+    }
+    else
+    {
+        yCError(CCS) << "Size error:" << in.size();
+        out.addVocab32(VOCAB_CC_FAILED);
+        return false;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
 bool RpcTransformResponder::transformIncomingData(std::vector<double>& vin)
 {
     return KinRepresentation::encodePose(vin, vin, coord, orient, units);
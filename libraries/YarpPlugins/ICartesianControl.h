@@ -53,6 +53,7 @@ constexpr int VOCAB_CC_MOVJ = yarp::os::createVocab32('m','o','v','j'); ///< Mov
 constexpr int VOCAB_CC_RELJ = yarp::os::createVocab32('r','e','l','j'); ///< Move in joint space, relative coordinates
 constexpr int VOCAB_CC_MOVL = yarp::os::createVocab32('m','o','v','l'); ///< Linear move to target position
 constexpr int VOCAB_CC_MOVV = yarp::os::createVocab32('m','o','v','v'); ///< Linear move with given velocity
+constexpr int VOCAB_CC_MOVW = yarp::os::createVocab32('m','o','v','w'); ///< Linear move through queued waypoint, blended
 constexpr int VOCAB_CC_GCMP = yarp::os::createVocab32('g','c','m','p'); ///< Gravity compensation
 constexpr int VOCAB_CC_FORC = yarp::os::createVocab32('f','o','r','c'); ///< Force control
 constexpr int VOCAB_CC_STOP = yarp::os::createVocab32('s','t','o','p'); ///< Stop control
@@ -90,6 +91,7 @@ constexpr int VOCAB_CC_NOT_CONTROLLING = yarp::os::createVocab32('c','c','n','c'
 constexpr int VOCAB_CC_MOVJ_CONTROLLING = yarp::os::createVocab32('c','c','j','c'); ///< Controlling MOVJ commands
 constexpr int VOCAB_CC_MOVL_CONTROLLING = yarp::os::createVocab32('c','c','l','c'); ///< Controlling MOVL commands
 constexpr int VOCAB_CC_MOVV_CONTROLLING = yarp::os::createVocab32('c','c','v','c'); ///< Controlling MOVV commands
+constexpr int VOCAB_CC_MOVW_CONTROLLING = yarp::os::createVocab32('c','c','w','c'); ///< Controlling MOVW commands
 constexpr int VOCAB_CC_GCMP_CONTROLLING = yarp::os::createVocab32('c','c','g','c'); ///< Controlling GCMP commands
 constexpr int VOCAB_CC_FORC_CONTROLLING = yarp::os::createVocab32('c','c','f','c'); ///< Controlling FORC commands
 
@@ -127,6 +129,31 @@ constexpr int VOCAB_CC_CONFIG_CMC_PERIOD = yarp::os::createVocab32('c','p','c','
 constexpr int VOCAB_CC_CONFIG_WAIT_PERIOD = yarp::os::createVocab32('c','p','w','p');   ///< Check period of 'wait' command [ms]
 constexpr int VOCAB_CC_CONFIG_FRAME = yarp::os::createVocab32('c','p','f');             ///< Reference frame
 constexpr int VOCAB_CC_CONFIG_STREAMING_CMD = yarp::os::createVocab32('c','p','s','c'); ///< Preset streaming command
+constexpr int VOCAB_CC_CONFIG_BLEND_RADIUS = yarp::os::createVocab32('c','p','b','r');  ///< Blend radius of queued waypoints [m]
+constexpr int VOCAB_CC_CONFIG_TIME_OPTIMAL = yarp::os::createVocab32('c','p','t','o');  ///< Time-optimal MOVL at this fraction of joint limits (0: fixed duration)
+constexpr int VOCAB_CC_CONFIG_MOVJ_DIRECT = yarp::os::createVocab32('c','p','m','d');   ///< Stream jerk-limited MOVJ in position direct mode (0: controller profile)
+constexpr int VOCAB_CC_CONFIG_MOVL_DIRECT = yarp::os::createVocab32('c','p','l','d');   ///< Stream MOVL joints solved ahead of time in position direct mode (0: velocity control)
+constexpr int VOCAB_CC_CONFIG_STREAM_INTERPOLATION = yarp::os::createVocab32('c','p','s','i');  ///< Render pose/movi streams at the CMC rate (0: act once per message)
+constexpr int VOCAB_CC_CONFIG_STREAM_EXTRAPOLATION = yarp::os::createVocab32('c','p','s','e');  ///< Maximum time to extrapolate past the last streamed target [s]
+constexpr int VOCAB_CC_CONFIG_STREAM_TIMEOUT = yarp::os::createVocab32('c','p','s','t');        ///< Longest interval between streamed targets of a moving stream [s]
+
+// Controller statistics (read-only parameter keys, not listed by getParameters)
+constexpr int VOCAB_CC_STATS_TICKS = yarp::os::createVocab32('s','t','c','k');       ///< Number of CMC iterations
+constexpr int VOCAB_CC_STATS_RUN_MEAN = yarp::os::createVocab32('s','r','u','a');    ///< Mean CMC iteration time [ms]
+constexpr int VOCAB_CC_STATS_RUN_MAX = yarp::os::createVocab32('s','r','u','m');     ///< Worst CMC iteration time [ms]
+constexpr int VOCAB_CC_STATS_JITTER_MEAN = yarp::os::createVocab32('s','j','i','a'); ///< Mean deviation from the CMC schedule [ms]
+constexpr int VOCAB_CC_STATS_JITTER_MAX = yarp::os::createVocab32('s','j','i','m');  ///< Worst deviation from the CMC schedule [ms]
+constexpr int VOCAB_CC_STATS_OVERRUNS = yarp::os::createVocab32('s','o','v','r');    ///< CMC iterations that took longer than the period
+
+// Latency histograms (see ICartesianControl::getLatencyStats)
+constexpr int VOCAB_CC_LATENCY_STATS = yarp::os::createVocab32('l','a','t','s');     ///< Latency statistics group
+constexpr int VOCAB_CC_LATENCY_ENCODERS = yarp::os::createVocab32('l','e','n','c');  ///< Encoder read
+constexpr int VOCAB_CC_LATENCY_FWD_KIN = yarp::os::createVocab32('l','f','w','d');   ///< Forward kinematics
+constexpr int VOCAB_CC_LATENCY_POSE_DIFF = yarp::os::createVocab32('l','d','i','f'); ///< Pose difference
+constexpr int VOCAB_CC_LATENCY_INV_KIN = yarp::os::createVocab32('l','i','n','v');   ///< Inverse kinematics (differential or not) and dynamics
+constexpr int VOCAB_CC_LATENCY_CHECKS = yarp::os::createVocab32('l','c','h','k');    ///< Control mode and joint limit checks
+constexpr int VOCAB_CC_LATENCY_SEND = yarp::os::createVocab32('l','s','n','d');      ///< Command sent to the robot
+constexpr int VOCAB_CC_LATENCY_TICK = yarp::os::createVocab32('l','t','c','k');      ///< Whole CMC iteration
 
 /** @} */
 
@@ -240,6 +267,24 @@ public:
      */
     virtual bool movv(const std::vector<double> &xdotd) = 0;
 
+    /**
+     * @brief Linear move through queued waypoint
+     *
+     * Append a waypoint to the current MOVW motion, or start a new one from the
+     * current position. Each waypoint is reached along a line trajectory, the next
+     * one may be queued while the robot is still moving. Corners are rounded off
+     * within the configured blend radius (see @ref VOCAB_CC_CONFIG_BLEND_RADIUS)
+     * instead of stopping at every waypoint. The motion ends once the last queued
+     * waypoint has been reached.
+     *
+     * @param xd 6-element vector describing desired position in cartesian space; first
+     * three elements denote translation (meters), last three denote rotation in scaled
+     * axis-angle representation (radians).
+     *
+     * @return true on success, false otherwise (e.g. queue full)
+     */
+    virtual bool movw(const std::vector<double> &xd) = 0;
+
     /**
      * @brief Gravity compensation
      *
@@ -415,6 +460,29 @@ public:
      */
     virtual bool getParameters(std::map<int, double> & params) = 0;
 
+    /**
+     * @brief Retrieve latency statistics.
+     *
+     * Ask the controller to summarize the time spent in each phase of its
+     * control loop and streaming commands since start or last reset.
+     *
+     * @param stats Dictionary of YARP-encoded phase vocabs as keys and their
+     * summaries: sample count, minimum, 50th, 90th, 99th and 99.9th percentiles,
+     * maximum (durations in milliseconds).
+     *
+     * @return true on success, false otherwise
+     */
+    virtual bool getLatencyStats(std::map<int, std::vector<double>> & stats) = 0;
+
+    /**
+     * @brief Reset latency statistics.
+     *
+     * Discard all samples recorded so far.
+     *
+     * @return true on success, false otherwise
+     */
+    virtual bool resetLatencyStats() = 0;
+
     /** @} */
 };
 
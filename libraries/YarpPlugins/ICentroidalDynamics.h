@@ -0,0 +1,69 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#ifndef __I_CENTROIDAL_DYNAMICS__
+#define __I_CENTROIDAL_DYNAMICS__
+
+#include <vector>
+
+/**
+ * @file
+ * @brief Contains roboticslab::ICentroidalDynamics
+ * @ingroup YarpPlugins
+ * @{
+ */
+
+namespace roboticslab
+{
+
+/**
+ * @brief Abstract base class for whole-body center of mass and centroidal momentum
+ * computations.
+ *
+ * All quantities are expressed in the base frame of the kinematic model. Meant to
+ * be called on every cycle of a control loop, implementations should not allocate
+ * memory as long as the output vectors keep their size between calls.
+ */
+class ICentroidalDynamics
+{
+public:
+    //! Destructor
+    virtual ~ICentroidalDynamics() {}
+
+    /**
+     * @brief Get total mass of the robot
+     *
+     * @return Sum of the masses of all links (kilograms).
+     */
+    virtual double getTotalMass() = 0;
+
+    /**
+     * @brief Compute the position of the center of mass
+     * @param q Vector describing a position in joint space (meters or degrees).
+     * @param com 3-element vector describing the position of the center of mass (meters).
+     * @return true on success, false otherwise
+     */
+    virtual bool getCenterOfMass(const std::vector<double> &q, std::vector<double> &com) = 0;
+
+    /**
+     * @brief Compute the center of mass, its Jacobian and the centroidal momentum
+     * @param q Vector describing a position in joint space (meters or degrees).
+     * @param qdot Vector describing a velocity in joint space (meters/second or degrees/second).
+     * @param com 3-element vector describing the position of the center of mass (meters).
+     * @param comJacobian 3xN Jacobian of the center of mass, stored row by row; maps joint
+     * velocities (meters/second or degrees/second) to the velocity of the center of mass
+     * (meters/second).
+     * @param momentum 6-element vector describing the centroidal momentum; first three
+     * elements denote linear momentum (kilograms*meters/second), last three denote angular
+     * momentum about the center of mass (kilograms*meters^2/second).
+     * @return true on success, false otherwise
+     */
+    virtual bool getCentroidalDynamics(const std::vector<double> &q, const std::vector<double> &qdot,
+                                       std::vector<double> &com, std::vector<double> &comJacobian,
+                                       std::vector<double> &momentum) = 0;
+};
+
+} // namespace roboticslab
+
+/** @} */
+
+#endif // __I_CENTROIDAL_DYNAMICS__
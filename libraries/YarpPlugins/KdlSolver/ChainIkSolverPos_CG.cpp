@@ -0,0 +1,194 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#include "ChainIkSolverPos_CG.hpp"
+
+#include <kdl/chainfksolverpos_recursive.hpp>
+
+using namespace roboticslab;
+
+// -----------------------------------------------------------------------------
+
+namespace
+{
+    void frameToArray(const KDL::Frame & H, double * out)
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            for (int j = 0; j < 3; j++)
+            {
+                out[3 * i + j] = H.M(i, j);
+            }
+
+            out[9 + i] = H.p(i);
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+ChainIkSolverPos_CG::ChainIkSolverPos_CG(const KDL::Chain & _chain, yarp::os::SharedLibrary * _library, SolveFn _solveFn,
+        int _solutions, ConfigurationSelector * _config)
+    : chain(_chain),
+      library(_library),
+      config(_config),
+      solveFn(_solveFn),
+      values(_solutions * _chain.getNrOfJoints()),
+      solutions(_solutions, KDL::JntArray(_chain.getNrOfJoints()))
+{}
+
+// -----------------------------------------------------------------------------
+
+ChainIkSolverPos_CG::~ChainIkSolverPos_CG()
+{
+    delete config;
+    config = nullptr;
+
+    delete library;
+    library = nullptr;
+}
+
+// -----------------------------------------------------------------------------
+
+int ChainIkSolverPos_CG::CartToJnt(const KDL::JntArray & q_init, const KDL::Frame & p_in, KDL::JntArray & q_out)
+{
+    if (error == E_SOLUTION_NOT_FOUND)
+    {
+        return error;
+    }
+
+    double H[12];
+    frameToArray(p_in, H);
+
+    bool ret = solveFn(H, values.data());
+
+    for (int i = 0; i < solutions.size(); i++)
+    {
+        for (int j = 0; j < chain.getNrOfJoints(); j++)
+        {
+            solutions[i](j) = values[i * chain.getNrOfJoints() + j];
+        }
+    }
+
+    if (!config->configure(solutions))
+    {
+        return (error = E_OUT_OF_LIMITS);
+    }
+
+    if (!config->findOptimalConfiguration(q_init))
+    {
+        return (error = E_OUT_OF_LIMITS);
+    }
+
+    config->retrievePose(q_out);
+
+    return (error = ret ? E_NOERROR : E_NOT_REACHABLE);
+}
+
+// -----------------------------------------------------------------------------
+
+void ChainIkSolverPos_CG::updateInternalDataStructures()
+{
+    // the plugin is bound to the original geometry, appended links are not supported
+    if (!isValid(chain, solveFn, solutions.size()))
+    {
+        error = E_SOLUTION_NOT_FOUND;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+bool ChainIkSolverPos_CG::isValid(const KDL::Chain & chain, SolveFn solveFn, int solutions)
+{
+    const int joints = chain.getNrOfJoints();
+
+    KDL::ChainFkSolverPos_recursive fkSolver(chain);
+    KDL::JntArray q(joints);
+    KDL::Frame H_target, H_actual;
+
+    double H[12];
+    std::vector<double> values(solutions * joints);
+
+    // a few arbitrary (but deterministic) non-singular joint configurations, each must be recovered by one of the IK solutions
+    for (double step : {0.1, -0.2, 0.3})
+    {
+        for (int j = 0; j < joints; j++)
+        {
+            q(j) = step * (j + 1);
+        }
+
+        if (fkSolver.JntToCart(q, H_target) < 0)
+        {
+            return false;
+        }
+
+        frameToArray(H_target, H);
+        solveFn(H, values.data());
+
+        bool found = false;
+
+        for (int i = 0; i < solutions && !found; i++)
+        {
+            for (int j = 0; j < joints; j++)
+            {
+                q(j) = values[i * joints + j];
+            }
+
+            found = fkSolver.JntToCart(q, H_actual) >= 0 && KDL::Equal(H_actual, H_target, 1e-6);
+        }
+
+        if (!found)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+KDL::ChainIkSolverPos * ChainIkSolverPos_CG::create(const KDL::Chain & chain, const ConfigurationSelectorFactory & configFactory,
+        const std::string & path)
+{
+    auto * library = new yarp::os::SharedLibrary(path.c_str());
+
+    if (!library->isValid())
+    {
+        delete library;
+        return nullptr;
+    }
+
+    auto jointsFn = reinterpret_cast<JointsFn>(library->getSymbol("roboticslab_st_ik_joints"));
+    auto solutionsFn = reinterpret_cast<SolutionsFn>(library->getSymbol("roboticslab_st_ik_solutions"));
+    auto solveFn = reinterpret_cast<SolveFn>(library->getSymbol("roboticslab_st_ik_solve"));
+
+    if (!jointsFn || !solutionsFn || !solveFn || jointsFn() != chain.getNrOfJoints() || solutionsFn() < 1
+        || !isValid(chain, solveFn, solutionsFn()))
+    {
+        delete library;
+        return nullptr;
+    }
+
+    ConfigurationSelector * config = configFactory.create();
+
+    return new ChainIkSolverPos_CG(chain, library, solveFn, solutionsFn(), config);
+}
+
+// -----------------------------------------------------------------------------
+
+const char * ChainIkSolverPos_CG::strError(const int error) const
+{
+    switch (error)
+    {
+    case E_SOLUTION_NOT_FOUND:
+        return "IK solution not found";
+    case E_OUT_OF_LIMITS:
+        return "Target pose out of robot limits";
+    case E_NOT_REACHABLE:
+        return "IK solution not reachable";
+    default:
+        return KDL::SolverI::strError(error);
+    }
+}
+
+// -----------------------------------------------------------------------------
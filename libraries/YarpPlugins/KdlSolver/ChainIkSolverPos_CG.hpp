@@ -0,0 +1,122 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#ifndef __CHAIN_IK_SOLVER_POS_CG_HPP__
+#define __CHAIN_IK_SOLVER_POS_CG_HPP__
+
+#include <string>
+#include <vector>
+
+#include <yarp/os/SharedLibrary.h>
+
+#include <kdl/chain.hpp>
+#include <kdl/chainiksolver.hpp>
+
+#include "ConfigurationSelector.hpp"
+
+namespace roboticslab
+{
+
+/**
+ * @ingroup KdlSolver
+ * @brief IK solver that wraps a specialized Screw Theory solver loaded from a plugin.
+ *
+ * Plugins are built with the `roboticslab_add_screw_theory_ik_plugin` CMake function,
+ * which runs `screwTheoryIkGenerator` on a kinematics .ini file. Generated code follows
+ * the same steps as @ref ChainIkSolverPos_ST, but all subproblems are inlined and no
+ * dynamic memory is allocated. The plugin must export the following C symbols:
+ *
+ * @code
+ * int roboticslab_st_ik_joints();
+ * int roboticslab_st_ik_solutions();
+ * int roboticslab_st_ik_solve(const double * H, double * q); // H: 3x3 rotation (row-major) + position
+ * @endcode
+ *
+ * On creation, the plugin is checked against the kinematic chain it is meant to solve.
+ */
+class ChainIkSolverPos_CG : public KDL::ChainIkSolverPos
+{
+public:
+    /** @brief Destructor. */
+    virtual ~ChainIkSolverPos_CG();
+
+    /**
+     * @brief Calculate inverse position kinematics.
+     *
+     * @param q_init Initial guess of the joint coordinates (used for configuration selection).
+     * @param p_in Input cartesian coordinates.
+     * @param q_out Output joint coordinates.
+     *
+     * @return Return code, \ref E_SOLUTION_NOT_FOUND if the plugin does not match the chain,
+     * \ref E_OUT_OF_LIMITS if all solutions violate joint limits or \ref E_NOT_REACHABLE
+     * if the target pose is out of reach.
+     */
+    int CartToJnt(const KDL::JntArray & q_init, const KDL::Frame & p_in, KDL::JntArray & q_out) override;
+
+    /**
+    * @brief Update the internal data structures.
+    *
+    * Update the internal data structures. This is required if the number of segments
+    * or number of joints of a chain has changed. This provides a single point of contact
+    * for solver memory allocations.
+    */
+    void updateInternalDataStructures() override;
+
+    /**
+     * @brief Return a description of the last error
+     *
+     * @param error Error code.
+     *
+     * @return If \p error is known then a description of \p error, otherwise
+     * "UNKNOWN ERROR".
+     */
+    const char * strError(const int error) const override;
+
+    /**
+     * @brief Create an instance of \ref ChainIkSolverPos_CG.
+     *
+     * @param chain Input kinematic chain.
+     * @param configFactory Instance of an abstract factory class that
+     * instantiates a ConfigurationSelector.
+     * @param path Path to the plugin (shared library).
+     *
+     * @return Solver instance or null if the plugin could not be loaded or
+     * does not solve this chain.
+     */
+    static KDL::ChainIkSolverPos * create(const KDL::Chain & chain, const ConfigurationSelectorFactory & configFactory,
+                                          const std::string & path);
+
+    /** @brief Return code, IK solution not found. */
+    static const int E_SOLUTION_NOT_FOUND = -100;
+
+    /** @brief Return code, target pose out of robot limits. */
+    static const int E_OUT_OF_LIMITS = -101;
+
+    /** @brief Return code, solution out of reach. */
+    static const int E_NOT_REACHABLE = 100;
+
+private:
+    using JointsFn = int (*)();
+    using SolutionsFn = int (*)();
+    using SolveFn = int (*)(const double *, double *);
+
+    ChainIkSolverPos_CG(const KDL::Chain & chain, yarp::os::SharedLibrary * library, SolveFn solveFn,
+                        int solutions, ConfigurationSelector * config);
+
+    static bool isValid(const KDL::Chain & chain, SolveFn solveFn, int solutions);
+
+    const KDL::Chain & chain;
+
+    // we own these, resources freed in destructor
+    yarp::os::SharedLibrary * library;
+    ConfigurationSelector * config;
+
+    SolveFn solveFn;
+
+    // preallocated, joint values are stored contiguously one solution after another
+    std::vector<double> values;
+    std::vector<KDL::JntArray> solutions;
+};
+
+} // namespace roboticslab
+
+#endif // __CHAIN_IK_SOLVER_POS_CG_HPP__
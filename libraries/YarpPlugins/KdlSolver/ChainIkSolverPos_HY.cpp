@@ -0,0 +1,137 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#include "ChainIkSolverPos_HY.hpp"
+
+using namespace roboticslab;
+
+// -----------------------------------------------------------------------------
+
+namespace
+{
+    ScrewTheoryIkProblem * buildIdealizedProblem(const KDL::Chain & chain, double tolerance)
+    {
+        PoeExpression poe = PoeExpression::fromChain(chain);
+        PoeExpression poeIdealized = ScrewTheoryIkProblemBuilder::idealize(poe, tolerance);
+        ScrewTheoryIkProblemBuilder builder(poeIdealized);
+        return builder.build();
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+ChainIkSolverPos_HY::ChainIkSolverPos_HY(const KDL::Chain & _chain, ScrewTheoryIkProblem * _problem,
+        ConfigurationSelector * _config, double _tolerance, int _maxIter, double _eps)
+    : chain(_chain),
+      problem(_problem),
+      config(_config),
+      tolerance(_tolerance),
+      eps(_eps),
+      fkSolverPos(_chain),
+      ikSolverVel(_chain),
+      ikSolverPos(_chain, fkSolverPos, ikSolverVel, _maxIter, _eps)
+{}
+
+// -----------------------------------------------------------------------------
+
+ChainIkSolverPos_HY::~ChainIkSolverPos_HY()
+{
+    delete problem;
+    problem = nullptr;
+
+    delete config;
+    config = nullptr;
+}
+
+// -----------------------------------------------------------------------------
+
+int ChainIkSolverPos_HY::CartToJnt(const KDL::JntArray & q_init, const KDL::Frame & p_in, KDL::JntArray & q_out)
+{
+    if (error == E_SOLUTION_NOT_FOUND)
+    {
+        return error;
+    }
+
+    std::vector<KDL::JntArray> solutions;
+
+    // Reachability of the idealized chain is irrelevant, let the refinement step decide.
+    problem->solve(p_in, solutions);
+
+    // Only refinements that did converge may be selected.
+    std::vector<bool> converged(solutions.size());
+    bool anyConverged = false;
+
+    for (int i = 0; i < solutions.size(); i++)
+    {
+        KDL::JntArray seed(solutions[i]);
+        converged[i] = ikSolverPos.CartToJnt(seed, p_in, solutions[i]) >= E_NOERROR;
+        anyConverged = anyConverged || converged[i];
+    }
+
+    // If none did, pick the best effort among all of them (as ChainIkSolverPos_ST does for unreachable targets).
+    bool valid = anyConverged ? config->configure(solutions, converged) : config->configure(solutions);
+
+    if (!valid || !config->findOptimalConfiguration(q_init))
+    {
+        return (error = E_OUT_OF_LIMITS);
+    }
+
+    config->retrievePose(q_out);
+
+    return (error = anyConverged ? E_NOERROR : E_NOT_REACHABLE);
+}
+
+// -----------------------------------------------------------------------------
+
+void ChainIkSolverPos_HY::updateInternalDataStructures()
+{
+    fkSolverPos.updateInternalDataStructures();
+    ikSolverVel.updateInternalDataStructures();
+    ikSolverPos.updateInternalDataStructures();
+
+    ScrewTheoryIkProblem * problem = buildIdealizedProblem(chain, tolerance);
+
+    if (!problem)
+    {
+        error = E_SOLUTION_NOT_FOUND;
+        return;
+    }
+
+    delete this->problem;
+    this->problem = problem;
+}
+
+// -----------------------------------------------------------------------------
+
+KDL::ChainIkSolverPos * ChainIkSolverPos_HY::create(const KDL::Chain & chain, const ConfigurationSelectorFactory & configFactory,
+        double tolerance, int maxIter, double eps)
+{
+    ScrewTheoryIkProblem * problem = buildIdealizedProblem(chain, tolerance);
+
+    if (!problem)
+    {
+        return nullptr;
+    }
+
+    ConfigurationSelector * config = configFactory.create();
+
+    return new ChainIkSolverPos_HY(chain, problem, config, tolerance, maxIter, eps);
+}
+
+// -----------------------------------------------------------------------------
+
+const char * ChainIkSolverPos_HY::strError(const int error) const
+{
+    switch (error)
+    {
+    case E_SOLUTION_NOT_FOUND:
+        return "IK solution not found";
+    case E_OUT_OF_LIMITS:
+        return "Target pose out of robot limits";
+    case E_NOT_REACHABLE:
+        return "IK solution not reachable";
+    default:
+        return KDL::SolverI::strError(error);
+    }
+}
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,111 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#ifndef __CHAIN_IK_SOLVER_POS_HY_HPP__
+#define __CHAIN_IK_SOLVER_POS_HY_HPP__
+
+#include <kdl/chainfksolverpos_recursive.hpp>
+#include <kdl/chainiksolver.hpp>
+#include <kdl/chainiksolverpos_nr.hpp>
+#include <kdl/chainiksolvervel_pinv.hpp>
+
+#include "ScrewTheoryIkProblem.hpp"
+#include "ConfigurationSelector.hpp"
+
+namespace roboticslab
+{
+
+/**
+ * @ingroup KdlSolver
+ * @brief Hybrid IK solver using Screw Theory and Newton-Raphson refinement.
+ *
+ * Intended for kinematic chains that are almost, but not exactly, solvable by
+ * \ref ScrewTheoryIkProblemBuilder (e.g. a spherical wrist with a slightly offset
+ * axis). The nearest idealized chain is solved in closed form, then each solution
+ * is refined with a few Newton-Raphson iterations on the actual chain. The optimal
+ * configuration is picked afterwards.
+ */
+class ChainIkSolverPos_HY : public KDL::ChainIkSolverPos
+{
+public:
+    /** @brief Destructor. */
+    virtual ~ChainIkSolverPos_HY();
+
+    /**
+     * @brief Calculate inverse position kinematics.
+     *
+     * @param q_init Initial guess of the joint coordinates (used for configuration selection).
+     * @param p_in Input cartesian coordinates.
+     * @param q_out Output joint coordinates.
+     *
+     * @return Return code, \ref E_SOLUTION_NOT_FOUND if there is no solution,
+     * \ref E_OUT_OF_LIMITS if all converged ones violate joint limits or
+     * \ref E_NOT_REACHABLE if refinement did not converge for any of them (the
+     * output is then the best effort among them).
+     */
+    int CartToJnt(const KDL::JntArray & q_init, const KDL::Frame & p_in, KDL::JntArray & q_out) override;
+
+    /**
+    * @brief Update the internal data structures.
+    *
+    * Update the internal data structures. This is required if the number of segments
+    * or number of joints of a chain has changed. This provides a single point of contact
+    * for solver memory allocations.
+    */
+    void updateInternalDataStructures() override;
+
+    /**
+     * @brief Return a description of the last error
+     *
+     * @param error Error code.
+     *
+     * @return If \p error is known then a description of \p error, otherwise
+     * "UNKNOWN ERROR".
+     */
+    const char * strError(const int error) const override;
+
+    /**
+     * @brief Create an instance of \ref ChainIkSolverPos_HY.
+     *
+     * @param chain Input kinematic chain.
+     * @param configFactory Instance of an abstract factory class that
+     * instantiates a ConfigurationSelector.
+     * @param tolerance Maximum deviation of the actual chain geometry with respect
+     * to its idealized counterpart, see \ref ScrewTheoryIkProblemBuilder::idealize.
+     * @param maxIter Maximum number of Newton-Raphson iterations per solution.
+     * @param eps Precision of the Newton-Raphson refinement.
+     *
+     * @return Solver instance or null if no solution was found.
+     */
+    static KDL::ChainIkSolverPos * create(const KDL::Chain & chain, const ConfigurationSelectorFactory & configFactory,
+                                          double tolerance, int maxIter, double eps);
+
+    /** @brief Return code, IK solution not found. */
+    static const int E_SOLUTION_NOT_FOUND = -100;
+
+    /** @brief Return code, target pose out of robot limits. */
+    static const int E_OUT_OF_LIMITS = -101;
+
+    /** @brief Return code, solution out of reach. */
+    static const int E_NOT_REACHABLE = 100;
+
+private:
+    ChainIkSolverPos_HY(const KDL::Chain & chain, ScrewTheoryIkProblem * problem, ConfigurationSelector * config,
+                        double tolerance, int maxIter, double eps);
+
+    const KDL::Chain & chain;
+
+    ScrewTheoryIkProblem * problem;
+
+    ConfigurationSelector * config;
+
+    const double tolerance;
+    const double eps;
+
+    KDL::ChainFkSolverPos_recursive fkSolverPos;
+    KDL::ChainIkSolverVel_pinv ikSolverVel;
+    KDL::ChainIkSolverPos_NR ikSolverPos;
+};
+
+} // namespace roboticslab
+
+#endif // __CHAIN_IK_SOLVER_POS_HY_HPP__
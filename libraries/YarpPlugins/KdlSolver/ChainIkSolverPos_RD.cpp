@@ -0,0 +1,346 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#include "ChainIkSolverPos_RD.hpp"
+
+#include <algorithm> // std::copy, std::find, std::max, std::min
+
+using namespace roboticslab;
+
+// -----------------------------------------------------------------------------
+
+namespace
+{
+    PoeExpression lockJoint(const PoeExpression & poe, int lockedJoint, double value)
+    {
+        // Move the locked term to the right end of the POE, i.e. e_1 * ... * e_j(q_j) * ... * e_N * H_S_T(0) =
+        // e_1 * ... * [e_j(q_j) * e_(j+1) * e_j(q_j)^(-1)] * ... * [e_j(q_j) * e_N * e_j(q_j)^(-1)] * e_j(q_j) * H_S_T(0)
+        KDL::Frame H_locked = poe.exponentialAtJoint(lockedJoint).asFrame(value);
+        PoeExpression out(H_locked * poe.getTransform());
+
+        for (int i = 0; i < poe.size(); i++)
+        {
+            if (i < lockedJoint)
+            {
+                out.append(poe.exponentialAtJoint(i));
+            }
+            else if (i > lockedJoint)
+            {
+                out.append(poe.exponentialAtJoint(i), H_locked);
+            }
+        }
+
+        return out;
+    }
+
+    std::vector<double> makeSamples(double qMin, double qMax, int samples)
+    {
+        if (samples == 1)
+        {
+            return {(qMin + qMax) / 2.0};
+        }
+
+        std::vector<double> values(samples);
+
+        for (int i = 0; i < samples; i++)
+        {
+            values[i] = qMin + (qMax - qMin) * i / (samples - 1);
+        }
+
+        return values;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+ChainIkSolverPos_RD::ChainIkSolverPos_RD(const KDL::Chain & _chain, const Problems & _problems,
+        ConfigurationSelector * _config, const std::vector<double> & _values, int _lockedJoint, int _threads)
+    : chain(_chain),
+      problems(_problems),
+      config(_config),
+      values(_values),
+      lockedJoint(_lockedJoint),
+      poe(PoeExpression::fromChain(_chain))
+{
+    // One additional sample for the current value of the locked joint, if applicable.
+    int n = values.size() + (isLockedAtEnd() ? 1 : 0);
+
+    sampleValues.resize(n);
+    sampleSolutions.resize(n);
+    sampleReachable.resize(n);
+
+    int threads = _threads > 0 ? _threads : std::thread::hardware_concurrency();
+    threads = std::max(1, std::min(threads, n));
+
+    workers.reserve(threads - 1);
+
+    for (int i = 1; i < threads; i++)
+    {
+        workers.emplace_back(&ChainIkSolverPos_RD::runWorker, this, i);
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+ChainIkSolverPos_RD::~ChainIkSolverPos_RD()
+{
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        poolStop = true;
+    }
+
+    poolStart.notify_all();
+
+    for (auto & worker : workers)
+    {
+        worker.join();
+    }
+
+    for (auto * problem : problems)
+    {
+        delete problem;
+    }
+
+    problems.clear();
+
+    delete config;
+    config = nullptr;
+}
+
+// -----------------------------------------------------------------------------
+
+void ChainIkSolverPos_RD::solveSamples(const KDL::Frame & p_in, int first, int step)
+{
+    for (int i = first; i < sampleValues.size(); i += step)
+    {
+        if (isLockedAtEnd())
+        {
+            // The reduced POE has been built with a zero-valued locked joint, move it to the target pose instead.
+            KDL::Frame H_locked = poe.exponentialAtJoint(lockedJoint).asFrame(sampleValues[i]);
+            KDL::Frame H_target;
+
+            if (lockedJoint == 0)
+            {
+                H_target = H_locked.Inverse() * p_in;
+            }
+            else
+            {
+                const KDL::Frame & H_S_T_0 = poe.getTransform();
+                H_target = p_in * H_S_T_0.Inverse() * H_locked.Inverse() * H_S_T_0;
+            }
+
+            sampleReachable[i] = problems[0]->solve(H_target, sampleSolutions[i]);
+        }
+        else
+        {
+            sampleReachable[i] = problems[i]->solve(p_in, sampleSolutions[i]);
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void ChainIkSolverPos_RD::runWorker(int index)
+{
+    unsigned long round = 0;
+
+    while (true)
+    {
+        std::unique_lock<std::mutex> lock(poolMutex);
+        poolStart.wait(lock, [this, round] { return poolStop || poolRound != round; });
+
+        if (poolStop)
+        {
+            return;
+        }
+
+        round = poolRound;
+        const KDL::Frame & p_in = *poolTarget;
+        lock.unlock();
+
+        solveSamples(p_in, index, workers.size() + 1);
+
+        lock.lock();
+
+        if (--poolPending == 0)
+        {
+            poolDone.notify_one();
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+int ChainIkSolverPos_RD::CartToJnt(const KDL::JntArray & q_init, const KDL::Frame & p_in, KDL::JntArray & q_out)
+{
+    if (error == E_SOLUTION_NOT_FOUND)
+    {
+        return error;
+    }
+
+    if (isLockedAtEnd())
+    {
+        sampleValues[0] = q_init(lockedJoint);
+        std::copy(values.begin(), values.end(), sampleValues.begin() + 1);
+    }
+    else
+    {
+        sampleValues = values;
+    }
+
+    if (!workers.empty())
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        poolTarget = &p_in;
+        poolPending = workers.size();
+        poolRound++;
+    }
+
+    poolStart.notify_all();
+    solveSamples(p_in, 0, workers.size() + 1);
+
+    if (!workers.empty())
+    {
+        std::unique_lock<std::mutex> lock(poolMutex);
+        poolDone.wait(lock, [this] { return poolPending == 0; });
+    }
+
+    // Unreachable samples yield approximate solutions only, discard them unless nothing else is available.
+    bool reachable = std::find(sampleReachable.begin(), sampleReachable.end(), true) != sampleReachable.end();
+
+    // Samples are stored contiguously, the current value of the locked joint comes first (if applicable).
+    // Each sample always contributes the same number of solutions, therefore any given index refers to
+    // the same sample and branch on every call (as required by stateful configuration selectors).
+    int k = 0;
+
+    for (int i = 0; i < sampleValues.size(); i++)
+    {
+        for (const auto & partial : sampleSolutions[i])
+        {
+            if (k == solutions.size())
+            {
+                solutions.emplace_back(chain.getNrOfJoints());
+                mask.push_back(true);
+            }
+
+            KDL::JntArray & q = solutions[k];
+
+            for (int j = 0; j < q.rows(); j++)
+            {
+                q(j) = j < lockedJoint ? partial(j) : (j == lockedJoint ? sampleValues[i] : partial(j - 1));
+            }
+
+            mask[k++] = !reachable || sampleReachable[i];
+        }
+    }
+
+    solutions.resize(k);
+    mask.resize(k);
+
+    if (!config->configure(solutions, mask))
+    {
+        return (error = E_OUT_OF_LIMITS);
+    }
+
+    if (!config->findOptimalConfiguration(q_init))
+    {
+        return (error = E_OUT_OF_LIMITS);
+    }
+
+    config->retrievePose(q_out);
+
+    return (error = reachable ? E_NOERROR : E_NOT_REACHABLE);
+}
+
+// -----------------------------------------------------------------------------
+
+void ChainIkSolverPos_RD::updateInternalDataStructures()
+{
+    Problems problems;
+
+    if (!buildProblems(chain, isLockedAtEnd() ? std::vector<double>{0.0} : values, lockedJoint, problems))
+    {
+        error = E_SOLUTION_NOT_FOUND;
+        return;
+    }
+
+    for (auto * problem : this->problems)
+    {
+        delete problem;
+    }
+
+    this->problems = problems;
+    poe = PoeExpression::fromChain(chain);
+}
+
+// -----------------------------------------------------------------------------
+
+bool ChainIkSolverPos_RD::buildProblems(const KDL::Chain & chain, const std::vector<double> & values, int lockedJoint,
+        Problems & problems)
+{
+    PoeExpression poe = PoeExpression::fromChain(chain);
+
+    for (double value : values)
+    {
+        ScrewTheoryIkProblemBuilder builder(lockJoint(poe, lockedJoint, value));
+        ScrewTheoryIkProblem * problem = builder.build();
+
+        if (!problem)
+        {
+            for (auto * problem : problems)
+            {
+                delete problem;
+            }
+
+            problems.clear();
+            return false;
+        }
+
+        problems.push_back(problem);
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+KDL::ChainIkSolverPos * ChainIkSolverPos_RD::create(const KDL::Chain & chain, const ConfigurationSelectorFactory & configFactory,
+        const KDL::JntArray & qMin, const KDL::JntArray & qMax, int lockedJoint, int samples, int threads)
+{
+    if (lockedJoint < 0 || lockedJoint >= chain.getNrOfJoints() || samples < 1)
+    {
+        return nullptr;
+    }
+
+    std::vector<double> values = makeSamples(qMin(lockedJoint), qMax(lockedJoint), samples);
+    bool lockedAtEnd = lockedJoint == 0 || lockedJoint == chain.getNrOfJoints() - 1;
+
+    Problems problems;
+
+    if (!buildProblems(chain, lockedAtEnd ? std::vector<double>{0.0} : values, lockedJoint, problems))
+    {
+        return nullptr;
+    }
+
+    ConfigurationSelector * config = configFactory.create();
+
+    return new ChainIkSolverPos_RD(chain, problems, config, values, lockedJoint, threads);
+}
+
+// -----------------------------------------------------------------------------
+
+const char * ChainIkSolverPos_RD::strError(const int error) const
+{
+    switch (error)
+    {
+    case E_SOLUTION_NOT_FOUND:
+        return "IK solution not found";
+    case E_OUT_OF_LIMITS:
+        return "Target pose out of robot limits";
+    case E_NOT_REACHABLE:
+        return "IK solution not reachable";
+    default:
+        return KDL::SolverI::strError(error);
+    }
+}
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,149 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#ifndef __CHAIN_IK_SOLVER_POS_RD_HPP__
+#define __CHAIN_IK_SOLVER_POS_RD_HPP__
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <kdl/chainiksolver.hpp>
+
+#include "ScrewTheoryIkProblem.hpp"
+#include "ConfigurationSelector.hpp"
+
+namespace roboticslab
+{
+
+/**
+ * @ingroup KdlSolver
+ * @brief Closed-form IK solver for kinematically redundant chains (one extra DOF).
+ *
+ * The self-motion of the chain is parameterized by a locked joint (e.g. the arm
+ * angle of a 7-DOF arm). For each sampled value of said joint, the remaining
+ * non-redundant chain is solved with Screw Theory. Samples are processed in
+ * parallel by a pool of worker threads that lives as long as the solver, and
+ * the optimal configuration is picked among all of them. Solutions keep their
+ * position in the list passed on to the ConfigurationSelector across calls,
+ * those of unreachable samples are masked out unless no sample is reachable.
+ *
+ * If the locked joint is the first or the last one of the chain, a single IK
+ * problem is shared by all samples and the current value of the locked joint
+ * is tried first, therefore it will not move unless required. Otherwise, one
+ * IK problem is built per sample and the locked joint only takes sampled values.
+ */
+class ChainIkSolverPos_RD : public KDL::ChainIkSolverPos
+{
+public:
+    /** @brief Destructor. */
+    virtual ~ChainIkSolverPos_RD();
+
+    /**
+     * @brief Calculate inverse position kinematics.
+     *
+     * @param q_init Initial guess of the joint coordinates (used for configuration selection).
+     * @param p_in Input cartesian coordinates.
+     * @param q_out Output joint coordinates.
+     *
+     * @return Return code, \ref E_SOLUTION_NOT_FOUND if there is no solution,
+     * \ref E_OUT_OF_LIMITS if all of them violate joint limits or \ref E_NOT_REACHABLE
+     * if no sample yields an exact solution.
+     */
+    int CartToJnt(const KDL::JntArray & q_init, const KDL::Frame & p_in, KDL::JntArray & q_out) override;
+
+    /**
+    * @brief Update the internal data structures.
+    *
+    * Update the internal data structures. This is required if the number of segments
+    * or number of joints of a chain has changed. This provides a single point of contact
+    * for solver memory allocations.
+    */
+    void updateInternalDataStructures() override;
+
+    /**
+     * @brief Return a description of the last error
+     *
+     * @param error Error code.
+     *
+     * @return If \p error is known then a description of \p error, otherwise
+     * "UNKNOWN ERROR".
+     */
+    const char * strError(const int error) const override;
+
+    /**
+     * @brief Create an instance of \ref ChainIkSolverPos_RD.
+     *
+     * @param chain Input kinematic chain.
+     * @param configFactory Instance of an abstract factory class that
+     * instantiates a ConfigurationSelector.
+     * @param qMin Joint array of minimum joint limits.
+     * @param qMax Joint array of maximum joint limits.
+     * @param lockedJoint Index of the joint that parameterizes the self-motion.
+     * @param samples Number of values of the locked joint, evenly distributed
+     * within its limits.
+     * @param threads Number of worker threads, zero for hardware concurrency.
+     *
+     * @return Solver instance or null if no solution was found.
+     */
+    static KDL::ChainIkSolverPos * create(const KDL::Chain & chain, const ConfigurationSelectorFactory & configFactory,
+                                          const KDL::JntArray & qMin, const KDL::JntArray & qMax,
+                                          int lockedJoint, int samples, int threads);
+
+    /** @brief Return code, IK solution not found. */
+    static const int E_SOLUTION_NOT_FOUND = -100;
+
+    /** @brief Return code, target pose out of robot limits. */
+    static const int E_OUT_OF_LIMITS = -101;
+
+    /** @brief Return code, solution out of reach. */
+    static const int E_NOT_REACHABLE = 100;
+
+private:
+    using Problems = std::vector<ScrewTheoryIkProblem *>;
+
+    ChainIkSolverPos_RD(const KDL::Chain & chain, const Problems & problems, ConfigurationSelector * config,
+                        const std::vector<double> & values, int lockedJoint, int threads);
+
+    bool isLockedAtEnd() const
+    { return lockedJoint == 0 || lockedJoint == chain.getNrOfJoints() - 1; }
+
+    void solveSamples(const KDL::Frame & p_in, int first, int step);
+
+    void runWorker(int index);
+
+    static bool buildProblems(const KDL::Chain & chain, const std::vector<double> & values, int lockedJoint, Problems & problems);
+
+    const KDL::Chain & chain;
+
+    // we own these, resources freed in destructor
+    Problems problems;
+
+    ConfigurationSelector * config;
+
+    const std::vector<double> values;
+    const int lockedJoint;
+
+    PoeExpression poe;
+
+    // per-sample scratch data, sample #0 holds the current value of the locked joint if locked at either end
+    std::vector<double> sampleValues;
+    std::vector<ScrewTheoryIkProblem::Solutions> sampleSolutions;
+    std::vector<char> sampleReachable;
+
+    std::vector<KDL::JntArray> solutions;
+    std::vector<bool> mask;
+
+    // helper threads, the caller of CartToJnt handles the first share of samples
+    std::vector<std::thread> workers;
+    std::mutex poolMutex;
+    std::condition_variable poolStart, poolDone;
+    const KDL::Frame * poolTarget {nullptr};
+    unsigned long poolRound {0};
+    int poolPending {0};
+    bool poolStop {false};
+};
+
+} // namespace roboticslab
+
+#endif // __CHAIN_IK_SOLVER_POS_RD_HPP__
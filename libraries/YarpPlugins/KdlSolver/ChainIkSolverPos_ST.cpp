@@ -7,10 +7,11 @@ using namespace roboticslab;
 // -----------------------------------------------------------------------------
 
 ChainIkSolverPos_ST::ChainIkSolverPos_ST(const KDL::Chain & _chain, ScrewTheoryIkProblem * _problem,
-        ConfigurationSelector * _config)
+        std::shared_ptr<const ConfigurationSelectorFactory> _configFactory, ConfigurationSelector * _config)
     : chain(_chain),
       problem(_problem),
-      config(_config)
+      configFactory(_configFactory),
+      context(_config)
 {}
 
 // -----------------------------------------------------------------------------
@@ -19,37 +20,40 @@ ChainIkSolverPos_ST::~ChainIkSolverPos_ST()
 {
     delete problem;
     problem = nullptr;
-
-    delete config;
-    config = nullptr;
 }
 
 // -----------------------------------------------------------------------------
 
 int ChainIkSolverPos_ST::CartToJnt(const KDL::JntArray & q_init, const KDL::Frame & p_in, KDL::JntArray & q_out)
 {
-    if (error == E_SOLUTION_NOT_FOUND)
+    return (error = CartToJnt(q_init, p_in, q_out, context));
+}
+
+// -----------------------------------------------------------------------------
+
+int ChainIkSolverPos_ST::CartToJnt(const KDL::JntArray & q_init, const KDL::Frame & p_in, KDL::JntArray & q_out,
+        Context & context) const
+{
+    if (!problem)
     {
-        return error;
+        return E_SOLUTION_NOT_FOUND;
     }
 
-    std::vector<KDL::JntArray> solutions;
+    bool ret = problem->solve(p_in, context.solutions);
 
-    bool ret = problem->solve(p_in, solutions);
-
-    if (!config->configure(solutions))
+    if (!context.config->configure(context.solutions))
     {
-        return (error = E_OUT_OF_LIMITS);
+        return E_OUT_OF_LIMITS;
     }
 
-    if (!config->findOptimalConfiguration(q_init))
+    if (!context.config->findOptimalConfiguration(q_init))
     {
-        return (error = E_OUT_OF_LIMITS);
+        return E_OUT_OF_LIMITS;
     }
 
-    config->retrievePose(q_out);
+    context.config->retrievePose(q_out);
 
-    return (error = ret ? E_NOERROR : E_NOT_REACHABLE);
+    return ret ? E_NOERROR : E_NOT_REACHABLE;
 }
 
 // -----------------------------------------------------------------------------
@@ -60,19 +64,20 @@ void ChainIkSolverPos_ST::updateInternalDataStructures()
     ScrewTheoryIkProblemBuilder builder(poe);
     ScrewTheoryIkProblem * problem = builder.build();
 
+    // a null problem is reported by CartToJnt as E_SOLUTION_NOT_FOUND
+    delete this->problem;
+    this->problem = problem;
+
     if (!problem)
     {
         error = E_SOLUTION_NOT_FOUND;
-        return;
     }
-
-    delete this->problem;
-    this->problem = problem;
 }
 
 // -----------------------------------------------------------------------------
 
-KDL::ChainIkSolverPos * ChainIkSolverPos_ST::create(const KDL::Chain & chain, const ConfigurationSelectorFactory & configFactory)
+KDL::ChainIkSolverPos * ChainIkSolverPos_ST::create(const KDL::Chain & chain,
+        std::shared_ptr<const ConfigurationSelectorFactory> configFactory)
 {
     PoeExpression poe = PoeExpression::fromChain(chain);
     ScrewTheoryIkProblemBuilder builder(poe);
@@ -83,9 +88,15 @@ KDL::ChainIkSolverPos * ChainIkSolverPos_ST::create(const KDL::Chain & chain, co
         return nullptr;
     }
 
-    ConfigurationSelector * config = configFactory.create();
+    ConfigurationSelector * config = configFactory ? configFactory->create() : nullptr;
+
+    if (!config)
+    {
+        delete problem;
+        return nullptr;
+    }
 
-    return new ChainIkSolverPos_ST(chain, problem, config);
+    return new ChainIkSolverPos_ST(chain, problem, configFactory, config);
 }
 
 // -----------------------------------------------------------------------------
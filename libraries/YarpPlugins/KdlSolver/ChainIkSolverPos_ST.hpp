@@ -3,6 +3,8 @@
 #ifndef __CHAIN_IK_SOLVER_POS_ST_HPP__
 #define __CHAIN_IK_SOLVER_POS_ST_HPP__
 
+#include <memory>
+
 #include <kdl/chainiksolver.hpp>
 
 #include "ScrewTheoryIkProblem.hpp"
@@ -19,10 +21,37 @@ namespace roboticslab
  * around \ref ScrewTheoryIkProblem. Non-exhaustive tests on TEO's (UC3M) right arm
  * kinematic chain reveal that this is 5-10 faster than a numeric Newton-Raphson
  * solver as provided by KDL (e.g. KDL::ChainIkSolverPos_NR_JL).
+ *
+ * The IK problem is immutable, whereas the state of the configuration selector
+ * persists between calls. Concurrent callers may share a single instance of this
+ * class as long as each of them owns a \ref Context, see \ref makeContext.
  */
 class ChainIkSolverPos_ST : public KDL::ChainIkSolverPos
 {
 public:
+    /**
+     * @brief Per-caller state of the IK solver.
+     *
+     * Holds the configuration selector and preallocated storage for the global
+     * IK solutions. Move-only.
+     */
+    class Context
+    {
+    public:
+        /**
+         * @brief Constructor.
+         *
+         * @param config Configuration selector, ownership is transferred.
+         */
+        explicit Context(ConfigurationSelector * config) : config(config) {}
+
+    private:
+        friend class ChainIkSolverPos_ST;
+
+        std::unique_ptr<ConfigurationSelector> config;
+        ScrewTheoryIkProblem::Solutions solutions;
+    };
+
     /** @brief Destructor. */
     virtual ~ChainIkSolverPos_ST();
 
@@ -38,6 +67,30 @@ public:
      */
     int CartToJnt(const KDL::JntArray & q_init, const KDL::Frame & p_in, KDL::JntArray & q_out) override;
 
+    /**
+     * @brief Calculate inverse position kinematics, reentrant variant.
+     *
+     * Neither the error state of this instance nor its default context are
+     * altered, hence this method is safe to call from several threads at once
+     * as long as each thread passes its own context.
+     *
+     * @param q_init Initial guess of the joint coordinates (used for configuration selection).
+     * @param p_in Input cartesian coordinates.
+     * @param q_out Output joint coordinates.
+     * @param context Per-caller state, see \ref makeContext.
+     *
+     * @return Return code, see \ref CartToJnt.
+     */
+    int CartToJnt(const KDL::JntArray & q_init, const KDL::Frame & p_in, KDL::JntArray & q_out, Context & context) const;
+
+    /**
+     * @brief Create a new per-caller context.
+     *
+     * @return A context whose configuration selector starts afresh.
+     */
+    Context makeContext() const
+    { return Context(configFactory->create()); }
+
     /**
     * @brief Update the internal data structures.
     *
@@ -62,11 +115,11 @@ public:
      *
      * @param chain Input kinematic chain.
      * @param configFactory Instance of an abstract factory class that
-     * instantiates a ConfigurationSelector.
+     * instantiates a ConfigurationSelector, kept alive to serve new contexts.
      *
      * @return Solver instance or null if no solution was found.
      */
-    static KDL::ChainIkSolverPos * create(const KDL::Chain & chain, const ConfigurationSelectorFactory & configFactory);
+    static KDL::ChainIkSolverPos * create(const KDL::Chain & chain, std::shared_ptr<const ConfigurationSelectorFactory> configFactory);
 
     /** @brief Return code, IK solution not found. */
     static const int E_SOLUTION_NOT_FOUND = -100;
@@ -78,13 +131,19 @@ public:
     static const int E_NOT_REACHABLE = 100;
 
 private:
-    ChainIkSolverPos_ST(const KDL::Chain & chain, ScrewTheoryIkProblem * problem, ConfigurationSelector * config);
+    ChainIkSolverPos_ST(const KDL::Chain & chain, ScrewTheoryIkProblem * problem,
+            std::shared_ptr<const ConfigurationSelectorFactory> configFactory, ConfigurationSelector * config);
 
     const KDL::Chain & chain;
 
+    // we own these, resources freed in destructor
     ScrewTheoryIkProblem * problem;
 
-    ConfigurationSelector * config;
+    // instantiates the selector of each new context
+    std::shared_ptr<const ConfigurationSelectorFactory> configFactory;
+
+    // used by the non-reentrant KDL interface
+    Context context;
 };
 
 } // namespace roboticslab
@@ -0,0 +1,185 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#include "ChainParser.hpp"
+
+#include <sstream>
+
+#include <yarp/os/Bottle.h>
+#include <yarp/os/LogStream.h>
+#include <yarp/os/Value.h>
+
+#include <kdl/frames.hpp>
+#include <kdl/joint.hpp>
+#include <kdl/rigidbodyinertia.hpp>
+#include <kdl/rotationalinertia.hpp>
+#include <kdl/segment.hpp>
+
+#include "KinematicRepresentation.hpp"
+#include "LogComponent.hpp"
+
+using namespace roboticslab;
+
+constexpr auto DEFAULT_NUM_LINKS = 1;
+
+// -----------------------------------------------------------------------------
+
+bool roboticslab::getMatrixFromProperties(const yarp::os::Searchable & options, const std::string & tag, Eigen::MatrixXd & mat)
+{
+    const auto * bH = options.find(tag).asList();
+
+    if (!bH)
+    {
+        return false;
+    }
+
+    int i = 0;
+    int j = 0;
+
+    for (int cnt = 0; cnt < bH->size() && cnt < mat.rows() * mat.cols(); cnt++)
+    {
+        mat(i, j) = bH->get(cnt).asFloat64();
+
+        if (++j >= mat.cols())
+        {
+            i++;
+            j = 0;
+        }
+    }
+
+    std::stringstream ss;
+    ss << "Matrix " << tag << ":\n" << mat;
+    yCInfo(KDLS) << ss.str();
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+bool roboticslab::parseChain(const yarp::os::Searchable & options, KDL::Chain & chain)
+{
+    //-- numlinks
+    int numLinks = options.check("numLinks", yarp::os::Value(DEFAULT_NUM_LINKS), "chain number of segments").asInt32();
+    yCInfo(KDLS) << "numLinks:" << numLinks;
+
+    //-- H0
+    Eigen::MatrixXd H0 = Eigen::MatrixXd::Identity(4, 4);
+
+    if (!getMatrixFromProperties(options, "H0", H0))
+    {
+        yCWarning(KDLS) << "Failed to parse H0, using default identity matrix";
+    }
+
+    KDL::Vector kdlVec0(H0(0, 3), H0(1, 3), H0(2, 3));
+    KDL::Rotation kdlRot0(H0(0, 0), H0(0, 1), H0(0, 2), H0(1, 0), H0(1, 1), H0(1, 2), H0(2, 0), H0(2, 1), H0(2, 2));
+    chain.addSegment(KDL::Segment(KDL::Joint(KDL::Joint::None), KDL::Frame(kdlRot0, kdlVec0)));
+
+    //-- links
+    for (int linkIndex = 0; linkIndex < numLinks; linkIndex++)
+    {
+        std::string link = "link_" + std::to_string(linkIndex);
+        yarp::os::Bottle & bLink = options.findGroup(link);
+
+        if (!bLink.isNull())
+        {
+            //-- Kinematic
+            double linkOffset = bLink.check("offset", yarp::os::Value(0.0), "DH joint angle (degrees)").asFloat64();
+            double linkD = bLink.check("D", yarp::os::Value(0.0), "DH link offset (meters)").asFloat64();
+            double linkA = bLink.check("A", yarp::os::Value(0.0), "DH link length (meters)").asFloat64();
+            double linkAlpha = bLink.check("alpha", yarp::os::Value(0.0), "DH link twist (degrees)").asFloat64();
+
+            KDL::Joint axis(KDL::Joint::RotZ);
+            KDL::Frame H = KDL::Frame::DH(linkA, KinRepresentation::degToRad(linkAlpha), linkD, KinRepresentation::degToRad(linkOffset));
+
+            //-- Dynamic
+            if (bLink.check("mass") && bLink.check("cog") && bLink.check("inertia"))
+            {
+                double linkMass = bLink.check("mass", yarp::os::Value(0.0), "link mass (SI units)").asFloat64();
+                yarp::os::Bottle linkCog = bLink.findGroup("cog", "vector of link's center of gravity (SI units)").tail();
+                yarp::os::Bottle linkInertia = bLink.findGroup("inertia", "vector of link's inertia (SI units)").tail();
+
+                KDL::Vector cog(linkCog.get(0).asFloat64(), linkCog.get(1).asFloat64(), linkCog.get(2).asFloat64());
+                KDL::RotationalInertia inertia(linkInertia.get(0).asFloat64(), linkInertia.get(1).asFloat64(), linkInertia.get(2).asFloat64());
+
+                chain.addSegment(KDL::Segment(axis, H, KDL::RigidBodyInertia(linkMass, cog, inertia)));
+
+                yCInfo(KDLS, "Added: %s (offset %f) (D %f) (A %f) (alpha %f) (mass %f) (cog %f %f %f) (inertia %f %f %f)",
+                       link.c_str(), linkOffset, linkD, linkA, linkAlpha, linkMass,
+                       linkCog.get(0).asFloat64(), linkCog.get(1).asFloat64(), linkCog.get(2).asFloat64(),
+                       linkInertia.get(0).asFloat64(), linkInertia.get(1).asFloat64(), linkInertia.get(2).asFloat64());
+            }
+            else
+            {
+                chain.addSegment(KDL::Segment(axis, H));
+                yCInfo(KDLS, "Added: %s (offset %f) (D %f) (A %f) (alpha %f)", link.c_str(), linkOffset, linkD, linkA, linkAlpha);
+            }
+        }
+        else
+        {
+            std::string xyzLink = "xyzLink_" + std::to_string(linkIndex);
+            yCWarning(KDLS, "Not found: \"%s\", looking for \"%s\" instead.", link.c_str(), xyzLink.c_str());
+
+            yarp::os::Bottle & bXyzLink = options.findGroup(xyzLink);
+
+            if (bXyzLink.isNull())
+            {
+                yCError(KDLS, "Not found: \"%s\" either.", xyzLink.c_str());
+                return false;
+            }
+
+            double linkX = bXyzLink.check("x", yarp::os::Value(0.0), "X coordinate of next frame (meters)").asFloat64();
+            double linkY = bXyzLink.check("y", yarp::os::Value(0.0), "Y coordinate of next frame (meters)").asFloat64();
+            double linkZ = bXyzLink.check("z", yarp::os::Value(0.0), "Z coordinate of next frame (meters)").asFloat64();
+
+            std::string linkTypes = "joint type (Rot[XYZ]|InvRot[XYZ]|Trans[XYZ]|InvTrans[XYZ]), e.g. 'RotZ'";
+            std::string linkType = bXyzLink.check("Type", yarp::os::Value("NULL"), linkTypes.c_str()).asString();
+
+            KDL::Frame H(KDL::Vector(linkX, linkY, linkZ));
+
+            if (linkType == "RotX") {
+                chain.addSegment(KDL::Segment(KDL::Joint(KDL::Joint::RotX), H));
+            } else if (linkType == "RotY") {
+                chain.addSegment(KDL::Segment(KDL::Joint(KDL::Joint::RotY), H));
+            } else if (linkType == "RotZ") {
+                chain.addSegment(KDL::Segment(KDL::Joint(KDL::Joint::RotZ), H));
+            } else if (linkType == "InvRotX") {
+                chain.addSegment(KDL::Segment(KDL::Joint(KDL::Joint::RotX, -1.0), H));
+            } else if (linkType == "InvRotY") {
+                chain.addSegment(KDL::Segment(KDL::Joint(KDL::Joint::RotY, -1.0), H));
+            } else if (linkType == "InvRotZ") {
+                chain.addSegment(KDL::Segment(KDL::Joint(KDL::Joint::RotZ, -1.0), H));
+            } else if (linkType == "TransX") {
+                chain.addSegment(KDL::Segment(KDL::Joint(KDL::Joint::TransX), H));
+            } else if (linkType == "TransY") {
+                chain.addSegment(KDL::Segment(KDL::Joint(KDL::Joint::TransY), H));
+            } else if (linkType == "TransZ") {
+                chain.addSegment(KDL::Segment(KDL::Joint(KDL::Joint::TransZ), H));
+            } else if (linkType == "InvTransX") {
+                chain.addSegment(KDL::Segment(KDL::Joint(KDL::Joint::TransX, -1.0), H));
+            } else if (linkType == "InvTransY") {
+                chain.addSegment(KDL::Segment(KDL::Joint(KDL::Joint::TransY, -1.0), H));
+            } else if (linkType == "InvTransZ") {
+                chain.addSegment(KDL::Segment(KDL::Joint(KDL::Joint::TransZ, -1.0), H));
+            } else {
+                yCWarning(KDLS, "Link joint type \"%s\" unrecognized!", linkType.c_str());
+            }
+
+            yCInfo(KDLS, "Added: %s (Type %s) (x %f) (y %f) (z %f)", xyzLink.c_str(), linkType.c_str(), linkX, linkY, linkZ);
+        }
+    }
+
+    //-- HN
+    Eigen::MatrixXd HN = Eigen::MatrixXd::Identity(4, 4);
+
+    if (!getMatrixFromProperties(options, "HN", HN))
+    {
+        yCWarning(KDLS) << "Failed to parse HN, using default identity matrix";
+    }
+
+    KDL::Vector kdlVecN(HN(0, 3), HN(1, 3), HN(2, 3));
+    KDL::Rotation kdlRotN(HN(0, 0), HN(0, 1), HN(0, 2), HN(1, 0), HN(1, 1), HN(1, 2), HN(2, 0), HN(2, 1), HN(2, 2));
+    chain.addSegment(KDL::Segment(KDL::Joint(KDL::Joint::None), KDL::Frame(kdlRotN, kdlVecN)));
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
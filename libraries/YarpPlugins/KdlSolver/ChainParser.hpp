@@ -0,0 +1,44 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#ifndef __CHAIN_PARSER_HPP__
+#define __CHAIN_PARSER_HPP__
+
+#include <string>
+
+#include <yarp/os/Searchable.h>
+
+#include <kdl/chain.hpp>
+
+#include <Eigen/Core>
+
+namespace roboticslab
+{
+
+/**
+ * @ingroup KdlSolver
+ * @brief Parses a matrix stored in row-major order.
+ *
+ * @param options Configuration options.
+ * @param tag Name of the option that holds the matrix.
+ * @param mat Output matrix, its size is preserved.
+ *
+ * @return True if the option was found, false otherwise.
+ */
+bool getMatrixFromProperties(const yarp::os::Searchable & options, const std::string & tag, Eigen::MatrixXd & mat);
+
+/**
+ * @ingroup KdlSolver
+ * @brief Builds a kinematic chain as described in a kinematics .ini file.
+ *
+ * Parses H0, the link_N (DH) or xyzLink_N groups and HN, see \ref KdlSolver.
+ *
+ * @param options Configuration options.
+ * @param chain Output chain, segments are appended to it.
+ *
+ * @return True on success, false otherwise.
+ */
+bool parseChain(const yarp::os::Searchable & options, KDL::Chain & chain);
+
+} // namespace roboticslab
+
+#endif // __CHAIN_PARSER_HPP__
@@ -2,7 +2,7 @@
 
 #include "KdlSolver.hpp"
 
-#include <sstream>
+#include <memory>
 #include <string>
 
 #include <yarp/conf/version.h>
@@ -15,10 +15,6 @@
 
 #include <kdl/frames.hpp>
 #include <kdl/jntarray.hpp>
-#include <kdl/joint.hpp>
-#include <kdl/rigidbodyinertia.hpp>
-#include <kdl/rotationalinertia.hpp>
-#include <kdl/segment.hpp>
 
 #include <kdl/chainfksolverpos_recursive.hpp>
 #include <kdl/chainiksolverpos_lma.hpp>
@@ -30,18 +26,27 @@
 #include "KinematicRepresentation.hpp"
 #include "ConfigurationSelector.hpp"
 
+#include "ChainParser.hpp"
 #include "ChainIkSolverPos_ST.hpp"
+#include "ChainIkSolverPos_HY.hpp"
+#include "ChainIkSolverPos_RD.hpp"
+#include "ChainIkSolverPos_CG.hpp"
 #include "ChainIkSolverPos_ID.hpp"
 #include "LogComponent.hpp"
 
 using namespace roboticslab;
 
 constexpr auto DEFAULT_KINEMATICS = "none.ini";
-constexpr auto DEFAULT_NUM_LINKS = 1;
 constexpr auto DEFAULT_EPS_POS = 1e-5;
 constexpr auto DEFAULT_EPS_VEL = 1e-5;
 constexpr auto DEFAULT_MAXITER_POS = 1000;
 constexpr auto DEFAULT_MAXITER_VEL = 150;
+constexpr auto DEFAULT_MAXITER_HY = 10;
+constexpr auto DEFAULT_IDEAL_TOLERANCE = 0.01;
+constexpr auto DEFAULT_LOCKED_JOINT = 0;
+constexpr auto DEFAULT_SWEEP_SAMPLES = 16;
+constexpr auto DEFAULT_SWEEP_THREADS = 0;
+constexpr auto DEFAULT_IK_PLUGIN = "";
 constexpr auto DEFAULT_IK_POS_SOLVER = "st";
 constexpr auto DEFAULT_IK_VEL_SOLVER = "pinv";
 constexpr auto DEFAULT_LMA_WEIGHTS = "1 1 1 0.1 0.1 0.1";
@@ -52,36 +57,6 @@ constexpr auto DEFAULT_STRATEGY = "leastOverallAngularDisplacement";
 
 namespace
 {
-    bool getMatrixFromProperties(const yarp::os::Searchable & options, const std::string & tag, Eigen::MatrixXd & mat)
-    {
-        const auto * bH = options.find(tag).asList();
-
-        if (!bH)
-        {
-            return false;
-        }
-
-        int i = 0;
-        int j = 0;
-
-        for (int cnt = 0; cnt < bH->size() && cnt < mat.rows() * mat.cols(); cnt++)
-        {
-            mat(i, j) = bH->get(cnt).asFloat64();
-
-            if (++j >= mat.cols())
-            {
-                i++;
-                j = 0;
-            }
-        }
-
-        std::stringstream ss;
-        ss << "Matrix " << tag << ":\n" << mat;
-        yCInfo(KDLS) << ss.str();
-
-        return true;
-    }
-
     bool parseLmaFromBottle(const yarp::os::Bottle & b, Eigen::Matrix<double, 6, 1> & L)
     {
         if (b.size() != 6)
@@ -171,10 +146,6 @@ bool KdlSolver::open(yarp::os::Searchable & config)
 
     yCDebug(KDLS) << "fullConfig:" << fullConfig.toString();
 
-    //-- numlinks
-    int numLinks = fullConfig.check("numLinks", yarp::os::Value(DEFAULT_NUM_LINKS), "chain number of segments").asInt32();
-    yCInfo(KDLS) << "numLinks:" << numLinks;
-
     //-- gravity (default)
     yarp::os::Value defaultGravityValue;
     yarp::os::Bottle * defaultGravityBottle = defaultGravityValue.asList();
@@ -188,124 +159,12 @@ bool KdlSolver::open(yarp::os::Searchable & config)
     KDL::Vector gravity(gravityBottle->get(0).asFloat64(), gravityBottle->get(1).asFloat64(), gravityBottle->get(2).asFloat64());
     yCInfo(KDLS) << "gravity:" << gravityBottle->toString();
 
-    //-- H0
-    Eigen::MatrixXd H0 = Eigen::MatrixXd::Identity(4, 4);
-
-    if (!getMatrixFromProperties(fullConfig, "H0", H0))
-    {
-        yCWarning(KDLS) << "Failed to parse H0, using default identity matrix";
-    }
-
-    KDL::Vector kdlVec0(H0(0, 3), H0(1, 3), H0(2, 3));
-    KDL::Rotation kdlRot0(H0(0, 0), H0(0, 1), H0(0, 2), H0(1, 0), H0(1, 1), H0(1, 2), H0(2, 0), H0(2, 1), H0(2, 2));
-    chain.addSegment(KDL::Segment(KDL::Joint(KDL::Joint::None), KDL::Frame(kdlRot0, kdlVec0)));
-
-    //-- links
-    for (int linkIndex = 0; linkIndex < numLinks; linkIndex++)
+    //-- chain
+    if (!parseChain(fullConfig, chain))
     {
-        std::string link = "link_" + std::to_string(linkIndex);
-        yarp::os::Bottle & bLink = fullConfig.findGroup(link);
-
-        if (!bLink.isNull())
-        {
-            //-- Kinematic
-            double linkOffset = bLink.check("offset", yarp::os::Value(0.0), "DH joint angle (degrees)").asFloat64();
-            double linkD = bLink.check("D", yarp::os::Value(0.0), "DH link offset (meters)").asFloat64();
-            double linkA = bLink.check("A", yarp::os::Value(0.0), "DH link length (meters)").asFloat64();
-            double linkAlpha = bLink.check("alpha", yarp::os::Value(0.0), "DH link twist (degrees)").asFloat64();
-
-            KDL::Joint axis(KDL::Joint::RotZ);
-            KDL::Frame H = KDL::Frame::DH(linkA, KinRepresentation::degToRad(linkAlpha), linkD, KinRepresentation::degToRad(linkOffset));
-
-            //-- Dynamic
-            if (bLink.check("mass") && bLink.check("cog") && bLink.check("inertia"))
-            {
-                double linkMass = bLink.check("mass", yarp::os::Value(0.0), "link mass (SI units)").asFloat64();
-                yarp::os::Bottle linkCog = bLink.findGroup("cog", "vector of link's center of gravity (SI units)").tail();
-                yarp::os::Bottle linkInertia = bLink.findGroup("inertia", "vector of link's inertia (SI units)").tail();
-
-                KDL::Vector cog(linkCog.get(0).asFloat64(), linkCog.get(1).asFloat64(), linkCog.get(2).asFloat64());
-                KDL::RotationalInertia inertia(linkInertia.get(0).asFloat64(), linkInertia.get(1).asFloat64(), linkInertia.get(2).asFloat64());
-
-                chain.addSegment(KDL::Segment(axis, H, KDL::RigidBodyInertia(linkMass, cog, inertia)));
-
-                yCInfo(KDLS, "Added: %s (offset %f) (D %f) (A %f) (alpha %f) (mass %f) (cog %f %f %f) (inertia %f %f %f)",
-                       link.c_str(), linkOffset, linkD, linkA, linkAlpha, linkMass,
-                       linkCog.get(0).asFloat64(), linkCog.get(1).asFloat64(), linkCog.get(2).asFloat64(),
-                       linkInertia.get(0).asFloat64(), linkInertia.get(1).asFloat64(), linkInertia.get(2).asFloat64());
-            }
-            else
-            {
-                chain.addSegment(KDL::Segment(axis, H));
-                yCInfo(KDLS, "Added: %s (offset %f) (D %f) (A %f) (alpha %f)", link.c_str(), linkOffset, linkD, linkA, linkAlpha);
-            }
-        }
-        else
-        {
-            std::string xyzLink = "xyzLink_" + std::to_string(linkIndex);
-            yCWarning(KDLS, "Not found: \"%s\", looking for \"%s\" instead.", link.c_str(), xyzLink.c_str());
-
-            yarp::os::Bottle & bXyzLink = fullConfig.findGroup(xyzLink);
-
-            if (bXyzLink.isNull())
-            {
-                yCError(KDLS, "Not found: \"%s\" either.", xyzLink.c_str());
-                return false;
-            }
-
-            double linkX = bXyzLink.check("x", yarp::os::Value(0.0), "X coordinate of next frame (meters)").asFloat64();
-            double linkY = bXyzLink.check("y", yarp::os::Value(0.0), "Y coordinate of next frame (meters)").asFloat64();
-            double linkZ = bXyzLink.check("z", yarp::os::Value(0.0), "Z coordinate of next frame (meters)").asFloat64();
-
-            std::string linkTypes = "joint type (Rot[XYZ]|InvRot[XYZ]|Trans[XYZ]|InvTrans[XYZ]), e.g. 'RotZ'";
-            std::string linkType = bXyzLink.check("Type", yarp::os::Value("NULL"), linkTypes.c_str()).asString();
-
-            KDL::Frame H(KDL::Vector(linkX, linkY, linkZ));
-
-            if (linkType == "RotX") {
-                chain.addSegment(KDL::Segment(KDL::Joint(KDL::Joint::RotX), H));
-            } else if (linkType == "RotY") {
-                chain.addSegment(KDL::Segment(KDL::Joint(KDL::Joint::RotY), H));
-            } else if (linkType == "RotZ") {
-                chain.addSegment(KDL::Segment(KDL::Joint(KDL::Joint::RotZ), H));
-            } else if (linkType == "InvRotX") {
-                chain.addSegment(KDL::Segment(KDL::Joint(KDL::Joint::RotX, -1.0), H));
-            } else if (linkType == "InvRotY") {
-                chain.addSegment(KDL::Segment(KDL::Joint(KDL::Joint::RotY, -1.0), H));
-            } else if (linkType == "InvRotZ") {
-                chain.addSegment(KDL::Segment(KDL::Joint(KDL::Joint::RotZ, -1.0), H));
-            } else if (linkType == "TransX") {
-                chain.addSegment(KDL::Segment(KDL::Joint(KDL::Joint::TransX), H));
-            } else if (linkType == "TransY") {
-                chain.addSegment(KDL::Segment(KDL::Joint(KDL::Joint::TransY), H));
-            } else if (linkType == "TransZ") {
-                chain.addSegment(KDL::Segment(KDL::Joint(KDL::Joint::TransZ), H));
-            } else if (linkType == "InvTransX") {
-                chain.addSegment(KDL::Segment(KDL::Joint(KDL::Joint::TransX, -1.0), H));
-            } else if (linkType == "InvTransY") {
-                chain.addSegment(KDL::Segment(KDL::Joint(KDL::Joint::TransY, -1.0), H));
-            } else if (linkType == "InvTransZ") {
-                chain.addSegment(KDL::Segment(KDL::Joint(KDL::Joint::TransZ, -1.0), H));
-            } else {
-                yCWarning(KDLS, "Link joint type \"%s\" unrecognized!", linkType.c_str());
-            }
-
-            yCInfo(KDLS, "Added: %s (Type %s) (x %f) (y %f) (z %f)", xyzLink.c_str(), linkType.c_str(), linkX, linkY, linkZ);
-        }
-    }
-
-    //-- HN
-    Eigen::MatrixXd HN = Eigen::MatrixXd::Identity(4, 4);
-
-    if (!getMatrixFromProperties(fullConfig, "HN", HN))
-    {
-        yCWarning(KDLS) << "Failed to parse HN, using default identity matrix";
+        return false;
     }
 
-    KDL::Vector kdlVecN(HN(0, 3), HN(1, 3), HN(2, 3));
-    KDL::Rotation kdlRotN(HN(0, 0), HN(0, 1), HN(0, 2), HN(1, 0), HN(1, 1), HN(1, 2), HN(2, 0), HN(2, 1), HN(2, 2));
-    chain.addSegment(KDL::Segment(KDL::Joint(KDL::Joint::None), KDL::Frame(kdlRotN, kdlVecN)));
-
     yCInfo(KDLS) << "Chain number of segments:" << chain.getNrOfSegments();
     yCInfo(KDLS) << "Chain number of joints:" << chain.getNrOfJoints();
 
@@ -358,8 +217,8 @@ bool KdlSolver::open(yarp::os::Searchable & config)
     }
 
     //-- IK pos solver algorithm.
-    auto ik = fullConfig.check("ik", yarp::os::Value(DEFAULT_IK_POS_SOLVER), "IK solver algorithm (lma, nrjl, st, id)"); // back-compat
-    auto ikPos = fullConfig.check("ikPos", ik, "IK position solver algorithm (lma, nrjl, st, id)").asString();
+    auto ik = fullConfig.check("ik", yarp::os::Value(DEFAULT_IK_POS_SOLVER), "IK solver algorithm (lma, nrjl, st, hybrid, redundant, generated, id)"); // back-compat
+    auto ikPos = fullConfig.check("ikPos", ik, "IK position solver algorithm (lma, nrjl, st, hybrid, redundant, generated, id)").asString();
 
     if (ikPos == "lma")
     {
@@ -411,12 +270,12 @@ bool KdlSolver::open(yarp::os::Searchable & config)
 
         if (strategy == "leastOverallAngularDisplacement")
         {
-            ConfigurationSelectorLeastOverallAngularDisplacementFactory factory(qMin, qMax);
+            auto factory = std::make_shared<ConfigurationSelectorLeastOverallAngularDisplacementFactory>(qMin, qMax);
             ikSolverPos = ChainIkSolverPos_ST::create(chain, factory);
         }
         else if (strategy == "humanoidGait")
         {
-            ConfigurationSelectorHumanoidGaitFactory factory(qMin, qMax);
+            auto factory = std::make_shared<ConfigurationSelectorHumanoidGaitFactory>(qMin, qMax);
             ikSolverPos = ChainIkSolverPos_ST::create(chain, factory);
         }
         else
@@ -431,6 +290,145 @@ bool KdlSolver::open(yarp::os::Searchable & config)
             return false;
         }
     }
+    else if (ikPos == "hybrid")
+    {
+        KDL::JntArray qMax(chain.getNrOfJoints());
+        KDL::JntArray qMin(chain.getNrOfJoints());
+
+        //-- Joint limits.
+        if (!retrieveJointLimits(fullConfig, qMin, qMax))
+        {
+            yCError(KDLS) << "Unable to retrieve joint limits";
+            return false;
+        }
+
+        double tolerance = fullConfig.check("idealTolerance", yarp::os::Value(DEFAULT_IDEAL_TOLERANCE),
+            "maximum deviation from the idealized chain (meters, sine of angle)").asFloat64();
+        double eps = fullConfig.check("epsPos", yarp::os::Value(DEFAULT_EPS_POS), "IK position solver precision (meters)").asFloat64();
+        double maxIter = fullConfig.check("maxIterPos", yarp::os::Value(DEFAULT_MAXITER_HY), "IK position solver max iterations").asInt32();
+
+        //-- IK configuration selection strategy.
+        std::string strategy = fullConfig.check("invKinStrategy", yarp::os::Value(DEFAULT_STRATEGY), "IK configuration strategy").asString();
+
+        if (strategy == "leastOverallAngularDisplacement")
+        {
+            ConfigurationSelectorLeastOverallAngularDisplacementFactory factory(qMin, qMax);
+            ikSolverPos = ChainIkSolverPos_HY::create(chain, factory, tolerance, maxIter, eps);
+        }
+        else if (strategy == "humanoidGait")
+        {
+            ConfigurationSelectorHumanoidGaitFactory factory(qMin, qMax);
+            ikSolverPos = ChainIkSolverPos_HY::create(chain, factory, tolerance, maxIter, eps);
+        }
+        else
+        {
+            yCError(KDLS) << "Unsupported IK strategy:" << strategy;
+            return false;
+        }
+
+        if (!ikSolverPos)
+        {
+            yCError(KDLS) << "Unable to solve IK, idealized chain has no closed-form solution";
+            return false;
+        }
+    }
+    else if (ikPos == "redundant")
+    {
+        KDL::JntArray qMax(chain.getNrOfJoints());
+        KDL::JntArray qMin(chain.getNrOfJoints());
+
+        //-- Joint limits.
+        if (!retrieveJointLimits(fullConfig, qMin, qMax))
+        {
+            yCError(KDLS) << "Unable to retrieve joint limits";
+            return false;
+        }
+
+        int lockedJoint = fullConfig.check("lockedJoint", yarp::os::Value(DEFAULT_LOCKED_JOINT),
+            "joint that parameterizes the self-motion of a redundant chain").asInt32();
+        int samples = fullConfig.check("sweepSamples", yarp::os::Value(DEFAULT_SWEEP_SAMPLES),
+            "number of sampled values of the locked joint").asInt32();
+        int threads = fullConfig.check("sweepThreads", yarp::os::Value(DEFAULT_SWEEP_THREADS),
+            "number of threads that process the samples (0: hardware concurrency)").asInt32();
+
+        if (lockedJoint < 0 || lockedJoint >= chain.getNrOfJoints())
+        {
+            yCError(KDLS) << "Illegal locked joint:" << lockedJoint;
+            return false;
+        }
+
+        if (samples < 1 || threads < 0)
+        {
+            yCError(KDLS) << "Illegal sweep configuration, samples:" << samples << "threads:" << threads;
+            return false;
+        }
+
+        //-- IK configuration selection strategy.
+        std::string strategy = fullConfig.check("invKinStrategy", yarp::os::Value(DEFAULT_STRATEGY), "IK configuration strategy").asString();
+
+        if (strategy == "leastOverallAngularDisplacement")
+        {
+            ConfigurationSelectorLeastOverallAngularDisplacementFactory factory(qMin, qMax);
+            ikSolverPos = ChainIkSolverPos_RD::create(chain, factory, qMin, qMax, lockedJoint, samples, threads);
+        }
+        else
+        {
+            yCError(KDLS) << "Unsupported IK strategy:" << strategy;
+            return false;
+        }
+
+        if (!ikSolverPos)
+        {
+            yCError(KDLS) << "Unable to solve IK, reduced chain has no closed-form solution";
+            return false;
+        }
+    }
+    else if (ikPos == "generated")
+    {
+        KDL::JntArray qMax(chain.getNrOfJoints());
+        KDL::JntArray qMin(chain.getNrOfJoints());
+
+        //-- Joint limits.
+        if (!retrieveJointLimits(fullConfig, qMin, qMax))
+        {
+            yCError(KDLS) << "Unable to retrieve joint limits";
+            return false;
+        }
+
+        std::string ikPlugin = fullConfig.check("ikPlugin", yarp::os::Value(DEFAULT_IK_PLUGIN),
+            "path to IK solver plugin built by roboticslab_add_screw_theory_ik_plugin").asString();
+
+        if (ikPlugin.empty())
+        {
+            yCError(KDLS) << "Missing 'ikPlugin' option";
+            return false;
+        }
+
+        //-- IK configuration selection strategy.
+        std::string strategy = fullConfig.check("invKinStrategy", yarp::os::Value(DEFAULT_STRATEGY), "IK configuration strategy").asString();
+
+        if (strategy == "leastOverallAngularDisplacement")
+        {
+            ConfigurationSelectorLeastOverallAngularDisplacementFactory factory(qMin, qMax);
+            ikSolverPos = ChainIkSolverPos_CG::create(chain, factory, ikPlugin);
+        }
+        else if (strategy == "humanoidGait")
+        {
+            ConfigurationSelectorHumanoidGaitFactory factory(qMin, qMax);
+            ikSolverPos = ChainIkSolverPos_CG::create(chain, factory, ikPlugin);
+        }
+        else
+        {
+            yCError(KDLS) << "Unsupported IK strategy:" << strategy;
+            return false;
+        }
+
+        if (!ikSolverPos)
+        {
+            yCError(KDLS) << "Unable to load IK plugin or it does not match this chain:" << ikPlugin;
+            return false;
+        }
+    }
     else if (ikPos == "id")
     {
         KDL::JntArray qMax(chain.getNrOfJoints());
@@ -94,7 +94,8 @@ bool KdlSolver::fwdKin(const std::vector<double> &q, std::vector<double> &x)
         fkSolverPos->JntToCart(qInRad, fOutCart);
     }
 
-    x = KdlVectorConverter::frameToVector(fOutCart);
+    x.resize(6);
+    KdlVectorConverter::frameToVector(fOutCart, x.data());
 
     return true;
 }
@@ -107,7 +108,8 @@ bool KdlSolver::poseDiff(const std::vector<double> &xLhs, const std::vector<doub
     KDL::Frame fRhs = KdlVectorConverter::vectorToFrame(xRhs);
 
     KDL::Twist diff = KDL::diff(fRhs, fLhs); // [fLhs - fRhs] for translation
-    xOut = KdlVectorConverter::twistToVector(diff);
+    xOut.resize(6);
+    KdlVectorConverter::twistToVector(diff, xOut.data());
 
     return true;
 }
@@ -0,0 +1,88 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include <yarp/os/LogStream.h>
+#include <yarp/os/Property.h>
+#include <yarp/os/ResourceFinder.h>
+#include <yarp/os/Value.h>
+
+#include <kdl/chain.hpp>
+
+#include "ChainParser.hpp"
+#include "ProductOfExponentials.hpp"
+#include "ScrewTheoryIkProblem.hpp"
+
+using namespace roboticslab;
+
+/**
+ * @ingroup KdlSolver
+ *
+ * @brief Emits a specialized IK solver for the kinematic chain described in a .ini file.
+ *
+ * Usage: `screwTheoryIkGenerator --kinematics <file.ini> --name <namespace> --output <file.hpp>`.
+ * The IK problem is built once, all subproblems are then inlined into a single
+ * allocation-free function, see @ref ScrewTheoryIkProblem::generateCode. Prefer
+ * the `roboticslab_add_screw_theory_ik_plugin` CMake function over direct calls.
+ */
+int main(int argc, char * argv[])
+{
+    yarp::os::ResourceFinder rf;
+    rf.setDefaultContext("kinematics");
+    rf.configure(argc, argv);
+
+    std::string kinematics = rf.check("kinematics", yarp::os::Value(""), "path to file with description of robot kinematics").asString();
+    std::string name = rf.check("name", yarp::os::Value("screw_theory_ik"), "namespace of the generated solver").asString();
+    std::string output = rf.check("output", yarp::os::Value(""), "path to output header").asString();
+
+    if (kinematics.empty() || output.empty())
+    {
+        yError() << "Usage: screwTheoryIkGenerator --kinematics <file.ini> --name <namespace> --output <file.hpp>";
+        return 1;
+    }
+
+    std::string kinematicsFullPath = rf.findFileByName(kinematics);
+
+    yarp::os::Property fullConfig;
+
+    if (!fullConfig.fromConfigFile(kinematicsFullPath))
+    {
+        yError() << "Unable to load kinematics file:" << kinematics;
+        return 1;
+    }
+
+    KDL::Chain chain;
+
+    if (!parseChain(fullConfig, chain))
+    {
+        yError() << "Unable to parse kinematic chain";
+        return 1;
+    }
+
+    // the builder relies on random test points, make the output reproducible
+    std::srand(0);
+
+    ScrewTheoryIkProblemBuilder builder(PoeExpression::fromChain(chain));
+    std::unique_ptr<ScrewTheoryIkProblem> problem(builder.build());
+
+    if (!problem)
+    {
+        yError() << "Unable to find a closed-form IK solution for this chain";
+        return 1;
+    }
+
+    std::ofstream ofs(output);
+
+    if (!ofs || !problem->generateCode(ofs, name) || !ofs.flush())
+    {
+        yError() << "Unable to generate IK solver:" << output;
+        return 1;
+    }
+
+    yInfo() << "Generated IK solver with" << problem->solutions() << "solutions:" << output;
+
+    return 0;
+}
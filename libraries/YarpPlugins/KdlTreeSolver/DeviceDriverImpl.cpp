@@ -3,6 +3,7 @@
 #include "KdlTreeSolver.hpp"
 
 #include <algorithm> // std::find
+#include <map>
 #include <sstream>
 #include <string>
 
@@ -21,14 +22,16 @@
 #include <kdl/rotationalinertia.hpp>
 #include <kdl/segment.hpp>
 
-#include <kdl/treefksolverpos_recursive.hpp>
 #include <kdl/treeidsolver_recursive_newton_euler.hpp>
 #include <kdl/treeiksolverpos_nr_jl.hpp>
 #include <kdl/treeiksolverpos_online.hpp>
 #include <kdl/treeiksolvervel_wdls.hpp>
 
+#include "ConfigurationSelector.hpp"
 #include "KinematicRepresentation.hpp"
 #include "LogComponent.hpp"
+#include "TreeIkSolverPos_ST.hpp"
+#include "TreeIkSolverPos_Subtrees.hpp"
 
 using namespace roboticslab;
 
@@ -39,6 +42,8 @@ constexpr auto DEFAULT_MAXITER = 1000;
 constexpr auto DEFAULT_V_TRANSL_MAX = 1.0; // meters/s
 constexpr auto DEFAULT_V_ROT_MAX = 50.0; // degrees/s
 constexpr auto DEFAULT_IK_SOLVER = "nrjl";
+constexpr auto DEFAULT_PARALLEL_IK = true;
+constexpr auto DEFAULT_STRATEGY = "leastOverallAngularDisplacement";
 
 // ------------------- DeviceDriver Related ------------------------------------
 
@@ -173,6 +178,10 @@ bool KdlTreeSolver::open(yarp::os::Searchable & config)
     KDL::Vector gravity(gravityBottle->get(0).asFloat64(), gravityBottle->get(1).asFloat64(), gravityBottle->get(2).asFloat64());
     yCInfo(KDLS) << "gravity:" << gravityBottle->toString();
 
+    //-- IK configuration selection strategy (default), only used by the st solver.
+    std::string defaultStrategy = fullConfig.check("invKinStrategy", yarp::os::Value(DEFAULT_STRATEGY), "IK configuration strategy").asString();
+    std::map<std::string, std::string> strategies;
+
     for (int i = 0; i < chains.size(); i++)
     {
         KDL::Chain chain;
@@ -326,6 +335,9 @@ bool KdlTreeSolver::open(yarp::os::Searchable & config)
         {
             endpoints.push_back(chainName);
 
+            auto strategy = chainConfig.check("invKinStrategy", yarp::os::Value(defaultStrategy), "IK configuration strategy").asString();
+            strategies.emplace(chainName, strategy);
+
             if (chainConfig.check("mergeWith", "other chain's TCP to merge this TCP with"))
             {
                 auto mergeWith = chainConfig.find("mergeWith").asString();
@@ -346,32 +358,37 @@ bool KdlTreeSolver::open(yarp::os::Searchable & config)
     yCInfo(KDLS) << "Tree number of joints:" << tree.getNrOfJoints();
     yCInfo(KDLS) << "Tree endpoints:" << endpoints;
 
-    fkSolverPos = new KDL::TreeFkSolverPos_recursive(tree);
+    fkSolverPos = new TreeFkSolverPos_Endpoints(tree, endpoints);
+    endpointFrames.resize(endpoints.size());
     ikSolverVel = new KDL::TreeIkSolverVel_wdls(tree, endpoints);
     idSolver = new KDL::TreeIdSolver_RNE(tree, gravity);
 
-    {
-        auto * temp = dynamic_cast<KDL::TreeIkSolverVel_wdls *>(ikSolverVel);
+    centroidalSolver = new TreeCentroidalSolver(tree);
+    centroidalQ.resize(tree.getNrOfJoints());
+    centroidalQdot.resize(tree.getNrOfJoints());
+    centroidalJacobian.resize(3, tree.getNrOfJoints());
+    yCInfo(KDLS) << "Tree total mass:" << centroidalSolver->getTotalMass();
 
-        auto lambda = fullConfig.check("lambda", yarp::os::Value(DEFAULT_LAMBDA), "lambda parameter for diff IK").asFloat64();
-        temp->setLambda(lambda); // disclaimer: never set this to zero (which is the default)
+    auto lambda = fullConfig.check("lambda", yarp::os::Value(DEFAULT_LAMBDA), "lambda parameter for diff IK").asFloat64();
 
-        Eigen::MatrixXd wJS = Eigen::MatrixXd::Identity(tree.getNrOfJoints(), tree.getNrOfJoints());
+    Eigen::MatrixXd wJS = Eigen::MatrixXd::Identity(tree.getNrOfJoints(), tree.getNrOfJoints());
 
-        if (!getMatrixFromProperties(fullConfig, "weightJS", wJS))
-        {
-            yCWarning(KDLS) << "Failed to parse weightJS, using default identity matrix";
-        }
-
-        temp->setWeightJS(wJS);
+    if (!getMatrixFromProperties(fullConfig, "weightJS", wJS))
+    {
+        yCWarning(KDLS) << "Failed to parse weightJS, using default identity matrix";
+    }
 
-        Eigen::MatrixXd wTS = Eigen::MatrixXd::Identity(6 * endpoints.size(), 6 * endpoints.size());
+    Eigen::MatrixXd wTS = Eigen::MatrixXd::Identity(6 * endpoints.size(), 6 * endpoints.size());
 
-        if (!getMatrixFromProperties(fullConfig, "weightTS", wTS))
-        {
-            yCWarning(KDLS) << "Failed to parse weightTS, using default identity matrix";
-        }
+    if (!getMatrixFromProperties(fullConfig, "weightTS", wTS))
+    {
+        yCWarning(KDLS) << "Failed to parse weightTS, using default identity matrix";
+    }
 
+    {
+        auto * temp = dynamic_cast<KDL::TreeIkSolverVel_wdls *>(ikSolverVel);
+        temp->setLambda(lambda); // disclaimer: never set this to zero (which is the default)
+        temp->setWeightJS(wJS);
         temp->setWeightTS(wTS);
     }
 
@@ -387,31 +404,156 @@ bool KdlTreeSolver::open(yarp::os::Searchable & config)
     }
 
     //-- IK solver algorithm.
-    std::string ik = fullConfig.check("ik", yarp::os::Value(DEFAULT_IK_SOLVER), "IK solver algorithm (nrjl, online)").asString();
+    std::string ik = fullConfig.check("ik", yarp::os::Value(DEFAULT_IK_SOLVER),
+        "IK solver algorithm (nrjl, online, st), st requires endpoints that share no movable joints").asString();
+
+    double eps = 0.0;
+    int maxIter = 0;
+    double vTranslMax = 0.0;
+    double vRotMax = 0.0;
 
     if (ik == "nrjl")
     {
         //-- Precision and max iterations.
-        double eps = fullConfig.check("eps", yarp::os::Value(DEFAULT_EPS), "IK solver precision (meters)").asFloat64();
-        int maxIter = fullConfig.check("maxIter", yarp::os::Value(DEFAULT_MAXITER), "maximum number of iterations").asInt32();
-
-        ikSolverPos = new KDL::TreeIkSolverPos_NR_JL(tree, endpoints, qMin, qMax, *fkSolverPos, *ikSolverVel, maxIter, eps);
+        eps = fullConfig.check("eps", yarp::os::Value(DEFAULT_EPS), "IK solver precision (meters)").asFloat64();
+        maxIter = fullConfig.check("maxIter", yarp::os::Value(DEFAULT_MAXITER), "maximum number of iterations").asInt32();
     }
     else if (ik == "online")
     {
         //-- Max cartesian speed.
-        double vTranslMax = fullConfig.check("vTranslMax", yarp::os::Value(DEFAULT_V_TRANSL_MAX), "maximum translation speed (meters/second)").asFloat64();
-        double vRotMax = fullConfig.check("vRotMax", yarp::os::Value(DEFAULT_V_ROT_MAX), "maximum rotation speed (degrees/second)").asFloat64();
-
+        vTranslMax = fullConfig.check("vTranslMax", yarp::os::Value(DEFAULT_V_TRANSL_MAX), "maximum translation speed (meters/second)").asFloat64();
+        vRotMax = fullConfig.check("vRotMax", yarp::os::Value(DEFAULT_V_ROT_MAX), "maximum rotation speed (degrees/second)").asFloat64();
         vRotMax = KinRepresentation::degToRad(vRotMax);
-        ikSolverPos = new KDL::TreeIkSolverPos_Online(tree.getNrOfJoints(), endpoints, qMin, qMax, qMaxVels, vTranslMax, vRotMax, *fkSolverPos, *ikSolverVel);
     }
-    else
+    else if (ik != "st")
     {
         yCError(KDLS) << "Unsupported IK solver algorithm:" << ik.c_str();
         return false;
     }
 
+    //-- Independent subtrees.
+    bool parallelIk = fullConfig.check("parallelIk", yarp::os::Value(DEFAULT_PARALLEL_IK),
+        "solve independent subtrees on separate threads, always enabled by st").asBool();
+
+    if (ik == "st")
+    {
+        // closed-form IK is solved per chain, i.e. each endpoint must be the only one in its subtree
+        for (const auto & subEndpoints : TreeIkSolverPos_Subtrees::findSubtrees(tree, endpoints))
+        {
+            if (subEndpoints.size() != 1)
+            {
+                yCError(KDLS) << "IK solver st requires endpoints that share no movable joints, found:" << subEndpoints;
+                return false;
+            }
+        }
+
+        parallelIk = true;
+    }
+
+    // Joint limits and weights are sliced for each subtree, the velocity solver is not shared with diffInvKin.
+    auto factory = [&](const KDL::Tree & subtree, const std::vector<std::string> & subEndpoints, const std::vector<int> & joints,
+                       TreeIkSolverPos_Subtrees::Solvers & solvers)
+    {
+        KDL::JntArray subMin(joints.size());
+        KDL::JntArray subMax(joints.size());
+        KDL::JntArray subMaxVels(joints.size());
+        Eigen::MatrixXd subWJS(joints.size(), joints.size());
+
+        for (int i = 0; i < joints.size(); i++)
+        {
+            subMin(i) = qMin(joints[i]);
+            subMax(i) = qMax(joints[i]);
+            subMaxVels(i) = qMaxVels(joints[i]);
+
+            for (int j = 0; j < joints.size(); j++)
+            {
+                subWJS(i, j) = wJS(joints[i], joints[j]);
+            }
+        }
+
+        std::vector<int> indices;
+
+        for (const auto & endpoint : subEndpoints)
+        {
+            indices.push_back(std::find(endpoints.cbegin(), endpoints.cend(), endpoint) - endpoints.cbegin());
+        }
+
+        Eigen::MatrixXd subWTS(6 * indices.size(), 6 * indices.size());
+
+        for (int i = 0; i < indices.size(); i++)
+        {
+            for (int j = 0; j < indices.size(); j++)
+            {
+                subWTS.block<6, 6>(6 * i, 6 * j) = wTS.block<6, 6>(6 * indices[i], 6 * indices[j]);
+            }
+        }
+
+        if (ik == "st")
+        {
+            // a subtree with a single endpoint (checked above) is a chain whose joints are numbered
+            // from root to tip, which is the order expected by the selector
+            const auto & endpoint = subEndpoints[0];
+            const auto & strategy = strategies[endpoint];
+
+            if (strategy == "leastOverallAngularDisplacement")
+            {
+                ConfigurationSelectorLeastOverallAngularDisplacementFactory configFactory(subMin, subMax);
+                solvers.ikSolverPos.reset(TreeIkSolverPos_ST::create(subtree, endpoint, configFactory));
+            }
+            else if (strategy == "humanoidGait")
+            {
+                ConfigurationSelectorHumanoidGaitFactory configFactory(subMin, subMax);
+                solvers.ikSolverPos.reset(TreeIkSolverPos_ST::create(subtree, endpoint, configFactory));
+            }
+            else
+            {
+                yCError(KDLS) << "Unsupported IK strategy:" << strategy;
+                return false;
+            }
+
+            if (!solvers.ikSolverPos)
+            {
+                yCError(KDLS) << "Unable to solve IK in closed form for endpoint" << endpoint;
+                return false;
+            }
+
+            return true;
+        }
+
+        auto * fk = new TreeFkSolverPos_Endpoints(subtree, subEndpoints);
+        auto * vel = new KDL::TreeIkSolverVel_wdls(subtree, subEndpoints);
+
+        solvers.fkSolverPos.reset(fk);
+        solvers.ikSolverVel.reset(vel);
+
+        vel->setLambda(lambda);
+        vel->setWeightJS(subWJS);
+        vel->setWeightTS(subWTS);
+
+        if (ik == "nrjl")
+        {
+            solvers.ikSolverPos.reset(new KDL::TreeIkSolverPos_NR_JL(subtree, subEndpoints, subMin, subMax, *fk, *vel, maxIter, eps));
+        }
+        else
+        {
+            solvers.ikSolverPos.reset(new KDL::TreeIkSolverPos_Online(joints.size(), subEndpoints, subMin, subMax, subMaxVels,
+                                                                      vTranslMax, vRotMax, *fk, *vel));
+        }
+
+        return true;
+    };
+
+    auto * temp = TreeIkSolverPos_Subtrees::create(tree, endpoints, factory, parallelIk);
+
+    if (!temp)
+    {
+        yCError(KDLS) << "Unable to set up IK solver";
+        return false;
+    }
+
+    yCInfo(KDLS) << "IK subtrees:" << temp->getNrOfSubtrees();
+    ikSolverPos = temp;
+
     return true;
 }
 
@@ -431,6 +573,9 @@ bool KdlTreeSolver::close()
     delete idSolver;
     idSolver = nullptr;
 
+    delete centroidalSolver;
+    centroidalSolver = nullptr;
+
     return true;
 }
 
@@ -49,20 +49,21 @@ bool KdlTreeSolver::restoreOriginalChain()
 
 bool KdlTreeSolver::changeOrigin(const std::vector<double> & x_old_obj, const std::vector<double> & x_new_old, std::vector<double> & x_new_obj)
 {
-    x_new_obj.clear();
-    x_new_obj.reserve(endpoints.size() * 6);
+    if (x_old_obj.size() != endpoints.size() * 6 || x_new_old.size() != endpoints.size() * 6)
+    {
+        yCError(KDLS, "changeOrigin(): size mismatch; expected: %zu", endpoints.size() * 6);
+        return false;
+    }
+
+    x_new_obj.resize(endpoints.size() * 6);
 
     for (auto i = 0; i < endpoints.size(); i++)
     {
-        std::vector<double> temp_old_obj(x_old_obj.cbegin() + i * 6, x_old_obj.cbegin() + (i + 1) * 6);
-        std::vector<double> temp_new_old(x_new_old.cbegin() + i * 6, x_new_old.cbegin() + (i + 1) * 6);
-
-        KDL::Frame H_old_obj = KdlVectorConverter::vectorToFrame(temp_old_obj);
-        KDL::Frame H_new_old = KdlVectorConverter::vectorToFrame(temp_new_old);
+        KDL::Frame H_old_obj = KdlVectorConverter::vectorToFrame(x_old_obj.data() + i * 6);
+        KDL::Frame H_new_old = KdlVectorConverter::vectorToFrame(x_new_old.data() + i * 6);
         KDL::Frame H_new_obj = H_new_old * H_old_obj;
 
-        std::vector<double> temp_new_obj = KdlVectorConverter::frameToVector(H_new_obj);
-        x_new_obj.insert(x_new_obj.end(), temp_new_obj.cbegin(), temp_new_obj.cend());
+        KdlVectorConverter::frameToVector(H_new_obj, x_new_obj.data() + i * 6);
     }
 
     return true;
@@ -79,20 +80,17 @@ bool KdlTreeSolver::fwdKin(const std::vector<double> & q, std::vector<double> &
         qInRad(motor) = KinRepresentation::degToRad(q[motor]);
     }
 
-    x.clear();
-    x.reserve(endpoints.size() * 6);
-
-    for (const auto & endpoint : endpoints)
+    // all endpoints at once, shared segments are evaluated only once
+    if (fkSolverPos->JntToCart(qInRad, endpointFrames) < 0)
     {
-        KDL::Frame fOutCart;
+        return false;
+    }
 
-        if (fkSolverPos->JntToCart(qInRad, fOutCart, endpoint) < 0)
-        {
-            return false;
-        }
+    x.resize(endpoints.size() * 6);
 
-        auto temp = KdlVectorConverter::frameToVector(fOutCart);
-        x.insert(x.end(), temp.cbegin(), temp.cend());
+    for (auto i = 0; i < endpoints.size(); i++)
+    {
+        KdlVectorConverter::frameToVector(endpointFrames[i], x.data() + i * 6);
     }
 
     return true;
@@ -102,21 +100,21 @@ bool KdlTreeSolver::fwdKin(const std::vector<double> & q, std::vector<double> &
 
 bool KdlTreeSolver::poseDiff(const std::vector<double> & xLhs, const std::vector<double> & xRhs, std::vector<double> & xOut)
 {
-    xOut.clear();
-    xOut.reserve(endpoints.size() * 6);
+    if (xLhs.size() != endpoints.size() * 6 || xRhs.size() != endpoints.size() * 6)
+    {
+        yCError(KDLS, "poseDiff(): size mismatch; expected: %zu", endpoints.size() * 6);
+        return false;
+    }
+
+    xOut.resize(endpoints.size() * 6);
 
     for (auto i = 0; i < endpoints.size(); i++)
     {
-        std::vector<double> temp_xLhs(xLhs.cbegin() + i * 6, xLhs.cbegin() + (i + 1) * 6);
-        std::vector<double> temp_xRhs(xRhs.cbegin() + i * 6, xRhs.cbegin() + (i + 1) * 6);
-
-        KDL::Frame fLhs = KdlVectorConverter::vectorToFrame(temp_xLhs);
-        KDL::Frame fRhs = KdlVectorConverter::vectorToFrame(temp_xRhs);
+        KDL::Frame fLhs = KdlVectorConverter::vectorToFrame(xLhs.data() + i * 6);
+        KDL::Frame fRhs = KdlVectorConverter::vectorToFrame(xRhs.data() + i * 6);
 
         KDL::Twist diff = KDL::diff(fRhs, fLhs); // [fLhs - fRhs] for translation
-        std::vector<double> temp_xOut = KdlVectorConverter::twistToVector(diff);
-
-        xOut.insert(xOut.end(), temp_xOut.cbegin(), temp_xOut.cend());
+        KdlVectorConverter::twistToVector(diff, xOut.data() + i * 6);
     }
 
     return true;
@@ -137,8 +135,7 @@ bool KdlTreeSolver::invKin(const std::vector<double> & xd, const std::vector<dou
         }
         else
         {
-            std::vector<double> sub(xd.cbegin() + i * 6, xd.cbegin() + (i + 1) * 6);
-            frames.emplace(endpoint, KdlVectorConverter::vectorToFrame(sub));
+            frames.emplace(endpoint, KdlVectorConverter::vectorToFrame(xd.data() + i * 6));
             i++;
         }
     }
@@ -152,14 +149,15 @@ bool KdlTreeSolver::invKin(const std::vector<double> & xd, const std::vector<dou
 
     if (frame == TCP_FRAME)
     {
-        for (const auto & endpoint : endpoints)
+        if (fkSolverPos->JntToCart(qGuessInRad, endpointFrames) < 0)
         {
-            KDL::Frame fOutCart;
+            return false;
+        }
 
-            if (fkSolverPos->JntToCart(qGuessInRad, fOutCart, endpoint) < 0)
-            {
-                return false;
-            }
+        for (auto j = 0; j < endpoints.size(); j++)
+        {
+            const auto & endpoint = endpoints[j];
+            const KDL::Frame & fOutCart = endpointFrames[j];
 
             auto it = frames.find(endpoint);
             it->second = fOutCart * it->second;
@@ -203,8 +201,7 @@ bool KdlTreeSolver::diffInvKin(const std::vector<double> & q, const std::vector<
         }
         else
         {
-            std::vector<double> sub(xdot.cbegin() + i * 6, xdot.cbegin() + (i + 1) * 6);
-            twists.emplace(endpoint, KdlVectorConverter::vectorToTwist(sub));
+            twists.emplace(endpoint, KdlVectorConverter::vectorToTwist(xdot.data() + i * 6));
             i++;
         }
     }
@@ -218,14 +215,15 @@ bool KdlTreeSolver::diffInvKin(const std::vector<double> & q, const std::vector<
 
     if (frame == TCP_FRAME)
     {
-        for (const auto & endpoint : endpoints)
+        if (fkSolverPos->JntToCart(qInRad, endpointFrames) < 0)
         {
-            KDL::Frame fOutCart;
+            return false;
+        }
 
-            if (fkSolverPos->JntToCart(qInRad, fOutCart, endpoint) < 0)
-            {
-                return false;
-            }
+        for (auto j = 0; j < endpoints.size(); j++)
+        {
+            const auto & endpoint = endpoints[j];
+            const KDL::Frame & fOutCart = endpointFrames[j];
 
             auto it = twists.find(endpoint);
 
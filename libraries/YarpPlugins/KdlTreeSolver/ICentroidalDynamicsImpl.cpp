@@ -0,0 +1,103 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#include "KdlTreeSolver.hpp"
+
+#include <yarp/os/LogStream.h>
+
+#include <kdl/frames.hpp>
+
+#include "KinematicRepresentation.hpp"
+#include "LogComponent.hpp"
+
+using namespace roboticslab;
+
+// -----------------------------------------------------------------------------
+
+double KdlTreeSolver::getTotalMass()
+{
+    return centroidalSolver->getTotalMass();
+}
+
+// -----------------------------------------------------------------------------
+
+bool KdlTreeSolver::getCenterOfMass(const std::vector<double> & q, std::vector<double> & com)
+{
+    if (q.size() != tree.getNrOfJoints())
+    {
+        yCError(KDLS, "getCenterOfMass(): size mismatch; expected: %d", tree.getNrOfJoints());
+        return false;
+    }
+
+    for (int motor = 0; motor < tree.getNrOfJoints(); motor++)
+    {
+        centroidalQ(motor) = KinRepresentation::degToRad(q[motor]);
+    }
+
+    KDL::Vector p;
+
+    if (centroidalSolver->JntToCoM(centroidalQ, p) < 0)
+    {
+        return false;
+    }
+
+    com.resize(3);
+    com[0] = p.x();
+    com[1] = p.y();
+    com[2] = p.z();
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+bool KdlTreeSolver::getCentroidalDynamics(const std::vector<double> & q, const std::vector<double> & qdot,
+        std::vector<double> & com, std::vector<double> & comJacobian, std::vector<double> & momentum)
+{
+    if (q.size() != tree.getNrOfJoints() || qdot.size() != tree.getNrOfJoints())
+    {
+        yCError(KDLS, "getCentroidalDynamics(): size mismatch; expected: %d", tree.getNrOfJoints());
+        return false;
+    }
+
+    for (int motor = 0; motor < tree.getNrOfJoints(); motor++)
+    {
+        centroidalQ(motor) = KinRepresentation::degToRad(q[motor]);
+        centroidalQdot(motor) = KinRepresentation::degToRad(qdot[motor]);
+    }
+
+    KDL::Vector p;
+    KDL::Wrench h;
+
+    if (centroidalSolver->JntToCentroidal(centroidalQ, centroidalQdot, p, centroidalJacobian, h) < 0)
+    {
+        return false;
+    }
+
+    com.resize(3);
+    com[0] = p.x();
+    com[1] = p.y();
+    com[2] = p.z();
+
+    // joint velocities are given in degrees/second, hence the Jacobian is scaled accordingly
+    comJacobian.resize(3 * tree.getNrOfJoints());
+
+    for (int row = 0; row < 3; row++)
+    {
+        for (int col = 0; col < tree.getNrOfJoints(); col++)
+        {
+            comJacobian[row * tree.getNrOfJoints() + col] = KinRepresentation::degToRad(centroidalJacobian(row, col));
+        }
+    }
+
+    momentum.resize(6);
+
+    for (int i = 0; i < 3; i++)
+    {
+        momentum[i] = h.force(i);
+        momentum[i + 3] = h.torque(i);
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
@@ -9,12 +9,18 @@
 
 #include <yarp/dev/DeviceDriver.h>
 
+#include <Eigen/Core>
+
+#include <kdl/frames.hpp>
+#include <kdl/jntarray.hpp>
 #include <kdl/tree.hpp>
-#include <kdl/treefksolver.hpp>
 #include <kdl/treeiksolver.hpp>
 #include <kdl/treeidsolver.hpp>
 
 #include "ICartesianSolver.h"
+#include "ICentroidalDynamics.h"
+#include "TreeCentroidalSolver.hpp"
+#include "TreeFkSolverPos_Endpoints.hpp"
 
 namespace roboticslab
 {
@@ -28,16 +34,18 @@ namespace roboticslab
 
 /**
  * @ingroup KdlTreeSolver
- * @brief The KdlTreeSolver class implements ICartesianSolver.
+ * @brief The KdlTreeSolver class implements ICartesianSolver and ICentroidalDynamics.
  */
 class KdlTreeSolver : public yarp::dev::DeviceDriver,
-                      public ICartesianSolver
+                      public ICartesianSolver,
+                      public ICentroidalDynamics
 {
 public:
     KdlTreeSolver() : fkSolverPos(nullptr),
                       ikSolverPos(nullptr),
                       ikSolverVel(nullptr),
-                      idSolver(nullptr)
+                      idSolver(nullptr),
+                      centroidalSolver(nullptr)
     {}
 
     // -- ICartesianSolver declarations. Implementation in ICartesianSolverImpl.cpp --
@@ -75,6 +83,17 @@ public:
     // Perform inverse dynamics.
     bool invDyn(const std::vector<double> & q, const std::vector<double> & qdot, const std::vector<double> & qdotdot, const std::vector<std::vector<double>> & fexts, std::vector<double> & t) override;
 
+    // -- ICentroidalDynamics declarations. Implementation in ICentroidalDynamicsImpl.cpp --
+
+    // Get total mass of the robot.
+    double getTotalMass() override;
+
+    // Compute the position of the center of mass.
+    bool getCenterOfMass(const std::vector<double> & q, std::vector<double> & com) override;
+
+    // Compute the center of mass, its Jacobian and the centroidal momentum.
+    bool getCentroidalDynamics(const std::vector<double> & q, const std::vector<double> & qdot, std::vector<double> & com, std::vector<double> & comJacobian, std::vector<double> & momentum) override;
+
     // -------- DeviceDriver declarations. Implementation in IDeviceImpl.cpp --------
 
     bool open(yarp::os::Searchable & config) override;
@@ -85,10 +104,19 @@ protected:
     std::vector<std::string> endpoints;
     std::map<std::string, std::string> mergedEndpoints;
     KDL::Tree tree;
-    KDL::TreeFkSolverPos * fkSolverPos;
+    TreeFkSolverPos_Endpoints * fkSolverPos;
     KDL::TreeIkSolverPos * ikSolverPos;
     KDL::TreeIkSolverVel * ikSolverVel;
     KDL::TreeIdSolver * idSolver;
+    TreeCentroidalSolver * centroidalSolver;
+
+    // preallocated FK output, one frame per endpoint
+    std::vector<KDL::Frame> endpointFrames;
+
+    // preallocated input and output of the centroidal solver
+    KDL::JntArray centroidalQ;
+    KDL::JntArray centroidalQdot;
+    Eigen::Matrix3Xd centroidalJacobian;
 };
 
 } // namespace roboticslab
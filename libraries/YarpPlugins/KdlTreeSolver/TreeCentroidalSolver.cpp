@@ -0,0 +1,182 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#include "TreeCentroidalSolver.hpp"
+
+#include <utility> // std::pair
+
+#include <kdl/joint.hpp>
+#include <kdl/rigidbodyinertia.hpp>
+#include <kdl/rotationalinertia.hpp>
+
+using namespace roboticslab;
+
+// -----------------------------------------------------------------------------
+
+TreeCentroidalSolver::TreeCentroidalSolver(const KDL::Tree & tree)
+    : nrOfJoints(tree.getNrOfJoints()),
+      totalMass(0.0)
+{
+    // Depth-first traversal from the root, parents are stored before their children.
+    std::vector<std::pair<KDL::SegmentMap::const_iterator, int>> pending {{tree.getRootSegment(), -1}};
+
+    while (!pending.empty())
+    {
+        auto it = pending.back().first;
+        int parent = pending.back().second;
+        pending.pop_back();
+
+        const KDL::Segment & segment = KDL::GetTreeElementSegment(it->second);
+        int qNr = segment.getJoint().getType() == KDL::Joint::None ? -1 : KDL::GetTreeElementQNr(it->second);
+
+        int index = steps.size();
+        steps.push_back({&segment, qNr, parent});
+        totalMass += segment.getInertia().getMass();
+
+        for (const auto & child : KDL::GetTreeElementChildren(it->second))
+        {
+            pending.emplace_back(child, index);
+        }
+    }
+
+    frames.resize(steps.size());
+    axes.resize(steps.size());
+    twists.resize(steps.size());
+    cogs.resize(steps.size());
+    subtreeMasses.resize(steps.size());
+    subtreeMoments.resize(steps.size());
+}
+
+// -----------------------------------------------------------------------------
+
+void TreeCentroidalSolver::updateFrames(const KDL::JntArray & q_in)
+{
+    for (int i = 0; i < steps.size(); i++)
+    {
+        const Step & step = steps[i];
+        const KDL::Frame & H_parent = step.parent != -1 ? frames[step.parent] : KDL::Frame::Identity();
+
+        frames[i] = H_parent * step.segment->pose(step.qNr != -1 ? q_in(step.qNr) : 0.0);
+        cogs[i] = frames[i] * step.segment->getInertia().getCOG();
+
+        if (step.qNr != -1)
+        {
+            // joint axis and origin are expressed in the parent's frame
+            const KDL::Joint & joint = step.segment->getJoint();
+            KDL::Twist unit = joint.twist(1.0);
+            KDL::Vector w = H_parent.M * unit.rot;
+            KDL::Vector origin = H_parent * joint.JointOrigin();
+            axes[i] = KDL::Twist(H_parent.M * unit.vel + origin * w, w);
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void TreeCentroidalSolver::updateSubtrees()
+{
+    for (int i = 0; i < steps.size(); i++)
+    {
+        subtreeMasses[i] = steps[i].segment->getInertia().getMass();
+        subtreeMoments[i] = subtreeMasses[i] * cogs[i];
+    }
+
+    // children are visited before their parents
+    for (int i = steps.size() - 1; i > 0; i--)
+    {
+        int parent = steps[i].parent;
+        subtreeMasses[parent] += subtreeMasses[i];
+        subtreeMoments[parent] += subtreeMoments[i];
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+int TreeCentroidalSolver::JntToCoM(const KDL::JntArray & q_in, KDL::Vector & com)
+{
+    if (q_in.rows() != nrOfJoints)
+    {
+        return E_ILLEGAL_ARGUMENT_SIZE;
+    }
+
+    if (totalMass <= 0.0)
+    {
+        return E_NO_MASS;
+    }
+
+    updateFrames(q_in);
+
+    com = KDL::Vector::Zero();
+
+    for (int i = 0; i < steps.size(); i++)
+    {
+        com += steps[i].segment->getInertia().getMass() * cogs[i];
+    }
+
+    com = com / totalMass;
+    return E_NOERROR;
+}
+
+// -----------------------------------------------------------------------------
+
+int TreeCentroidalSolver::JntToCentroidal(const KDL::JntArray & q_in, const KDL::JntArray & qdot_in, KDL::Vector & com,
+        Eigen::Matrix3Xd & jac, KDL::Wrench & momentum)
+{
+    if (q_in.rows() != nrOfJoints || qdot_in.rows() != nrOfJoints || jac.cols() != nrOfJoints)
+    {
+        return E_ILLEGAL_ARGUMENT_SIZE;
+    }
+
+    if (totalMass <= 0.0)
+    {
+        return E_NO_MASS;
+    }
+
+    updateFrames(q_in);
+    updateSubtrees();
+
+    com = subtreeMoments[0] / totalMass;
+
+    KDL::Vector linear = KDL::Vector::Zero();
+    KDL::Vector angular = KDL::Vector::Zero();
+
+    for (int i = 0; i < steps.size(); i++)
+    {
+        const Step & step = steps[i];
+
+        twists[i] = step.parent != -1 ? twists[step.parent] : KDL::Twist::Zero();
+
+        if (step.qNr != -1)
+        {
+            const KDL::Twist & axis = axes[i];
+            twists[i] = twists[i] + axis * qdot_in(step.qNr);
+
+            // velocity of the CoM of the subtree for a unit joint speed, scaled by its share of the total mass
+            KDL::Vector column = (subtreeMasses[i] * axis.vel + axis.rot * subtreeMoments[i]) / totalMass;
+            jac.col(step.qNr) << column.x(), column.y(), column.z();
+        }
+
+        const KDL::RigidBodyInertia & inertia = step.segment->getInertia();
+        double mass = inertia.getMass();
+
+        if (mass <= 0.0)
+        {
+            continue;
+        }
+
+        const KDL::Twist & twist = twists[i];
+        KDL::Vector p = mass * (twist.vel + twist.rot * cogs[i]);
+
+        // rotational inertia about the CoM of the segment, applied in the segment's frame
+        KDL::Vector cog = inertia.getCOG();
+        KDL::Vector w = frames[i].M.Inverse(twist.rot);
+        KDL::Vector Iw = inertia.getRotationalInertia() * w - mass * (cog * (w * cog));
+
+        linear += p;
+        angular += frames[i].M * Iw + (cogs[i] - com) * p;
+    }
+
+    momentum = KDL::Wrench(linear, angular);
+    return E_NOERROR;
+}
+
+// -----------------------------------------------------------------------------
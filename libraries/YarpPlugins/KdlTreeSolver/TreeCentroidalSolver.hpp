@@ -0,0 +1,97 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#ifndef __TREE_CENTROIDAL_SOLVER_HPP__
+#define __TREE_CENTROIDAL_SOLVER_HPP__
+
+#include <vector>
+
+#include <Eigen/Core>
+
+#include <kdl/frames.hpp>
+#include <kdl/jntarray.hpp>
+#include <kdl/segment.hpp>
+#include <kdl/tree.hpp>
+
+namespace roboticslab
+{
+
+/**
+ * @ingroup KdlTreeSolver
+ * @brief Whole-body center of mass and centroidal momentum of a tree.
+ *
+ * Uses the inertia of every segment of the tree. Each call performs a forward pass
+ * from the root (poses and velocities of all segments) and a backward pass from the
+ * leaves (mass and first moment of mass of each subtree), the Jacobian of the center
+ * of mass is obtained from the latter. No memory is allocated on runtime.
+ */
+class TreeCentroidalSolver
+{
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @param tree Input kinematic tree.
+     */
+    explicit TreeCentroidalSolver(const KDL::Tree & tree);
+
+    /** @brief Sum of the masses of all segments. */
+    double getTotalMass() const
+    { return totalMass; }
+
+    /**
+     * @brief Compute the center of mass.
+     *
+     * @param q_in Input joint coordinates.
+     * @param com Position of the center of mass, expressed in the root frame.
+     *
+     * @return Negative on failure, @ref E_NOERROR otherwise.
+     */
+    int JntToCoM(const KDL::JntArray & q_in, KDL::Vector & com);
+
+    /**
+     * @brief Compute the center of mass, its Jacobian and the centroidal momentum.
+     *
+     * @param q_in Input joint coordinates.
+     * @param qdot_in Input joint velocities.
+     * @param com Position of the center of mass, expressed in the root frame.
+     * @param jac Jacobian of the center of mass (3 rows, one column per joint).
+     * @param momentum Linear (force part) and angular (torque part) momentum,
+     * the latter taken about the center of mass. Both are expressed in the root frame.
+     *
+     * @return Negative on failure, @ref E_NOERROR otherwise.
+     */
+    int JntToCentroidal(const KDL::JntArray & q_in, const KDL::JntArray & qdot_in, KDL::Vector & com,
+                        Eigen::Matrix3Xd & jac, KDL::Wrench & momentum);
+
+    static const int E_NOERROR = 0;
+    static const int E_ILLEGAL_ARGUMENT_SIZE = -101;
+    static const int E_NO_MASS = -102;
+
+private:
+    struct Step
+    {
+        const KDL::Segment * segment;
+        int qNr; // -1 if fixed
+        int parent; // -1 if root
+    };
+
+    void updateFrames(const KDL::JntArray & q_in);
+    void updateSubtrees();
+
+    const unsigned int nrOfJoints;
+    double totalMass;
+
+    std::vector<Step> steps; // parents always come first
+
+    // preallocated, one element per step
+    std::vector<KDL::Frame> frames;
+    std::vector<KDL::Twist> axes; // joint twist for unit speed, reference point at the root origin
+    std::vector<KDL::Twist> twists; // reference point at the root origin
+    std::vector<KDL::Vector> cogs;
+    std::vector<double> subtreeMasses;
+    std::vector<KDL::Vector> subtreeMoments; // first moment of mass, i.e. mass times CoM
+};
+
+} // namespace roboticslab
+
+#endif // __TREE_CENTROIDAL_SOLVER_HPP__
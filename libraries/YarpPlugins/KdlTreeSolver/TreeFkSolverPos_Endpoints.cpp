@@ -0,0 +1,151 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#include "TreeFkSolverPos_Endpoints.hpp"
+
+#include <map>
+#include <set>
+
+using namespace roboticslab;
+
+// -----------------------------------------------------------------------------
+
+TreeFkSolverPos_Endpoints::TreeFkSolverPos_Endpoints(const KDL::Tree & _tree, const std::vector<std::string> & _endpoints)
+    : tree(_tree),
+      endpoints(_endpoints),
+      valid(false)
+{
+    updateInternalDataStructures();
+}
+
+// -----------------------------------------------------------------------------
+
+int TreeFkSolverPos_Endpoints::jointIndex(const KDL::TreeElement & element)
+{
+    const KDL::Segment & segment = KDL::GetTreeElementSegment(element);
+    return segment.getJoint().getType() == KDL::Joint::None ? -1 : KDL::GetTreeElementQNr(element);
+}
+
+// -----------------------------------------------------------------------------
+
+void TreeFkSolverPos_Endpoints::updateInternalDataStructures()
+{
+    steps.clear();
+    endpointSteps.clear();
+    valid = false;
+
+    const KDL::SegmentMap & segments = tree.getSegments();
+    std::set<std::string> required;
+
+    // Mark all segments that lie between the root and an endpoint.
+    for (const auto & endpoint : endpoints)
+    {
+        auto it = segments.find(endpoint);
+
+        if (it == segments.end())
+        {
+            return;
+        }
+
+        while (required.insert(it->first).second && it != tree.getRootSegment())
+        {
+            it = KDL::GetTreeElementParent(it->second);
+        }
+    }
+
+    // Depth-first traversal from the root, parents are stored before their children.
+    std::map<std::string, int> indices;
+    std::vector<std::pair<KDL::SegmentMap::const_iterator, int>> pending {{tree.getRootSegment(), -1}};
+
+    while (!pending.empty())
+    {
+        auto it = pending.back().first;
+        int parent = pending.back().second;
+        pending.pop_back();
+
+        int index = steps.size();
+        steps.push_back({&KDL::GetTreeElementSegment(it->second), jointIndex(it->second), parent});
+        indices.emplace(it->first, index);
+
+        for (const auto & child : KDL::GetTreeElementChildren(it->second))
+        {
+            if (required.find(child->first) != required.end())
+            {
+                pending.emplace_back(child, index);
+            }
+        }
+    }
+
+    for (const auto & endpoint : endpoints)
+    {
+        endpointSteps.push_back(indices[endpoint]);
+    }
+
+    frames.resize(steps.size());
+    valid = true;
+}
+
+// -----------------------------------------------------------------------------
+
+int TreeFkSolverPos_Endpoints::JntToCart(const KDL::JntArray & q_in, std::vector<KDL::Frame> & p_out)
+{
+    if (!valid)
+    {
+        return E_SEGMENT_NOT_FOUND;
+    }
+
+    if (q_in.rows() != tree.getNrOfJoints() || p_out.size() != endpoints.size())
+    {
+        return E_ILLEGAL_ARGUMENT_SIZE;
+    }
+
+    for (int i = 0; i < steps.size(); i++)
+    {
+        const Step & step = steps[i];
+        KDL::Frame H = step.segment->pose(step.qNr != -1 ? q_in(step.qNr) : 0.0);
+        frames[i] = step.parent != -1 ? frames[step.parent] * H : H;
+    }
+
+    for (int i = 0; i < endpointSteps.size(); i++)
+    {
+        p_out[i] = frames[endpointSteps[i]];
+    }
+
+    return E_NOERROR;
+}
+
+// -----------------------------------------------------------------------------
+
+int TreeFkSolverPos_Endpoints::JntToCart(const KDL::JntArray & q_in, KDL::Frame & p_out, const std::string & segmentName)
+{
+    if (q_in.rows() != tree.getNrOfJoints())
+    {
+        return E_ILLEGAL_ARGUMENT_SIZE;
+    }
+
+    auto it = tree.getSegments().find(segmentName);
+
+    if (it == tree.getSegments().end())
+    {
+        return E_SEGMENT_NOT_FOUND;
+    }
+
+    // Walk up to the root, same as KDL::TreeFkSolverPos_recursive but without recursion.
+    p_out = KDL::Frame::Identity();
+
+    while (true)
+    {
+        int qNr = jointIndex(it->second);
+        p_out = KDL::GetTreeElementSegment(it->second).pose(qNr != -1 ? q_in(qNr) : 0.0) * p_out;
+
+        if (it == tree.getRootSegment())
+        {
+            break;
+        }
+
+        it = KDL::GetTreeElementParent(it->second);
+    }
+
+    return E_NOERROR;
+}
+
+// -----------------------------------------------------------------------------
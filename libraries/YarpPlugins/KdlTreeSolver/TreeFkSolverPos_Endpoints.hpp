@@ -0,0 +1,102 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#ifndef __TREE_FK_SOLVER_POS_ENDPOINTS_HPP__
+#define __TREE_FK_SOLVER_POS_ENDPOINTS_HPP__
+
+#include <string>
+#include <vector>
+
+#include <kdl/frames.hpp>
+#include <kdl/jntarray.hpp>
+#include <kdl/segment.hpp>
+#include <kdl/tree.hpp>
+#include <kdl/treefksolver.hpp>
+
+namespace roboticslab
+{
+
+/**
+ * @ingroup KdlTreeSolver
+ * @brief FK solver for several endpoints of a tree at once.
+ *
+ * Segments are visited once per call in a single root-to-leaves pass, therefore
+ * segments shared by several endpoints (e.g. the torso of a humanoid) are not
+ * evaluated more than once, as opposed to KDL::TreeFkSolverPos_recursive. Only
+ * segments that lead to an endpoint are considered. No memory is allocated on
+ * runtime.
+ */
+class TreeFkSolverPos_Endpoints : public KDL::TreeFkSolverPos
+{
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @param tree Input kinematic tree.
+     * @param endpoints Names of the endpoint segments.
+     */
+    TreeFkSolverPos_Endpoints(const KDL::Tree & tree, const std::vector<std::string> & endpoints);
+
+    /**
+     * @brief Perform FK on all endpoints.
+     *
+     * @param q_in Input joint coordinates.
+     * @param p_out Output cartesian poses, one per endpoint in the same order as
+     * passed to the constructor. Must be already sized.
+     *
+     * @return Return code, < 0 if something went wrong.
+     */
+    int JntToCart(const KDL::JntArray & q_in, std::vector<KDL::Frame> & p_out);
+
+    /**
+     * @brief Perform FK on a single segment.
+     *
+     * Any segment is accepted, not only endpoints.
+     *
+     * @param q_in Input joint coordinates.
+     * @param p_out Output cartesian pose.
+     * @param segmentName Name of the segment.
+     *
+     * @return Return code, < 0 if something went wrong.
+     */
+    int JntToCart(const KDL::JntArray & q_in, KDL::Frame & p_out, const std::string & segmentName) override;
+
+    /**
+     * @brief Update the internal data structures.
+     *
+     * Required if the structure of the tree has changed.
+     */
+    void updateInternalDataStructures();
+
+    /** @brief Return code, success. */
+    static const int E_NOERROR = 0;
+
+    /** @brief Return code, segment not found in tree. */
+    static const int E_SEGMENT_NOT_FOUND = -100;
+
+    /** @brief Return code, input or output vector size mismatch. */
+    static const int E_ILLEGAL_ARGUMENT_SIZE = -101;
+
+private:
+    struct Step
+    {
+        const KDL::Segment * segment;
+        int qNr; // -1 if fixed
+        int parent; // -1 if root
+    };
+
+    static int jointIndex(const KDL::TreeElement & element);
+
+    const KDL::Tree & tree;
+    const std::vector<std::string> endpoints;
+
+    // segments in root-to-leaves order, parents always come first
+    std::vector<Step> steps;
+    std::vector<int> endpointSteps;
+    std::vector<KDL::Frame> frames;
+
+    bool valid;
+};
+
+} // namespace roboticslab
+
+#endif // __TREE_FK_SOLVER_POS_ENDPOINTS_HPP__
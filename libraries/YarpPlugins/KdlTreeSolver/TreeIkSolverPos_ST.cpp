@@ -0,0 +1,136 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#include "TreeIkSolverPos_ST.hpp"
+
+#include <algorithm> // std::reverse
+
+#include <kdl/chain.hpp>
+#include <kdl/joint.hpp>
+#include <kdl/segment.hpp>
+
+#include "ProductOfExponentials.hpp"
+
+using namespace roboticslab;
+
+// -----------------------------------------------------------------------------
+
+TreeIkSolverPos_ST::TreeIkSolverPos_ST(const std::string & _endpoint, const std::vector<int> & _joints,
+        ScrewTheoryIkProblem * _problem, ConfigurationSelector * _config)
+    : endpoint(_endpoint),
+      joints(_joints),
+      problem(_problem),
+      config(_config),
+      qInitChain(_joints.size()),
+      qOutChain(_joints.size())
+{}
+
+// -----------------------------------------------------------------------------
+
+TreeIkSolverPos_ST::~TreeIkSolverPos_ST()
+{
+    delete problem;
+    problem = nullptr;
+
+    delete config;
+    config = nullptr;
+}
+
+// -----------------------------------------------------------------------------
+
+double TreeIkSolverPos_ST::CartToJnt(const KDL::JntArray & q_init, const KDL::Frames & p_in, KDL::JntArray & q_out)
+{
+    auto it = p_in.find(endpoint);
+
+    if (it == p_in.end())
+    {
+        return E_SOLUTION_NOT_FOUND;
+    }
+
+    for (int i = 0; i < joints.size(); i++)
+    {
+        qInitChain(i) = q_init(joints[i]);
+    }
+
+    bool ret = problem->solve(it->second, solutions);
+
+    if (!config->configure(solutions))
+    {
+        return E_OUT_OF_LIMITS;
+    }
+
+    if (!config->findOptimalConfiguration(qInitChain))
+    {
+        return E_OUT_OF_LIMITS;
+    }
+
+    config->retrievePose(qOutChain);
+
+    q_out = q_init;
+
+    for (int i = 0; i < joints.size(); i++)
+    {
+        q_out(joints[i]) = qOutChain(i);
+    }
+
+    return ret ? E_NOERROR : E_NOT_REACHABLE;
+}
+
+// -----------------------------------------------------------------------------
+
+KDL::TreeIkSolverPos * TreeIkSolverPos_ST::create(const KDL::Tree & tree, const std::string & endpoint,
+        const ConfigurationSelectorFactory & configFactory)
+{
+    const KDL::SegmentMap & segments = tree.getSegments();
+    const auto root = tree.getRootSegment();
+    auto it = segments.find(endpoint);
+
+    if (it == segments.end())
+    {
+        return nullptr;
+    }
+
+    // Walk up from the endpoint, the root segment is not part of the chain.
+    std::vector<KDL::SegmentMap::const_iterator> path;
+
+    for (; it != root; it = KDL::GetTreeElementParent(it->second))
+    {
+        path.push_back(it);
+    }
+
+    std::reverse(path.begin(), path.end());
+
+    KDL::Chain chain;
+    std::vector<int> joints;
+
+    for (const auto & element : path)
+    {
+        const KDL::Segment & segment = KDL::GetTreeElementSegment(element->second);
+        chain.addSegment(segment);
+
+        if (segment.getJoint().getType() != KDL::Joint::None)
+        {
+            joints.push_back(KDL::GetTreeElementQNr(element->second));
+        }
+    }
+
+    PoeExpression poe = PoeExpression::fromChain(chain);
+    ScrewTheoryIkProblemBuilder builder(poe);
+    ScrewTheoryIkProblem * problem = builder.build();
+
+    if (!problem)
+    {
+        return nullptr;
+    }
+
+    ConfigurationSelector * config = configFactory.create();
+
+    if (!config)
+    {
+        delete problem;
+        return nullptr;
+    }
+
+    return new TreeIkSolverPos_ST(endpoint, joints, problem, config);
+}
+
+// -----------------------------------------------------------------------------
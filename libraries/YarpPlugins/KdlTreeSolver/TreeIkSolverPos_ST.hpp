@@ -0,0 +1,87 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#ifndef __TREE_IK_SOLVER_POS_ST_HPP__
+#define __TREE_IK_SOLVER_POS_ST_HPP__
+
+#include <string>
+#include <vector>
+
+#include <kdl/frames.hpp>
+#include <kdl/jntarray.hpp>
+#include <kdl/tree.hpp>
+#include <kdl/treeiksolver.hpp>
+
+#include "ScrewTheoryIkProblem.hpp"
+#include "ConfigurationSelector.hpp"
+
+namespace roboticslab
+{
+
+/**
+ * @ingroup KdlTreeSolver
+ * @brief IK solver using Screw Theory on a single branch of a tree.
+ *
+ * The kinematic chain that spans from the root of the tree to the given endpoint
+ * is solved in closed form by means of a \ref ScrewTheoryIkProblem, the optimal
+ * solution is picked by a \ref ConfigurationSelector. Joints that do not belong
+ * to this chain keep their initial values. Meant to be used on each independent
+ * subtree of a \ref TreeIkSolverPos_Subtrees instance. Endpoints that share
+ * movable joints (e.g. two arms on a revolute torso) are not supported, see
+ * \ref TreeIkSolverPos_Subtrees::findSubtrees.
+ */
+class TreeIkSolverPos_ST : public KDL::TreeIkSolverPos
+{
+public:
+    /** @brief Destructor. */
+    ~TreeIkSolverPos_ST() override;
+
+    /**
+     * @brief Calculate inverse position kinematics.
+     *
+     * @param q_init Initial guess of the joint coordinates.
+     * @param p_in Target cartesian poses, must contain the endpoint of this solver.
+     * @param q_out Output joint coordinates.
+     *
+     * @return Negative on failure, @ref E_NOT_REACHABLE if the target could only
+     * be approximated, @ref E_NOERROR otherwise.
+     */
+    double CartToJnt(const KDL::JntArray & q_init, const KDL::Frames & p_in, KDL::JntArray & q_out) override;
+
+    /**
+     * @brief Create an instance of \ref TreeIkSolverPos_ST.
+     *
+     * @param tree Input kinematic tree.
+     * @param endpoint Name of the endpoint segment.
+     * @param configFactory Instance of a factory class that dynamically
+     * instantiates a ConfigurationSelector, joint limits must follow the
+     * root-to-endpoint order of the chain.
+     *
+     * @return Solver instance or null if the endpoint was not found or the chain
+     * could not be solved in closed form.
+     */
+    static KDL::TreeIkSolverPos * create(const KDL::Tree & tree, const std::string & endpoint,
+                                         const ConfigurationSelectorFactory & configFactory);
+
+    static const int E_NOERROR = 0;
+    static const int E_SOLUTION_NOT_FOUND = -100;
+    static const int E_OUT_OF_LIMITS = -101;
+    static const int E_NOT_REACHABLE = 100;
+
+private:
+    TreeIkSolverPos_ST(const std::string & endpoint, const std::vector<int> & joints,
+                       ScrewTheoryIkProblem * problem, ConfigurationSelector * config);
+
+    const std::string endpoint;
+    const std::vector<int> joints; // tree index of each joint of the chain
+
+    ScrewTheoryIkProblem * problem;
+    ConfigurationSelector * config;
+
+    ScrewTheoryIkProblem::Solutions solutions;
+    KDL::JntArray qInitChain;
+    KDL::JntArray qOutChain;
+};
+
+} // namespace roboticslab
+
+#endif // __TREE_IK_SOLVER_POS_ST_HPP__
@@ -0,0 +1,393 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#include "TreeIkSolverPos_Subtrees.hpp"
+
+#include <algorithm> // std::any_of, std::max, std::min
+#include <numeric> // std::iota
+#include <set>
+#include <utility> // std::pair
+
+using namespace roboticslab;
+
+// -----------------------------------------------------------------------------
+
+namespace
+{
+    bool isMovable(const KDL::TreeElement & element)
+    {
+        return KDL::GetTreeElementSegment(element).getJoint().getType() != KDL::Joint::None;
+    }
+
+    int findGroup(std::vector<int> & groups, int i)
+    {
+        while (groups[i] != i)
+        {
+            i = groups[i] = groups[groups[i]];
+        }
+
+        return i;
+    }
+
+    // Segments along each root-to-endpoint path, endpoints that share at least one movable joint belong
+    // to the same group (union-find).
+    bool groupEndpoints(const KDL::Tree & tree, const std::vector<std::string> & endpoints, bool split,
+                        std::vector<std::set<std::string>> & paths, std::vector<int> & groups)
+    {
+        const KDL::SegmentMap & segments = tree.getSegments();
+        const auto root = tree.getRootSegment();
+
+        std::vector<std::set<int>> pathJoints(endpoints.size());
+        paths.assign(endpoints.size(), {});
+
+        for (int i = 0; i < endpoints.size(); i++)
+        {
+            auto it = segments.find(endpoints[i]);
+
+            if (it == segments.end())
+            {
+                return false;
+            }
+
+            while (true)
+            {
+                paths[i].insert(it->first);
+
+                if (isMovable(it->second))
+                {
+                    pathJoints[i].insert(KDL::GetTreeElementQNr(it->second));
+                }
+
+                if (it == root)
+                {
+                    break;
+                }
+
+                it = KDL::GetTreeElementParent(it->second);
+            }
+        }
+
+        groups.resize(endpoints.size());
+        std::iota(groups.begin(), groups.end(), 0);
+
+        for (int i = 0; i < endpoints.size(); i++)
+        {
+            for (int j = i + 1; j < endpoints.size(); j++)
+            {
+                bool shared = !split || std::any_of(pathJoints[i].cbegin(), pathJoints[i].cend(),
+                                                    [&](int q) { return pathJoints[j].count(q) != 0; });
+
+                if (shared)
+                {
+                    // keep the lowest index as the representative of each group
+                    int a = findGroup(groups, i);
+                    int b = findGroup(groups, j);
+                    groups[std::max(a, b)] = std::min(a, b);
+                }
+            }
+        }
+
+        return true;
+    }
+
+    bool sameFrames(const KDL::Frames & lhs, const KDL::Frames & rhs)
+    {
+        if (lhs.size() != rhs.size())
+        {
+            return false;
+        }
+
+        for (auto itL = lhs.cbegin(), itR = rhs.cbegin(); itL != lhs.cend(); ++itL, ++itR)
+        {
+            if (itL->first != itR->first || !KDL::Equal(itL->second, itR->second))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool sameJoints(const KDL::JntArray & lhs, const KDL::JntArray & rhs)
+    {
+        for (int i = 0; i < lhs.rows(); i++)
+        {
+            if (!KDL::Equal(lhs(i), rhs(i)))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+TreeIkSolverPos_Subtrees * TreeIkSolverPos_Subtrees::create(const KDL::Tree & tree, const std::vector<std::string> & endpoints,
+        const Factory & factory, bool split)
+{
+    const KDL::SegmentMap & segments = tree.getSegments();
+    const auto root = tree.getRootSegment();
+
+    std::vector<std::set<std::string>> paths;
+    std::vector<int> groups;
+
+    if (!groupEndpoints(tree, endpoints, split, paths, groups))
+    {
+        return nullptr;
+    }
+
+    std::unique_ptr<TreeIkSolverPos_Subtrees> solver(new TreeIkSolverPos_Subtrees(tree.getNrOfJoints()));
+
+    for (int i = 0; i < endpoints.size(); i++)
+    {
+        if (findGroup(groups, i) != i)
+        {
+            continue; // not the first endpoint of its group, already processed
+        }
+
+        std::unique_ptr<Subtree> subtree(new Subtree(root->first));
+        std::set<std::string> required;
+
+        for (int j = i; j < endpoints.size(); j++)
+        {
+            if (findGroup(groups, j) == i)
+            {
+                subtree->endpoints.push_back(endpoints[j]);
+                required.insert(paths[j].cbegin(), paths[j].cend());
+            }
+        }
+
+        // Depth-first traversal from the root, only segments that lead to an endpoint of this subtree.
+        std::vector<KDL::SegmentMap::const_iterator> pending {root};
+
+        while (!pending.empty())
+        {
+            auto it = pending.back();
+            pending.pop_back();
+
+            for (const auto & child : KDL::GetTreeElementChildren(it->second))
+            {
+                if (required.count(child->first) != 0)
+                {
+                    subtree->tree.addSegment(KDL::GetTreeElementSegment(child->second), it->first);
+                    pending.push_back(child);
+                }
+            }
+        }
+
+        // Map local joint indices to global ones.
+        subtree->joints.resize(subtree->tree.getNrOfJoints());
+
+        for (const auto & entry : subtree->tree.getSegments())
+        {
+            if (isMovable(entry.second))
+            {
+                subtree->joints[KDL::GetTreeElementQNr(entry.second)] = KDL::GetTreeElementQNr(segments.find(entry.first)->second);
+            }
+        }
+
+        if (!factory(subtree->tree, subtree->endpoints, subtree->joints, subtree->solvers))
+        {
+            return nullptr;
+        }
+
+        subtree->q_init_local.resize(subtree->joints.size());
+        subtree->q_init.resize(subtree->joints.size());
+        subtree->q_out.resize(subtree->joints.size());
+
+        for (const auto & endpoint : subtree->endpoints)
+        {
+            subtree->p_in_local.emplace(endpoint, KDL::Frame::Identity());
+        }
+
+        solver->subtrees.push_back(std::move(subtree));
+    }
+
+    for (int i = 1; i < solver->subtrees.size(); i++)
+    {
+        solver->workers.emplace_back(&TreeIkSolverPos_Subtrees::runWorker, solver.get(), i);
+    }
+
+    return solver.release();
+}
+
+// -----------------------------------------------------------------------------
+
+std::vector<std::vector<std::string>> TreeIkSolverPos_Subtrees::findSubtrees(const KDL::Tree & tree,
+        const std::vector<std::string> & endpoints)
+{
+    std::vector<std::set<std::string>> paths;
+    std::vector<int> groups;
+
+    if (!groupEndpoints(tree, endpoints, true, paths, groups))
+    {
+        return {};
+    }
+
+    std::vector<std::vector<std::string>> out;
+
+    for (int i = 0; i < endpoints.size(); i++)
+    {
+        if (findGroup(groups, i) != i)
+        {
+            continue;
+        }
+
+        out.emplace_back();
+
+        for (int j = i; j < endpoints.size(); j++)
+        {
+            if (findGroup(groups, j) == i)
+            {
+                out.back().push_back(endpoints[j]);
+            }
+        }
+    }
+
+    return out;
+}
+
+// -----------------------------------------------------------------------------
+
+TreeIkSolverPos_Subtrees::~TreeIkSolverPos_Subtrees()
+{
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        poolStop = true;
+    }
+
+    poolStart.notify_all();
+
+    for (auto & worker : workers)
+    {
+        worker.join();
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void TreeIkSolverPos_Subtrees::runWorker(int index)
+{
+    unsigned long round = 0;
+
+    while (true)
+    {
+        std::unique_lock<std::mutex> lock(poolMutex);
+        poolStart.wait(lock, [this, round] { return poolStop || poolRound != round; });
+
+        if (poolStop)
+        {
+            return;
+        }
+
+        round = poolRound;
+        const KDL::JntArray & q_init = *poolJoints;
+        const KDL::Frames & p_in = *poolTargets;
+        lock.unlock();
+
+        solve(*subtrees[index], q_init, p_in);
+
+        lock.lock();
+
+        if (--poolPending == 0)
+        {
+            poolDone.notify_one();
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void TreeIkSolverPos_Subtrees::solve(Subtree & subtree, const KDL::JntArray & q_init, const KDL::Frames & p_in)
+{
+    KDL::JntArray & q_init_local = subtree.q_init_local;
+    KDL::Frames & p_in_local = subtree.p_in_local;
+
+    for (int i = 0; i < subtree.joints.size(); i++)
+    {
+        q_init_local(i) = q_init(subtree.joints[i]);
+    }
+
+    for (auto & entry : p_in_local)
+    {
+        entry.second = p_in.at(entry.first);
+    }
+
+    // Same inputs as last time, hence same output.
+    if (subtree.cached && sameFrames(p_in_local, subtree.p_in) && sameJoints(q_init_local, subtree.q_init))
+    {
+        return;
+    }
+
+    subtree.result = subtree.solvers.ikSolverPos->CartToJnt(q_init_local, p_in_local, subtree.q_out);
+    subtree.q_init = q_init_local;
+    subtree.p_in = p_in_local;
+    subtree.cached = subtree.result >= 0;
+}
+
+// -----------------------------------------------------------------------------
+
+double TreeIkSolverPos_Subtrees::CartToJnt(const KDL::JntArray & q_init, const KDL::Frames & p_in, KDL::JntArray & q_out)
+{
+    if (q_init.rows() != nrOfJoints || q_out.rows() != nrOfJoints)
+    {
+        return -1;
+    }
+
+    for (const auto & subtree : subtrees)
+    {
+        for (const auto & endpoint : subtree->endpoints)
+        {
+            if (p_in.find(endpoint) == p_in.end())
+            {
+                return -1;
+            }
+        }
+    }
+
+    if (subtrees.empty())
+    {
+        q_out = q_init;
+        return 0.0;
+    }
+
+    if (!workers.empty())
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        poolJoints = &q_init;
+        poolTargets = &p_in;
+        poolPending = workers.size();
+        poolRound++;
+    }
+
+    poolStart.notify_all();
+    solve(*subtrees[0], q_init, p_in);
+
+    if (!workers.empty())
+    {
+        std::unique_lock<std::mutex> lock(poolMutex);
+        poolDone.wait(lock, [this] { return poolPending == 0; });
+    }
+
+    // Joints that do not lead to any endpoint are left untouched.
+    q_out = q_init;
+
+    double minResult = 0.0;
+    double maxResult = 0.0;
+
+    for (const auto & subtree : subtrees)
+    {
+        for (int i = 0; i < subtree->joints.size(); i++)
+        {
+            q_out(subtree->joints[i]) = subtree->q_out(i);
+        }
+
+        minResult = std::min(minResult, subtree->result);
+        maxResult = std::max(maxResult, subtree->result);
+    }
+
+    return minResult < 0 ? minResult : maxResult;
+}
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,160 @@
+// -*- mode:C++; tab-width:4; c-basic-offset:4; indent-tabs-mode:nil -*-
+
+#ifndef __TREE_IK_SOLVER_POS_SUBTREES_HPP__
+#define __TREE_IK_SOLVER_POS_SUBTREES_HPP__
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <kdl/frames.hpp>
+#include <kdl/jntarray.hpp>
+#include <kdl/tree.hpp>
+#include <kdl/treefksolver.hpp>
+#include <kdl/treeiksolver.hpp>
+
+namespace roboticslab
+{
+
+/**
+ * @ingroup KdlTreeSolver
+ * @brief IK solver that splits a tree into independent subtrees.
+ *
+ * Endpoints whose root-to-tip paths share no movable joint (e.g. two legs or two
+ * arms hanging from a fixed root) are assigned to different subtrees. Each subtree
+ * is solved by its own IK solver on a separate thread, then the resulting joint
+ * values are merged. Threads are started along with the solver and wait for the
+ * next call in between, the caller's thread handles the first subtree. Joints that do not lead to any endpoint keep their initial
+ * values.
+ *
+ * Each subtree remembers its last inputs and output. If neither its targets nor
+ * its initial joint values have changed since the previous call, the solver is
+ * skipped and the previous output is reused.
+ */
+class TreeIkSolverPos_Subtrees : public KDL::TreeIkSolverPos
+{
+public:
+    /**
+     * @brief Set of solvers that operate on a subtree.
+     *
+     * The IK position solver may hold references to the other two, which can be
+     * left empty if not needed (e.g. closed-form solvers).
+     */
+    struct Solvers
+    {
+        std::unique_ptr<KDL::TreeFkSolverPos> fkSolverPos;
+        std::unique_ptr<KDL::TreeIkSolverVel> ikSolverVel;
+        std::unique_ptr<KDL::TreeIkSolverPos> ikSolverPos;
+    };
+
+    /**
+     * @brief Creates the solvers for a subtree.
+     *
+     * Arguments: the subtree, its endpoints, the global index of each of its
+     * joints and the output set of solvers. Returns false on failure.
+     */
+    using Factory = std::function<bool(const KDL::Tree &, const std::vector<std::string> &, const std::vector<int> &, Solvers &)>;
+
+    /** @brief Destructor, stops the worker threads. */
+    ~TreeIkSolverPos_Subtrees() override;
+
+    /**
+     * @brief Create an instance of \ref TreeIkSolverPos_Subtrees.
+     *
+     * @param tree Input kinematic tree.
+     * @param endpoints Names of the endpoint segments.
+     * @param factory Creates the solvers of each subtree.
+     * @param split Whether to look for independent subtrees, otherwise the whole
+     * tree is processed as a single subtree.
+     *
+     * @return Solver instance or null if a subtree could not be set up.
+     */
+    static TreeIkSolverPos_Subtrees * create(const KDL::Tree & tree, const std::vector<std::string> & endpoints,
+                                             const Factory & factory, bool split);
+
+    /**
+     * @brief Group endpoints into independent subtrees.
+     *
+     * Endpoints end up in the same group if their root-to-tip paths share any
+     * movable joint, either directly or through other endpoints of the group.
+     *
+     * @param tree Input kinematic tree.
+     * @param endpoints Names of the endpoint segments.
+     *
+     * @return Names of the endpoints of each subtree, empty if any endpoint was
+     * not found.
+     */
+    static std::vector<std::vector<std::string>> findSubtrees(const KDL::Tree & tree, const std::vector<std::string> & endpoints);
+
+    /**
+     * @brief Calculate inverse position kinematics.
+     *
+     * @param q_init Initial guess of the joint coordinates.
+     * @param p_in Target cartesian poses, one per endpoint.
+     * @param q_out Output joint coordinates.
+     *
+     * @return The lowest return value among all subtree solvers if any of them
+     * failed (negative), the highest one otherwise.
+     */
+    double CartToJnt(const KDL::JntArray & q_init, const KDL::Frames & p_in, KDL::JntArray & q_out) override;
+
+    /** @brief Number of independent subtrees. */
+    int getNrOfSubtrees() const
+    { return subtrees.size(); }
+
+private:
+    struct Subtree
+    {
+        explicit Subtree(const std::string & root)
+            : tree(root),
+              result(0.0),
+              cached(false)
+        {}
+
+        KDL::Tree tree;
+        std::vector<std::string> endpoints;
+        std::vector<int> joints;
+        Solvers solvers;
+
+        // scratch inputs of the current call
+        KDL::JntArray q_init_local;
+        KDL::Frames p_in_local;
+
+        // inputs and output of the last call
+        KDL::JntArray q_init;
+        KDL::JntArray q_out;
+        KDL::Frames p_in;
+        double result;
+        bool cached;
+    };
+
+    TreeIkSolverPos_Subtrees(int nrOfJoints)
+        : nrOfJoints(nrOfJoints)
+    {}
+
+    static void solve(Subtree & subtree, const KDL::JntArray & q_init, const KDL::Frames & p_in);
+
+    void runWorker(int index);
+
+    const int nrOfJoints;
+
+    std::vector<std::unique_ptr<Subtree>> subtrees;
+
+    // one thread per subtree except the first one
+    std::vector<std::thread> workers;
+    std::mutex poolMutex;
+    std::condition_variable poolStart, poolDone;
+    const KDL::JntArray * poolJoints {nullptr};
+    const KDL::Frames * poolTargets {nullptr};
+    unsigned long poolRound {0};
+    int poolPending {0};
+    bool poolStop {false};
+};
+
+} // namespace roboticslab
+
+#endif // __TREE_IK_SOLVER_POS_SUBTREES_HPP__
@@ -0,0 +1,113 @@
+#include "gtest/gtest.h"
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <yarp/os/all.h>
+#include <yarp/dev/Drivers.h>
+#include <yarp/dev/PolyDriver.h>
+
+#include "ICartesianControl.h"
+
+namespace roboticslab
+{
+
+/**
+ * @ingroup kinematics-dynamics-tests
+ * @brief Tests \ref AmorCartesianControl against the offline AMOR API provided by AmorMockLib.
+ */
+class AmorCartesianControlTest : public testing::Test
+{
+
+    public:
+        virtual void SetUp() {
+            // every call to the simulated controller takes 5-15 ms
+            setenv("AMOR_MOCK_LATENCY_MS", "10", 1);
+            setenv("AMOR_MOCK_JITTER_MS", "5", 1);
+
+            yarp::os::ResourceFinder rf;
+            rf.setVerbose(false);
+            rf.setDefaultContext("testKdlSolverFromFile");
+            std::string kinematicsFileFullPath = rf.findFileByName("testKdlSolverFromFile.ini");
+
+            yarp::os::Property cartesianControlOptions {
+                {"device", yarp::os::Value("AmorCartesianControl")},
+                {"kinematics", yarp::os::Value(kinematicsFileFullPath)},
+                {"waitPeriodMs", yarp::os::Value(5)}
+            };
+
+            cartesianControlDevice.open(cartesianControlOptions);
+
+            if (!cartesianControlDevice.isValid())
+            {
+                yError() << "CartesianControl device not valid:" << cartesianControlOptions.find("device").asString();
+                return;
+            }
+
+            if (!cartesianControlDevice.view(iCartesianControl))
+            {
+                yError() << "Could not view iCartesianControl in:" << cartesianControlOptions.find("device").asString();
+                return;
+            }
+        }
+
+        virtual void TearDown()
+        {
+            cartesianControlDevice.close();
+        }
+
+    protected:
+        yarp::dev::PolyDriver cartesianControlDevice;
+        roboticslab::ICartesianControl *iCartesianControl;
+};
+
+TEST_F( AmorCartesianControlTest, AmorCartesianControlStat)
+{
+    std::vector<double> x;
+    int state;
+    ASSERT_TRUE(iCartesianControl->stat(x,&state));
+    ASSERT_EQ(state,VOCAB_CC_NOT_CONTROLLING);
+    ASSERT_NEAR(x[0], 0.3, 1e-9);
+    ASSERT_NEAR(x[1], 0, 1e-9);
+    ASSERT_NEAR(x[2], 0.5, 1e-9);
+}
+
+TEST_F( AmorCartesianControlTest, AmorCartesianControlStatLatency)
+{
+    // served from the state cached by the I/O thread, not blocked by the controller
+    std::vector<double> x;
+    double start = yarp::os::Time::now();
+
+    for (int i = 0; i < 100; i++)
+    {
+        ASSERT_TRUE(iCartesianControl->stat(x));
+    }
+
+    ASSERT_LT(yarp::os::Time::now() - start, 0.1);
+}
+
+TEST_F( AmorCartesianControlTest, AmorCartesianControlMovl)
+{
+    std::vector<double> xd {0.35, 0.05, 0.45, 0, 0, 0}, x;
+    ASSERT_TRUE(iCartesianControl->movl(xd));
+    ASSERT_TRUE(iCartesianControl->wait(5.0));
+    ASSERT_TRUE(iCartesianControl->stat(x));
+    ASSERT_NEAR(x[0], 0.35, 1e-6);
+    ASSERT_NEAR(x[1], 0.05, 1e-6);
+    ASSERT_NEAR(x[2], 0.45, 1e-6);
+}
+
+TEST_F( AmorCartesianControlTest, AmorCartesianControlMovv)
+{
+    std::vector<double> xdotd {0.05, 0, 0, 0, 0, 0}, x;
+    ASSERT_TRUE(iCartesianControl->movv(xdotd));
+    yarp::os::Time::delay(0.5);
+    ASSERT_TRUE(iCartesianControl->stopControl());
+    ASSERT_TRUE(iCartesianControl->stat(x));
+    ASSERT_GT(x[0], 0.3);
+    ASSERT_NEAR(x[1], 0, 1e-9);
+    ASSERT_NEAR(x[2], 0.5, 1e-9);
+}
+
+}  // namespace roboticslab
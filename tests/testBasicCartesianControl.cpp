@@ -1,6 +1,7 @@
 #include "gtest/gtest.h"
 
 #include <cmath>
+#include <map>
 #include <vector>
 #include <algorithm>
 
@@ -145,4 +146,124 @@ TEST_F( BasicCartesianControlTest, BasicCartesianControlTool)
     ASSERT_NEAR(xNoTool[5], 0, 1e-9);
 }
 
+TEST_F( BasicCartesianControlTest, BasicCartesianControlLatencyStats)
+{
+    std::map<int, std::vector<double>> stats;
+    ASSERT_TRUE(iCartesianControl->getLatencyStats(stats));
+    ASSERT_EQ(stats.size(), 7);
+
+    for (const auto & it : stats)
+    {
+        ASSERT_EQ(it.second.size(), 7); // count, min, p50, p90, p99, p99.9, max
+    }
+
+    // the CMC thread has been running since SetUp()
+    const std::vector<double> tick = stats[VOCAB_CC_LATENCY_TICK];
+    ASSERT_GT(tick[0], 0);
+    ASSERT_LE(tick[1], tick[2]);
+    ASSERT_LE(tick[2], tick[3]);
+    ASSERT_LE(tick[3], tick[4]);
+    ASSERT_LE(tick[4], tick[5]);
+    ASSERT_LE(tick[5], tick[6]);
+
+    ASSERT_TRUE(iCartesianControl->resetLatencyStats());
+    ASSERT_TRUE(iCartesianControl->getLatencyStats(stats));
+    ASSERT_LT(stats[VOCAB_CC_LATENCY_TICK][0], tick[0]);
+}
+
+TEST_F( BasicCartesianControlTest, BasicCartesianControlMovw)
+{
+    double radius;
+    ASSERT_TRUE(iCartesianControl->getParameter(VOCAB_CC_CONFIG_BLEND_RADIUS, &radius));
+    ASSERT_EQ(radius, 0.0);
+    ASSERT_FALSE(iCartesianControl->setParameter(VOCAB_CC_CONFIG_BLEND_RADIUS, -1.0));
+
+    ASSERT_TRUE(iCartesianControl->setParameter(VOCAB_CC_CONFIG_BLEND_RADIUS, 0.05));
+    ASSERT_TRUE(iCartesianControl->setParameter(VOCAB_CC_CONFIG_TRAJ_DURATION, 1.0));
+
+    // two waypoints close to the reachable circle, the second one blended into the first
+    const double q1 = M_PI / 18, q2 = M_PI / 9;
+    std::vector<double> xd1 {std::cos(q1), std::sin(q1), 0, 0, 0, q1};
+    std::vector<double> xd2 {std::cos(q2), std::sin(q2), 0, 0, 0, q2};
+    std::vector<double> x;
+    int state;
+
+    ASSERT_TRUE(iCartesianControl->movw(xd1));
+    ASSERT_TRUE(iCartesianControl->movw(xd2));
+    ASSERT_TRUE(iCartesianControl->stat(x, &state));
+    ASSERT_EQ(state, VOCAB_CC_MOVW_CONTROLLING);
+
+    ASSERT_TRUE(iCartesianControl->wait(5.0));
+    ASSERT_TRUE(iCartesianControl->stat(x, &state));
+    ASSERT_EQ(state, VOCAB_CC_NOT_CONTROLLING);
+    ASSERT_NEAR(x[0], xd2[0], 1e-2);
+    ASSERT_NEAR(x[1], xd2[1], 1e-2);
+    ASSERT_NEAR(x[5], xd2[5], 1e-2);
+
+    // back to the start, a new motion once the previous one is over
+    std::vector<double> xd0 {1, 0, 0, 0, 0, 0};
+    ASSERT_TRUE(iCartesianControl->movw(xd0));
+    ASSERT_TRUE(iCartesianControl->wait(5.0));
+    ASSERT_TRUE(iCartesianControl->stat(x));
+    ASSERT_NEAR(x[0], 1, 1e-2);
+    ASSERT_NEAR(x[1], 0, 1e-2);
+    ASSERT_NEAR(x[5], 0, 1e-2);
+}
+
+TEST_F( BasicCartesianControlTest, BasicCartesianControlParameterRanges)
+{
+    // behaviour is covered by testBasicCartesianControlTrajectories, only check defaults and validation here
+    struct Case { int vocab; double initial, valid, invalid; };
+
+    const Case cases[] = {
+        {VOCAB_CC_CONFIG_TIME_OPTIMAL, 0.0, 0.8, 1.5},
+        {VOCAB_CC_CONFIG_TIME_OPTIMAL, 0.0, 0.8, -0.1},
+        {VOCAB_CC_CONFIG_MOVJ_DIRECT, 0.0, 1.0, 0.5},
+        {VOCAB_CC_CONFIG_MOVL_DIRECT, 0.0, 1.0, 0.5},
+        {VOCAB_CC_CONFIG_STREAM_INTERPOLATION, 0.0, 1.0, 0.5},
+        {VOCAB_CC_CONFIG_STREAM_EXTRAPOLATION, 0.1, 0.05, -1.0},
+        {VOCAB_CC_CONFIG_STREAM_TIMEOUT, 0.5, 1.0, -1.0}
+    };
+
+    for (const auto & c : cases)
+    {
+        double value;
+        ASSERT_TRUE(iCartesianControl->getParameter(c.vocab, &value));
+        ASSERT_EQ(value, c.initial);
+
+        ASSERT_FALSE(iCartesianControl->setParameter(c.vocab, c.invalid));
+        ASSERT_TRUE(iCartesianControl->setParameter(c.vocab, c.valid));
+        ASSERT_TRUE(iCartesianControl->getParameter(c.vocab, &value));
+        ASSERT_EQ(value, c.valid);
+
+        ASSERT_TRUE(iCartesianControl->setParameter(c.vocab, c.initial));
+    }
+}
+
+TEST_F( BasicCartesianControlTest, BasicCartesianControlMoviStreamLimits)
+{
+    ASSERT_TRUE(iCartesianControl->setParameter(VOCAB_CC_CONFIG_STREAMING_CMD, VOCAB_CC_MOVI));
+    ASSERT_TRUE(iCartesianControl->setParameter(VOCAB_CC_CONFIG_STREAM_INTERPOLATION, 1.0));
+    ASSERT_TRUE(iCartesianControl->setParameter(VOCAB_CC_CONFIG_STREAM_EXTRAPOLATION, 0.1));
+
+    auto target = [](double deg) -> std::vector<double>
+    {
+        const double q = deg * M_PI / 180.0;
+        return {std::cos(q), std::sin(q), 0, 0, 0, q};
+    };
+
+    // fast approach to the upper limit (100 deg), extrapolating at this rate would overshoot it by far
+    iCartesianControl->movi(target(90.0));
+    yarp::os::Time::delay(0.02);
+    iCartesianControl->movi(target(99.0));
+    yarp::os::Time::delay(0.3);
+
+    std::vector<double> x;
+    ASSERT_TRUE(iCartesianControl->stat(x));
+    ASSERT_GT(x[5], 98.0 * M_PI / 180.0);
+    ASSERT_LE(x[5], 100.0 * M_PI / 180.0 + 1e-9);
+
+    ASSERT_TRUE(iCartesianControl->stopControl());
+}
+
 }  // namespace roboticslab
@@ -0,0 +1,829 @@
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <kdl/frames.hpp>
+#include <kdl/path_line.hpp>
+#include <kdl/rotational_interpolation_sa.hpp>
+#include <kdl/trajectory_segment.hpp>
+#include <kdl/velocityprofile_trap.hpp>
+
+#include "JointPathSolver.hpp"
+#include "JointTrajectory.hpp"
+#include "KdlVectorConverter.hpp"
+#include "StreamInterpolator.hpp"
+#include "TimeOptimalProfile.hpp"
+#include "TwistTrajectory.hpp"
+#include "WaypointTrajectory.hpp"
+
+namespace roboticslab
+{
+
+/**
+ * @brief Toy single-joint solver with periodic solutions.
+ *
+ * The joint angle is 100 times the x coordinate of the target, modulo 360
+ * degrees: the solution closest to the initial guess is picked, as an
+ * iterative solver would do. Targets beyond @ref reach are unreachable.
+ */
+class PeriodicSolver : public ICartesianSolver
+{
+public:
+    int getNumJoints() override { return 1; }
+    int getNumTcps() override { return 1; }
+    bool appendLink(const std::vector<double> & x) override { return false; }
+    bool restoreOriginalChain() override { return false; }
+    bool changeOrigin(const std::vector<double> & x_old_obj, const std::vector<double> & x_new_old, std::vector<double> & x_new_obj) override { return false; }
+    bool fwdKin(const std::vector<double> & q, std::vector<double> & x) override { return false; }
+    bool poseDiff(const std::vector<double> & xLhs, const std::vector<double> & xRhs, std::vector<double> & xOut) override { return false; }
+    bool diffInvKin(const std::vector<double> & q, const std::vector<double> & xdot, std::vector<double> & qdot, const reference_frame frame) override { return false; }
+    bool invDyn(const std::vector<double> & q, std::vector<double> & t) override { return false; }
+    bool invDyn(const std::vector<double> & q, const std::vector<double> & qdot, const std::vector<double> & qdotdot,
+                const std::vector<std::vector<double>> & fexts, std::vector<double> & t) override { return false; }
+
+    bool invKin(const std::vector<double> & xd, const std::vector<double> & qGuess, std::vector<double> & q, const reference_frame frame) override
+    {
+        if (xd[0] > reach)
+        {
+            return false;
+        }
+
+        const double angle = std::remainder(100.0 * xd[0], 360.0);
+        q = {angle + 360.0 * std::round((qGuess[0] - angle) / 360.0)};
+        return true;
+    }
+
+    double reach {1e9};
+};
+
+/**
+ * @ingroup kinematics-dynamics-tests
+ * @brief Tests the trajectory generators that back \ref BasicCartesianControl.
+ */
+class BasicCartesianControlTrajectoriesTest : public testing::Test
+{
+public:
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+
+    //! Translational speed of the first TCP.
+    static double speed(const std::vector<double> & xdot)
+    {
+        return std::sqrt(xdot[0] * xdot[0] + xdot[1] * xdot[1] + xdot[2] * xdot[2]);
+    }
+
+    //! Trapezoidal-profiled straight motion between two frames.
+    static KDL::Trajectory * makeSegment(const KDL::Frame & start, const KDL::Frame & end, double duration)
+    {
+        auto * interpolator = new KDL::RotationalInterpolation_SingleAxis();
+        auto * path = new KDL::Path_Line(start, end, interpolator, 1.0);
+        auto * profile = new KDL::VelocityProfile_Trap(10.0, 10.0);
+        return new KDL::Trajectory_Segment(path, profile, duration);
+    }
+
+    //! Tabulated straight line along the x axis.
+    static void makeLine(double length, double duration, double step, SampledTrajectory & trajectory)
+    {
+        std::vector<std::unique_ptr<KDL::Trajectory>> trajectories;
+        trajectories.emplace_back(makeSegment(KDL::Frame::Identity(), KDL::Frame(KDL::Vector(length, 0, 0)), duration));
+        ASSERT_TRUE(trajectory.configure(trajectories, step));
+    }
+
+    //! Jerk-limited time law must be continuous up to the acceleration and respect all limits.
+    static void checkProfile(const JointTrajectory::Profile & profile, double maxVel, double maxAcc, double maxJerk)
+    {
+        const double h = 1e-6;
+
+        ASSERT_EQ(profile.position(0.0), 0.0);
+        ASSERT_EQ(profile.position(profile.duration), 1.0);
+        ASSERT_LE(profile.peakVel, maxVel * (1 + 1e-9));
+        ASSERT_LE(profile.peakAcc, maxAcc * (1 + 1e-9));
+        ASSERT_LE(profile.jerk, maxJerk * (1 + 1e-9));
+
+        // covers the unit distance with the peak velocity held during the cruise phase
+        ASSERT_NEAR(profile.peakVel * (profile.rampTime + profile.cruiseTime), 1.0, 1e-9);
+
+        const double ramp = profile.rampTime, jerkTime = profile.jerkTime, cruise = profile.cruiseTime;
+
+        const double boundaries[] = {
+            0.0, jerkTime, ramp - jerkTime, ramp, ramp + cruise,
+            ramp + cruise + jerkTime, 2 * ramp + cruise - jerkTime, profile.duration
+        };
+
+        for (double t : boundaries)
+        {
+            // one-sided difference quotients meet
+            const double left = (profile.position(t) - profile.position(t - h)) / h;
+            const double right = (profile.position(t + h) - profile.position(t)) / h;
+
+            ASSERT_NEAR(profile.position(t + h), profile.position(t - h), 2 * h * profile.peakVel * (1 + 1e-6));
+            ASSERT_NEAR(left, right, 2 * h * profile.peakAcc * (1 + 1e-3));
+        }
+
+        // bounded third differences over the whole profile, including the rest before and after
+        const double dt = 1e-3;
+        const int n = profile.duration / dt + 4;
+        std::vector<double> s(n);
+
+        for (int k = 0; k < n; k++)
+        {
+            s[k] = profile.position((k - 2) * dt);
+        }
+
+        for (int k = 3; k < n; k++)
+        {
+            const double vel = (s[k] - s[k - 1]) / dt;
+            const double acc = (s[k] - 2 * s[k - 1] + s[k - 2]) / (dt * dt);
+            const double jerk = (s[k] - 3 * s[k - 1] + 3 * s[k - 2] - s[k - 3]) / (dt * dt * dt);
+
+            ASSERT_GE(vel, -1e-9);
+            ASSERT_LE(vel, maxVel * (1 + 1e-6));
+            ASSERT_LE(std::abs(acc), maxAcc * (1 + 1e-3) + 1e-6);
+            ASSERT_LE(std::abs(jerk), maxJerk * (1 + 1e-3) + 1e-3);
+        }
+    }
+};
+
+TEST_F(BasicCartesianControlTrajectoriesTest, TwistTrajectoryConstantTwist)
+{
+    const KDL::Frame H_start(KDL::Rotation::RPY(0.1, -0.2, 0.3), KDL::Vector(0.5, -0.1, 0.2));
+    const KDL::Twist twist(KDL::Vector(0.01, 0.02, -0.03), KDL::Vector(0.0, 0.1, 0.05));
+
+    TwistTrajectory trajectory;
+    ASSERT_TRUE(trajectory.configure(KdlVectorConverter::frameToVector(H_start), KdlVectorConverter::twistToVector(twist), 1.0));
+    ASSERT_EQ(trajectory.getNumTcps(), 1);
+
+    // path length is dominated by the rotation, 1 rad at ~0.1118 rad/s
+    const double duration = 1.0 / twist.rot.Norm();
+
+    std::vector<double> x(6), xdot(6);
+
+    for (double t : {0.0, 0.5, 2.0, 5.0, duration - 1e-3})
+    {
+        trajectory.evaluate(t, x.data(), xdot.data());
+
+        KDL::Frame H_expected(KDL::Rotation::Rot(twist.rot, twist.rot.Norm() * t) * H_start.M, H_start.p + twist.vel * t);
+        ASSERT_TRUE(KDL::Equal(KdlVectorConverter::vectorToFrame(x), H_expected, 1e-9));
+        ASSERT_TRUE(KDL::Equal(KdlVectorConverter::vectorToTwist(xdot), twist, 1e-12));
+    }
+
+    // final pose is held with null twist
+    std::vector<double> xEnd(6);
+    trajectory.evaluate(duration, xEnd.data(), xdot.data());
+
+    for (double t : {duration + 1.0, 1e9})
+    {
+        trajectory.evaluate(t, x.data(), xdot.data());
+        ASSERT_TRUE(KDL::Equal(KdlVectorConverter::vectorToFrame(x), KdlVectorConverter::vectorToFrame(xEnd), 1e-12));
+        ASSERT_TRUE(KDL::Equal(KdlVectorConverter::vectorToTwist(xdot), KDL::Twist::Zero(), 1e-12));
+    }
+}
+
+TEST_F(BasicCartesianControlTrajectoriesTest, TwistTrajectoryNullTwist)
+{
+    // two TCPs, only the second one moves
+    const std::vector<double> x_start {0.5, 0.0, 0.2, 0.0, 0.3, 0.0,   -0.5, 0.0, 0.2, 0.0, 0.0, 0.4};
+    const std::vector<double> xdot {0.0, 0.0, 0.0, 0.0, 0.0, 0.0,   0.1, 0.0, 0.0, 0.0, 0.0, 0.0};
+
+    TwistTrajectory trajectory;
+    ASSERT_TRUE(trajectory.configure(x_start, xdot, 10.0));
+    ASSERT_EQ(trajectory.getNumTcps(), 2);
+
+    std::vector<double> x(12), xdotOut(12);
+
+    for (double t : {0.0, 1.0, 50.0, 1e9})
+    {
+        trajectory.evaluate(t, x.data(), xdotOut.data());
+
+        for (int i = 0; i < 6; i++)
+        {
+            ASSERT_NEAR(x[i], x_start[i], 1e-12);
+            ASSERT_EQ(xdotOut[i], 0.0);
+        }
+
+        // 10 m at 0.1 m/s
+        ASSERT_NEAR(x[6], -0.5 + 0.1 * std::min(t, 100.0), 1e-9);
+        ASSERT_NEAR(xdotOut[6], t < 100.0 ? 0.1 : 0.0, 1e-12);
+        ASSERT_TRUE(std::isfinite(x[6]));
+    }
+}
+
+TEST_F(BasicCartesianControlTrajectoriesTest, TwistTrajectoryInvalid)
+{
+    TwistTrajectory trajectory;
+    ASSERT_FALSE(trajectory.configure({}, {}, 1.0));
+    ASSERT_FALSE(trajectory.configure(std::vector<double>(12), std::vector<double>(6), 1.0));
+    ASSERT_FALSE(trajectory.configure(std::vector<double>(5), std::vector<double>(5), 1.0));
+    ASSERT_FALSE(trajectory.configure(std::vector<double>(6), std::vector<double>(6), 0.0));
+    ASSERT_EQ(trajectory.getNumTcps(), 0);
+}
+
+TEST_F(BasicCartesianControlTrajectoriesTest, WaypointTrajectoryReachesWaypoints)
+{
+    const std::vector<std::vector<double>> targets {
+        {1.0, 0.0, 0.0, 0.0, 0.0, 0.5},
+        {1.0, 1.0, 0.0, 0.0, 0.0, 1.0},
+        {0.0, 1.0, 0.5, 0.3, 0.0, 0.0}
+    };
+
+    WaypointTrajectory trajectory;
+    trajectory.reset(std::vector<double>(6, 0.0));
+
+    // no blending, one segment per second
+    for (const auto & xd : targets)
+    {
+        ASSERT_TRUE(trajectory.append(xd, 0.0, 1.0, 0.0));
+    }
+
+    std::vector<double> x(6), xdot(6), last;
+    trajectory.getLastWaypoint(last);
+
+    for (int i = 0; i < 6; i++)
+    {
+        ASSERT_NEAR(last[i], targets.back()[i], 1e-12);
+    }
+
+    for (unsigned int k = 0; k < targets.size(); k++)
+    {
+        // each segment ends at rest on its waypoint
+        trajectory.evaluate(k + 1.0 - 1e-9, x.data(), xdot.data());
+        ASSERT_TRUE(KDL::Equal(KdlVectorConverter::vectorToFrame(x), KdlVectorConverter::vectorToFrame(targets[k]), 1e-6));
+        ASSERT_LT(speed(xdot), 1e-6);
+    }
+
+    ASSERT_FALSE(trajectory.evaluate(targets.size(), x.data(), xdot.data()));
+    ASSERT_TRUE(KDL::Equal(KdlVectorConverter::vectorToFrame(x), KdlVectorConverter::vectorToFrame(targets.back()), 1e-12));
+    ASSERT_TRUE(KDL::Equal(KdlVectorConverter::vectorToTwist(xdot), KDL::Twist::Zero(), 1e-12));
+}
+
+TEST_F(BasicCartesianControlTrajectoriesTest, WaypointTrajectoryBlending)
+{
+    // right angle corner at (1, 0, 0)
+    const std::vector<double> corner {1.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    const std::vector<double> target {1.0, 1.0, 0.0, 0.0, 0.0, 0.0};
+    const double radius = 0.1, dt = 1e-3;
+
+    WaypointTrajectory trajectory;
+    trajectory.reset(std::vector<double>(6, 0.0));
+    ASSERT_TRUE(trajectory.append(corner, 0.0, 1.0, radius));
+    ASSERT_TRUE(trajectory.append(target, 0.0, 1.0, radius));
+
+    std::vector<double> x(6), xdot(6);
+    double t = dt, minDistance = 1.0;
+
+    while (trajectory.evaluate(t, x.data(), xdot.data()))
+    {
+        // never stops on the way, shortcuts the corner
+        ASSERT_GT(speed(xdot), 0.0);
+        minDistance = std::min(minDistance, std::hypot(x[0] - 1.0, x[1]));
+        t += dt;
+    }
+
+    // shorter than two segments in a row
+    ASSERT_LT(t, 2.0);
+    ASSERT_GT(minDistance, 1e-3);
+    ASSERT_LT(minDistance, radius);
+
+    // ends on the last waypoint regardless
+    for (int i = 0; i < 6; i++)
+    {
+        ASSERT_NEAR(x[i], target[i], 1e-12);
+    }
+
+    // same path without blending stops at the corner
+    trajectory.reset(std::vector<double>(6, 0.0));
+    ASSERT_TRUE(trajectory.append(corner, 0.0, 1.0, 0.0));
+    ASSERT_TRUE(trajectory.append(target, 0.0, 1.0, 0.0));
+    ASSERT_TRUE(trajectory.evaluate(1.0, x.data(), xdot.data()));
+    ASSERT_EQ(speed(xdot), 0.0);
+}
+
+TEST_F(BasicCartesianControlTrajectoriesTest, WaypointTrajectoryRejectsAppend)
+{
+    const std::vector<double> xd {0.1, 0.0, 0.0, 0.0, 0.0, 0.0};
+    std::vector<double> x(6), xdot(6);
+
+    // closed until the first reset
+    WaypointTrajectory trajectory;
+    ASSERT_TRUE(trajectory.isClosed());
+    ASSERT_FALSE(trajectory.append(xd, 0.0, 1.0, 0.0));
+
+    trajectory.reset(std::vector<double>(6, 0.0));
+    ASSERT_FALSE(trajectory.isClosed());
+
+    // wrong size, no duration
+    ASSERT_FALSE(trajectory.append(std::vector<double>(12, 0.0), 0.0, 1.0, 0.0));
+    ASSERT_FALSE(trajectory.append(xd, 0.0, 0.0, 0.0));
+
+    // full queue
+    for (int i = 0; i < WaypointTrajectory::CAPACITY; i++)
+    {
+        ASSERT_TRUE(trajectory.append(xd, 0.0, 1.0, 0.0));
+    }
+
+    ASSERT_FALSE(trajectory.append(xd, 0.0, 1.0, 0.0));
+
+    // room again once the first segment is done
+    ASSERT_TRUE(trajectory.evaluate(1.5, x.data(), xdot.data()));
+    ASSERT_TRUE(trajectory.append(xd, 1.5, 1.0, 0.0));
+    ASSERT_FALSE(trajectory.append(xd, 1.5, 1.0, 0.0));
+
+    // closed once the last segment is over
+    ASSERT_FALSE(trajectory.evaluate(100.0, x.data(), xdot.data()));
+    ASSERT_TRUE(trajectory.isClosed());
+    ASSERT_FALSE(trajectory.append(xd, 100.0, 1.0, 0.0));
+
+    trajectory.reset(std::vector<double>(6, 0.0));
+    ASSERT_TRUE(trajectory.append(xd, 0.0, 1.0, 0.0));
+}
+
+TEST_F(BasicCartesianControlTrajectoriesTest, TimeOptimalProfileStraightLine)
+{
+    // single joint moving proportionally to the path parameter: q(s) = distance * s
+    const double maxVel = 20.0, maxAcc = 40.0;
+    const int numPoints = 1001;
+    const double dt = 1e-4;
+
+    // reaches the velocity limit and cruises, then a shorter triangular one
+    for (double distance : {90.0, 5.0})
+    {
+        const std::vector<std::vector<double>> dq(numPoints, {distance});
+        const std::vector<std::vector<double>> ddq(numPoints, {0.0});
+
+        TimeOptimalProfile profile;
+        ASSERT_TRUE(profile.configure(dq, ddq, {0.0}, {maxVel}, {maxAcc}));
+
+        const double expected = distance >= maxVel * maxVel / maxAcc
+                              ? distance / maxVel + maxVel / maxAcc
+                              : 2.0 * std::sqrt(distance / maxAcc);
+
+        // the switch to cruise and to braking falls on the grid
+        ASSERT_NEAR(profile.Duration(), expected, 2.0 * expected / (numPoints - 1));
+        ASSERT_GE(profile.Duration(), expected * (1 - 1e-9));
+
+        ASSERT_EQ(profile.Pos(0.0), 0.0);
+        ASSERT_EQ(profile.Pos(profile.Duration()), 1.0);
+        ASSERT_EQ(profile.Vel(profile.Duration()), 0.0);
+
+        for (double t = 0.0; t <= profile.Duration(); t += dt)
+        {
+            // joint velocity q' * sdot, joint acceleration q' * sddot + q'' * sdot^2
+            ASSERT_LE(std::abs(distance * profile.Vel(t)), maxVel * (1 + 1e-9));
+            ASSERT_LE(std::abs(distance * profile.Acc(t)), maxAcc * (1 + 1e-9));
+            ASSERT_GE(profile.Vel(t), 0.0);
+        }
+
+        // stretched in time, maps onto the actual path length
+        TimeOptimalProfile stretched(profile);
+        stretched.SetProfileDuration(0.5, 2.5, 2.0 * profile.Duration());
+        ASSERT_NEAR(stretched.Duration(), 2.0 * profile.Duration(), 1e-12);
+        ASSERT_NEAR(stretched.Pos(stretched.Duration()), 2.5, 1e-12);
+        ASSERT_NEAR(stretched.Pos(0.5 * stretched.Duration()), 0.5 + 2.0 * profile.Pos(0.5 * profile.Duration()) , 1e-12);
+    }
+
+    // negative direction uses the lower limit, or the upper one if the lower one is null
+    const std::vector<std::vector<double>> dq(numPoints, {-90.0});
+    const std::vector<std::vector<double>> ddq(numPoints, {0.0});
+
+    TimeOptimalProfile profile;
+    ASSERT_TRUE(profile.configure(dq, ddq, {-10.0}, {maxVel}, {maxAcc}));
+    ASSERT_GE(profile.Duration(), 90.0 / 10.0);
+    ASSERT_TRUE(profile.configure(dq, ddq, {0.0}, {maxVel}, {maxAcc}));
+    ASSERT_GE(profile.Duration(), 90.0 / maxVel);
+    ASSERT_LT(profile.Duration(), 90.0 / 10.0);
+
+    // inconsistent limits
+    ASSERT_FALSE(profile.configure(dq, ddq, {0.0}, {0.0}, {maxAcc}));
+    ASSERT_FALSE(profile.configure(dq, ddq, {0.0}, {maxVel}, {}));
+}
+
+TEST_F(BasicCartesianControlTrajectoriesTest, JointTrajectoryProfileCruise)
+{
+    // velocity and acceleration limits are both reached
+    const double maxVel = 1.0, maxAcc = 4.0, maxJerk = 40.0;
+    JointTrajectory::Profile profile;
+    ASSERT_TRUE(profile.configure(maxVel, maxAcc, maxJerk));
+
+    ASSERT_GT(profile.cruiseTime, 0.0);
+    ASSERT_NEAR(profile.peakVel, maxVel, 1e-12);
+    ASSERT_NEAR(profile.peakAcc, maxAcc, 1e-12);
+    ASSERT_NEAR(profile.duration, 1.0 / maxVel + maxVel / maxAcc + maxAcc / maxJerk, 1e-12);
+    checkProfile(profile, maxVel, maxAcc, maxJerk);
+
+    // acceleration limit not reached before the velocity limit
+    ASSERT_TRUE(profile.configure(0.5, 4.0, 4.0));
+    ASSERT_GT(profile.cruiseTime, 0.0);
+    ASSERT_NEAR(profile.peakVel, 0.5, 1e-12);
+    ASSERT_LT(profile.peakAcc, 4.0);
+    ASSERT_NEAR(profile.duration, 1.0 / 0.5 + 2.0 * std::sqrt(0.5 / 4.0), 1e-12);
+    checkProfile(profile, 0.5, 4.0, 4.0);
+
+    ASSERT_FALSE(profile.configure(0.0, maxAcc, maxJerk));
+    ASSERT_FALSE(profile.configure(maxVel, maxAcc, -1.0));
+}
+
+TEST_F(BasicCartesianControlTrajectoriesTest, JointTrajectoryProfileNoCruise)
+{
+    JointTrajectory::Profile profile;
+
+    // acceleration-limited: constant acceleration phase, no cruise
+    ASSERT_TRUE(profile.configure(10.0, 4.0, 40.0));
+    ASSERT_EQ(profile.cruiseTime, 0.0);
+    ASSERT_NEAR(profile.peakAcc, 4.0, 1e-12);
+    ASSERT_GT(profile.rampTime, 2.0 * profile.jerkTime);
+    ASSERT_NEAR(profile.duration, 0.1 + std::sqrt(0.1 * 0.1 + 4.0 / 4.0), 1e-12);
+    checkProfile(profile, 10.0, 4.0, 40.0);
+
+    // jerk-limited: neither the velocity nor the acceleration limit is reached, D = 2 * J * tj^3
+    ASSERT_TRUE(profile.configure(10.0, 10.0, 1.0));
+    ASSERT_EQ(profile.cruiseTime, 0.0);
+    ASSERT_LT(profile.peakAcc, 10.0);
+    ASSERT_NEAR(profile.rampTime, 2.0 * profile.jerkTime, 1e-12);
+    ASSERT_NEAR(profile.duration, 4.0 * std::cbrt(0.5), 1e-12);
+    checkProfile(profile, 10.0, 10.0, 1.0);
+}
+
+TEST_F(BasicCartesianControlTrajectoriesTest, JointTrajectorySynchronized)
+{
+    const std::vector<double> q0 {10.0, -20.0, 0.0, 5.0};
+    const std::vector<double> qd {40.0, -30.0, 0.0, 65.0};
+    const std::vector<double> maxVel {20.0, 30.0, 1.0, 50.0};
+    const std::vector<double> maxAcc {40.0, 10.0, 1.0, 100.0};
+    const std::vector<double> maxJerk {200.0, 100.0, 1.0, 100.0};
+    const double dt = 1e-3;
+
+    JointTrajectory trajectory;
+    trajectory.reset(q0, maxVel, maxAcc, maxJerk);
+    ASSERT_TRUE(trajectory.append(qd, 0.0));
+
+    std::vector<double> q(4), previous(q0), velocity(4, 0.0);
+    double t = dt;
+
+    while (trajectory.evaluate(t, q.data()))
+    {
+        // same normalized progress for all moving joints, the idle one stays put
+        const double s = (q[0] - q0[0]) / (qd[0] - q0[0]);
+        ASSERT_NEAR((q[1] - q0[1]) / (qd[1] - q0[1]), s, 1e-12);
+        ASSERT_NEAR((q[3] - q0[3]) / (qd[3] - q0[3]), s, 1e-12);
+        ASSERT_EQ(q[2], q0[2]);
+
+        for (int joint = 0; joint < 4; joint++)
+        {
+            const double vel = (q[joint] - previous[joint]) / dt;
+            ASSERT_LE(std::abs(vel), maxVel[joint] * (1 + 1e-6));
+            ASSERT_LE(std::abs(vel - velocity[joint]), maxAcc[joint] * dt * (1 + 1e-3));
+            velocity[joint] = vel;
+        }
+
+        previous = q;
+        t += dt;
+    }
+
+    // everyone arrives at once
+    ASSERT_EQ(q, qd);
+    ASSERT_TRUE(trajectory.isClosed());
+
+    // each limit is set by the most constrained joint relative to its distance
+    JointTrajectory::Profile profile;
+    ASSERT_TRUE(profile.configure(20.0 / 30.0, 10.0 / 10.0, 100.0 / 60.0));
+    ASSERT_NEAR(t, profile.duration, 1.5 * dt);
+}
+
+TEST_F(BasicCartesianControlTrajectoriesTest, JointTrajectoryChain)
+{
+    const std::vector<double> limits {10.0, 10.0};
+    const std::vector<double> q0 {0.0, 0.0}, qd1 {10.0, -5.0}, qd2 {10.0, 5.0};
+
+    JointTrajectory trajectory;
+    ASSERT_FALSE(trajectory.append(qd1, 0.0)); // closed until the first reset
+
+    trajectory.reset(q0, limits, limits, limits);
+    ASSERT_TRUE(trajectory.append(qd1, 0.0));
+    ASSERT_TRUE(trajectory.append(qd2, 0.0));
+    ASSERT_FALSE(trajectory.append({1.0, 2.0, 3.0}, 0.0));
+
+    std::vector<double> last;
+    trajectory.getLastTarget(last);
+    ASSERT_EQ(last, qd2);
+
+    JointTrajectory::Profile first, second;
+    ASSERT_TRUE(first.configure(10.0 / 10.0, 10.0 / 10.0, 10.0 / 10.0));
+    ASSERT_TRUE(second.configure(10.0 / 10.0, 10.0 / 10.0, 10.0 / 10.0));
+
+    std::vector<double> q(2);
+
+    // halfway through the first segment, the second one has not started
+    ASSERT_TRUE(trajectory.evaluate(0.5 * first.duration, q.data()));
+    ASSERT_NEAR(q[0], 5.0, 1e-9);
+    ASSERT_NEAR(q[1], -2.5, 1e-9);
+
+    // second segment starts where and when the first one ends, at rest
+    ASSERT_TRUE(trajectory.evaluate(first.duration, q.data()));
+    ASSERT_EQ(q, qd1);
+    ASSERT_TRUE(trajectory.evaluate(first.duration + 1e-3, q.data()));
+    ASSERT_EQ(q[0], qd1[0]);
+    ASSERT_NEAR(q[1], qd1[1], 10.0 * 1e-9);
+
+    ASSERT_TRUE(trajectory.evaluate(first.duration + 0.5 * second.duration, q.data()));
+    ASSERT_NEAR(q[1], 0.0, 1e-9);
+
+    ASSERT_FALSE(trajectory.evaluate(first.duration + second.duration, q.data()));
+    ASSERT_EQ(q, qd2);
+    ASSERT_FALSE(trajectory.append(qd1, 100.0));
+
+    // queue capacity
+    trajectory.reset(q0, limits, limits, limits);
+
+    for (int i = 0; i < JointTrajectory::CAPACITY; i++)
+    {
+        ASSERT_TRUE(trajectory.append({i + 1.0, 0.0}, 0.0));
+    }
+
+    ASSERT_FALSE(trajectory.append(qd1, 0.0));
+}
+
+TEST_F(BasicCartesianControlTrajectoriesTest, JointPathSolverParallel)
+{
+    // two and a half turns, each chunk spans well over half a turn
+    SampledTrajectory trajectory;
+    makeLine(9.0, 9.0, 0.01, trajectory);
+    const int numSamples = trajectory.getNumSamples();
+
+    PeriodicSolver solvers[4];
+    const std::vector<double> q {0.0};
+
+    JointSpline sequential;
+    ASSERT_TRUE(sequential.configure(numSamples, 1, trajectory.getStep()));
+    ASSERT_EQ(solveJointPath(trajectory, {&solvers[0]}, q, sequential), -1);
+
+    // unwrapped, no jumps between solution branches
+    ASSERT_EQ(sequential.row(0)[0], 0.0);
+    ASSERT_NEAR(sequential.row(numSamples - 1)[0], 900.0, 1e-6);
+
+    for (int k = 1; k < numSamples; k++)
+    {
+        ASSERT_LT(std::abs(sequential.row(k)[0] - sequential.row(k - 1)[0]), 10.0);
+    }
+
+    for (int threads = 2; threads <= 4; threads++)
+    {
+        std::vector<ICartesianSolver *> pool;
+
+        for (int i = 0; i < threads; i++)
+        {
+            pool.push_back(&solvers[i]);
+        }
+
+        JointSpline parallel;
+        ASSERT_TRUE(parallel.configure(numSamples, 1, trajectory.getStep()));
+        ASSERT_EQ(solveJointPath(trajectory, pool, q, parallel), -1);
+
+        for (int k = 0; k < numSamples; k++)
+        {
+            ASSERT_EQ(parallel.row(k)[0], sequential.row(k)[0]);
+        }
+    }
+}
+
+TEST_F(BasicCartesianControlTrajectoriesTest, JointPathSolverUnreachable)
+{
+    SampledTrajectory trajectory;
+    makeLine(9.0, 9.0, 0.01, trajectory);
+
+    PeriodicSolver solvers[4];
+
+    for (auto & solver : solvers)
+    {
+        solver.reach = 6.0;
+    }
+
+    // same failing sample regardless of the number of threads
+    int expected = -1;
+
+    for (int k = 0; k < trajectory.getNumSamples() && expected == -1; k++)
+    {
+        if (trajectory.getPose(k)[0] > 6.0)
+        {
+            expected = k;
+        }
+    }
+
+    ASSERT_NE(expected, -1);
+
+    for (int threads = 1; threads <= 4; threads++)
+    {
+        std::vector<ICartesianSolver *> pool;
+
+        for (int i = 0; i < threads; i++)
+        {
+            pool.push_back(&solvers[i]);
+        }
+
+        JointSpline jointPath;
+        ASSERT_TRUE(jointPath.configure(trajectory.getNumSamples(), 1, trajectory.getStep()));
+        ASSERT_EQ(solveJointPath(trajectory, pool, {0.0}, jointPath), expected);
+    }
+}
+
+TEST_F(BasicCartesianControlTrajectoriesTest, SampledTrajectoryMatchesKdl)
+{
+    const KDL::Frame start(KDL::Rotation::RotX(0.1), KDL::Vector(0.1, 0.2, 0.3));
+    const KDL::Frame end(KDL::Rotation::RPY(0.3, -0.2, 0.5), KDL::Vector(0.4, -0.1, 0.5));
+    std::unique_ptr<KDL::Trajectory> reference(makeSegment(start, end, 2.0));
+
+    std::vector<std::unique_ptr<KDL::Trajectory>> trajectories;
+    trajectories.emplace_back(makeSegment(start, end, 2.0));
+
+    SampledTrajectory trajectory;
+    ASSERT_TRUE(trajectory.configure(trajectories, 0.01));
+    ASSERT_EQ(trajectory.getNumTcps(), 1);
+    ASSERT_EQ(trajectory.getNumSamples(), 201);
+    ASSERT_NEAR(trajectory.getStep(), 0.01, 1e-12);
+    ASSERT_EQ(trajectory.getDuration(), 2.0);
+
+    std::vector<double> x(6), xdot(6), xPrev(6), xdotPrev(6), xMid(6), xdotMid(6);
+
+    for (int k = 0; k < trajectory.getNumSamples() - 1; k++)
+    {
+        const double t = k * trajectory.getStep();
+
+        // at samples, the table reproduces the original trajectory
+        trajectory.evaluate(t, x.data(), xdot.data());
+        const auto expected = KdlVectorConverter::frameToVector(reference->Pos(t));
+        const auto expectedDot = KdlVectorConverter::twistToVector(reference->Vel(t));
+
+        for (int j = 0; j < 6; j++)
+        {
+            ASSERT_NEAR(x[j], expected[j], 1e-9);
+            ASSERT_NEAR(xdot[j], expectedDot[j], 1e-9);
+        }
+
+        // between samples, linear interpolation that stays close to it
+        trajectory.evaluate(t + 0.5 * trajectory.getStep(), xMid.data(), xdotMid.data());
+        trajectory.evaluate(t + trajectory.getStep(), xPrev.data(), xdotPrev.data());
+        const auto between = KdlVectorConverter::frameToVector(reference->Pos(t + 0.5 * trajectory.getStep()));
+
+        for (int j = 0; j < 6; j++)
+        {
+            ASSERT_NEAR(xMid[j], 0.5 * (x[j] + xPrev[j]), 1e-9);
+            ASSERT_NEAR(xdotMid[j], 0.5 * (xdot[j] + xdotPrev[j]), 1e-9);
+            ASSERT_NEAR(xMid[j], between[j], 1e-4);
+        }
+    }
+}
+
+TEST_F(BasicCartesianControlTrajectoriesTest, SampledTrajectoryUnwrapsRotation)
+{
+    // 170 to 190 degrees about +Z, i.e. 170 degrees about -Z at the end
+    std::vector<std::unique_ptr<KDL::Trajectory>> trajectories;
+    trajectories.emplace_back(makeSegment(KDL::Frame(KDL::Rotation::RotZ(170 * KDL::deg2rad)),
+                                          KDL::Frame(KDL::Rotation::RotZ(190 * KDL::deg2rad)), 1.0));
+
+    SampledTrajectory trajectory;
+    ASSERT_TRUE(trajectory.configure(trajectories, 0.01));
+
+    // the rotation vector keeps growing along +Z past pi instead of flipping its axis
+    ASSERT_NEAR(trajectory.getPose(0)[5], 170 * KDL::deg2rad, 1e-9);
+    ASSERT_NEAR(trajectory.getPose(trajectory.getNumSamples() - 1)[5], 190 * KDL::deg2rad, 1e-9);
+
+    for (int k = 1; k < trajectory.getNumSamples(); k++)
+    {
+        ASSERT_GE(trajectory.getPose(k)[5], trajectory.getPose(k - 1)[5]);
+        ASSERT_LT(trajectory.getPose(k)[5] - trajectory.getPose(k - 1)[5], 1 * KDL::deg2rad);
+    }
+
+    // hence interpolation across pi is well-behaved
+    std::vector<double> x(6), xdot(6);
+
+    for (int k = 0; k < trajectory.getNumSamples() - 1; k++)
+    {
+        trajectory.evaluate((k + 0.5) * trajectory.getStep(), x.data(), xdot.data());
+        ASSERT_GT(x[5], trajectory.getPose(k)[5] - 1e-12);
+        ASSERT_LT(x[5], trajectory.getPose(k + 1)[5] + 1e-12);
+    }
+}
+
+TEST_F(BasicCartesianControlTrajectoriesTest, SampledTrajectoryHoldsFinalPose)
+{
+    SampledTrajectory trajectory;
+    makeLine(1.0, 2.0, 0.01, trajectory);
+
+    const double * last = trajectory.getPose(trajectory.getNumSamples() - 1);
+    ASSERT_NEAR(last[0], 1.0, 1e-9);
+
+    std::vector<double> x(6), xdot(6);
+
+    for (double t : {2.0, 2.5, 100.0})
+    {
+        trajectory.evaluate(t, x.data(), xdot.data());
+
+        for (int j = 0; j < 6; j++)
+        {
+            ASSERT_EQ(x[j], last[j]);
+            ASSERT_EQ(xdot[j], 0.0);
+        }
+    }
+
+    // before the start, the first pose
+    trajectory.evaluate(-1.0, x.data(), xdot.data());
+    ASSERT_EQ(x[0], 0.0);
+}
+
+TEST_F(BasicCartesianControlTrajectoriesTest, SampledTrajectoryDecimation)
+{
+    // 100 seconds at 1 ms exceed the table size, the grid is widened
+    SampledTrajectory trajectory;
+    makeLine(1.0, 100.0, 0.001, trajectory);
+
+    const int maxSamples = 65536;
+    ASSERT_EQ(trajectory.getNumSamples(), maxSamples);
+    ASSERT_NEAR(trajectory.getStep(), 100.0 / (maxSamples - 1), 1e-12);
+    ASSERT_GT(trajectory.getStep(), 0.001);
+
+    // still spans the whole movement
+    ASSERT_EQ(trajectory.getDuration(), 100.0);
+    ASSERT_NEAR(trajectory.getPose(maxSamples - 1)[0], 1.0, 1e-9);
+
+    std::vector<double> x(6), xdot(6);
+    trajectory.evaluate(50.0, x.data(), xdot.data());
+    ASSERT_NEAR(x[0], 0.5, 1e-6);
+
+    // shorter movements are not decimated
+    makeLine(1.0, 10.0, 0.001, trajectory);
+    ASSERT_EQ(trajectory.getNumSamples(), 10001);
+    ASSERT_NEAR(trajectory.getStep(), 0.001, 1e-12);
+}
+
+TEST_F(BasicCartesianControlTrajectoriesTest, StreamInterpolatorWindsBack)
+{
+    StreamInterpolator stream;
+    stream.configure(1);
+    stream.setMaxExtrapolation(0.1);
+    stream.setMaxInterval(0.5);
+
+    double x, dx, xdot;
+    ASSERT_FALSE(stream.evaluate(0.0, &x, &dx, &xdot));
+
+    // first target, not assumed to be moving
+    stream.push({1.0}, {}, 0.0);
+    ASSERT_TRUE(stream.evaluate(0.05, &x, &dx, &xdot));
+    ASSERT_EQ(x, 1.0);
+    ASSERT_EQ(dx, 0.0);
+    ASSERT_EQ(xdot, 0.0);
+
+    // 0.2 units per 0.4 seconds, slower than the extrapolation window
+    stream.push({1.2}, {0.2}, 0.4);
+
+    // extrapolate
+    ASSERT_TRUE(stream.evaluate(0.45, &x, &dx, &xdot));
+    ASSERT_EQ(x, 1.2);
+    ASSERT_NEAR(dx, 0.025, 1e-9);
+    ASSERT_NEAR(xdot, 0.5, 1e-9);
+
+    // wind back to the latest target
+    ASSERT_TRUE(stream.evaluate(0.55, &x, &dx, &xdot));
+    ASSERT_NEAR(dx, 0.025, 1e-9);
+    ASSERT_NEAR(xdot, -0.5, 1e-9);
+
+    // hold it
+    ASSERT_TRUE(stream.evaluate(0.65, &x, &dx, &xdot));
+    ASSERT_EQ(dx, 0.0);
+    ASSERT_EQ(xdot, 0.0);
+
+    ASSERT_TRUE(stream.evaluate(10.0, &x, &dx, &xdot));
+    ASSERT_EQ(x, 1.2);
+    ASSERT_EQ(dx, 0.0);
+    ASSERT_EQ(xdot, 0.0);
+}
+
+TEST_F(BasicCartesianControlTrajectoriesTest, StreamInterpolatorPause)
+{
+    StreamInterpolator stream;
+    stream.configure(1);
+    stream.setMaxExtrapolation(0.1);
+    stream.setMaxInterval(0.5);
+
+    double x, dx, xdot;
+
+    // a stream resumed after a longer interval starts at rest
+    stream.push({0.0}, {}, 0.0);
+    stream.push({1.0}, {1.0}, 0.6);
+    ASSERT_TRUE(stream.evaluate(0.65, &x, &dx, &xdot));
+    ASSERT_EQ(x, 1.0);
+    ASSERT_EQ(dx, 0.0);
+    ASSERT_EQ(xdot, 0.0);
+
+    // reset drops the target
+    stream.reset();
+    ASSERT_FALSE(stream.evaluate(0.7, &x, &dx, &xdot));
+}
+
+}  // namespace roboticslab
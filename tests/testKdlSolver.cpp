@@ -127,5 +127,270 @@ TEST_F( KdlSolverTest, KdlSolverInvDyn3)
     ASSERT_NEAR(t[0], 5, 1e-9);  //-- T = F*d = 1kg * 10m/s^2 * 0.5m = 5 N*m
 }
 
+/**
+ * @ingroup kinematics-dynamics-tests
+ * @brief Tests \ref KdlSolver ikin on a simple mechanism with a tool frame (HN).
+ */
+class KdlSolverToolTest : public testing::Test
+{
+
+    public:
+        virtual void SetUp() {
+            //-- HN: tool 0.5 m further along the link, rotated 90 degrees about Z
+            yarp::os::Property solverOptions("(device KdlSolver) (numLinks 1) (link_0 (A 1)) (mins (-180)) (maxs (180))"
+                " (HN (0 -1 0 0.5  1 0 0 0  0 0 1 0  0 0 0 1))");
+
+            solverDevice.open(solverOptions);
+
+            if (!solverDevice.isValid())
+            {
+                yError() << "solverDevice not valid:" << solverOptions.find("device").asString();
+                return;
+            }
+
+            if (!solverDevice.view(iCartesianSolver))
+            {
+                yError() << "Could not view ICartesianSolver in" << solverOptions.find("device").asString();
+                return;
+            }
+        }
+
+        virtual void TearDown()
+        {
+            solverDevice.close();
+        }
+
+    protected:
+        yarp::dev::PolyDriver solverDevice;
+        roboticslab::ICartesianSolver *iCartesianSolver;
+};
+
+TEST_F( KdlSolverToolTest, KdlSolverToolFwdKin)
+{
+    std::vector<double> q(1),x;
+    q[0]=90.0;
+    iCartesianSolver->fwdKin(q,x);
+    ASSERT_NEAR(x[0], 0, 1e-9);
+    ASSERT_NEAR(x[1], 1.5, 1e-9);
+    ASSERT_NEAR(x[2], 0, 1e-9);
+    ASSERT_NEAR(x[3], 0, 1e-9);  //-- o(x)
+    ASSERT_NEAR(x[4], 0, 1e-9);  //-- o(y)
+    ASSERT_NEAR(std::abs(x[5]), M_PI, 1e-9);  //-- o(z): 90 (joint) + 90 (HN)
+}
+
+TEST_F( KdlSolverToolTest, KdlSolverToolInvKin)
+{
+    std::vector<double> xd(6),qGuess(1),q;
+    xd[0] = 0;  // x
+    xd[1] = -1.5;  // y
+    xd[2] = 0;  // z
+    xd[3] = 0;  // o(x)
+    xd[4] = 0;  // o(y)
+    xd[5] = 0;  // o(z): -90 (joint) + 90 (HN)
+    qGuess[0] = -80;
+    iCartesianSolver->invKin(xd,qGuess,q);
+    ASSERT_EQ(q.size(), 1 );
+    ASSERT_NEAR(q[0], -90, 1e-3);
+}
+
+/**
+ * @ingroup kinematics-dynamics-tests
+ * @brief Tests \ref KdlSolver hybrid ikin on a mechanism that is close to, but not exactly, solvable in closed form.
+ *
+ * Right arm of TEO with a few millimeters of spurious link lengths, as if taken from a calibrated model.
+ */
+class KdlSolverHybridTest : public testing::Test
+{
+
+    public:
+        virtual void SetUp() {
+            yarp::os::Property solverOptions("(device KdlSolver) (numLinks 6) (ikPos hybrid) (epsPos 1e-9)"
+                " (link_0 (A 0) (D 0) (alpha -90) (offset 0))"
+                " (link_1 (A 0.002) (D 0) (alpha -90) (offset -90))"
+                " (link_2 (A 0) (D -0.32901) (alpha -90) (offset -90))"
+                " (link_3 (A 0.001) (D 0) (alpha 90) (offset 0))"
+                " (link_4 (A 0) (D -0.215) (alpha -90) (offset 0))"
+                " (link_5 (A -0.09) (D 0.003) (alpha 0) (offset -90))"
+                " (mins (-180 -180 -180 -180 -180 -180)) (maxs (180 180 180 180 180 180))");
+
+            solverDevice.open(solverOptions);
+
+            if (!solverDevice.isValid())
+            {
+                yError() << "solverDevice not valid:" << solverOptions.find("device").asString();
+                return;
+            }
+
+            if (!solverDevice.view(iCartesianSolver))
+            {
+                yError() << "Could not view ICartesianSolver in" << solverOptions.find("device").asString();
+                return;
+            }
+        }
+
+        virtual void TearDown()
+        {
+            solverDevice.close();
+        }
+
+    protected:
+        yarp::dev::PolyDriver solverDevice;
+        roboticslab::ICartesianSolver *iCartesianSolver;
+};
+
+TEST_F( KdlSolverHybridTest, KdlSolverHybridRoundTrip)
+{
+    std::vector<double> qTarget {-20, 10, 30, 40, -30, 20};
+    std::vector<double> xd, x, q;
+
+    ASSERT_TRUE(iCartesianSolver->fwdKin(qTarget, xd));
+    ASSERT_TRUE(iCartesianSolver->invKin(xd, qTarget, q));
+    ASSERT_EQ(q.size(), 6);
+    ASSERT_TRUE(iCartesianSolver->fwdKin(q, x));
+
+    //-- the refined solution reaches the target on the actual chain, not only on the idealized one
+    for (int i = 0; i < 6; i++)
+    {
+        ASSERT_NEAR(x[i], xd[i], 1e-6);
+    }
+}
+
+TEST_F( KdlSolverHybridTest, KdlSolverHybridClosestBranch)
+{
+    std::vector<double> qTarget {-20, 10, 30, 40, -30, 20};
+    std::vector<double> xd, q;
+
+    ASSERT_TRUE(iCartesianSolver->fwdKin(qTarget, xd));
+
+    //-- guess a few degrees apart, the other branches (e.g. elbow up/down) are way farther
+    std::vector<double> qGuess {-25, 15, 25, 45, -35, 15};
+
+    ASSERT_TRUE(iCartesianSolver->invKin(xd, qGuess, q));
+    ASSERT_EQ(q.size(), 6);
+
+    for (int i = 0; i < 6; i++)
+    {
+        ASSERT_NEAR(q[i], qTarget[i], 1e-3);
+    }
+}
+
+/**
+ * @ingroup kinematics-dynamics-tests
+ * @brief Tests \ref KdlSolver closed-form ikin on a redundant (7-DOF) mechanism.
+ *
+ * Joints 0 and 1 are coaxial, joints 1 through 6 describe the right arm of TEO.
+ */
+class KdlSolverRedundantTest : public testing::Test
+{
+
+    public:
+        static bool openSolver(yarp::dev::PolyDriver & device, int lockedJoint, int threads)
+        {
+            yarp::os::Property solverOptions("(device KdlSolver) (numLinks 7) (ikPos redundant) (sweepSamples 7)"
+                " (link_0 (A 0) (D 0) (alpha 0) (offset 0))"
+                " (link_1 (A 0) (D 0) (alpha -90) (offset 0))"
+                " (link_2 (A 0) (D 0) (alpha -90) (offset -90))"
+                " (link_3 (A 0) (D -0.32901) (alpha -90) (offset -90))"
+                " (link_4 (A 0) (D 0) (alpha 90) (offset 0))"
+                " (link_5 (A 0) (D -0.215) (alpha -90) (offset 0))"
+                " (link_6 (A -0.09) (D 0) (alpha 0) (offset -90))"
+                " (mins (-180 -180 -180 -180 -180 -180 -180)) (maxs (180 180 180 180 180 180 180))");
+
+            solverOptions.put("lockedJoint", lockedJoint);
+            solverOptions.put("sweepThreads", threads);
+
+            return device.open(solverOptions);
+        }
+
+        static void checkRoundTrip(roboticslab::ICartesianSolver * iCartesianSolver, const std::vector<double> & qTarget,
+                                   const std::vector<double> & qGuess, std::vector<double> & q)
+        {
+            std::vector<double> xd, x;
+            ASSERT_TRUE(iCartesianSolver->fwdKin(qTarget, xd));
+            ASSERT_TRUE(iCartesianSolver->invKin(xd, qGuess, q));
+            ASSERT_EQ(q.size(), 7);
+            ASSERT_TRUE(iCartesianSolver->fwdKin(q, x));
+
+            for (int i = 0; i < 6; i++)
+            {
+                ASSERT_NEAR(x[i], xd[i], 1e-6);
+            }
+        }
+};
+
+TEST_F( KdlSolverRedundantTest, KdlSolverRedundantLockedAtEnd)
+{
+    yarp::dev::PolyDriver solverDevice;
+    roboticslab::ICartesianSolver * iCartesianSolver;
+
+    ASSERT_TRUE(openSolver(solverDevice, 0, 2));
+    ASSERT_TRUE(solverDevice.view(iCartesianSolver));
+
+    std::vector<double> qTarget {15, -20, 10, 30, 40, -30, 20};
+    std::vector<double> q;
+
+    //-- the current value of the locked joint is preferred
+    checkRoundTrip(iCartesianSolver, qTarget, qTarget, q);
+    ASSERT_NEAR(q[0], qTarget[0], 1e-6);
+}
+
+TEST_F( KdlSolverRedundantTest, KdlSolverRedundantLockedInBetween)
+{
+    yarp::dev::PolyDriver solverDevice;
+    roboticslab::ICartesianSolver * iCartesianSolver;
+
+    ASSERT_TRUE(openSolver(solverDevice, 1, 2));
+    ASSERT_TRUE(solverDevice.view(iCartesianSolver));
+
+    std::vector<double> qTarget {15, -20, 10, 30, 40, -30, 20};
+    std::vector<double> q;
+
+    checkRoundTrip(iCartesianSolver, qTarget, qTarget, q);
+
+    //-- only sampled values of the locked joint are allowed, i.e. -180, -120, ..., 180
+    ASSERT_NEAR(std::remainder(q[1], 60.0), 0.0, 1e-6);
+}
+
+TEST_F( KdlSolverRedundantTest, KdlSolverRedundantThreads)
+{
+    yarp::dev::PolyDriver serialDevice, parallelDevice;
+    roboticslab::ICartesianSolver * serialSolver;
+    roboticslab::ICartesianSolver * parallelSolver;
+
+    ASSERT_TRUE(openSolver(serialDevice, 1, 1));
+    ASSERT_TRUE(serialDevice.view(serialSolver));
+
+    ASSERT_TRUE(openSolver(parallelDevice, 1, 4));
+    ASSERT_TRUE(parallelDevice.view(parallelSolver));
+
+    std::vector<double> qTarget {15, -20, 10, 30, 40, -30, 20};
+    std::vector<double> qSerial(qTarget), qParallel(qTarget);
+
+    //-- same choices along a path, regardless of the number of threads and of previous choices
+    for (int n = 0; n < 20; n++)
+    {
+        std::vector<double> qPrevSerial(qSerial), qPrevParallel(qParallel);
+
+        for (int i = 0; i < 7; i++)
+        {
+            qTarget[i] += 1.0;
+        }
+
+        checkRoundTrip(serialSolver, qTarget, qPrevSerial, qSerial);
+        checkRoundTrip(parallelSolver, qTarget, qPrevParallel, qParallel);
+
+        for (int i = 0; i < 7; i++)
+        {
+            ASSERT_NEAR(qSerial[i], qParallel[i], 1e-9);
+        }
+
+        //-- the locked joint stays put, since the selector sticks to its first choice
+        if (n != 0)
+        {
+            ASSERT_NEAR(qSerial[1], qPrevSerial[1], 1e-9);
+        }
+    }
+}
+
 }  // namespace roboticslab
 
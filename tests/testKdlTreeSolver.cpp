@@ -0,0 +1,508 @@
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <kdl/frames.hpp>
+#include <kdl/jntarray.hpp>
+#include <kdl/joint.hpp>
+#include <kdl/rigidbodyinertia.hpp>
+#include <kdl/rotationalinertia.hpp>
+#include <kdl/segment.hpp>
+#include <kdl/tree.hpp>
+#include <kdl/treefksolverpos_recursive.hpp>
+#include <kdl/treeiksolver.hpp>
+
+#include "ConfigurationSelector.hpp"
+#include "TreeCentroidalSolver.hpp"
+#include "TreeIkSolverPos_ST.hpp"
+#include "TreeIkSolverPos_Subtrees.hpp"
+
+namespace roboticslab
+{
+
+/**
+ * @ingroup kinematics-dynamics-tests
+ * @brief Tests the solvers that back \ref KdlTreeSolver.
+ */
+class KdlTreeSolverTest : public testing::Test
+{
+public:
+    /**
+     * @brief Fake IK solver, counts calls and tells joint values apart.
+     *
+     * Each joint of the subtree is set to the X coordinate of the target of the
+     * first endpoint plus its local index.
+     */
+    class CountingIkSolver : public KDL::TreeIkSolverPos
+    {
+    public:
+        CountingIkSolver(int & calls, std::thread::id & threadId, double result)
+            : calls(calls), threadId(threadId), result(result)
+        {}
+
+        double CartToJnt(const KDL::JntArray & q_init, const KDL::Frames & p_in, KDL::JntArray & q_out) override
+        {
+            calls++;
+            threadId = std::this_thread::get_id();
+
+            for (int i = 0; i < q_out.rows(); i++)
+            {
+                q_out(i) = p_in.begin()->second.p.x() + i;
+            }
+
+            return result;
+        }
+
+    private:
+        int & calls;
+        std::thread::id & threadId;
+        double result;
+    };
+
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+
+    /**
+     * @brief Two 2-DOF arms and a 1-DOF head on a fixed (or revolute) torso.
+     *
+     * Joint ids: torso (if movable) first, then left arm, right arm and head.
+     */
+    static KDL::Tree makeTwoArmTree(bool movableTorso)
+    {
+        KDL::Tree tree("root");
+
+        tree.addSegment(KDL::Segment("torso", KDL::Joint(movableTorso ? KDL::Joint::RotZ : KDL::Joint::None),
+                                     KDL::Frame(KDL::Vector(0, 0, 0.5))), "root");
+
+        tree.addSegment(KDL::Segment("left_1", KDL::Joint(KDL::Joint::RotY), KDL::Frame(KDL::Vector(0, 0.2, 0))), "torso");
+        tree.addSegment(KDL::Segment("left_2", KDL::Joint(KDL::Joint::RotY), KDL::Frame(KDL::Vector(0.3, 0, 0))), "left_1");
+
+        tree.addSegment(KDL::Segment("right_1", KDL::Joint(KDL::Joint::RotY), KDL::Frame(KDL::Vector(0, -0.2, 0))), "torso");
+        tree.addSegment(KDL::Segment("right_2", KDL::Joint(KDL::Joint::RotY), KDL::Frame(KDL::Vector(0.3, 0, 0))), "right_1");
+
+        tree.addSegment(KDL::Segment("head", KDL::Joint(KDL::Joint::RotZ), KDL::Frame(KDL::Vector(0, 0, 0.2))), "torso");
+
+        return tree;
+    }
+
+    /**
+     * @brief Two 6-DOF TEO arms on a fixed (or revolute) torso.
+     *
+     * Joint ids: torso (if movable) first, then left arm and right arm.
+     */
+    static KDL::Tree makeTwoTeoArmTree(bool movableTorso)
+    {
+        const KDL::Joint rotZ(KDL::Joint::RotZ);
+        KDL::Tree tree("root");
+
+        tree.addSegment(KDL::Segment("torso", KDL::Joint(movableTorso ? KDL::Joint::RotZ : KDL::Joint::None),
+                                     KDL::Frame(KDL::Vector(0, 0, 0.5))), "root");
+
+        for (const std::string & side : {"left", "right"})
+        {
+            const double y = side == "left" ? 0.34692 : -0.34692;
+            std::string parent = "torso";
+
+            tree.addSegment(KDL::Segment(side + "_0", KDL::Joint(KDL::Joint::None), KDL::Frame(KDL::Vector(0, y, 0))), parent);
+            parent = side + "_0";
+
+            const KDL::Frame links[] = {
+                KDL::Frame::DH(    0, -KDL::PI / 2,        0,            0),
+                KDL::Frame::DH(    0, -KDL::PI / 2,        0, -KDL::PI / 2),
+                KDL::Frame::DH(    0, -KDL::PI / 2, -0.32901, -KDL::PI / 2),
+                KDL::Frame::DH(    0,  KDL::PI / 2,        0,            0),
+                KDL::Frame::DH(    0, -KDL::PI / 2,   -0.215,            0),
+                KDL::Frame::DH(-0.09,            0,        0, -KDL::PI / 2)
+            };
+
+            for (int i = 0; i < 6; i++)
+            {
+                const auto name = side + "_" + std::to_string(i + 1);
+                tree.addSegment(KDL::Segment(name, rotZ, links[i]), parent);
+                parent = name;
+            }
+        }
+
+        return tree;
+    }
+
+    /**
+     * @brief Small tree with mass on every segment, revolute, prismatic and fixed joints.
+     *
+     * Joint ids: base, left_1, left_2, right_1, right_2.
+     */
+    static KDL::Tree makeMassiveTree()
+    {
+        KDL::Tree tree("root");
+
+        tree.addSegment(KDL::Segment("base", KDL::Joint(KDL::Joint::RotZ), KDL::Frame(KDL::Vector(0, 0, 0.3)),
+                                     KDL::RigidBodyInertia(5.0, KDL::Vector(0, 0.02, 0.1), KDL::RotationalInertia(0.1, 0.1, 0.05))), "root");
+
+        tree.addSegment(KDL::Segment("left_1", KDL::Joint(KDL::Joint::RotY), KDL::Frame(KDL::Vector(0, 0.2, 0)),
+                                     KDL::RigidBodyInertia(1.5, KDL::Vector(0.1, 0, 0), KDL::RotationalInertia(0.01, 0.02, 0.02))), "base");
+        tree.addSegment(KDL::Segment("left_2", KDL::Joint(KDL::Joint::RotX), KDL::Frame(KDL::Rotation::RotZ(0.3), KDL::Vector(0.3, 0, 0)),
+                                     KDL::RigidBodyInertia(1.0, KDL::Vector(0.15, 0.01, 0), KDL::RotationalInertia(0.01, 0.01, 0.01))), "left_1");
+
+        tree.addSegment(KDL::Segment("right_1", KDL::Joint(KDL::Joint::RotY), KDL::Frame(KDL::Vector(0, -0.2, 0)),
+                                     KDL::RigidBodyInertia(1.2, KDL::Vector(0.1, 0, 0.02), KDL::RotationalInertia(0.01, 0.02, 0.02))), "base");
+        tree.addSegment(KDL::Segment("right_2", KDL::Joint(KDL::Joint::TransX), KDL::Frame(KDL::Vector(0.3, 0, 0)),
+                                     KDL::RigidBodyInertia(0.8, KDL::Vector(0.05, 0, -0.01), KDL::RotationalInertia(0.01, 0.01, 0.01))), "right_1");
+
+        tree.addSegment(KDL::Segment("sensor", KDL::Joint(KDL::Joint::None), KDL::Frame(KDL::Vector(0, 0, 0.25)),
+                                     KDL::RigidBodyInertia(0.3, KDL::Vector(0, 0, 0.02))), "base");
+
+        return tree;
+    }
+
+protected:
+    TreeIkSolverPos_Subtrees * createCountingSolver(const KDL::Tree & tree, bool split, double result = 0.0)
+    {
+        auto factory = [this, result](const KDL::Tree & subtree, const std::vector<std::string> & endpoints,
+                                      const std::vector<int> & joints, TreeIkSolverPos_Subtrees::Solvers & solvers)
+        {
+            const auto & key = endpoints[0];
+            calls[key] = 0;
+            solvers.ikSolverPos.reset(new CountingIkSolver(calls[key], threadIds[key], result));
+            return true;
+        };
+
+        return TreeIkSolverPos_Subtrees::create(tree, {"left_2", "right_2"}, factory, split);
+    }
+
+    // std::map nodes are stable, solvers keep references to them
+    std::map<std::string, int> calls;
+    std::map<std::string, std::thread::id> threadIds;
+};
+
+TEST_F(KdlTreeSolverTest, SubtreesSplit)
+{
+    std::unique_ptr<TreeIkSolverPos_Subtrees> solver;
+
+    solver.reset(createCountingSolver(makeTwoArmTree(false), true));
+    ASSERT_TRUE(solver);
+    ASSERT_EQ(solver->getNrOfSubtrees(), 2);
+
+    solver.reset(createCountingSolver(makeTwoArmTree(false), false));
+    ASSERT_TRUE(solver);
+    ASSERT_EQ(solver->getNrOfSubtrees(), 1);
+
+    // both arms depend on the torso joint
+    solver.reset(createCountingSolver(makeTwoArmTree(true), true));
+    ASSERT_TRUE(solver);
+    ASSERT_EQ(solver->getNrOfSubtrees(), 1);
+}
+
+TEST_F(KdlTreeSolverTest, SubtreesMerge)
+{
+    KDL::Tree tree = makeTwoArmTree(false);
+    std::unique_ptr<TreeIkSolverPos_Subtrees> solver(createCountingSolver(tree, true));
+    ASSERT_TRUE(solver);
+
+    KDL::JntArray q_init(tree.getNrOfJoints());
+    KDL::JntArray q_out(tree.getNrOfJoints());
+    q_init(4) = 0.5; // head
+
+    KDL::Frames p_in;
+    p_in["left_2"] = KDL::Frame(KDL::Vector(1.0, 0, 0));
+    p_in["right_2"] = KDL::Frame(KDL::Vector(2.0, 0, 0));
+
+    ASSERT_EQ(solver->CartToJnt(q_init, p_in, q_out), 0.0);
+
+    ASSERT_EQ(q_out(0), 1.0); // left arm
+    ASSERT_EQ(q_out(1), 2.0);
+    ASSERT_EQ(q_out(2), 2.0); // right arm
+    ASSERT_EQ(q_out(3), 3.0);
+    ASSERT_EQ(q_out(4), 0.5); // head, untouched
+
+    // a target is missing
+    p_in.erase("right_2");
+    ASSERT_LT(solver->CartToJnt(q_init, p_in, q_out), 0.0);
+}
+
+TEST_F(KdlTreeSolverTest, SubtreesCache)
+{
+    KDL::Tree tree = makeTwoArmTree(false);
+    std::unique_ptr<TreeIkSolverPos_Subtrees> solver(createCountingSolver(tree, true));
+    ASSERT_TRUE(solver);
+
+    KDL::JntArray q_init(tree.getNrOfJoints());
+    KDL::JntArray q_out(tree.getNrOfJoints());
+
+    KDL::Frames p_in;
+    p_in["left_2"] = KDL::Frame(KDL::Vector(1.0, 0, 0));
+    p_in["right_2"] = KDL::Frame(KDL::Vector(2.0, 0, 0));
+
+    ASSERT_EQ(solver->CartToJnt(q_init, p_in, q_out), 0.0);
+    ASSERT_EQ(calls["left_2"], 1);
+    ASSERT_EQ(calls["right_2"], 1);
+
+    // hit: same targets and initial joint values
+    KDL::JntArray q_out_cached(tree.getNrOfJoints());
+    ASSERT_EQ(solver->CartToJnt(q_init, p_in, q_out_cached), 0.0);
+    ASSERT_EQ(calls["left_2"], 1);
+    ASSERT_EQ(calls["right_2"], 1);
+    ASSERT_EQ(q_out_cached, q_out);
+
+    // miss: new target for the left arm only
+    p_in["left_2"] = KDL::Frame(KDL::Vector(1.5, 0, 0));
+    ASSERT_EQ(solver->CartToJnt(q_init, p_in, q_out), 0.0);
+    ASSERT_EQ(calls["left_2"], 2);
+    ASSERT_EQ(calls["right_2"], 1);
+    ASSERT_EQ(q_out(0), 1.5);
+    ASSERT_EQ(q_out(2), 2.0);
+
+    // miss: new initial values for the right arm only
+    q_init(3) = 0.1;
+    ASSERT_EQ(solver->CartToJnt(q_init, p_in, q_out), 0.0);
+    ASSERT_EQ(calls["left_2"], 2);
+    ASSERT_EQ(calls["right_2"], 2);
+
+    // a joint outside of every subtree does not invalidate anything
+    q_init(4) = 0.2;
+    ASSERT_EQ(solver->CartToJnt(q_init, p_in, q_out), 0.0);
+    ASSERT_EQ(calls["left_2"], 2);
+    ASSERT_EQ(calls["right_2"], 2);
+    ASSERT_EQ(q_out(4), 0.2);
+}
+
+TEST_F(KdlTreeSolverTest, SubtreesFailuresNotCached)
+{
+    KDL::Tree tree = makeTwoArmTree(false);
+    std::unique_ptr<TreeIkSolverPos_Subtrees> solver(createCountingSolver(tree, true, -1.0));
+    ASSERT_TRUE(solver);
+
+    KDL::JntArray q_init(tree.getNrOfJoints());
+    KDL::JntArray q_out(tree.getNrOfJoints());
+
+    KDL::Frames p_in;
+    p_in["left_2"] = KDL::Frame(KDL::Vector(1.0, 0, 0));
+    p_in["right_2"] = KDL::Frame(KDL::Vector(2.0, 0, 0));
+
+    ASSERT_EQ(solver->CartToJnt(q_init, p_in, q_out), -1.0);
+    ASSERT_EQ(solver->CartToJnt(q_init, p_in, q_out), -1.0);
+    ASSERT_EQ(calls["left_2"], 2);
+    ASSERT_EQ(calls["right_2"], 2);
+}
+
+TEST_F(KdlTreeSolverTest, SubtreesWorkerThreads)
+{
+    KDL::Tree tree = makeTwoArmTree(false);
+    std::unique_ptr<TreeIkSolverPos_Subtrees> solver(createCountingSolver(tree, true));
+    ASSERT_TRUE(solver);
+
+    KDL::JntArray q_init(tree.getNrOfJoints());
+    KDL::JntArray q_out(tree.getNrOfJoints());
+    KDL::Frames p_in;
+
+    std::thread::id workerId;
+
+    for (int n = 0; n < 1000; n++)
+    {
+        p_in["left_2"] = KDL::Frame(KDL::Vector(n, 0, 0));
+        p_in["right_2"] = KDL::Frame(KDL::Vector(-n, 0, 0));
+
+        ASSERT_EQ(solver->CartToJnt(q_init, p_in, q_out), 0.0);
+        ASSERT_EQ(q_out(0), n);
+        ASSERT_EQ(q_out(2), -n);
+
+        // the first subtree is solved by the caller, the other one always by the same worker thread
+        ASSERT_EQ(threadIds["left_2"], std::this_thread::get_id());
+        ASSERT_NE(threadIds["right_2"], std::this_thread::get_id());
+
+        if (n == 0)
+        {
+            workerId = threadIds["right_2"];
+        }
+
+        ASSERT_EQ(threadIds["right_2"], workerId);
+    }
+
+    ASSERT_EQ(calls["left_2"], 1000);
+    ASSERT_EQ(calls["right_2"], 1000);
+}
+
+TEST_F(KdlTreeSolverTest, SubtreesFind)
+{
+    using Groups = std::vector<std::vector<std::string>>;
+
+    KDL::Tree fixed = makeTwoArmTree(false);
+    ASSERT_EQ(TreeIkSolverPos_Subtrees::findSubtrees(fixed, {"left_2", "right_2"}), (Groups {{"left_2"}, {"right_2"}}));
+    ASSERT_EQ(TreeIkSolverPos_Subtrees::findSubtrees(fixed, {"left_2", "head", "left_1"}), (Groups {{"left_2", "left_1"}, {"head"}}));
+    ASSERT_TRUE(TreeIkSolverPos_Subtrees::findSubtrees(fixed, {"left_2", "unknown"}).empty());
+
+    // both arms depend on the torso joint, closed-form IK cannot handle this (see KdlTreeSolver)
+    KDL::Tree movable = makeTwoArmTree(true);
+    ASSERT_EQ(TreeIkSolverPos_Subtrees::findSubtrees(movable, {"left_2", "right_2"}), (Groups {{"left_2", "right_2"}}));
+}
+
+TEST_F(KdlTreeSolverTest, ClosedFormTwoArms)
+{
+    KDL::Tree tree = makeTwoTeoArmTree(false);
+    const std::vector<std::string> endpoints {"left_6", "right_6"};
+
+    auto groups = TreeIkSolverPos_Subtrees::findSubtrees(tree, endpoints);
+    ASSERT_EQ(groups.size(), 2);
+
+    auto factory = [](const KDL::Tree & subtree, const std::vector<std::string> & subEndpoints,
+                      const std::vector<int> & joints, TreeIkSolverPos_Subtrees::Solvers & solvers)
+    {
+        KDL::JntArray qMin(joints.size());
+        KDL::JntArray qMax(joints.size());
+
+        for (int i = 0; i < joints.size(); i++)
+        {
+            qMin(i) = -KDL::PI;
+            qMax(i) = KDL::PI;
+        }
+
+        ConfigurationSelectorLeastOverallAngularDisplacementFactory configFactory(qMin, qMax);
+        solvers.ikSolverPos.reset(TreeIkSolverPos_ST::create(subtree, subEndpoints[0], configFactory));
+        return solvers.ikSolverPos != nullptr;
+    };
+
+    std::unique_ptr<TreeIkSolverPos_Subtrees> solver(TreeIkSolverPos_Subtrees::create(tree, endpoints, factory, true));
+    ASSERT_TRUE(solver);
+    ASSERT_EQ(solver->getNrOfSubtrees(), 2);
+
+    KDL::TreeFkSolverPos_recursive fkSolver(tree);
+
+    for (int n = 0; n < 20; n++)
+    {
+        KDL::JntArray q(tree.getNrOfJoints());
+
+        for (int i = 0; i < q.rows(); i++)
+        {
+            q(i) = 1.2 * std::sin(0.9 * (n * q.rows() + i) + 0.4);
+        }
+
+        KDL::Frames p_in;
+
+        for (const auto & endpoint : endpoints)
+        {
+            ASSERT_GE(fkSolver.JntToCart(q, p_in[endpoint], endpoint), 0);
+        }
+
+        // least displaced solution from the target configuration and from the home position
+        for (const auto & q_init : {q, KDL::JntArray(tree.getNrOfJoints())})
+        {
+            KDL::JntArray q_out(tree.getNrOfJoints());
+            ASSERT_EQ(solver->CartToJnt(q_init, p_in, q_out), 0.0); // E_NOERROR
+
+            for (const auto & endpoint : endpoints)
+            {
+                KDL::Frame H;
+                ASSERT_GE(fkSolver.JntToCart(q_out, H, endpoint), 0);
+                ASSERT_TRUE(KDL::Equal(H, p_in[endpoint], 1e-6));
+            }
+        }
+    }
+}
+
+TEST_F(KdlTreeSolverTest, CentroidalCoM)
+{
+    KDL::Tree tree = makeMassiveTree();
+    TreeCentroidalSolver solver(tree);
+    ASSERT_NEAR(solver.getTotalMass(), 9.8, 1e-12);
+
+    KDL::TreeFkSolverPos_recursive fkSolver(tree);
+
+    KDL::JntArray q(tree.getNrOfJoints());
+    KDL::JntArray qdot(tree.getNrOfJoints());
+    Eigen::Matrix3Xd jac(3, tree.getNrOfJoints());
+    KDL::Wrench momentum;
+
+    for (int n = 0; n < 10; n++)
+    {
+        for (int i = 0; i < q.rows(); i++)
+        {
+            q(i) = std::sin(0.7 * (n * q.rows() + i) + 0.2);
+        }
+
+        // weighted sum of the CoM of each segment, placed by the FK solver
+        KDL::Vector expected = KDL::Vector::Zero();
+
+        for (const auto & segment : tree.getSegments())
+        {
+            const auto & inertia = KDL::GetTreeElementSegment(segment.second).getInertia();
+            KDL::Frame H;
+            ASSERT_GE(fkSolver.JntToCart(q, H, segment.first), 0);
+            expected += inertia.getMass() * (H * inertia.getCOG());
+        }
+
+        expected = expected / solver.getTotalMass();
+
+        KDL::Vector com;
+        ASSERT_EQ(solver.JntToCoM(q, com), 0.0); // E_NOERROR
+        ASSERT_TRUE(KDL::Equal(com, expected, 1e-12));
+
+        ASSERT_EQ(solver.JntToCentroidal(q, qdot, com, jac, momentum), 0.0);
+        ASSERT_TRUE(KDL::Equal(com, expected, 1e-12));
+    }
+
+    // wrong sizes
+    KDL::Vector com;
+    ASSERT_LT(solver.JntToCoM(KDL::JntArray(2), com), 0);
+}
+
+TEST_F(KdlTreeSolverTest, CentroidalJacobian)
+{
+    KDL::Tree tree = makeMassiveTree();
+    TreeCentroidalSolver solver(tree);
+
+    const int joints = tree.getNrOfJoints();
+    const double h = 1e-6;
+
+    KDL::JntArray q(joints);
+    KDL::JntArray qdot(joints);
+    Eigen::Matrix3Xd jac(3, joints);
+    KDL::Vector com;
+    KDL::Wrench momentum;
+
+    for (int n = 0; n < 10; n++)
+    {
+        for (int i = 0; i < joints; i++)
+        {
+            q(i) = std::sin(0.7 * (n * joints + i) + 0.2);
+            qdot(i) = std::cos(1.3 * (n * joints + i));
+        }
+
+        ASSERT_EQ(solver.JntToCentroidal(q, qdot, com, jac, momentum), 0.0);
+
+        // central differences of the CoM, one joint at a time
+        for (int i = 0; i < joints; i++)
+        {
+            KDL::JntArray qPlus(q), qMinus(q);
+            qPlus(i) += h;
+            qMinus(i) -= h;
+
+            KDL::Vector comPlus, comMinus;
+            ASSERT_EQ(solver.JntToCoM(qPlus, comPlus), 0.0);
+            ASSERT_EQ(solver.JntToCoM(qMinus, comMinus), 0.0);
+
+            KDL::Vector column = (comPlus - comMinus) / (2 * h);
+
+            ASSERT_NEAR(jac(0, i), column.x(), 1e-8);
+            ASSERT_NEAR(jac(1, i), column.y(), 1e-8);
+            ASSERT_NEAR(jac(2, i), column.z(), 1e-8);
+        }
+
+        // linear momentum is the total mass times the CoM velocity
+        Eigen::Vector3d comDot = jac * qdot.data;
+
+        ASSERT_NEAR(momentum.force.x(), solver.getTotalMass() * comDot(0), 1e-9);
+        ASSERT_NEAR(momentum.force.y(), solver.getTotalMass() * comDot(1), 1e-9);
+        ASSERT_NEAR(momentum.force.z(), solver.getTotalMass() * comDot(2), 1e-9);
+    }
+}
+
+}  // namespace roboticslab
@@ -1,7 +1,12 @@
 #include "gtest/gtest.h"
 
 #include <algorithm>
+#include <cmath>
 #include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
 #include <vector>
 #include <utility>
 
@@ -15,8 +20,12 @@
 #include "ConfigurationSelector.hpp"
 #include "MatrixExponential.hpp"
 #include "ProductOfExponentials.hpp"
+#include "ScrewTheoryDualQuaternion.hpp"
+#include "ScrewTheoryIkKernels.hpp"
 #include "ScrewTheoryIkProblem.hpp"
 #include "ScrewTheoryIkSubproblems.hpp"
+#include "ScrewTheoryScalar.hpp"
+#include "ScrewTheoryTools.hpp"
 
 namespace roboticslab
 {
@@ -279,6 +288,20 @@ public:
         return poe;
     }
 
+    static PoeExpression makeGantryWithWristKinematicsFromPoE()
+    {
+        PoeExpression poe(KDL::Frame(KDL::Vector(0.1, 0, 0.25)));
+
+        poe.append(MatrixExponential(MatrixExponential::TRANSLATION, {1, 0, 0}));
+        poe.append(MatrixExponential(MatrixExponential::TRANSLATION, {0, 1, 0}));
+        poe.append(MatrixExponential(MatrixExponential::TRANSLATION, {0, 0, 1}));
+        poe.append(MatrixExponential(MatrixExponential::ROTATION, {0, 0, 1}, {0.1, 0, 0.2}));
+        poe.append(MatrixExponential(MatrixExponential::ROTATION, {0, 1, 0}, {0.1, 0, 0.2}));
+        poe.append(MatrixExponential(MatrixExponential::ROTATION, {0, 0, 1}, {0.1, 0, 0.2}));
+
+        return poe;
+    }
+
     static void checkSolutions(const ScrewTheoryIkSubproblem::Solutions & actual, const ScrewTheoryIkSubproblem::Solutions & expected)
     {
         ScrewTheoryIkSubproblem::JointIdsToSolutions actualSorted, expectedSorted;
@@ -849,6 +872,135 @@ TEST_F(ScrewTheoryTest, PardosFour)
     checkSolutions(actual, expected);
 }
 
+TEST_F(ScrewTheoryTest, RevolutePrismatic)
+{
+    KDL::Vector p(1, 0, 0);
+    KDL::Vector k(0, 2, 0);
+
+    MatrixExponential exp1(MatrixExponential::ROTATION, KDL::Vector(0, 0, 1));
+    MatrixExponential exp2(MatrixExponential::TRANSLATION, KDL::Vector(1, 0, 0));
+    RevolutePrismatic rp(0, 1, exp1, exp2, p);
+
+    ASSERT_EQ(rp.solutions(), 2);
+
+    KDL::Frame rhs(k - p);
+    ScrewTheoryIkSubproblem::Solutions actual;
+    ASSERT_TRUE(rp.solve(rhs, KDL::Frame::Identity(), actual));
+
+    ASSERT_EQ(actual.size(), 2);
+    ASSERT_EQ(actual[0].size(), 2);
+    ASSERT_EQ(actual[1].size(), 2);
+
+    ScrewTheoryIkSubproblem::Solutions expected(2);
+    ScrewTheoryIkSubproblem::JointIdsToSolutions sols1(2), sols2(2);
+
+    sols1[0] = std::make_pair(0, KDL::PI / 2);
+    sols1[1] = std::make_pair(1, 1.0);
+
+    sols2[0] = std::make_pair(0, -KDL::PI / 2);
+    sols2[1] = std::make_pair(1, -3.0);
+
+    expected[0] = sols1;
+    expected[1] = sols2;
+
+    checkSolutions(actual, expected);
+
+    KDL::Vector k2 = k + KDL::Vector(0, 0, 1);
+    KDL::Frame rhs2(k2 - p);
+    ASSERT_FALSE(rp.solve(rhs2, KDL::Frame::Identity(), actual));
+
+    MatrixExponential exp3(MatrixExponential::TRANSLATION, KDL::Vector(0, 0, 1));
+    RevolutePrismatic rpb(0, 1, exp1, exp3, p);
+
+    ASSERT_EQ(rpb.solutions(), 1);
+
+    KDL::Vector k3(0, 1, 2);
+    KDL::Frame rhs3(k3 - p);
+    ASSERT_TRUE(rpb.solve(rhs3, KDL::Frame::Identity(), actual));
+
+    ASSERT_EQ(actual.size(), 1);
+    ASSERT_EQ(actual[0].size(), 2);
+
+    ScrewTheoryIkSubproblem::Solutions expected2(1);
+    ScrewTheoryIkSubproblem::JointIdsToSolutions sols3(2);
+
+    sols3[0] = std::make_pair(0, KDL::PI / 2);
+    sols3[1] = std::make_pair(1, 2.0);
+
+    expected2[0] = sols3;
+
+    checkSolutions(actual, expected2);
+}
+
+TEST_F(ScrewTheoryTest, PrismaticRevolute)
+{
+    KDL::Vector p(1, 0, 0);
+    KDL::Vector k(2, 0.6, 0);
+
+    MatrixExponential exp1(MatrixExponential::TRANSLATION, KDL::Vector(1, 0, 0));
+    MatrixExponential exp2(MatrixExponential::ROTATION, KDL::Vector(0, 0, 1));
+    PrismaticRevolute pr(0, 1, exp1, exp2, p);
+
+    ASSERT_EQ(pr.solutions(), 2);
+
+    KDL::Frame rhs(k - p);
+    ScrewTheoryIkSubproblem::Solutions actual;
+    ASSERT_TRUE(pr.solve(rhs, KDL::Frame::Identity(), actual));
+
+    ASSERT_EQ(actual.size(), 2);
+    ASSERT_EQ(actual[0].size(), 2);
+    ASSERT_EQ(actual[1].size(), 2);
+
+    ScrewTheoryIkSubproblem::Solutions expected(2);
+    ScrewTheoryIkSubproblem::JointIdsToSolutions sols1(2), sols2(2);
+
+    sols1[0] = std::make_pair(0, 2.8);
+    sols1[1] = std::make_pair(1, std::atan2(0.6, -0.8));
+
+    sols2[0] = std::make_pair(0, 1.2);
+    sols2[1] = std::make_pair(1, std::atan2(0.6, 0.8));
+
+    expected[0] = sols1;
+    expected[1] = sols2;
+
+    checkSolutions(actual, expected);
+
+    KDL::Vector k2 = k + KDL::Vector(0, 1, 0);
+    KDL::Frame rhs2(k2 - p);
+    ASSERT_FALSE(pr.solve(rhs2, KDL::Frame::Identity(), actual));
+}
+
+TEST_F(ScrewTheoryTest, PrismaticTriad)
+{
+    KDL::Vector p(0, 0, 0);
+    KDL::Vector k(1, 2, 3);
+
+    MatrixExponential exp1(MatrixExponential::TRANSLATION, KDL::Vector(1, 0, 0));
+    MatrixExponential exp2(MatrixExponential::TRANSLATION, KDL::Vector(0, 1, 0));
+    MatrixExponential exp3(MatrixExponential::TRANSLATION, KDL::Vector(0, 1, 1));
+    PrismaticTriad pt(0, 1, 2, exp1, exp2, exp3, p);
+
+    ASSERT_EQ(pt.solutions(), 1);
+
+    KDL::Frame rhs(k - p);
+    ScrewTheoryIkSubproblem::Solutions actual;
+    ASSERT_TRUE(pt.solve(rhs, KDL::Frame::Identity(), actual));
+
+    ASSERT_EQ(actual.size(), 1);
+    ASSERT_EQ(actual[0].size(), 3);
+
+    ScrewTheoryIkSubproblem::Solutions expected(1);
+    ScrewTheoryIkSubproblem::JointIdsToSolutions sols(3);
+
+    sols[0] = std::make_pair(0, 1.0);
+    sols[1] = std::make_pair(1, -1.0);
+    sols[2] = std::make_pair(2, 3 * std::sqrt(2.0));
+
+    expected[0] = sols;
+
+    checkSolutions(actual, expected);
+}
+
 TEST_F(ScrewTheoryTest, AbbIrb120Kinematics)
 {
     KDL::Chain chain = makeAbbIrb120KinematicsFromDH();
@@ -889,6 +1041,14 @@ TEST_F(ScrewTheoryTest, AbbIrb6620lxKinematics)
     checkRobotKinematics(chain, poe, 4);
 }
 
+TEST_F(ScrewTheoryTest, GantryWithWristKinematics)
+{
+    PoeExpression poe = makeGantryWithWristKinematicsFromPoE();
+    KDL::Chain chain = poe.toChain();
+
+    checkRobotKinematics(chain, poe, 2);
+}
+
 TEST_F(ScrewTheoryTest, TeoRightArmKinematics)
 {
     KDL::Chain chain = makeTeoRightArmKinematicsFromDH();
@@ -905,6 +1065,250 @@ TEST_F(ScrewTheoryTest, TeoRightLegKinematics)
     checkRobotKinematics(chain, poe, 8);
 }
 
+TEST_F(ScrewTheoryTest, IdealizedKinematics)
+{
+    PoeExpression poeIdeal = makeTeoRightArmKinematicsFromPoE();
+    PoeExpression poeSame = ScrewTheoryIkProblemBuilder::idealize(poeIdeal, 0.01);
+
+    ASSERT_EQ(poeSame.size(), poeIdeal.size());
+    ASSERT_EQ(poeSame.getTransform(), poeIdeal.getTransform());
+
+    for (int i = 0; i < poeIdeal.size(); i++)
+    {
+        ASSERT_EQ(poeSame.exponentialAtJoint(i).getAxis(), poeIdeal.exponentialAtJoint(i).getAxis());
+        ASSERT_EQ(poeSame.exponentialAtJoint(i).getOrigin(), poeIdeal.exponentialAtJoint(i).getOrigin());
+    }
+
+    // offset and slightly tilt the last wrist axis
+    const KDL::Joint rotZ(KDL::Joint::RotZ);
+    KDL::Chain chain;
+
+    chain.addSegment(KDL::Segment(rotZ, KDL::Frame::DH(    0, -KDL::PI / 2,        0,            0)));
+    chain.addSegment(KDL::Segment(rotZ, KDL::Frame::DH(    0, -KDL::PI / 2,        0, -KDL::PI / 2)));
+    chain.addSegment(KDL::Segment(rotZ, KDL::Frame::DH(    0, -KDL::PI / 2, -0.32901, -KDL::PI / 2)));
+    chain.addSegment(KDL::Segment(rotZ, KDL::Frame::DH(    0,  KDL::PI / 2,        0,            0)));
+    chain.addSegment(KDL::Segment(rotZ, KDL::Frame::DH(0.002, -KDL::PI / 2 + 0.001, -0.215,      0)));
+    chain.addSegment(KDL::Segment(rotZ, KDL::Frame::DH(-0.09,            0,        0, -KDL::PI / 2)));
+
+    PoeExpression poe = PoeExpression::fromChain(chain);
+
+    ScrewTheoryIkProblemBuilder builder(poe);
+    ScrewTheoryIkProblem * ikProblem = builder.build();
+
+    ASSERT_FALSE(ikProblem);
+
+    PoeExpression poeIdealized = ScrewTheoryIkProblemBuilder::idealize(poe, 0.01);
+
+    ASSERT_EQ(poeIdealized.size(), poe.size());
+    ASSERT_EQ(poeIdealized.getTransform(), poe.getTransform());
+
+    ScrewTheoryIkProblemBuilder idealBuilder(poeIdealized);
+    ikProblem = idealBuilder.build();
+
+    ASSERT_TRUE(ikProblem);
+    ASSERT_EQ(ikProblem->solutions(), 8);
+
+    KDL::JntArray q = fillJointValues(poe.size(), 0.1);
+    KDL::Frame H_S_T_q;
+
+    ASSERT_TRUE(poe.evaluate(q, H_S_T_q));
+
+    ScrewTheoryIkProblem::Solutions solutions;
+    ikProblem->solve(H_S_T_q, solutions);
+    delete ikProblem;
+
+    // closed-form solutions of the idealized chain are a close guess for the actual one
+    int n = -1;
+
+    for (int i = 0; i < solutions.size(); i++)
+    {
+        if ((solutions[i].data - q.data).norm() < 0.05)
+        {
+            n = i;
+        }
+    }
+
+    ASSERT_NE(n, -1);
+}
+
+TEST_F(ScrewTheoryTest, GeneratedCode)
+{
+    PoeExpression poe = makeTeoRightArmKinematicsFromPoE();
+    ScrewTheoryIkProblemBuilder builder(poe);
+    ScrewTheoryIkProblem * ikProblem = builder.build();
+
+    ASSERT_TRUE(ikProblem);
+
+    std::ostringstream oss;
+    bool ret = ikProblem->generateCode(oss, "teo_right_arm");
+    delete ikProblem;
+
+    ASSERT_TRUE(ret);
+
+    std::string code = oss.str();
+
+    ASSERT_NE(code.find("namespace teo_right_arm"), std::string::npos);
+    ASSERT_NE(code.find("constexpr int JOINTS = 6;"), std::string::npos);
+    ASSERT_NE(code.find("constexpr int SOLUTIONS = 8;"), std::string::npos);
+    ASSERT_NE(code.find("inline bool solve(const KDL::Frame & H_S_T, double (&q)[SOLUTIONS][JOINTS])"), std::string::npos);
+    ASSERT_NE(code.find("padenKahanThree("), std::string::npos);
+}
+
+TEST_F(ScrewTheoryTest, ScalarPrecision)
+{
+    PoeExpression poe = makeTeoRightArmKinematicsFromPoE();
+    PoeExpressiond poed(poe);
+    PoeExpressionf poef(poe);
+
+    ASSERT_EQ(poed.size(), poe.size());
+    ASSERT_EQ(poef.size(), poe.size());
+
+    const int count = 50;
+    std::vector<double> qd(count * poe.size());
+    std::vector<float> qf(qd.size());
+
+    for (int i = 0; i < qd.size(); i++)
+    {
+        qd[i] = KDL::PI * std::sin(0.7 * i + 0.3);
+        qf[i] = qd[i];
+    }
+
+    std::vector<FrameT<double>> Hd(count);
+    std::vector<FrameT<float>> Hf(count);
+
+    poed.evaluate(qd.data(), count, Hd.data());
+    poef.evaluate(qf.data(), count, Hf.data());
+
+    for (int n = 0; n < count; n++)
+    {
+        KDL::JntArray q(poe.size());
+
+        for (int i = 0; i < poe.size(); i++)
+        {
+            q(i) = qd[n * poe.size() + i];
+        }
+
+        KDL::Frame H;
+        ASSERT_TRUE(poe.evaluate(q, H));
+
+        // double precision matches the KDL-based path, single precision is within a few micrometers
+        ASSERT_TRUE(KDL::Equal(toKdl(Hd[n]), H, 1e-12));
+        ASSERT_TRUE(KDL::Equal(toKdl(Hf[n]), H, 1e-5));
+    }
+
+    // same subproblem kernel, double (KDL) vs single precision
+    MatrixExponential exp1(MatrixExponential::ROTATION, KDL::Vector(1, 0, 0), KDL::Vector(1, 0, 0));
+    MatrixExponential exp2(MatrixExponential::ROTATION, KDL::Vector(0, 1, 0), KDL::Vector(1, 0, 0));
+
+    const KDL::Vector & axis1 = exp1.getAxis();
+    const KDL::Vector & axis2 = exp2.getAxis();
+    const KDL::Vector & r = exp1.getOrigin();
+    KDL::Vector p(0, 1, 0);
+
+    for (int n = 0; n < count; n++)
+    {
+        KDL::Frame rhs = exp1.asFrame(qd[2 * n]) * exp2.asFrame(qd[2 * n + 1]);
+
+        double thetad[4];
+        float thetaf[4];
+
+        bool retd = padenKahanTwo(axis1, axis2, r, axis1 * axis2, vectorPow2(axis1), vectorPow2(axis2),
+                                  KDL::dot(axis1, axis2), p, rhs, KDL::Frame::Identity(), thetad);
+
+        bool retf = padenKahanTwo(toScalar<float>(axis1), toScalar<float>(axis2), toScalar<float>(r),
+                                  toScalar<float>(axis1 * axis2), toScalar<float>(vectorPow2(axis1)),
+                                  toScalar<float>(vectorPow2(axis2)), KDL::dot(axis1, axis2), toScalar<float>(p),
+                                  toScalar<float>(rhs), FrameT<float>::Identity(), thetaf);
+
+        ASSERT_TRUE(retd);
+        ASSERT_EQ(retf, retd);
+
+        // joint values are ill-conditioned near singularities, compare the resulting positions instead
+        for (int i = 0; i < 2; i++)
+        {
+            KDL::Vector pd = exp1.asFrame(thetad[2 * i]) * exp2.asFrame(thetad[2 * i + 1]) * p;
+            KDL::Vector pf = exp1.asFrame(thetaf[2 * i]) * exp2.asFrame(thetaf[2 * i + 1]) * p;
+
+            ASSERT_TRUE(KDL::Equal(pd, rhs * p, 1e-9));
+            ASSERT_TRUE(KDL::Equal(pf, rhs * p, 1e-4));
+        }
+    }
+}
+
+TEST_F(ScrewTheoryTest, DualQuaternion)
+{
+    KDL::Vector axis(0, 1, 1);
+    KDL::Vector origin(0.5, -0.2, 0.3);
+    double theta = 0.8;
+
+    MatrixExponentiald rot(MatrixExponential(MatrixExponential::ROTATION, axis, origin));
+    MatrixExponentiald trans(MatrixExponential(MatrixExponential::TRANSLATION, axis));
+
+    ASSERT_TRUE(KDL::Equal(toKdl(rot.asDualQuaternion(theta)), toKdl(rot.asFrame(theta))));
+    ASSERT_TRUE(KDL::Equal(toKdl(trans.asDualQuaternion(theta)), toKdl(trans.asFrame(theta))));
+
+    KDL::Frame H(KDL::Rotation::RPY(0.1, -0.5, 1.2), KDL::Vector(0.4, 0.5, -0.6));
+    DualQuaterniond dq = toDualQuaternion<double>(H);
+
+    ASSERT_TRUE(KDL::Equal(toKdl(dq), H));
+    ASSERT_TRUE(KDL::Equal(toKdl(dq.Inverse()), H.Inverse()));
+    ASSERT_TRUE(KDL::Equal(toKdl<double>(dq * toScalar<double>(origin)), H * origin));
+
+    PoeExpression poe = makeTeoRightArmKinematicsFromPoE();
+    PoeExpressiond poed(poe);
+    PoeExpressionf poef(poe);
+
+    const int count = 50;
+    std::vector<double> qd(count * poe.size());
+    std::vector<float> qf(qd.size());
+
+    for (int i = 0; i < qd.size(); i++)
+    {
+        qd[i] = KDL::PI * std::sin(0.7 * i + 0.3);
+        qf[i] = qd[i];
+    }
+
+    std::vector<DualQuaterniond> Hd(count);
+    std::vector<DualQuaternionf> Hf(count);
+
+    poed.evaluate(qd.data(), count, Hd.data());
+    poef.evaluate(qf.data(), count, Hf.data());
+
+    for (int n = 0; n < count; n++)
+    {
+        KDL::JntArray q(poe.size());
+
+        for (int i = 0; i < poe.size(); i++)
+        {
+            q(i) = qd[n * poe.size() + i];
+        }
+
+        KDL::Frame H_S_T;
+        ASSERT_TRUE(poe.evaluate(q, H_S_T));
+
+        ASSERT_TRUE(KDL::Equal(toKdl(Hd[n]), H_S_T, 1e-12));
+        ASSERT_TRUE(KDL::Equal(toKdl(Hf[n]), H_S_T, 1e-5));
+    }
+
+    // long products in single precision stay on the unit manifold after renormalization
+    DualQuaternionf acc = DualQuaternionf::Identity();
+
+    for (int i = 0; i < 1000; i++)
+    {
+        acc = acc * Hf[i % count];
+
+        if ((i + 1) % DualQuaternionf::RENORMALIZATION_PERIOD == 0)
+        {
+            acc.normalize();
+        }
+    }
+
+    acc.normalize();
+
+    ASSERT_NEAR(acc.getReal().norm(), 1, 1e-6);
+    ASSERT_NEAR(acc.getReal().coeffs().dot(acc.getDual().coeffs()), 0, 1e-6);
+}
+
 TEST_F(ScrewTheoryTest, ConfigurationSelector)
 {
     PoeExpression poe = makeTeoRightArmKinematicsFromPoE();
@@ -955,6 +1359,150 @@ TEST_F(ScrewTheoryTest, ConfigurationSelector)
     delete config;
 }
 
+TEST_F(ScrewTheoryTest, ConfigurationSelectorMask)
+{
+    PoeExpression poe = makeTeoRightArmKinematicsFromPoE();
+
+    KDL::JntArray q(poe.size());
+    q(3) = KDL::PI / 2; // elbow
+
+    KDL::Frame H;
+    ASSERT_TRUE(poe.evaluate(q, H));
+
+    ScrewTheoryIkProblemBuilder builder(poe);
+    ScrewTheoryIkProblem * ikProblem = builder.build();
+
+    ASSERT_TRUE(ikProblem);
+
+    ScrewTheoryIkProblem::Solutions solutions;
+    ASSERT_TRUE(ikProblem->solve(H, solutions));
+    delete ikProblem;
+
+    int n1 = findTargetConfiguration(solutions, q);
+    ASSERT_NE(n1, -1);
+
+    KDL::JntArray qMin = fillJointValues(poe.size(), -KDL::PI);
+    KDL::JntArray qMax = fillJointValues(poe.size(), KDL::PI);
+
+    ConfigurationSelectorLeastOverallAngularDisplacementFactory confFactory(qMin, qMax);
+    std::vector<bool> all(solutions.size(), true);
+    std::vector<bool> allButOne(all);
+    allButOne[n1] = false;
+
+    // nothing left to choose from
+    std::unique_ptr<ConfigurationSelector> config(confFactory.create());
+    ASSERT_FALSE(config->configure(solutions, std::vector<bool>(solutions.size(), false)));
+    ASSERT_FALSE(config->findOptimalConfiguration(q));
+
+    // the best configuration is masked out, pick another one
+    config.reset(confFactory.create());
+    ASSERT_TRUE(config->configure(solutions, allButOne));
+    ASSERT_TRUE(config->findOptimalConfiguration(q));
+
+    KDL::JntArray qSolved;
+    config->retrievePose(qSolved);
+    int n2 = findTargetConfiguration(solutions, qSolved);
+
+    ASSERT_NE(n2, -1);
+    ASSERT_NE(n2, n1);
+
+    // a masked-out configuration is never switched to, nor away from
+    config.reset(confFactory.create());
+    ASSERT_TRUE(config->configure(solutions, all));
+    ASSERT_TRUE(config->findOptimalConfiguration(q));
+    config->retrievePose(qSolved);
+    ASSERT_EQ(findTargetConfiguration(solutions, qSolved), n1);
+
+    ASSERT_TRUE(config->configure(solutions, allButOne));
+    ASSERT_FALSE(config->findOptimalConfiguration(q));
+
+    ASSERT_TRUE(config->configure(solutions, all));
+    ASSERT_TRUE(config->findOptimalConfiguration(q));
+    config->retrievePose(qSolved);
+    ASSERT_EQ(findTargetConfiguration(solutions, qSolved), n1);
+}
+
+TEST_F(ScrewTheoryTest, ConcurrentSolve)
+{
+    PoeExpression poe = makeTeoRightArmKinematicsFromPoE();
+
+    ScrewTheoryIkProblemBuilder builder(poe);
+    const ScrewTheoryIkProblem * ikProblem = builder.build();
+
+    ASSERT_TRUE(ikProblem);
+
+    KDL::JntArray qMin = fillJointValues(poe.size(), -KDL::PI);
+    KDL::JntArray qMax = fillJointValues(poe.size(), KDL::PI);
+
+    ConfigurationSelectorLeastOverallAngularDisplacementFactory confFactory(qMin, qMax);
+
+    const int poses = 20;
+    const int threads = 4;
+
+    std::vector<KDL::Frame> targets(poses);
+    std::vector<KDL::JntArray> expected(poses);
+
+    // sequential reference, a fresh selector per pose
+    for (int n = 0; n < poses; n++)
+    {
+        KDL::JntArray q(poe.size());
+
+        for (int i = 0; i < poe.size(); i++)
+        {
+            q(i) = 0.5 * std::sin(0.9 * (n * poe.size() + i) + 0.1);
+        }
+
+        ASSERT_TRUE(poe.evaluate(q, targets[n]));
+
+        ScrewTheoryIkProblem::Solutions solutions;
+        ASSERT_TRUE(ikProblem->solve(targets[n], solutions));
+
+        ConfigurationSelector * config = confFactory.create();
+        ASSERT_TRUE(config->configure(solutions));
+        ASSERT_TRUE(config->findOptimalConfiguration(q));
+        config->retrievePose(expected[n]);
+        delete config;
+
+        ASSERT_TRUE(KDL::Equal(expected[n], q));
+    }
+
+    // the same problem instance shared by several threads, each one with its own solutions and selector
+    std::vector<std::vector<KDL::JntArray>> results(threads, std::vector<KDL::JntArray>(poses));
+    std::vector<std::thread> pool;
+
+    for (int t = 0; t < threads; t++)
+    {
+        pool.emplace_back([&, t]
+        {
+            ScrewTheoryIkProblem::Solutions solutions;
+
+            for (int n = 0; n < poses; n++)
+            {
+                std::unique_ptr<ConfigurationSelector> config(confFactory.create());
+                ikProblem->solve(targets[n], solutions);
+                config->configure(solutions);
+                config->findOptimalConfiguration(expected[n]);
+                config->retrievePose(results[t][n]);
+            }
+        });
+    }
+
+    for (auto & worker : pool)
+    {
+        worker.join();
+    }
+
+    for (int t = 0; t < threads; t++)
+    {
+        for (int n = 0; n < poses; n++)
+        {
+            ASSERT_TRUE(KDL::Equal(results[t][n], expected[n]));
+        }
+    }
+
+    delete ikProblem;
+}
+
 TEST_F(ScrewTheoryTest, ConfigurationSelectorGait)
 {
     PoeExpression poe = makeTeoRightLegKinematicsFromPoE();
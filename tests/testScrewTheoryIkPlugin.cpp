@@ -0,0 +1,174 @@
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include <yarp/os/Property.h>
+#include <yarp/os/SharedLibrary.h>
+
+#include <kdl/chain.hpp>
+#include <kdl/frames.hpp>
+#include <kdl/jntarray.hpp>
+
+#include "ChainParser.hpp"
+#include "ProductOfExponentials.hpp"
+#include "ScrewTheoryIkProblem.hpp"
+
+namespace roboticslab
+{
+
+/**
+ * @ingroup kinematics-dynamics-tests
+ * @brief Tests an IK solver built by roboticslab_add_screw_theory_ik_plugin
+ * against the runtime ScrewTheoryIkProblem for the same kinematics file.
+ */
+class ScrewTheoryIkPluginTest : public testing::Test
+{
+public:
+    using JointsFn = int (*)();
+    using SolutionsFn = int (*)();
+    using SolveFn = int (*)(const double *, double *);
+
+    virtual void SetUp()
+    {
+        yarp::os::Property fullConfig;
+        ASSERT_TRUE(fullConfig.fromConfigFile(TEST_ST_IK_KINEMATICS));
+        ASSERT_TRUE(parseChain(fullConfig, chain));
+
+        poe = PoeExpression::fromChain(chain);
+
+        // same seed as screwTheoryIkGenerator, the builder relies on random test points
+        std::srand(0);
+
+        ScrewTheoryIkProblemBuilder builder(poe);
+        problem.reset(builder.build());
+        ASSERT_TRUE(problem);
+
+        library.reset(new yarp::os::SharedLibrary(TEST_ST_IK_PLUGIN));
+        ASSERT_TRUE(library->isValid());
+
+        auto jointsFn = reinterpret_cast<JointsFn>(library->getSymbol("roboticslab_st_ik_joints"));
+        auto solutionsFn = reinterpret_cast<SolutionsFn>(library->getSymbol("roboticslab_st_ik_solutions"));
+        solveFn = reinterpret_cast<SolveFn>(library->getSymbol("roboticslab_st_ik_solve"));
+
+        ASSERT_TRUE(jointsFn);
+        ASSERT_TRUE(solutionsFn);
+        ASSERT_TRUE(solveFn);
+
+        ASSERT_EQ(jointsFn(), poe.size());
+        ASSERT_EQ(solutionsFn(), problem->solutions());
+    }
+
+    virtual void TearDown()
+    {
+    }
+
+    static void frameToArray(const KDL::Frame & H, double * out)
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            for (int j = 0; j < 3; j++)
+            {
+                out[3 * i + j] = H.M(i, j);
+            }
+
+            out[9 + i] = H.p(i);
+        }
+    }
+
+protected:
+    KDL::Chain chain;
+    PoeExpression poe;
+    std::unique_ptr<ScrewTheoryIkProblem> problem;
+    std::unique_ptr<yarp::os::SharedLibrary> library;
+    SolveFn solveFn {nullptr};
+};
+
+TEST_F(ScrewTheoryIkPluginTest, SameSolutionsAsRuntimeProblem)
+{
+    const int joints = poe.size();
+    const int soln = problem->solutions();
+
+    std::vector<double> values(soln * joints);
+    double H[12];
+
+    for (int n = 0; n < 50; n++)
+    {
+        KDL::JntArray q(joints);
+
+        for (int j = 0; j < joints; j++)
+        {
+            q(j) = 1.5 * std::sin(0.7 * (n * joints + j) + 0.3);
+        }
+
+        KDL::Frame H_S_T;
+        ASSERT_TRUE(poe.evaluate(q, H_S_T));
+
+        ScrewTheoryIkProblem::Solutions expected;
+        bool expectedReachable = problem->solve(H_S_T, expected);
+
+        frameToArray(H_S_T, H);
+        bool actualReachable = solveFn(H, values.data());
+
+        ASSERT_EQ(actualReachable, expectedReachable);
+        ASSERT_TRUE(actualReachable);
+        ASSERT_EQ(expected.size(), soln);
+
+        bool targetFound = false;
+
+        for (int i = 0; i < soln; i++)
+        {
+            KDL::JntArray actual(joints);
+
+            for (int j = 0; j < joints; j++)
+            {
+                actual(j) = values[i * joints + j];
+            }
+
+            // each generated solution is also found by the runtime solver
+            bool matched = false;
+
+            for (int k = 0; k < soln && !matched; k++)
+            {
+                matched = KDL::Equal(actual, expected[k], 1e-9);
+            }
+
+            ASSERT_TRUE(matched);
+
+            KDL::Frame H_S_T_validate;
+            ASSERT_TRUE(poe.evaluate(actual, H_S_T_validate));
+            ASSERT_TRUE(KDL::Equal(H_S_T_validate, H_S_T, 1e-6));
+
+            targetFound = targetFound || KDL::Equal(actual, q, 1e-6);
+        }
+
+        ASSERT_TRUE(targetFound);
+    }
+}
+
+TEST_F(ScrewTheoryIkPluginTest, SameReachabilityAsRuntimeProblem)
+{
+    std::vector<double> values(problem->solutions() * poe.size());
+    double H[12];
+
+    // way out of reach
+    KDL::Frame H_S_T(KDL::Rotation::RPY(0.1, 0.2, 0.3), KDL::Vector(5.0, 5.0, 5.0));
+
+    ScrewTheoryIkProblem::Solutions expected;
+    bool expectedReachable = problem->solve(H_S_T, expected);
+
+    frameToArray(H_S_T, H);
+    bool actualReachable = solveFn(H, values.data());
+
+    ASSERT_FALSE(expectedReachable);
+    ASSERT_EQ(actualReachable, expectedReachable);
+
+    for (double value : values)
+    {
+        ASSERT_TRUE(std::isfinite(value));
+    }
+}
+
+}  // namespace roboticslab
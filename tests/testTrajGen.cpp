@@ -0,0 +1,247 @@
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <algorithm>
+#include <vector>
+
+#include "TrajGen.hpp"
+
+namespace roboticslab
+{
+
+/**
+ * @ingroup kinematics-dynamics-tests
+ * @brief Tests the 1-DOF trajectories of \ref TrajGen.
+ */
+class TrajGenTest : public testing::Test
+{
+public:
+    virtual void SetUp()
+    {
+    }
+
+    virtual void TearDown()
+    {
+    }
+
+    //! Peak magnitudes of the first and second derivatives, sampled every @p dt.
+    static void samplePeaks(const Traj & traj, double dt, double & maxVel, double & maxAcc)
+    {
+        const int n = traj.getT() / dt + 1;
+        std::vector<double> xdot(n), xdotdot(n);
+        traj.sample(0.0, dt, n, nullptr, xdot.data(), xdotdot.data());
+
+        maxVel = maxAcc = 0.0;
+
+        for (int k = 0; k < n; k++)
+        {
+            maxVel = std::max(maxVel, std::abs(xdot[k]));
+            maxAcc = std::max(maxAcc, std::abs(xdotdot[k]));
+        }
+    }
+
+    //! Batch evaluation must match per-point evaluation, also past the end of the trajectory.
+    static void expectSampleMatchesGet(const Traj & traj)
+    {
+        const int n = 50;
+        const double t0 = -0.1 * traj.getT();
+        const double dt = 1.5 * traj.getT() / n;
+
+        std::vector<double> x(n), xdot(n), xdotdot(n);
+        traj.sample(t0, dt, n, x.data(), xdot.data(), xdotdot.data());
+
+        for (int k = 0; k < n; k++)
+        {
+            const double ti = t0 + k * dt;
+
+            if (ti < 0.0)
+            {
+                continue; // undefined before the start, not all trajectories clamp
+            }
+
+            ASSERT_NEAR(x[k], traj.get(ti), 1e-12);
+            ASSERT_NEAR(xdot[k], traj.getdot(ti), 1e-12);
+            ASSERT_NEAR(xdotdot[k], traj.getdotdot(ti), 1e-12);
+        }
+
+        // null outputs are skipped
+        std::vector<double> xOnly(n);
+        traj.sample(t0, dt, n, xOnly.data(), nullptr, nullptr);
+        ASSERT_EQ(xOnly, x);
+    }
+};
+
+TEST_F(TrajGenTest, OrderFiveBoundaryConditions)
+{
+    OrderFiveTraj traj;
+    ASSERT_TRUE(traj.configure(0.5, -1.0, 0.2, -0.3, 0.1, 0.4, 2.0));
+    ASSERT_EQ(traj.getT(), 2.0);
+
+    ASSERT_NEAR(traj.get(0.0), 0.5, 1e-12);
+    ASSERT_NEAR(traj.getdot(0.0), 0.2, 1e-12);
+    ASSERT_NEAR(traj.getdotdot(0.0), 0.1, 1e-12);
+
+    ASSERT_NEAR(traj.get(2.0), -1.0, 1e-12);
+    ASSERT_NEAR(traj.getdot(2.0), -0.3, 1e-12);
+    ASSERT_NEAR(traj.getdotdot(2.0), 0.4, 1e-12);
+
+    // held past the end
+    ASSERT_NEAR(traj.get(3.0), -1.0, 1e-12);
+
+    // rest to rest
+    ASSERT_TRUE(traj.configure(1.0, 3.0, 4.0));
+    ASSERT_NEAR(traj.get(0.0), 1.0, 1e-12);
+    ASSERT_NEAR(traj.get(4.0), 3.0, 1e-12);
+    ASSERT_NEAR(traj.getdot(0.0), 0.0, 1e-12);
+    ASSERT_NEAR(traj.getdot(4.0), 0.0, 1e-12);
+    ASSERT_NEAR(traj.getdotdot(0.0), 0.0, 1e-12);
+    ASSERT_NEAR(traj.getdotdot(4.0), 0.0, 1e-12);
+    ASSERT_NEAR(traj.get(2.0), 2.0, 1e-12); // symmetric
+}
+
+TEST_F(TrajGenTest, OrderFiveMaxVelAcc)
+{
+    OrderFiveTraj traj;
+
+    // rest to rest: peak velocity 15/8 h/T at the middle, peak acceleration 10/sqrt(3) h/T^2
+    const double h = 2.0, T = 4.0;
+    ASSERT_TRUE(traj.configure(1.0, 1.0 + h, T));
+
+    const double peakVel = 15.0 / 8.0 * h / T;
+    const double peakAcc = 10.0 / std::sqrt(3.0) * h / (T * T);
+
+    ASSERT_TRUE(traj.maxVelBelow(peakVel * (1 + 1e-9)));
+    ASSERT_FALSE(traj.maxVelBelow(peakVel * (1 - 1e-9)));
+    ASSERT_TRUE(traj.maxAccBelow(peakAcc * (1 + 1e-9)));
+    ASSERT_FALSE(traj.maxAccBelow(peakAcc * (1 - 1e-9)));
+
+    // arbitrary boundary conditions, peaks found by dense sampling
+    ASSERT_TRUE(traj.configure(0.5, -1.0, 0.8, -0.3, 0.1, 0.4, 2.0));
+
+    double maxVel, maxAcc;
+    samplePeaks(traj, 1e-5, maxVel, maxAcc);
+
+    ASSERT_TRUE(traj.maxVelBelow(maxVel * (1 + 1e-6)));
+    ASSERT_FALSE(traj.maxVelBelow(maxVel * (1 - 1e-6)));
+    ASSERT_TRUE(traj.maxAccBelow(maxAcc * (1 + 1e-6)));
+    ASSERT_FALSE(traj.maxAccBelow(maxAcc * (1 - 1e-6)));
+}
+
+TEST_F(TrajGenTest, JerkLimitedCruise)
+{
+    // acceleration limit reached, then cruise at the velocity limit
+    const double maxVel = 0.5, maxAcc = 1.0, maxJerk = 4.0;
+    JerkLimitedTraj traj(maxVel, maxAcc, maxJerk);
+    ASSERT_TRUE(traj.configure(1.0, 2.0));
+
+    ASSERT_NEAR(traj.getT(), 1.0 / maxVel + maxVel / maxAcc + maxAcc / maxJerk, 1e-12);
+    ASSERT_TRUE(traj.maxVelBelow(maxVel * (1 + 1e-9)));
+    ASSERT_FALSE(traj.maxVelBelow(maxVel * (1 - 1e-9)));
+    ASSERT_TRUE(traj.maxAccBelow(maxAcc * (1 + 1e-9)));
+    ASSERT_FALSE(traj.maxAccBelow(maxAcc * (1 - 1e-9)));
+}
+
+TEST_F(TrajGenTest, JerkLimitedNoCruise)
+{
+    const double maxVel = 10.0, maxAcc = 1.0, maxJerk = 4.0;
+    JerkLimitedTraj traj(maxVel, maxAcc, maxJerk);
+
+    // acceleration limit reached, the distance is covered by Ta * v
+    ASSERT_TRUE(traj.configure(0.0, 1.0));
+    const double v = (traj.getT() / 2 - maxAcc / maxJerk) * maxAcc;
+    ASSERT_NEAR(v * traj.getT() / 2, 1.0, 1e-9);
+    ASSERT_TRUE(traj.maxAccBelow(maxAcc * (1 + 1e-9)));
+    ASSERT_FALSE(traj.maxAccBelow(maxAcc * (1 - 1e-9)));
+
+    // acceleration limit not reached, pure jerk phases: D = 2 * v^(3/2) / sqrt(J)
+    const double D = 0.01;
+    ASSERT_TRUE(traj.configure(0.0, D));
+    const double vPeak = std::cbrt(D * D * maxJerk / 4);
+    ASSERT_NEAR(traj.getT(), 4 * std::sqrt(vPeak / maxJerk), 1e-12);
+    ASSERT_TRUE(traj.maxVelBelow(vPeak * (1 + 1e-9)));
+    ASSERT_FALSE(traj.maxVelBelow(vPeak * (1 - 1e-9)));
+    ASSERT_TRUE(traj.maxAccBelow(std::sqrt(vPeak * maxJerk) * (1 + 1e-9)));
+    ASSERT_FALSE(traj.maxAccBelow(std::sqrt(vPeak * maxJerk) * (1 - 1e-9)));
+}
+
+TEST_F(TrajGenTest, JerkLimitedBoundaryConditionsAndLimits)
+{
+    const double maxVel = 0.5, maxAcc = 1.0, maxJerk = 4.0;
+    const double dt = 1e-4;
+
+    JerkLimitedTraj traj(maxVel, maxAcc, maxJerk);
+
+    struct Case { double xi, xf, T; }; // T = 0: shortest
+
+    // shortest, stretched, negative direction and no motion at all
+    const Case cases[] = {{1.0, 2.0, 0.0}, {1.0, 2.0, 5.0}, {1.0, -0.5, 0.0}, {1.0, 1.0, 1.0}};
+
+    for (const auto & c : cases)
+    {
+        const double xi = c.xi, xf = c.xf;
+
+        if (c.T != 0.0)
+        {
+            ASSERT_TRUE(traj.configure(xi, xf, c.T));
+            ASSERT_NEAR(traj.getT(), c.T, 1e-9);
+        }
+        else
+        {
+            ASSERT_TRUE(traj.configure(xi, xf));
+        }
+
+        const double T = traj.getT();
+
+        ASSERT_NEAR(traj.get(0.0), xi, 1e-12);
+        ASSERT_NEAR(traj.getdot(0.0), 0.0, 1e-12);
+        ASSERT_NEAR(traj.getdotdot(0.0), 0.0, 1e-12);
+        ASSERT_NEAR(traj.get(T), xf, 1e-12);
+        ASSERT_NEAR(traj.getdot(T), 0.0, 1e-12);
+        ASSERT_NEAR(traj.getdotdot(T), 0.0, 1e-12);
+
+        const int n = T / dt + 1;
+        std::vector<double> x(n), xdot(n), xdotdot(n);
+        traj.sample(0.0, dt, n, x.data(), xdot.data(), xdotdot.data());
+
+        for (int k = 0; k < n; k++)
+        {
+            ASSERT_LE(std::abs(xdot[k]), maxVel * (1 + 1e-9));
+            ASSERT_LE(std::abs(xdotdot[k]), maxAcc * (1 + 1e-9));
+
+            if (k != 0)
+            {
+                // continuous position and velocity, bounded jerk (across phase boundaries too)
+                ASSERT_LE(std::abs(x[k] - x[k - 1]), maxVel * dt * (1 + 1e-6));
+                ASSERT_LE(std::abs(xdot[k] - xdot[k - 1]), maxAcc * dt * (1 + 1e-6));
+                ASSERT_LE(std::abs(xdotdot[k] - xdotdot[k - 1]), maxJerk * dt * (1 + 1e-6));
+            }
+        }
+    }
+
+    // too short
+    ASSERT_FALSE(traj.configure(1.0, 2.0, 1.0));
+
+    // nonzero boundary velocities are not supported
+    ASSERT_FALSE(traj.configure(1.0, 2.0, 0.1, 0.0, 5.0));
+}
+
+TEST_F(TrajGenTest, SampleMatchesGet)
+{
+    OrderOneTraj orderOne;
+    ASSERT_TRUE(orderOne.configure(0.5, -1.0, 2.0));
+    expectSampleMatchesGet(orderOne);
+
+    OrderThreeTraj orderThree;
+    ASSERT_TRUE(orderThree.configure(0.5, -1.0, 0.2, -0.3, 2.0));
+    expectSampleMatchesGet(orderThree);
+
+    OrderFiveTraj orderFive;
+    ASSERT_TRUE(orderFive.configure(0.5, -1.0, 0.2, -0.3, 0.1, 0.4, 2.0));
+    expectSampleMatchesGet(orderFive);
+
+    JerkLimitedTraj jerkLimited(0.5, 1.0, 4.0);
+    ASSERT_TRUE(jerkLimited.configure(0.5, -1.0, 5.0));
+    expectSampleMatchesGet(jerkLimited);
+}
+
+}  // namespace roboticslab